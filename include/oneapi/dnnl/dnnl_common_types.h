@@ -87,6 +87,18 @@ typedef enum {
     dnnl_u8 = 6,
     /// 64-bit/double-precision floating point.
     dnnl_f64 = 7,
+    /// 4-bit signed integer. Two values are packed into a byte, the first one
+    /// in the low half of the byte.
+    dnnl_s4 = 11,
+    /// 4-bit unsigned integer. Two values are packed into a byte, the first
+    /// one in the low half of the byte.
+    dnnl_u4 = 12,
+    /// 8-bit floating point with a 5-bit exponent and a 2-bit mantissa, the
+    /// top half of an f16 value.
+    dnnl_f8_e5m2 = 13,
+    /// 8-bit floating point with a 4-bit exponent and a 3-bit mantissa. There
+    /// is no infinity, the largest finite value is 448.
+    dnnl_f8_e4m3 = 14,
 
     /// Parameter to allow internal only data_types without undefined behavior.
     /// This parameter is chosen to be valid for so long as sizeof(int) >= 2.
@@ -399,6 +399,85 @@ dnnl_status_t DNNL_API dnnl_graph_partition_compile(
         const dnnl_graph_logical_tensor_t **inputs, size_t out_num,
         const dnnl_graph_logical_tensor_t **outputs, dnnl_engine_t engine);
 
+/// Compiles a partition asynchronously. The compilation is done by a bounded
+/// pool of background threads, and the call returns a task handle immediately.
+/// The arguments are the same as #dnnl_graph_partition_compile(). The given
+/// logical tensors are copied, so they can be released once the call returns.
+/// The partition, the compiled partition and the engine must be kept alive
+/// until the task is completed. The output logical tensors deduced by the
+/// compilation can be queried from the compiled partition after that.
+///
+/// The number of background threads can be set with the
+/// `ONEDNN_GRAPH_COMPILE_THREADS` environment variable. By default, it's the
+/// number of hardware threads. The compilation is done for the max number of
+/// threads of the calling thread, as the synchronous compilation. When called
+/// from a background compilation thread, the compilation is done inline and
+/// the task is completed on return.
+///
+/// @param partition The target partition.
+/// @param compiled_partition Output compiled partition.
+/// @param in_num The number of input logical tensors.
+/// @param inputs A list of input logical tensors.
+/// @param out_num The number of output logical tensors.
+/// @param outputs A list of output logical tensors.
+/// @param engine The target engine of the compilation.
+/// @param task Output compilation task handle, which must be destroyed with
+///     #dnnl_graph_compile_task_destroy().
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise. The errors of the compilation itself are returned by
+///     #dnnl_graph_compile_task_wait().
+dnnl_status_t DNNL_API dnnl_graph_partition_compile_async(
+        dnnl_graph_partition_t partition,
+        dnnl_graph_compiled_partition_t compiled_partition, size_t in_num,
+        const dnnl_graph_logical_tensor_t **inputs, size_t out_num,
+        const dnnl_graph_logical_tensor_t **outputs, dnnl_engine_t engine,
+        dnnl_graph_compile_task_t *task);
+
+/// Creates a compiled partition from a cache blob returned by
+/// #dnnl_graph_compiled_partition_get_cache_blob(), without running the
+/// compilation. The cache blob is specific to the partition, the input and
+/// output logical tensors given at its compilation, the library version and
+/// the CPU ISA. The compiled partition has the same input and output logical
+/// tensors as the one the cache blob is created from.
+///
+/// @param partition The target partition.
+/// @param compiled_partition Output compiled partition.
+/// @param size The size of the cache blob in bytes.
+/// @param cache_blob The cache blob.
+/// @param engine The target engine of the compiled partition.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise. #dnnl_invalid_arguments is returned if the cache blob can't
+///     be used with the partition, in which case the partition should be
+///     compiled with #dnnl_graph_partition_compile().
+dnnl_status_t DNNL_API dnnl_graph_partition_compile_from_cache_blob(
+        dnnl_graph_partition_t partition,
+        dnnl_graph_compiled_partition_t compiled_partition, size_t size,
+        const uint8_t *cache_blob, dnnl_engine_t engine);
+
+/// Compiles a list of partitions concurrently on the background compilation
+/// threads and waits for all of them. The compiled partitions are not returned
+/// but kept in the compiled partition cache, so that the following
+/// compilations with the same partitions and logical tensors are cache hits.
+/// A partition can be listed several times with different logical tensors to
+/// warm up several shapes. The compilations are done for the max number of
+/// threads of the calling thread.
+///
+/// @param num The number of compilations.
+/// @param partitions A list of partitions to compile.
+/// @param in_nums The number of input logical tensors of each compilation.
+/// @param inputs The input logical tensors of each compilation.
+/// @param out_nums The number of output logical tensors of each compilation.
+/// @param outputs The output logical tensors of each compilation.
+/// @param engine The target engine of the compilations.
+/// @returns #dnnl_success if all the compilations succeed or the status of the
+///     first failed one otherwise.
+dnnl_status_t DNNL_API dnnl_graph_partition_warmup(size_t num,
+        const dnnl_graph_partition_t *partitions, const size_t *in_nums,
+        const dnnl_graph_logical_tensor_t *const *inputs,
+        const size_t *out_nums,
+        const dnnl_graph_logical_tensor_t *const *outputs,
+        dnnl_engine_t engine);
+
 /// Returns the number of input logical tensors of a partition.
 ///
 /// @param partition The target partition.
@@ -463,6 +542,19 @@ dnnl_status_t DNNL_API dnnl_graph_partition_is_supported(
 dnnl_status_t DNNL_API dnnl_graph_partition_get_engine_kind(
         const_dnnl_graph_partition_t partition, dnnl_engine_kind_t *kind);
 
+/// Sets whether the independent operations of a partition can be executed
+/// concurrently on CPU. It overrides the default of the library for the
+/// partition and takes effect at the next compilation of the partition.
+///
+/// @param partition The target partition.
+/// @param enable 1 to execute independent operations concurrently when they
+///     are small enough to not use all the cores by themselves, 0 to always
+///     execute the operations one by one.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_graph_partition_set_inter_op_parallel(
+        dnnl_graph_partition_t partition, uint8_t enable);
+
 /// @} dnnl_graph_api_partition
 
 /// @addtogroup dnnl_graph_api_compiled_partition
@@ -535,6 +627,62 @@ dnnl_status_t DNNL_API dnnl_graph_compiled_partition_get_inplace_ports(
         size_t *num_inplace_pairs,
         const dnnl_graph_inplace_pair_t **inplace_pairs);
 
+/// Retrieves the cache blob of a compiled partition. The cache blob can be
+/// stored and used to create the compiled partition in another process with
+/// #dnnl_graph_partition_compile_from_cache_blob().
+///
+/// @param compiled_partition The handle of target compiled_partition.
+/// @param size Size of the cache blob in bytes.
+/// @param cache_blob Cache blob of size @p size. If the @p cache_blob is
+///     nullptr then the size of the cache blob is returned in @p size.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise. #dnnl_unimplemented is returned if the compiled partition
+///     doesn't support cache blob.
+dnnl_status_t DNNL_API dnnl_graph_compiled_partition_get_cache_blob(
+        const_dnnl_graph_compiled_partition_t compiled_partition, size_t *size,
+        uint8_t *cache_blob);
+
+/// Invalidates the cached constant data that a compiled partition computed
+/// from a constant input, so that only the constant computations depending on
+/// the input are redone in the next execution. It should be called after the
+/// content of the input buffer is changed in place, e.g. when a weight is
+/// updated. The function must not be called concurrently with the executions
+/// of compiled partitions which use the same buffer.
+///
+/// @param compiled_partition The handle of target compiled_partition.
+/// @param tensor_id The id of the input logical tensor.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise. #dnnl_invalid_arguments is returned if the logical tensor
+///     is not an input of the compiled partition and #dnnl_unimplemented is
+///     returned if the compiled partition doesn't support it.
+dnnl_status_t DNNL_API dnnl_graph_compiled_partition_invalidate_constant_input(
+        dnnl_graph_compiled_partition_t compiled_partition, size_t tensor_id);
+
+/// Waits until a compilation task is completed.
+///
+/// @param task The compilation task.
+/// @returns The status of the compilation.
+dnnl_status_t DNNL_API dnnl_graph_compile_task_wait(
+        const_dnnl_graph_compile_task_t task);
+
+/// Queries whether a compilation task is completed without blocking.
+///
+/// @param task The compilation task.
+/// @param ready Output the status of the task: 1 if it's completed and 0
+///     otherwise.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_graph_compile_task_is_ready(
+        const_dnnl_graph_compile_task_t task, uint8_t *ready);
+
+/// Destroys a compilation task. The call waits until the task is completed.
+///
+/// @param task The compilation task to be destroyed.
+/// @returns #dnnl_success on success or a status describing the error
+///     otherwise.
+dnnl_status_t DNNL_API dnnl_graph_compile_task_destroy(
+        dnnl_graph_compile_task_t task);
+
 /// @} dnnl_graph_api_compiled_partition
 
 /// @addtogroup dnnl_graph_api_graph
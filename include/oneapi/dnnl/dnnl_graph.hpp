@@ -89,6 +89,13 @@ struct graph_handle_traits<dnnl_graph_compiled_partition_t> {
     }
 };
 
+template <>
+struct graph_handle_traits<dnnl_graph_compile_task_t> {
+    static dnnl_status_t destructor(dnnl_graph_compile_task_t p) {
+        return dnnl_graph_compile_task_destroy(p);
+    }
+};
+
 template <>
 struct graph_handle_traits<dnnl_graph_allocator_t> {
     static dnnl_status_t destructor(dnnl_graph_allocator_t p) {
@@ -105,6 +112,7 @@ DNNL_GRAPH_HANDLE_ALIAS(graph);
 DNNL_GRAPH_HANDLE_ALIAS(op);
 DNNL_GRAPH_HANDLE_ALIAS(tensor);
 DNNL_GRAPH_HANDLE_ALIAS(compiled_partition);
+DNNL_GRAPH_HANDLE_ALIAS(compile_task);
 DNNL_GRAPH_HANDLE_ALIAS(partition);
 
 #undef DNNL_GRAPH_HANDLE_ALIAS
@@ -665,6 +673,41 @@ public:
         return inplace_options;
     }
 
+    /// Returns the cache blob of a compiled partition. The cache blob can be
+    /// stored and used to create the compiled partition in another process
+    /// with #dnnl::graph::partition::compile_from_cache_blob().
+    ///
+    /// @returns The cache blob.
+    std::vector<uint8_t> get_cache_blob() const {
+        size_t size = 0;
+        error::wrap_c_api(
+                dnnl_graph_compiled_partition_get_cache_blob(
+                        get(), &size, nullptr),
+                "could not get cache blob size from a compiled partition");
+
+        std::vector<uint8_t> cache_blob(size);
+        error::wrap_c_api(
+                dnnl_graph_compiled_partition_get_cache_blob(
+                        get(), &size, cache_blob.data()),
+                "could not get a cache blob from a compiled partition");
+        return cache_blob;
+    }
+
+    /// Invalidates the cached constant data computed from a constant input,
+    /// so that only the constant computations depending on the input are
+    /// redone in the next execution. It should be called after the content
+    /// of the input buffer is changed in place, and must not be called
+    /// concurrently with the executions using the same buffer.
+    ///
+    /// @param tensor_id The id of the input logical tensor.
+    void invalidate_constant_input(size_t tensor_id) {
+        error::wrap_c_api(
+                dnnl_graph_compiled_partition_invalidate_constant_input(
+                        get(), tensor_id),
+                "could not invalidate the constant input of a compiled "
+                "partition");
+    }
+
     /// Execute a compiled partition.
     ///
     /// @param astream Stream object to run over.
@@ -691,6 +734,48 @@ public:
     }
 };
 
+/// An asynchronous compilation task, which is returned by
+/// #dnnl::graph::partition::compile_async(). The task keeps the partition and
+/// the engine used by the compilation alive until it's completed.
+class compile_task : public compile_task_handle {
+public:
+    /// Default constructor. Constructs an empty object.
+    compile_task() = default;
+
+    /// Waits until the compilation is completed and returns the compiled
+    /// partition. An exception is raised if the compilation failed.
+    ///
+    /// @returns The compiled partition.
+    compiled_partition wait() const {
+        error::wrap_c_api(dnnl_graph_compile_task_wait(get()),
+                "partition compile failed");
+        return cp_;
+    }
+
+    /// Returns whether the compilation is completed without blocking.
+    ///
+    /// @returns @c true if the compilation is completed or @c false otherwise.
+    bool is_ready() const {
+        uint8_t ready = 0;
+        error::wrap_c_api(dnnl_graph_compile_task_is_ready(get(), &ready),
+                "could not query the status of the compile task");
+        return ready != 0;
+    }
+
+private:
+    friend class partition;
+
+    compile_task(dnnl_graph_compile_task_t task, const partition_handle &p,
+            const compiled_partition &cp, const engine &e)
+        : partition_(p), cp_(cp), engine_(e) {
+        reset(task, false);
+    }
+
+    partition_handle partition_;
+    compiled_partition cp_;
+    engine engine_;
+};
+
 /// @} dnnl_graph_api_compiled_partition
 
 /// @addtogroup dnnl_graph_api_op Op
@@ -1199,6 +1284,125 @@ public:
         return compile_(inputs, outputs, e);
     }
 
+    /// Creates a compiled partition from a cache blob returned by
+    /// #dnnl::graph::compiled_partition::get_cache_blob(), without running
+    /// the compilation. The cache blob is specific to the partition, the
+    /// logical tensors given at its compilation, the library version and the
+    /// CPU ISA. An exception is raised if the cache blob can't be used, in
+    /// which case the partition should be compiled with
+    /// #dnnl::graph::partition::compile().
+    ///
+    /// @param cache_blob The cache blob.
+    /// @param e The engine used to create the compiled partition.
+    /// @returns A compiled partition.
+    compiled_partition compile_from_cache_blob(
+            const std::vector<uint8_t> &cache_blob, const engine &e) const {
+        if (!is_supported()) {
+            error::wrap_c_api(dnnl_invalid_arguments,
+                    "could not compile an unsupported partition");
+        }
+
+        dnnl_graph_compiled_partition_t cpartitions = nullptr;
+        error::wrap_c_api(
+                dnnl_graph_compiled_partition_create(&cpartitions, get()),
+                "could not create compiled_partition");
+        compiled_partition cp(cpartitions);
+
+        error::wrap_c_api(
+                dnnl_graph_partition_compile_from_cache_blob(get(),
+                        cpartitions, cache_blob.size(), cache_blob.data(),
+                        e.get()),
+                "could not create a compiled partition from a cache blob");
+        return cp;
+    }
+
+    /// Compiles a partition asynchronously on the background compilation
+    /// threads. See #dnnl::graph::partition::compile() for the details of the
+    /// compilation.
+    ///
+    /// @param inputs A list of input logical tensors.
+    /// @param outputs A list of output logical tensors.
+    /// @param e The engine used to compile the partition.
+    /// @returns A compile task. The compiled partition is returned by
+    ///     #dnnl::graph::compile_task::wait().
+    compile_task compile_async(const std::vector<logical_tensor> &inputs,
+            const std::vector<logical_tensor> &outputs, const engine &e) const {
+        if (!is_supported()) {
+            error::wrap_c_api(dnnl_invalid_arguments,
+                    "could not compile an unsupported partition");
+        }
+
+        std::vector<const dnnl_graph_logical_tensor_t *> c_inputs;
+        std::vector<const dnnl_graph_logical_tensor_t *> c_outputs;
+        c_inputs.reserve(inputs.size());
+        for (const auto &in : inputs) {
+            c_inputs.push_back(&(in.data));
+        }
+        c_outputs.reserve(outputs.size());
+        for (const auto &out : outputs) {
+            c_outputs.push_back(&(out.data));
+        }
+
+        dnnl_graph_compiled_partition_t cpartitions = nullptr;
+        error::wrap_c_api(
+                dnnl_graph_compiled_partition_create(&cpartitions, get()),
+                "could not create compiled_partition");
+        compiled_partition cp(cpartitions);
+
+        dnnl_graph_compile_task_t task = nullptr;
+        error::wrap_c_api(
+                dnnl_graph_partition_compile_async(get(), cpartitions,
+                        c_inputs.size(), c_inputs.data(), c_outputs.size(),
+                        c_outputs.data(), e.get(), &task),
+                "could not submit the partition compile");
+        return compile_task(task, *this, cp, e);
+    }
+
+    /// Compiles a list of partitions concurrently on the background
+    /// compilation threads and waits for all of them, to fill the compiled
+    /// partition cache. A partition can be listed several times with different
+    /// logical tensors to warm up several shapes.
+    ///
+    /// @param partitions A list of partitions to compile.
+    /// @param inputs The input logical tensors of each compilation.
+    /// @param outputs The output logical tensors of each compilation.
+    /// @param e The engine used to compile the partitions.
+    static void warmup(const std::vector<partition> &partitions,
+            const std::vector<std::vector<logical_tensor>> &inputs,
+            const std::vector<std::vector<logical_tensor>> &outputs,
+            const engine &e) {
+        if (partitions.size() != inputs.size()
+                || partitions.size() != outputs.size()) {
+            error::wrap_c_api(dnnl_invalid_arguments,
+                    "mismatched number of partitions and logical tensors");
+        }
+
+        const size_t num = partitions.size();
+        std::vector<dnnl_graph_partition_t> c_partitions;
+        std::vector<size_t> in_nums, out_nums;
+        std::vector<std::vector<dnnl_graph_logical_tensor_t>> c_inputs(num),
+                c_outputs(num);
+        std::vector<const dnnl_graph_logical_tensor_t *> c_input_ptrs,
+                c_output_ptrs;
+        for (size_t i = 0; i < num; i++) {
+            c_partitions.push_back(partitions[i].get());
+            in_nums.push_back(inputs[i].size());
+            out_nums.push_back(outputs[i].size());
+            for (const auto &in : inputs[i])
+                c_inputs[i].push_back(in.data);
+            for (const auto &out : outputs[i])
+                c_outputs[i].push_back(out.data);
+            c_input_ptrs.push_back(c_inputs[i].data());
+            c_output_ptrs.push_back(c_outputs[i].data());
+        }
+
+        error::wrap_c_api(
+                dnnl_graph_partition_warmup(num, c_partitions.data(),
+                        in_nums.data(), c_input_ptrs.data(), out_nums.data(),
+                        c_output_ptrs.data(), e.get()),
+                "could not warm up the partitions");
+    }
+
     /// Returns the supporting status of a partition. Some operations may not be
     /// supported by the library under certain circumstances. During
     /// partitioning stage, unsupported partitions will be returned to users
@@ -1269,6 +1473,19 @@ public:
         return static_cast<engine::kind>(akind);
     }
 
+    /// Sets whether the independent operations of the partition can be
+    /// executed concurrently on CPU. It overrides the default of the library
+    /// for the partition and takes effect at the next compilation.
+    ///
+    /// @param enable True to execute independent operations concurrently
+    ///     when they are small enough to not use all the cores by
+    ///     themselves, false to always execute the operations one by one.
+    void set_inter_op_parallel(bool enable) {
+        error::wrap_c_api(dnnl_graph_partition_set_inter_op_parallel(
+                                  get(), static_cast<uint8_t>(enable)),
+                "could not set inter-op parallelism of the partition");
+    }
+
 private:
     compiled_partition compile_(const std::vector<logical_tensor> &inputs,
             const std::vector<logical_tensor> &outputs, const engine &e) const {
@@ -436,6 +436,15 @@ typedef struct dnnl_graph_compiled_partition *dnnl_graph_compiled_partition_t;
 typedef const struct dnnl_graph_compiled_partition
         *const_dnnl_graph_compiled_partition_t;
 
+/// An opaque structure to describe an asynchronous compilation task.
+struct dnnl_graph_compile_task;
+
+/// A compilation task handle.
+typedef struct dnnl_graph_compile_task *dnnl_graph_compile_task_t;
+
+/// A constant compilation task handle.
+typedef const struct dnnl_graph_compile_task *const_dnnl_graph_compile_task_t;
+
 /// @} dnnl_graph_api_compiled_partition
 
 /// @addtogroup dnnl_graph_api_tensor
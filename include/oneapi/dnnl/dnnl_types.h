@@ -1730,6 +1730,8 @@ typedef enum {
     dnnl_softmax,
     /// A layer normalization primitive.
     dnnl_layer_normalization,
+    /// A group normalization primitive.
+    dnnl_group_normalization,
 
     /// Parameter to allow internal only primitives without undefined behavior.
     /// This parameter is chosen to be valid for so long as sizeof(int) >= 2.
@@ -2472,7 +2474,7 @@ typedef enum {
     dnnl_query_direction, ///< RNN parameter direction
     dnnl_query_activation_kind, ///< RNN parameter activation kind
     dnnl_query_kernel, ///< Pooling parameter kernel
-    dnnl_query_group_size_s64, ///< Shuffle parameter group size
+    dnnl_query_group_size_s64, ///< Shuffle group size or number of groups
 
     // memory descriptor section
     dnnl_query_some_md = 128, ///< stub
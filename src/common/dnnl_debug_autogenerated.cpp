@@ -49,6 +49,10 @@ const char *dnnl_dt2str(dnnl_data_type_t v) {
     if (v == dnnl_s8) return "s8";
     if (v == dnnl_u8) return "u8";
     if (v == dnnl_f64) return "f64";
+    if (v == dnnl_s4) return "s4";
+    if (v == dnnl_u4) return "u4";
+    if (v == dnnl_f8_e5m2) return "f8_e5m2";
+    if (v == dnnl_f8_e4m3) return "f8_e4m3";
     if (v == dnnl_data_type_max) return "data_type_max";
     assert(!"unknown dt");
     return "unknown dt";
@@ -1462,6 +1466,7 @@ const char *dnnl_prim_kind2str(dnnl_primitive_kind_t v) {
     if (v == dnnl_prelu) return "prelu";
     if (v == dnnl_softmax) return "softmax";
     if (v == dnnl_layer_normalization) return "layer_normalization";
+    if (v == dnnl_group_normalization) return "group_normalization";
     if (v == dnnl_primitive_kind_max) return "primitive_kind_max";
     assert(!"unknown prim_kind");
     return "unknown prim_kind";
@@ -25,6 +25,8 @@
 #include "bfloat16.hpp"
 #include "c_types_map.hpp"
 #include "float16.hpp"
+#include "float8.hpp"
+#include "int4.hpp"
 #include "nstl.hpp"
 #include "opdesc.hpp"
 #include "utils.hpp"
@@ -70,6 +72,22 @@ template <>
 struct prec_traits<data_type::u8> {
     typedef uint8_t type;
 };
+template <>
+struct prec_traits<data_type::s4> {
+    typedef int4_t type;
+};
+template <>
+struct prec_traits<data_type::u4> {
+    typedef uint4_t type;
+};
+template <>
+struct prec_traits<data_type::f8_e5m2> {
+    typedef float8_e5m2_t type;
+};
+template <>
+struct prec_traits<data_type::f8_e4m3> {
+    typedef float8_e4m3_t type;
+};
 
 template <>
 struct data_traits<float16_t> {
@@ -95,6 +113,22 @@ template <>
 struct data_traits<uint8_t> {
     static constexpr data_type_t data_type = data_type::u8;
 };
+template <>
+struct data_traits<int4_t> {
+    static constexpr data_type_t data_type = data_type::s4;
+};
+template <>
+struct data_traits<uint4_t> {
+    static constexpr data_type_t data_type = data_type::u4;
+};
+template <>
+struct data_traits<float8_e5m2_t> {
+    static constexpr data_type_t data_type = data_type::f8_e5m2;
+};
+template <>
+struct data_traits<float8_e4m3_t> {
+    static constexpr data_type_t data_type = data_type::f8_e4m3;
+};
 
 template <>
 struct typesize_traits<4> {
@@ -124,6 +158,7 @@ PKIND_TRAITS_INST(prelu);
 PKIND_TRAITS_INST(lrn);
 PKIND_TRAITS_INST(batch_normalization);
 PKIND_TRAITS_INST(layer_normalization);
+PKIND_TRAITS_INST(group_normalization);
 PKIND_TRAITS_INST(inner_product);
 PKIND_TRAITS_INST(rnn);
 PKIND_TRAITS_INST(gemm);
@@ -132,6 +167,7 @@ PKIND_TRAITS_INST(binary);
 PKIND_TRAITS_INST(matmul);
 PKIND_TRAITS_INST(resampling);
 PKIND_TRAITS_INST(reduction);
+PKIND_TRAITS_INST(sdpa);
 #undef PKIND_TRAITS_INST
 
 } // namespace impl
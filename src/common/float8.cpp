@@ -0,0 +1,128 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cmath>
+
+#include "common/bit_cast.hpp"
+#include "common/float8.hpp"
+
+namespace dnnl {
+namespace impl {
+
+namespace {
+
+// Returns the code of |f| in an 8-bit float with the given exponent bias and
+// number of mantissa bits, rounded to nearest even. The code is not clamped,
+// the values above the largest finite value give larger codes.
+template <uint32_t bias, uint32_t man_bits>
+uint32_t cvt_abs_float_to_f8_code(uint32_t abs_bits) {
+    constexpr uint32_t min_normal_bits = (127 + 1 - bias) << 23;
+    if (abs_bits < min_normal_bits) {
+        // The subnormal values are multiples of 2^(1 - bias - man_bits). Adding
+        // a number whose ulp is that value makes the f32 addition round to
+        // nearest even, and the mantissa of the sum is the code.
+        constexpr uint32_t magic_bits = (127 + 24 - bias - man_bits) << 23;
+        const float sum = utils::bit_cast<float>(abs_bits)
+                + utils::bit_cast<float>(magic_bits);
+        return utils::bit_cast<uint32_t>(sum) - magic_bits;
+    }
+
+    // Round the mantissa to nearest even and rebias the exponent. A carry out
+    // of the mantissa increments the exponent, as expected.
+    constexpr uint32_t shift = 23 - man_bits;
+    const uint32_t rounding_bias
+            = (1u << (shift - 1)) - 1 + ((abs_bits >> shift) & 1);
+    return (abs_bits + rounding_bias - ((127 - bias) << 23)) >> shift;
+}
+
+} // namespace
+
+float8_e5m2_t &float8_e5m2_t::operator=(float f) {
+    const uint32_t bits = utils::bit_cast<uint32_t>(f);
+    const uint8_t sign = (bits >> 24) & 0x80;
+    const uint32_t abs_bits = bits & 0x7fffffff;
+
+    if (abs_bits > 0x7f800000) {
+        // quiet NaN
+        raw_bits_ = sign | 0x7e;
+        return *this;
+    }
+
+    // infinity and the values rounded above the largest finite value
+    // become infinity
+    const uint32_t code = cvt_abs_float_to_f8_code<15, 2>(abs_bits);
+    raw_bits_ = sign | static_cast<uint8_t>(code < 0x7c ? code : 0x7c);
+    return *this;
+}
+
+float8_e5m2_t &float8_e5m2_t::operator=(float16_t f) {
+    const uint32_t fraw = f.raw;
+    const bool is_special = (fraw & 0x7c00) == 0x7c00;
+    const bool is_nan = is_special && (fraw & 0x03ff) != 0;
+
+    if (is_nan) {
+        raw_bits_ = static_cast<uint8_t>((fraw >> 8) | 0x02);
+    } else if (is_special) {
+        raw_bits_ = static_cast<uint8_t>(fraw >> 8);
+    } else {
+        // round the low byte to nearest even, the largest finite values
+        // round up to infinity
+        const uint32_t rounding_bias = 0x7f + ((fraw >> 8) & 1);
+        raw_bits_ = static_cast<uint8_t>((fraw + rounding_bias) >> 8);
+    }
+    return *this;
+}
+
+float8_e5m2_t::operator float() const {
+    const float16_t f16(static_cast<uint16_t>(raw_bits_ << 8), true);
+    return static_cast<float>(f16);
+}
+
+float8_e4m3_t &float8_e4m3_t::operator=(float f) {
+    const uint32_t bits = utils::bit_cast<uint32_t>(f);
+    const uint8_t sign = (bits >> 24) & 0x80;
+    const uint32_t abs_bits = bits & 0x7fffffff;
+
+    // There is no infinity: NaN, infinity and the values rounded above 448
+    // give codes from 0x7f (NaN) up
+    const uint32_t code = cvt_abs_float_to_f8_code<7, 3>(abs_bits);
+    raw_bits_ = sign | static_cast<uint8_t>(code < 0x7f ? code : 0x7f);
+    return *this;
+}
+
+float8_e4m3_t &float8_e4m3_t::operator=(float16_t f) {
+    // f16 to f32 is exact, so the value is rounded once
+    return (*this) = static_cast<float>(f);
+}
+
+float8_e4m3_t::operator float() const {
+    const uint32_t sign = static_cast<uint32_t>(raw_bits_ & 0x80) << 24;
+    const uint32_t exp = (raw_bits_ >> 3) & 0xf;
+    const uint32_t man = raw_bits_ & 0x7;
+
+    if (exp == 0xf && man == 0x7)
+        return utils::bit_cast<float>(sign | 0x7fc00000);
+    if (exp == 0) {
+        // subnormal value, man * 2^-9
+        const float v = std::scalbn(static_cast<float>(man), -9);
+        return sign ? -v : v;
+    }
+    return utils::bit_cast<float>(
+            sign | ((exp + 127 - 7) << 23) | (man << 20));
+}
+
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,83 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_FLOAT8_HPP
+#define COMMON_FLOAT8_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/float16.hpp"
+
+#include "oneapi/dnnl/dnnl.h"
+
+namespace dnnl {
+namespace impl {
+
+// 8-bit floating point with a 5-bit exponent and a 2-bit mantissa. It has the
+// exponent of f16, so a value is the top byte of the corresponding f16 value.
+struct float8_e5m2_t {
+    uint8_t raw_bits_;
+    float8_e5m2_t() = default;
+    constexpr float8_e5m2_t(uint8_t r, bool) : raw_bits_(r) {}
+    float8_e5m2_t(float f) { (*this) = f; }
+    float8_e5m2_t(float16_t f) { (*this) = f; }
+
+    float8_e5m2_t DNNL_API &operator=(float f);
+    float8_e5m2_t DNNL_API &operator=(float16_t f);
+
+    DNNL_API operator float() const;
+
+    float8_e5m2_t &operator+=(const float a) {
+        (*this) = float {*this} + a;
+        return *this;
+    }
+};
+
+static_assert(sizeof(float8_e5m2_t) == 1, "float8_e5m2_t must be 1 byte");
+
+// 8-bit floating point with a 4-bit exponent and a 3-bit mantissa. There is
+// no infinity and a single NaN encoding per sign (S.1111.111), so the largest
+// finite value is 448. Values that do not fit are converted to NaN.
+struct float8_e4m3_t {
+    uint8_t raw_bits_;
+    float8_e4m3_t() = default;
+    constexpr float8_e4m3_t(uint8_t r, bool) : raw_bits_(r) {}
+    float8_e4m3_t(float f) { (*this) = f; }
+    float8_e4m3_t(float16_t f) { (*this) = f; }
+
+    float8_e4m3_t DNNL_API &operator=(float f);
+    float8_e4m3_t DNNL_API &operator=(float16_t f);
+
+    DNNL_API operator float() const;
+
+    float8_e4m3_t &operator+=(const float a) {
+        (*this) = float {*this} + a;
+        return *this;
+    }
+};
+
+static_assert(sizeof(float8_e4m3_t) == 1, "float8_e4m3_t must be 1 byte");
+
+void cvt_f8_e5m2_to_float(float *out, const float8_e5m2_t *inp, size_t nelems);
+void cvt_f8_e4m3_to_float(float *out, const float8_e4m3_t *inp, size_t nelems);
+void cvt_float_to_f8_e5m2(float8_e5m2_t *out, const float *inp, size_t nelems);
+void cvt_float_to_f8_e4m3(float8_e4m3_t *out, const float *inp, size_t nelems);
+
+} // namespace impl
+} // namespace dnnl
+
+#endif
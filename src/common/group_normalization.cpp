@@ -0,0 +1,160 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include "oneapi/dnnl/dnnl.h"
+#include "opdesc.hpp"
+#include "primitive_desc_iface.hpp"
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+using namespace dnnl::impl;
+using namespace dnnl::impl::utils;
+using namespace dnnl::impl::status;
+using namespace dnnl::impl::prop_kind;
+using namespace dnnl::impl::types;
+
+#define VCHECK_GNORM(cond, msg, ...) \
+    VCONDCHECK(create, check, gnorm, (cond), status::invalid_arguments, msg, \
+            ##__VA_ARGS__);
+
+namespace {
+status_t gnorm_desc_init(group_normalization_desc_t *gnorm_desc,
+        prop_kind_t prop_kind, const memory_desc_t *src_desc,
+        const memory_desc_t *dst_desc, const memory_desc_t *diff_src_desc,
+        const memory_desc_t *diff_dst_desc, dim_t groups, float epsilon,
+        unsigned flags) {
+    const bool is_fwd = one_of(prop_kind, forward_training, forward_inference);
+    VCHECK_GNORM(!any_null(gnorm_desc, src_desc), VERBOSE_NULL_ARG);
+    VCHECK_GNORM(one_of(prop_kind, forward_training, forward_inference,
+                         backward_data, backward),
+            VERBOSE_BAD_PROPKIND);
+    VCHECK_GNORM(IMPLICATION(is_fwd, dst_desc != nullptr), VERBOSE_NULL_ARG);
+    VCHECK_GNORM(IMPLICATION(!is_fwd, !any_null(diff_src_desc, diff_dst_desc)),
+            VERBOSE_NULL_ARG);
+    VCHECK_GNORM(
+            IMPLICATION(is_fwd, !memory_desc_wrapper(src_desc).format_any()),
+            VERBOSE_UNSUPPORTED_TAG_S, "src");
+
+    unsigned gnorm_flags = normalization_flags::use_global_stats
+            | normalization_flags::use_scale | normalization_flags::use_shift;
+    VCHECK_GNORM((~gnorm_flags & flags) == 0, VERBOSE_BAD_FLAGS);
+
+    auto gd = group_normalization_desc_t();
+    gd.primitive_kind = primitive_kind::group_normalization;
+    gd.prop_kind = prop_kind;
+
+    bool runtime_dims_or_strides
+            = memory_desc_wrapper(src_desc).has_runtime_dims_or_strides();
+    if (is_fwd) {
+        runtime_dims_or_strides = runtime_dims_or_strides
+                || memory_desc_wrapper(dst_desc).has_runtime_dims_or_strides();
+    } else {
+        runtime_dims_or_strides = runtime_dims_or_strides
+                || memory_desc_wrapper(diff_src_desc)
+                           .has_runtime_dims_or_strides()
+                || memory_desc_wrapper(diff_dst_desc)
+                           .has_runtime_dims_or_strides();
+    }
+    VCONDCHECK(create, check, gnorm, !runtime_dims_or_strides,
+            status::unimplemented, VERBOSE_RUNTIMEDIM_UNSUPPORTED);
+
+    VCHECK_GNORM(src_desc->ndims >= 2, VERBOSE_BAD_NDIMS, "src",
+            src_desc->ndims);
+    // Every group holds the same number of channels
+    VCHECK_GNORM(groups > 0 && src_desc->dims[1] % groups == 0,
+            VERBOSE_BAD_PARAM, "groups");
+
+    gd.src_desc = *src_desc;
+    if (is_fwd) gd.dst_desc = *dst_desc;
+    if (!is_fwd) {
+        gd.diff_src_desc = *diff_src_desc;
+        gd.diff_dst_desc = *diff_dst_desc;
+    }
+
+    const bool has_scale_or_shift = flags
+            & (normalization_flags::use_scale | normalization_flags::use_shift);
+    if (has_scale_or_shift) {
+        dims_t scaleshift_dims = {src_desc->dims[1]};
+        memory_desc_init_by_tag(gd.scaleshift_desc, 1, scaleshift_dims,
+                data_type::f32, format_tag::a);
+        if (!is_fwd) gd.diff_scaleshift_desc = gd.scaleshift_desc;
+    }
+
+    dims_t stats_dims = {src_desc->dims[0], groups};
+    memory_desc_init_by_tag(
+            gd.stat_desc, 2, stats_dims, data_type::f32, format_tag::ab);
+
+    gd.groups = groups;
+    gd.group_norm_epsilon = epsilon;
+    gd.flags = flags;
+
+#define CHECK_DIMS(t1, t2) \
+    do { \
+        VCHECK_GNORM(gd.t2##_desc.ndims == gd.t1##_desc.ndims, \
+                VERBOSE_INCONSISTENT_NDIMS, #t1, #t2); \
+        VCHECK_GNORM(array_cmp(gd.t2##_desc.dims, gd.t1##_desc.dims, \
+                             gd.t1##_desc.ndims), \
+                VERBOSE_INCONSISTENT_DIM, #t1, -1, #t2, -1); \
+    } while (0)
+
+    if (is_fwd) {
+        CHECK_DIMS(src, dst);
+    } else {
+        CHECK_DIMS(src, diff_dst);
+        CHECK_DIMS(diff_src, diff_dst);
+    }
+#undef CHECK_DIMS
+
+    *gnorm_desc = gd;
+    return success;
+}
+} // namespace
+
+status_t dnnl_group_normalization_forward_primitive_desc_create(
+        primitive_desc_iface_t **primitive_desc_iface, engine_t *engine,
+        prop_kind_t prop_kind, const memory_desc_t *src_desc,
+        const memory_desc_t *dst_desc, dim_t groups, float epsilon,
+        unsigned flags, const primitive_attr_t *attr) {
+    if (!one_of(prop_kind, forward_training, forward_inference))
+        return invalid_arguments;
+
+    auto gnorm_desc = group_normalization_desc_t();
+    CHECK(gnorm_desc_init(&gnorm_desc, prop_kind, src_desc, dst_desc, nullptr,
+            nullptr, groups, epsilon, flags));
+    return primitive_desc_create(primitive_desc_iface, engine,
+            (const op_desc_t *)&gnorm_desc, nullptr, attr);
+}
+
+status_t dnnl_group_normalization_backward_primitive_desc_create(
+        primitive_desc_iface_t **primitive_desc_iface, engine_t *engine,
+        prop_kind_t prop_kind, const memory_desc_t *diff_src_desc,
+        const memory_desc_t *diff_dst_desc, const memory_desc_t *src_desc,
+        dim_t groups, float epsilon, unsigned flags,
+        const primitive_desc_iface_t *hint_fwd_pd,
+        const primitive_attr_t *attr) {
+    if (!one_of(prop_kind, backward, backward_data)) return invalid_arguments;
+
+    auto gnorm_desc = group_normalization_desc_t();
+    CHECK(gnorm_desc_init(&gnorm_desc, prop_kind, src_desc, nullptr,
+            diff_src_desc, diff_dst_desc, groups, epsilon, flags));
+    return primitive_desc_create(primitive_desc_iface, engine,
+            (const op_desc_t *)&gnorm_desc, hint_fwd_pd, attr);
+}
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
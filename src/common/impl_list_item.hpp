@@ -34,7 +34,7 @@ struct pk_dt_impl_key_t {
     }
 
 private:
-    enum { MAX_DT_NUM = 10 };
+    enum { MAX_DT_NUM = 16 };
     size_t value() const {
         return (((size_t)kind * MAX_DT_NUM + (size_t)src_dt) * MAX_DT_NUM
                        + (size_t)wei_dt)
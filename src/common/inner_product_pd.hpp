@@ -121,6 +121,9 @@ struct inner_product_pd_t : public primitive_desc_t {
         return s_d.has_zero_dim() || d_d.has_zero_dim();
     }
 
+    int wei_qmask_OC() const { return 1 << 0; }
+    int wei_qmask_IC() const { return 1 << 1; }
+
     bool is_fwd() const {
         return utils::one_of(desc_.prop_kind, prop_kind::forward_training,
                 prop_kind::forward_inference);
@@ -195,14 +198,47 @@ protected:
             = {DNNL_ARG_SRC, DNNL_ARG_WEIGHTS, DNNL_ARG_DST}) const {
         bool ok = attr()->scales_.has_default_values(supported_args);
         for (auto arg : supported_args) {
-            int mask = attr()->scales_.get(arg).mask_;
-            if (arg == DNNL_ARG_WEIGHTS)
-                ok = ok && (mask == 0 || mask == (1 << 0));
-            else
-                ok = ok && (mask == 0);
+            const auto &sc = attr()->scales_.get(arg);
+            const int mask = sc.mask_;
+            if (arg == DNNL_ARG_WEIGHTS) {
+                if (sc.has_default_groups())
+                    ok = ok && (mask == 0 || mask == wei_qmask_OC());
+                else
+                    ok = ok && mask == (wei_qmask_OC() | wei_qmask_IC())
+                            && wei_qparams_groups_ok(
+                                    sc.ndims_, sc.group_dims_);
+            } else
+                ok = ok && (mask == 0) && sc.has_default_groups()
+                        && sc.has_default_data_type();
         }
         return ok;
     }
+
+    // Checks the weights zero points: common, per OC or group-wise along IC.
+    // Source and destination zero points are not supported.
+    bool attr_wei_zero_points_ok() const {
+        const auto &zp = attr()->zero_points_;
+        if (!zp.has_default_values(DNNL_ARG_SRC)
+                || !zp.has_default_values(DNNL_ARG_DST))
+            return false;
+        if (zp.has_default_values(DNNL_ARG_WEIGHTS)) return true;
+
+        int mask = 0;
+        zp.get(DNNL_ARG_WEIGHTS, &mask);
+        const int group_ndims = zp.get_group_ndims(DNNL_ARG_WEIGHTS);
+        if (group_ndims == 0) return mask == 0 || mask == wei_qmask_OC();
+        return mask == (wei_qmask_OC() | wei_qmask_IC())
+                && wei_qparams_groups_ok(
+                        group_ndims, zp.get_group_dims(DNNL_ARG_WEIGHTS));
+    }
+
+    // Weights quantization parameters may be grouped along IC of 2D weights
+    // only: the groups are {1, G} with G dividing IC, so that the parameters
+    // form an [OC, IC / G] tensor.
+    bool wei_qparams_groups_ok(int group_ndims, const dims_t groups) const {
+        return ndims() == 2 && group_ndims == 2 && groups[0] == 1
+                && IC() % groups[1] == 0;
+    }
 };
 
 struct inner_product_fwd_pd_t : public inner_product_pd_t {
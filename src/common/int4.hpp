@@ -0,0 +1,80 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_INT4_HPP
+#define COMMON_INT4_HPP
+
+#include <cmath>
+#include <cstdint>
+
+namespace dnnl {
+namespace impl {
+
+// A single 4-bit value stored in the low half of a byte. In memory, two values
+// are packed into a byte, the value with the even index in the low half. Use
+// extract() and insert() to access the packed values.
+struct uint4_t {
+    uint8_t raw_bits_;
+    uint4_t() = default;
+    constexpr uint4_t(uint8_t r, bool) : raw_bits_(r) {}
+    uint4_t(float f) {
+        const float r = std::nearbyint(f);
+        raw_bits_ = static_cast<uint8_t>(r < 0.f ? 0.f : r > 15.f ? 15.f : r);
+    }
+
+    operator float() const { return static_cast<float>(raw_bits_); }
+
+    static uint4_t extract(uint8_t packed, int idx) {
+        return uint4_t((packed >> (4 * idx)) & 0xf, true);
+    }
+
+    uint8_t insert(uint8_t packed, int idx) const {
+        const int shift = 4 * idx;
+        return static_cast<uint8_t>(
+                (packed & ~(0xf << shift)) | ((raw_bits_ & 0xf) << shift));
+    }
+};
+
+struct int4_t {
+    uint8_t raw_bits_;
+    int4_t() = default;
+    constexpr int4_t(uint8_t r, bool) : raw_bits_(r) {}
+    int4_t(float f) {
+        const float r = std::nearbyint(f);
+        const int v = static_cast<int>(r < -8.f ? -8.f : r > 7.f ? 7.f : r);
+        raw_bits_ = static_cast<uint8_t>(v & 0xf);
+    }
+
+    operator float() const {
+        // sign extend the 4-bit value
+        return static_cast<float>(static_cast<int8_t>(raw_bits_ << 4) >> 4);
+    }
+
+    static int4_t extract(uint8_t packed, int idx) {
+        return int4_t((packed >> (4 * idx)) & 0xf, true);
+    }
+
+    uint8_t insert(uint8_t packed, int idx) const {
+        const int shift = 4 * idx;
+        return static_cast<uint8_t>(
+                (packed & ~(0xf << shift)) | ((raw_bits_ & 0xf) << shift));
+    }
+};
+
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -53,6 +53,8 @@ __itt_domain *itt_domain() {
 
 void primitive_task_start(primitive_kind_t kind) {
     if (kind == primitive_kind::undefined) return;
+    // internal primitives are not reported
+    if (kind >= primitive_kind::internal_only_start) return;
 
 #define CASE(x) \
     __itt_string_handle_create(dnnl_prim_kind2str(primitive_kind::x))
@@ -78,6 +80,7 @@ void primitive_task_start(primitive_kind_t kind) {
             CASE(prelu),
             CASE(softmax),
             CASE(layer_normalization),
+            CASE(group_normalization),
     };
 #undef CASE
     int kind_idx = (int)kind;
@@ -126,15 +126,57 @@ struct matmul_pd_t : public primitive_desc_t {
             = {DNNL_ARG_SRC, DNNL_ARG_WEIGHTS, DNNL_ARG_DST}) const {
         bool ok = attr()->scales_.has_default_values(supported_args);
         for (int arg : supported_args) {
-            const auto &mask = attr()->scales_.get(arg).mask_;
-            if (arg == DNNL_ARG_WEIGHTS)
-                ok = ok && (mask == 0 || mask == (1 << (dst_md()->ndims - 1)));
-            else
-                ok = ok && (mask == 0);
+            const auto &sc = attr()->scales_.get(arg);
+            const auto &mask = sc.mask_;
+            if (arg == DNNL_ARG_WEIGHTS) {
+                if (sc.has_default_groups())
+                    ok = ok && (mask == 0 || mask == wei_qmask_N());
+                else
+                    ok = ok && mask == (wei_qmask_K() | wei_qmask_N())
+                            && wei_qparams_groups_ok(
+                                    sc.ndims_, sc.group_dims_);
+            } else
+                ok = ok && (mask == 0) && sc.has_default_groups()
+                        && sc.has_default_data_type();
         }
         return ok;
     }
 
+    // Checks the zero points applied to the decompressed weights. Source and
+    // destination zero points are not supported.
+    bool attr_wei_decomp_zero_points_ok() const {
+        const auto &zp = attr()->zero_points_;
+        return zp.has_default_values(DNNL_ARG_SRC)
+                && zp.has_default_values(DNNL_ARG_DST)
+                && attr_wei_zero_points_ok();
+    }
+
+    // Checks the weights zero points: common, per N or group-wise along K.
+    bool attr_wei_zero_points_ok() const {
+        const auto &zp = attr()->zero_points_;
+        if (zp.has_default_values(DNNL_ARG_WEIGHTS)) return true;
+
+        int mask = 0;
+        zp.get(DNNL_ARG_WEIGHTS, &mask);
+        const int group_ndims = zp.get_group_ndims(DNNL_ARG_WEIGHTS);
+        if (group_ndims == 0) return mask == 0 || mask == wei_qmask_N();
+        return mask == (wei_qmask_K() | wei_qmask_N())
+                && wei_qparams_groups_ok(
+                        group_ndims, zp.get_group_dims(DNNL_ARG_WEIGHTS));
+    }
+
+    int wei_qmask_N() const { return 1 << (ndims() - 1); }
+    int wei_qmask_K() const { return 1 << (ndims() - 2); }
+
+    // Weights quantization parameters may be grouped along K only: the groups
+    // are {G, 1} with G dividing K, so that the parameters form a [K / G, N]
+    // tensor shared by all the batches.
+    bool wei_qparams_groups_ok(int group_ndims, const dims_t groups) const {
+        const dim_t K = weights_md_.dims[ndims() - 2];
+        return group_ndims == 2 && groups[1] == 1
+                && K != DNNL_RUNTIME_DIM_VAL && K % groups[0] == 0;
+    }
+
 protected:
     matmul_desc_t desc_;
 
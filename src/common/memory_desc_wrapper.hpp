@@ -226,6 +226,9 @@ struct memory_desc_wrapper : public c_compatible {
             }
 
             size_t data_size = max_size * data_type_size();
+            // two 4-bit values are packed into a byte
+            if (utils::one_of(data_type(), data_type::s4, data_type::u4))
+                data_size = utils::div_up(max_size, 2);
             if (is_additional_buffer()) {
                 // The additional buffers, typically of data type int32_t, float
                 // are stored at the end of data. Pad the data, so that the
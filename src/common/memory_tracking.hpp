@@ -162,6 +162,7 @@ enum {
     key_brgemm_primitive_batch,
     key_brgemm_primitive_buffer,
     key_brgemm_primitive_buffer_a,
+    key_brgemm_primitive_buffer_acc,
     key_brgemm_primitive_buffer_b,
     key_brgemm_primitive_buffer_comp,
     key_brgemm_primitive_buffer_d,
@@ -221,6 +222,10 @@ enum {
     key_gemm_int_c_in_acc_dt,
     key_gemm_tmp_buffer,
     key_gemm_flag,
+    key_gnorm_chunk_stats,
+    key_gnorm_scale_shift,
+    key_gnorm_tmp_mean,
+    key_gnorm_tmp_var,
     key_iprod_bias_bf16_convert_wsp,
     key_iprod_dst_bf16_convert_wsp,
     key_iprod_dst_reorder,
@@ -271,6 +276,11 @@ enum {
     key_rnn_ptrs_wei_layer,
     key_rnn_ptrs_wei_iter,
     key_rnn_ptrs_wei_projection,
+    key_sdpa_acc,
+    key_sdpa_k_pack,
+    key_sdpa_p,
+    key_sdpa_scores,
+    key_sdpa_v_pack,
     key_softmax_reduction,
     key_softmax_interim_store,
     key_sum_reduction,
@@ -284,6 +284,13 @@ static status_t zero_pad(const memory_t *memory, const exec_ctx_t &ctx) {
         case s32: return typed_zero_pad<s32>(memory, ctx);
         case s8: return typed_zero_pad<s8>(memory, ctx);
         case u8: return typed_zero_pad<u8>(memory, ctx);
+        case f8_e5m2: return typed_zero_pad<f8_e5m2>(memory, ctx);
+        case f8_e4m3: return typed_zero_pad<f8_e4m3>(memory, ctx);
+        // the padded area of the packed 4-bit types is not supported
+        case s4:
+        case u4:
+            return mdw.nelems(false) == mdw.nelems(true) ? success
+                                                         : unimplemented;
         default: assert(!"memory is undefined"); return unimplemented;
     }
     return unimplemented;
@@ -21,6 +21,7 @@
 
 #include "common/c_types_map.hpp"
 #include "common/gemm_types.hpp"
+#include "common/sdpa_types.hpp"
 
 namespace dnnl {
 namespace impl {
@@ -294,6 +295,38 @@ struct batch_normalization_desc_t {
     unsigned flags;
 };
 
+// A descriptor of a Group Normalization operation.
+struct group_normalization_desc_t {
+    // The kind of primitive. Used for self-identifying the primitive
+    // descriptor. Must be #dnnl_group_normalization.
+    primitive_kind_t primitive_kind;
+    // The kind of propagation. Possible values: #dnnl_forward_training,
+    // #dnnl_forward_inference, #dnnl_backward, and #dnnl_backward_data.
+    prop_kind_t prop_kind;
+    // Source memory descriptor.
+    memory_desc_t src_desc;
+    // Destination memory descriptor.
+    memory_desc_t dst_desc;
+    // Source gradient memory descriptor.
+    memory_desc_t diff_src_desc;
+    // Destination gradient memory descriptor.
+    memory_desc_t diff_dst_desc;
+    // Scale and/or shift data and gradient memory descriptor.
+    // Scaleshift memory descriptor uses 1D #dnnl_x format[Channels].
+    memory_desc_t scaleshift_desc;
+    memory_desc_t diff_scaleshift_desc;
+    // Statistics memory descriptor.
+    //
+    // Statistics (mean or variance) descriptor use 2D #dnnl_ab
+    // format[Batch, Groups].
+    memory_desc_t stat_desc;
+    // Number of groups the channels are split into.
+    dim_t groups;
+    // Group normalization epsilon parameter.
+    float group_norm_epsilon;
+    unsigned flags;
+};
+
 // A descriptor of a Layer Normalization operation.
 struct layer_normalization_desc_t {
     // The kind of primitive. Used for self-identifying the primitive
@@ -571,6 +604,7 @@ struct op_desc_t {
         lrn_desc_t lrn;
         batch_normalization_desc_t batch_normalization;
         layer_normalization_desc_t layer_normalization;
+        group_normalization_desc_t group_normalization;
         inner_product_desc_t inner_product;
         rnn_desc_t rnn;
         gemm_desc_t gemm;
@@ -582,6 +616,7 @@ struct op_desc_t {
         resampling_desc_t resampling;
         zero_pad_desc_t zero_pad;
         reduction_desc_t reduction;
+        sdpa_desc_t sdpa;
     };
 
 #define DECL_CTOR_AND_CONVERTERS(c_type) \
@@ -602,6 +637,7 @@ struct op_desc_t {
     DECL_CTOR_AND_CONVERTERS(lrn_desc_t);
     DECL_CTOR_AND_CONVERTERS(batch_normalization_desc_t);
     DECL_CTOR_AND_CONVERTERS(layer_normalization_desc_t);
+    DECL_CTOR_AND_CONVERTERS(group_normalization_desc_t);
     DECL_CTOR_AND_CONVERTERS(inner_product_desc_t);
     DECL_CTOR_AND_CONVERTERS(rnn_desc_t);
     DECL_CTOR_AND_CONVERTERS(gemm_desc_t);
@@ -613,6 +649,7 @@ struct op_desc_t {
     DECL_CTOR_AND_CONVERTERS(resampling_desc_t);
     DECL_CTOR_AND_CONVERTERS(zero_pad_desc_t);
     DECL_CTOR_AND_CONVERTERS(reduction_desc_t);
+    DECL_CTOR_AND_CONVERTERS(sdpa_desc_t);
 
     // concat_desc_t and sum_desc_t have data members which have non-trivial
     // special member functions hence the default destructor is implicitly
@@ -72,10 +72,18 @@ status_t zero_points_t::get(int arg, int *mask) const {
 }
 
 status_t zero_points_t::set(int arg, int mask) {
+    return set(arg, mask, 0, nullptr, data_type::s32);
+}
+
+status_t zero_points_t::set(int arg, int mask, int ndims,
+        const dims_t group_dims, data_type_t data_type) {
     const bool supported_arg
             = utils::one_of(arg, DNNL_ARG_SRC, DNNL_ARG_WEIGHTS, DNNL_ARG_DST);
     if (!supported_arg) return status::unimplemented;
 
+    const bool grouped = ndims > 0 || data_type != data_type::s32;
+    if (grouped && arg != DNNL_ARG_WEIGHTS) return status::unimplemented;
+
     switch (arg) {
         case DNNL_ARG_SRC:
             is_set_src = true;
@@ -84,6 +92,10 @@ status_t zero_points_t::set(int arg, int mask) {
         case DNNL_ARG_WEIGHTS:
             is_set_wei = true;
             mask_wei = mask;
+            group_ndims_wei = ndims;
+            for (int d = 0; d < DNNL_MAX_NDIMS; d++)
+                group_dims_wei[d] = d < ndims ? group_dims[d] : 0;
+            data_type_wei = data_type;
             break;
         case DNNL_ARG_DST:
             is_set_dst = true;
@@ -123,6 +135,18 @@ bool primitive_attr_t::has_default_values(dnnl_primitive_attr::skip_mask_t mask,
             rnn_weights_projection_qparams_);
     CHECK_ARG(IMPLICATION((bool)(~mask & smask_t::sum_dt),
             post_ops_.sum_with_default_dt(dst_dt)));
+    // group-wise and non-default data type quantization parameters must be
+    // explicitly allowed by an implementation
+#define CHECK_QPARAMS(mask_name, check) \
+    CHECK_ARG(IMPLICATION((mask & (mask_name)) != (mask_name), (check)))
+    CHECK_QPARAMS(smask_t::scales_runtime_groups, scales_.has_default_groups());
+    CHECK_QPARAMS(smask_t::scales_runtime_data_type,
+            scales_.has_default_data_type());
+    CHECK_QPARAMS(smask_t::zero_points_runtime_groups,
+            zero_points_.has_default_groups());
+    CHECK_QPARAMS(smask_t::zero_points_runtime_data_type,
+            zero_points_.has_default_data_type());
+#undef CHECK_QPARAMS
     bool gpu_attr_ok = IMPLICATION((bool)(~mask & smask_t::gpu_attr),
             !gpu_attr_ || gpu_attr_->has_default_values());
     CHECK_ARG(gpu_attr_ok);
@@ -327,9 +351,13 @@ bool post_ops_t::check_sum_consistent_dt(
     return ok;
 }
 
-status_t primitive_attr_t::set_fpmath_mode(fpmath_mode_t fpmath_mode) {
+status_t primitive_attr_t::set_fpmath_mode(
+        fpmath_mode_t fpmath_mode, bool apply_to_int) {
     auto st = check_fpmath_mode(fpmath_mode);
-    if (st == success) fpmath_mode_ = fpmath_mode;
+    if (st == success) {
+        fpmath_mode_ = fpmath_mode;
+        fpmath_apply_to_int_ = apply_to_int;
+    }
     return st;
 }
 
@@ -394,6 +422,20 @@ status_t dnnl_primitive_attr_set_fpmath_mode(
     return attr->set_fpmath_mode(mode);
 }
 
+status_t dnnl_primitive_attr_get_fpmath_mode_v2(const primitive_attr_t *attr,
+        fpmath_mode_t *mode, int *apply_to_int) {
+    if (any_null(attr, mode)) return invalid_arguments;
+    *mode = attr->fpmath_mode_;
+    if (apply_to_int) *apply_to_int = attr->fpmath_apply_to_int_;
+    return success;
+}
+
+status_t dnnl_primitive_attr_set_fpmath_mode_v2(
+        primitive_attr_t *attr, fpmath_mode_t mode, int apply_to_int) {
+    if (any_null(attr)) return invalid_arguments;
+    return attr->set_fpmath_mode(mode, apply_to_int);
+}
+
 status_t dnnl_primitive_attr_get_scratchpad_mode(
         const primitive_attr_t *attr, scratchpad_mode_t *scratchpad_mode) {
     if (any_null(attr, scratchpad_mode)) return invalid_arguments;
@@ -426,6 +468,38 @@ status_t dnnl_primitive_attr_set_zero_points_mask(
     return attr->zero_points_.set(arg, mask);
 }
 
+namespace {
+// The relation between the groups and the mask depends on the argument
+// dimensions, so it is checked by the implementations
+bool groups_ok(int mask, int ndims, const dims_t group_dims) {
+    if (mask < 0 || ndims < 0 || ndims > DNNL_MAX_NDIMS) return false;
+    if (ndims > 0 && group_dims == nullptr) return false;
+    for (int d = 0; d < ndims; d++)
+        if (group_dims[d] <= 0) return false;
+    return true;
+}
+} // namespace
+
+status_t dnnl_primitive_attr_set_scales_v2(primitive_attr_t *attr, int arg,
+        int mask, int ndims, const dims_t group_dims, data_type_t data_type) {
+    bool ok = attr && arg >= 0 && groups_ok(mask, ndims, group_dims)
+            && one_of(data_type, data_type::f32, data_type::bf16,
+                    data_type::f16)
+            && attr->output_scales_.has_default_values();
+    if (!ok) return invalid_arguments;
+    return attr->scales_.set(arg, mask, ndims, group_dims, data_type);
+}
+
+status_t dnnl_primitive_attr_set_zero_points_v2(primitive_attr_t *attr,
+        int arg, int mask, int ndims, const dims_t group_dims,
+        data_type_t data_type) {
+    bool ok = attr && groups_ok(mask, ndims, group_dims)
+            && one_of(data_type, data_type::s32, data_type::s8,
+                    data_type::u8, data_type::s4, data_type::u4);
+    if (!ok) return invalid_arguments;
+    return attr->zero_points_.set(arg, mask, ndims, group_dims, data_type);
+}
+
 status_t dnnl_primitive_attr_get_post_ops(
         const primitive_attr_t *attr, const post_ops_t **post_ops) {
     if (any_null(attr, post_ops)) return invalid_arguments;
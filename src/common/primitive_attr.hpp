@@ -17,6 +17,7 @@
 #ifndef COMMON_PRIMITIVE_ATTR_HPP
 #define COMMON_PRIMITIVE_ATTR_HPP
 
+#include <algorithm>
 #include <map>
 #include <initializer_list>
 
@@ -184,29 +185,47 @@ struct runtime_scales_t : public c_compatible {
     // runtime_scales_t() = default;
     runtime_scales_t() {}
 
-    status_t set(int mask) {
+    status_t set(int mask) { return set(0, mask, nullptr, data_type::f32); }
+
+    // Group-wise scales: a single scale is shared by `group_dims[d]`
+    // consecutive points along the last `ndims` dimensions of the argument,
+    // so the scales tensor is smaller than the argument along those
+    // dimensions.
+    status_t set(int ndims, int mask, const dims_t group_dims,
+            data_type_t data_type) {
         mask_ = mask;
         is_set_ = true;
+        ndims_ = ndims;
+        for (int d = 0; d < DNNL_MAX_NDIMS; d++)
+            group_dims_[d] = d < ndims ? group_dims[d] : 0;
+        data_type_ = data_type;
         return status::success;
     }
 
     bool operator==(const runtime_scales_t &rhs) const {
-        return mask_ == rhs.mask_ && is_set_ == rhs.is_set_;
+        return mask_ == rhs.mask_ && is_set_ == rhs.is_set_
+                && ndims_ == rhs.ndims_
+                && utils::array_cmp(group_dims_, rhs.group_dims_, ndims_)
+                && data_type_ == rhs.data_type_;
     }
 
     bool has_default_values() const { return !is_set_; }
 
+    bool has_default_groups() const { return ndims_ == 0; }
+
+    bool has_default_data_type() const { return data_type_ == data_type::f32; }
+
     bool defined() const { return has_default_values(); }
 
-    void reset() {
-        mask_ = 0;
-        is_set_ = false;
-    }
+    void reset() { *this = runtime_scales_t(); }
 
     // TODO: replace with `-1` to remove `is_set_`.
     // Hide `mask_` under `private:` to force interface usage.
     int mask_ = 0;
     bool is_set_ = false;
+    int ndims_ = 0;
+    dims_t group_dims_ = {};
+    data_type_t data_type_ = data_type::f32;
 };
 
 struct arg_scales_t : public c_compatible {
@@ -244,6 +263,34 @@ struct arg_scales_t : public c_compatible {
         return scales_[arg].set(mask);
     }
 
+    status_t set(int arg, int mask, int ndims, const dims_t group_dims,
+            data_type_t data_type) {
+        if (!check_arg(arg)) return status::invalid_arguments;
+        return scales_[arg].set(ndims, mask, group_dims, data_type);
+    }
+
+    // Returns true if the scales of all the arguments but `skip_args` are
+    // neither grouped nor of a non-default data type
+    bool has_default_groups(const std::vector<int> &skip_args = {}) const {
+        for (const auto &s : scales_) {
+            if (s.second.has_default_groups()) continue;
+            if (std::find(skip_args.begin(), skip_args.end(), s.first)
+                    == skip_args.end())
+                return false;
+        }
+        return true;
+    }
+
+    bool has_default_data_type(const std::vector<int> &skip_args = {}) const {
+        for (const auto &s : scales_) {
+            if (s.second.has_default_data_type()) continue;
+            if (std::find(skip_args.begin(), skip_args.end(), s.first)
+                    == skip_args.end())
+                return false;
+        }
+        return true;
+    }
+
     status_t get(int arg, int *mask, bool *is_set) const {
         if (!check_arg(arg)) return status::invalid_arguments;
         const auto &s = get(arg);
@@ -267,11 +314,13 @@ struct arg_scales_t : public c_compatible {
             // new object.
             if (scales_.count(it->first) == 1) {
                 auto &entry = scales_[it->first];
-                bool exists = entry.mask_ == it->second.mask_;
+                bool exists = entry == it->second;
                 if (exists) continue;
             }
 
-            CHECK(set(it->first, it->second.mask_));
+            const auto &s = it->second;
+            CHECK(set(it->first, s.mask_, s.ndims_, s.group_dims_,
+                    s.data_type_));
         }
         return status::success;
     }
@@ -302,7 +351,11 @@ struct zero_points_t : public c_compatible {
     bool operator==(const zero_points_t &rhs) const {
         return mask_src == rhs.mask_src && mask_wei == rhs.mask_wei
                 && mask_dst == rhs.mask_dst && is_set_src == rhs.is_set_src
-                && is_set_wei == rhs.is_set_wei && is_set_dst == rhs.is_set_dst;
+                && is_set_wei == rhs.is_set_wei && is_set_dst == rhs.is_set_dst
+                && group_ndims_wei == rhs.group_ndims_wei
+                && utils::array_cmp(group_dims_wei, rhs.group_dims_wei,
+                        group_ndims_wei)
+                && data_type_wei == rhs.data_type_wei;
     }
 
     // arg-specific checks
@@ -317,14 +370,36 @@ struct zero_points_t : public c_compatible {
         return check_all(&zero_points_t::has_default_values);
     }
 
+    // Weights zero points only may be grouped or of a data type other than
+    // s32, see runtime_scales_t for the meaning of the groups.
+    bool has_default_groups() const { return group_ndims_wei == 0; }
+    bool has_default_data_type() const {
+        return data_type_wei == data_type::s32;
+    }
+
+    int get_group_ndims(int arg) const {
+        return arg == DNNL_ARG_WEIGHTS ? group_ndims_wei : 0;
+    }
+    const dim_t *get_group_dims(int arg) const {
+        return arg == DNNL_ARG_WEIGHTS ? group_dims_wei : nullptr;
+    }
+    data_type_t get_data_type(int arg) const {
+        return arg == DNNL_ARG_WEIGHTS ? data_type_wei : data_type::s32;
+    }
+
     status_t get(int arg, int *mask) const;
 
     status_t set(int arg, int mask);
     status_t set(int arg) { return set(arg, 0); }
+    status_t set(int arg, int mask, int ndims, const dims_t group_dims,
+            data_type_t data_type);
 
 private:
     bool is_set_src = false, is_set_wei = false, is_set_dst = false;
     int mask_src = 0, mask_wei = 0, mask_dst = 0;
+    int group_ndims_wei = 0;
+    dims_t group_dims_wei = {};
+    data_type_t data_type_wei = data_type::s32;
 
     int get_mask(int arg) const {
         int mask = 0;
@@ -616,7 +691,8 @@ private:
 struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     dnnl_primitive_attr()
         : scratchpad_mode_(dnnl::impl::scratchpad_mode::library)
-        , fpmath_mode_(dnnl::impl::get_fpmath_mode()) {}
+        , fpmath_mode_(dnnl::impl::get_fpmath_mode())
+        , fpmath_apply_to_int_(false) {}
 
     dnnl_primitive_attr *clone() const {
         return new dnnl_primitive_attr(*this);
@@ -635,6 +711,7 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
         zero_points_ = other.zero_points_;
         scratchpad_mode_ = other.scratchpad_mode_;
         fpmath_mode_ = other.fpmath_mode_;
+        fpmath_apply_to_int_ = other.fpmath_apply_to_int_;
         post_ops_.copy_from(other.post_ops_);
         rnn_data_qparams_ = other.rnn_data_qparams_;
         CHECK(rnn_weights_qparams_.copy_from(other.rnn_weights_qparams_));
@@ -662,7 +739,12 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
         rnn_tparams = 1u << 9,
         sum_dt = 1u << 10,
         rnn_weights_projection_qparams = 1u << 11,
-        gpu_attr = 1u << 12
+        gpu_attr = 1u << 12,
+        scales_runtime_groups = (unsigned)scales_runtime | (1u << 13),
+        scales_runtime_data_type = (unsigned)scales_runtime | (1u << 14),
+        zero_points_runtime_groups = (unsigned)zero_points_runtime | (1u << 15),
+        zero_points_runtime_data_type
+        = (unsigned)zero_points_runtime | (1u << 16)
     };
 
     /** Returns true if the attributes have default values.
@@ -677,6 +759,7 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     bool operator==(const dnnl_primitive_attr &rhs) const {
         bool ret = scratchpad_mode_ == rhs.scratchpad_mode_
                 && fpmath_mode_ == rhs.fpmath_mode_
+                && fpmath_apply_to_int_ == rhs.fpmath_apply_to_int_
                 && output_scales_ == rhs.output_scales_
                 && scales_ == rhs.scales_ && zero_points_ == rhs.zero_points_
                 && post_ops_ == rhs.post_ops_
@@ -691,7 +774,8 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
         return ret;
     }
 
-    dnnl::impl::status_t set_fpmath_mode(dnnl::impl::fpmath_mode_t fpmath_mode);
+    dnnl::impl::status_t set_fpmath_mode(
+            dnnl::impl::fpmath_mode_t fpmath_mode, bool apply_to_int = false);
     dnnl::impl::status_t set_scratchpad_mode(
             dnnl::impl::scratchpad_mode_t scratchpad_mode);
     dnnl::impl::status_t set_post_ops(const dnnl::impl::post_ops_t &post_ops);
@@ -728,6 +812,9 @@ struct dnnl_primitive_attr : public dnnl::impl::c_compatible {
     dnnl::impl::zero_points_t zero_points_;
     dnnl::impl::scratchpad_mode_t scratchpad_mode_;
     dnnl::impl::fpmath_mode_t fpmath_mode_;
+    // If set, the integer weights are up-converted to the floating-point
+    // compute type of the primitive (weights decompression)
+    bool fpmath_apply_to_int_;
     dnnl::impl::post_ops_t post_ops_;
     dnnl::impl::rnn_data_qparams_t rnn_data_qparams_;
     dnnl::impl::scales_t rnn_weights_qparams_;
@@ -70,6 +70,7 @@ bool key_t::operator==(const key_t &rhs) const {
             CASE(deconvolution)
             CASE(eltwise)
             CASE(gemm)
+            CASE(group_normalization)
             CASE(inner_product)
             CASE(layer_normalization)
             CASE(lrn)
@@ -84,6 +85,7 @@ bool key_t::operator==(const key_t &rhs) const {
             CASE(softmax)
             CASE(sum)
             CASE(zero_pad)
+            CASE(sdpa)
             default: assert(!"unknown primitive kind");
         }
 #undef CASE
@@ -197,6 +199,7 @@ size_t get_attr_hash(const primitive_attr_t &attr) {
     seed = hash_combine(seed, static_cast<size_t>(attr.scratchpad_mode_));
     // fpmath_mode
     seed = hash_combine(seed, static_cast<size_t>(attr.fpmath_mode_));
+    seed = hash_combine(seed, attr.fpmath_apply_to_int_);
 
     if (!attr.output_scales_.has_default_values()) {
         // output_scales: mask
@@ -208,6 +211,12 @@ size_t get_attr_hash(const primitive_attr_t &attr) {
             seed = hash_combine(seed, p.first);
             // scales: mask
             seed = hash_combine(seed, p.second.mask_);
+            // scales: groups
+            seed = hash_combine(seed, p.second.ndims_);
+            seed = get_array_hash(
+                    seed, p.second.group_dims_, p.second.ndims_);
+            // scales: data type
+            seed = hash_combine(seed, static_cast<size_t>(p.second.data_type_));
         }
     }
     // zero_points
@@ -219,6 +228,15 @@ size_t get_attr_hash(const primitive_attr_t &attr) {
             attr.zero_points_.get(arg, &mask);
             // zero_points: mask
             seed = hash_combine(seed, mask);
+            // zero_points: groups
+            const int ndims = attr.zero_points_.get_group_ndims(arg);
+            seed = hash_combine(seed, ndims);
+            if (ndims > 0)
+                seed = get_array_hash(
+                        seed, attr.zero_points_.get_group_dims(arg), ndims);
+            // zero_points: data type
+            seed = hash_combine(seed,
+                    static_cast<size_t>(attr.zero_points_.get_data_type(arg)));
         }
     // post_ops: entry[:]
     for (int i = 0; i < attr.post_ops_.len(); i++) {
@@ -395,6 +413,29 @@ size_t get_desc_hash(const gemm_desc_t &desc) {
     return seed;
 }
 
+size_t get_desc_hash(const group_normalization_desc_t &desc) {
+    size_t seed = 0;
+    // Kinds
+    seed = hash_combine(seed, static_cast<size_t>(desc.primitive_kind));
+    seed = hash_combine(seed, static_cast<size_t>(desc.prop_kind));
+    // Memory descriptors
+    seed = hash_combine(seed, get_md_hash(desc.src_desc));
+    seed = hash_combine(seed, get_md_hash(desc.dst_desc));
+    seed = hash_combine(seed, get_md_hash(desc.diff_src_desc));
+    seed = hash_combine(seed, get_md_hash(desc.diff_dst_desc));
+    seed = hash_combine(seed, get_md_hash(desc.scaleshift_desc));
+    seed = hash_combine(seed, get_md_hash(desc.diff_scaleshift_desc));
+    seed = hash_combine(seed, get_md_hash(desc.stat_desc));
+    // Groups
+    seed = hash_combine(seed, desc.groups);
+    // Epsilon
+    seed = hash_combine(seed, desc.group_norm_epsilon);
+    // Flags
+    seed = hash_combine(seed, desc.flags);
+    // Combined hash for group normalization desc
+    return seed;
+}
+
 size_t get_desc_hash(const inner_product_desc_t &desc) {
     size_t seed = 0;
     // Kinds
@@ -656,6 +697,25 @@ size_t get_desc_hash(const zero_pad_desc_t &desc) {
     return seed;
 }
 
+size_t get_desc_hash(const sdpa_desc_t &desc) {
+    size_t seed = 0;
+    // Kinds
+    seed = hash_combine(seed, static_cast<size_t>(desc.primitive_kind));
+    // Memory descriptors
+    seed = hash_combine(seed, get_md_hash(desc.q_desc));
+    seed = hash_combine(seed, get_md_hash(desc.k_desc));
+    seed = hash_combine(seed, get_md_hash(desc.v_desc));
+    seed = hash_combine(seed, get_md_hash(desc.dst_desc));
+    seed = hash_combine(seed, get_md_hash(desc.attn_mask_desc));
+    seed = hash_combine(seed, get_md_hash(desc.page_table_desc));
+    // Scale and mask
+    seed = hash_combine(seed, static_cast<size_t>(desc.scale_dt));
+    seed = hash_combine(seed, desc.invert_scale);
+    seed = hash_combine(seed, desc.causal_mask);
+    // Combined hash for sdpa desc
+    return seed;
+}
+
 } // namespace primitive_hashing
 } // namespace impl
 } // namespace dnnl
@@ -74,6 +74,7 @@ size_t get_desc_hash(const binary_desc_t &desc);
 size_t get_desc_hash(const convolution_desc_t &desc);
 size_t get_desc_hash(const eltwise_desc_t &desc);
 size_t get_desc_hash(const gemm_desc_t &desc);
+size_t get_desc_hash(const group_normalization_desc_t &desc);
 size_t get_desc_hash(const inner_product_desc_t &desc);
 size_t get_desc_hash(const layer_normalization_desc_t &desc);
 size_t get_desc_hash(const lrn_desc_t &desc);
@@ -88,6 +89,7 @@ size_t get_desc_hash(const shuffle_desc_t &desc);
 size_t get_desc_hash(const softmax_desc_t &desc);
 size_t get_desc_hash(const sum_desc_t &desc);
 size_t get_desc_hash(const zero_pad_desc_t &desc);
+size_t get_desc_hash(const sdpa_desc_t &desc);
 
 template <typename T>
 size_t get_array_hash(size_t seed, const T *v, int size) {
@@ -160,6 +162,7 @@ struct hash<dnnl::impl::primitive_hashing::key_t> {
             CASE(deconvolution)
             CASE(eltwise)
             CASE(gemm)
+            CASE(group_normalization)
             CASE(inner_product)
             CASE(layer_normalization)
             CASE(lrn)
@@ -174,6 +177,7 @@ struct hash<dnnl::impl::primitive_hashing::key_t> {
             CASE(softmax)
             CASE(sum)
             CASE(zero_pad)
+            CASE(sdpa)
             default: assert(!"unknown primitive_kind");
         }
             // clang-format on
@@ -0,0 +1,188 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_SDPA_PD_HPP
+#define COMMON_SDPA_PD_HPP
+
+#include "oneapi/dnnl/dnnl.h"
+
+#include "common/c_types_map.hpp"
+#include "common/primitive_desc.hpp"
+#include "common/sdpa_types.hpp"
+#include "common/utils.hpp"
+
+namespace dnnl {
+namespace impl {
+
+struct sdpa_pd_t : public primitive_desc_t {
+    static constexpr auto base_pkind = primitive_kind::sdpa;
+
+    typedef sdpa_pd_t base_class;
+    typedef sdpa_pd_t hint_class;
+
+    const sdpa_desc_t *desc() const { return &desc_; }
+    const op_desc_t *op_desc() const override {
+        return reinterpret_cast<const op_desc_t *>(this->desc());
+    }
+
+    arg_usage_t arg_usage(int arg) const override {
+        if (utils::one_of(
+                    arg, DNNL_ARG_QUERIES, DNNL_ARG_KEYS, DNNL_ARG_VALUES))
+            return arg_usage_t::input;
+
+        if (arg == DNNL_ARG_ATTN_MASK && with_attn_mask())
+            return arg_usage_t::input;
+
+        if (arg == DNNL_ARG_SCALE && with_scale()) return arg_usage_t::input;
+
+        if (arg == DNNL_ARG_PAGE_TABLE && desc_.paged())
+            return arg_usage_t::input;
+
+        if (arg == DNNL_ARG_DST) return arg_usage_t::output;
+
+        return primitive_desc_t::arg_usage(arg);
+    }
+
+    const memory_desc_t *arg_md(int arg) const override {
+        switch (arg) {
+            case DNNL_ARG_QUERIES: return src_md(0);
+            case DNNL_ARG_KEYS: return src_md(1);
+            case DNNL_ARG_VALUES: return src_md(2);
+            case DNNL_ARG_ATTN_MASK: return src_md(3);
+            case DNNL_ARG_PAGE_TABLE: return src_md(4);
+            case DNNL_ARG_DST: return dst_md(0);
+            default: return primitive_desc_t::arg_md(arg);
+        }
+    }
+
+    const memory_desc_t *src_md(int index = 0) const override {
+        switch (index) {
+            case 0: return &desc_.q_desc;
+            case 1: return &desc_.k_desc;
+            case 2: return &desc_.v_desc;
+            case 3: return &desc_.attn_mask_desc;
+            case 4: return &desc_.page_table_desc;
+            default: return &glob_zero_md;
+        }
+    }
+    const memory_desc_t *dst_md(int index = 0) const override {
+        return index == 0 ? &desc_.dst_desc : &glob_zero_md;
+    }
+
+    int n_inputs() const override {
+        return 3 + with_attn_mask() + with_scale() + desc_.paged();
+    }
+    int n_outputs() const override { return 1; }
+
+    bool with_attn_mask() const {
+        return !memory_desc_wrapper(desc_.attn_mask_desc).is_zero();
+    }
+    bool with_scale() const { return desc_.scale_dt != data_type::undef; }
+    bool with_causal_mask() const { return desc_.causal_mask; }
+
+    bool has_zero_dim_memory() const {
+        for (const auto md : {&desc_.q_desc, &desc_.k_desc, &desc_.v_desc,
+                     &desc_.dst_desc})
+            if (memory_desc_wrapper(md).has_zero_dim()) return true;
+        return false;
+    }
+
+protected:
+    sdpa_desc_t desc_;
+
+    sdpa_pd_t(const sdpa_desc_t *adesc, const primitive_attr_t *attr,
+            const hint_class *hint_fwd_pd)
+        : primitive_desc_t(attr, base_pkind), desc_(*adesc) {}
+
+    // The mask is broadcast along the dimensions of size one, the other
+    // tensors must have the same batch dimensions as the destination.
+    bool dims_consistent() const {
+        const int ndims = desc_.ndims();
+        if (ndims < 2) return false;
+        for (const auto md : {&desc_.q_desc, &desc_.k_desc, &desc_.v_desc})
+            if (md->ndims != ndims) return false;
+        for (int d = 0; d < ndims - 2; ++d) {
+            const dim_t b = desc_.dst_desc.dims[d];
+            if (desc_.q_desc.dims[d] != b) return false;
+            if (desc_.paged()) continue;
+            if (desc_.k_desc.dims[d] != b || desc_.v_desc.dims[d] != b)
+                return false;
+        }
+
+        const auto &dst_dims = desc_.dst_desc.dims;
+        bool ok = desc_.queries() == dst_dims[ndims - 2]
+                && desc_.values() == dst_dims[ndims - 1]
+                && desc_.k_desc.dims[ndims - 2] == desc_.head_size();
+        if (desc_.paged())
+            ok = ok && paged_dims_consistent();
+        else
+            ok = ok && desc_.v_desc.dims[ndims - 2] == desc_.keys();
+        if (!ok || !with_attn_mask()) return ok;
+
+        const auto &msk = desc_.attn_mask_desc;
+        if (msk.ndims != ndims || msk.dims[ndims - 1] != desc_.keys())
+            return false;
+        for (int d = 0; d < ndims - 1; ++d)
+            if (!utils::one_of(msk.dims[d], 1, dst_dims[d])) return false;
+        return true;
+    }
+
+    // The pools of pages are [pages, heads, ...] with the same number of
+    // pages and the page table is [minibatch, pages per sequence]
+    bool paged_dims_consistent() const {
+        const auto &pt = desc_.page_table_desc;
+        const auto &k = desc_.k_desc;
+        const auto &v = desc_.v_desc;
+        const auto &dst_dims = desc_.dst_desc.dims;
+        return desc_.ndims() == 4 && pt.ndims == 2
+                && pt.data_type == data_type::s32 && pt.dims[0] == dst_dims[0]
+                && k.dims[0] == v.dims[0] && k.dims[1] == dst_dims[1]
+                && v.dims[1] == dst_dims[1]
+                && v.dims[2] == desc_.page_size();
+    }
+
+    // By default, we just resolve 'any' with blocked layout and trivial strides
+    bool set_default_format(memory_desc_t *md) {
+        memory_desc_wrapper mdw(md);
+        if (mdw.format_any()) {
+            if (mdw.has_runtime_dims_or_strides()) return false;
+            status_t status = memory_desc_init_by_strides(*md, nullptr);
+            if (status != status::success) return false;
+        }
+
+        return true;
+    }
+
+    bool set_default_formats() {
+        bool ok = true;
+
+        for (auto md : {&desc_.q_desc, &desc_.k_desc, &desc_.v_desc,
+                     &desc_.dst_desc}) {
+            ok = ok && set_default_format(md);
+        }
+        if (with_attn_mask())
+            ok = ok && set_default_format(&desc_.attn_mask_desc);
+        if (desc_.paged())
+            ok = ok && set_default_format(&desc_.page_table_desc);
+
+        return ok;
+    }
+};
+
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -0,0 +1,99 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_SDPA_TYPES_HPP
+#define COMMON_SDPA_TYPES_HPP
+
+#include <assert.h>
+
+#include "common/c_types_map.hpp"
+#include "common/memory_desc.hpp"
+
+namespace dnnl {
+namespace impl {
+
+#define DNNL_ARG_QUERIES DNNL_ARG_SRC_0
+#define DNNL_ARG_KEYS DNNL_ARG_SRC_1
+#define DNNL_ARG_VALUES DNNL_ARG_SRC_2
+#define DNNL_ARG_ATTN_MASK DNNL_ARG_SHIFT
+#define DNNL_ARG_PAGE_TABLE DNNL_ARG_SRC_3
+
+// A descriptor for a scaled dot product attention (SDPA) operation:
+//     dst = softmax(scale(Q * K) + mask) * V
+// where the scale multiplies or, with `invert_scale`, divides the scores by
+// a single value. The keys are given transposed, so both products are plain
+// matrix multiplications of the last two dimensions. The leading dimensions
+// are batch dimensions, the mask may be broadcast along any of them and
+// along the queries.
+//
+// With a page table, the keys and the values are stored in pages of a fixed
+// number of keys, shared by all the sequences of the batch. The descriptors
+// of the keys and the values then describe the pools of pages and the page
+// table gives the pages of every sequence in order. Only 4D problems
+// [minibatch, heads, ...] are supported in this mode: the pages hold the
+// keys of all the heads of a sequence.
+struct sdpa_desc_t {
+    // The kind of primitive. Used for self identifying the primitive
+    // descriptor. Must be primitive_kind::sdpa.
+    primitive_kind_t primitive_kind;
+    // Queries, [batch..., queries, head_size]
+    memory_desc_t q_desc;
+    // Keys, [batch..., head_size, keys], or the pool of pages of keys
+    // [pages, heads, head_size, page_size]
+    memory_desc_t k_desc;
+    // Values, [batch..., keys, values], or the pool of pages of values
+    // [pages, heads, page_size, values]
+    memory_desc_t v_desc;
+    // Destination, [batch..., queries, values]
+    memory_desc_t dst_desc;
+    // Additive mask, [batch... or 1, queries or 1, keys], or a zero memory
+    // descriptor if there is none
+    memory_desc_t attn_mask_desc;
+    // The s32 indices of the pages of every sequence in the pools,
+    // [minibatch, pages per sequence], or a zero memory descriptor if the
+    // keys and the values are not paged
+    memory_desc_t page_table_desc;
+    // The data type of the runtime scale passed as DNNL_ARG_SCALE, or undef
+    // if the scores are not scaled
+    data_type_t scale_dt;
+    bool invert_scale;
+    // Masks out the keys following the query of the same index
+    bool causal_mask;
+
+    int ndims() const { return dst_desc.ndims; }
+    dim_t batch() const {
+        dim_t batch = 1;
+        for (int d = 0; d < ndims() - 2; ++d)
+            batch *= dst_desc.dims[d];
+        return batch;
+    }
+    dim_t queries() const { return q_desc.dims[q_desc.ndims - 2]; }
+    dim_t head_size() const { return q_desc.dims[q_desc.ndims - 1]; }
+    bool paged() const { return page_table_desc.ndims != 0; }
+    dim_t page_size() const {
+        return paged() ? k_desc.dims[k_desc.ndims - 1] : 0;
+    }
+    dim_t keys() const {
+        return paged() ? page_table_desc.dims[1] * page_size()
+                       : k_desc.dims[k_desc.ndims - 1];
+    }
+    dim_t values() const { return v_desc.dims[v_desc.ndims - 1]; }
+};
+
+} // namespace impl
+} // namespace dnnl
+
+#endif
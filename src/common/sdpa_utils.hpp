@@ -0,0 +1,80 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef COMMON_SDPA_UTILS_HPP
+#define COMMON_SDPA_UTILS_HPP
+
+#include <memory>
+
+#include "oneapi/dnnl/dnnl.h"
+
+#include "common/c_types_map.hpp"
+#include "common/primitive_desc_iterator.hpp"
+#include "common/sdpa_pd.hpp"
+#include "common/sdpa_types.hpp"
+#include "common/utils.hpp"
+
+namespace dnnl {
+namespace impl {
+
+static inline sdpa_desc_t create_sdpa_desc(const memory_desc_t *q_md,
+        const memory_desc_t *k_md, const memory_desc_t *v_md,
+        const memory_desc_t *dst_md, const memory_desc_t *attn_mask_md,
+        data_type_t scale_dt, bool invert_scale, bool causal_mask,
+        const memory_desc_t *page_table_md = nullptr) {
+    auto sdpa_desc = sdpa_desc_t();
+    sdpa_desc.primitive_kind = primitive_kind::sdpa;
+    sdpa_desc.q_desc = *q_md;
+    sdpa_desc.k_desc = *k_md;
+    sdpa_desc.v_desc = *v_md;
+    sdpa_desc.dst_desc = *dst_md;
+    if (attn_mask_md) sdpa_desc.attn_mask_desc = *attn_mask_md;
+    if (page_table_md) sdpa_desc.page_table_desc = *page_table_md;
+    sdpa_desc.scale_dt = scale_dt;
+    sdpa_desc.invert_scale = invert_scale;
+    sdpa_desc.causal_mask = causal_mask;
+    return sdpa_desc;
+}
+
+// Creates the primitive descriptor of the first sdpa implementation accepting
+// the problem. The mask, the scale and the page table are optional: pass
+// nullptr and data_type::undef to skip them.
+static inline status_t create_sdpa_pd(
+        std::shared_ptr<primitive_desc_t> &sdpa_pd_, engine_t *engine,
+        const memory_desc_t *q_md, const memory_desc_t *k_md,
+        const memory_desc_t *v_md, const memory_desc_t *dst_md,
+        const memory_desc_t *attn_mask_md, data_type_t scale_dt,
+        bool invert_scale, bool causal_mask,
+        const primitive_attr_t *attr = nullptr,
+        const memory_desc_t *page_table_md = nullptr) {
+    auto sdpa_desc = create_sdpa_desc(q_md, k_md, v_md, dst_md, attn_mask_md,
+            scale_dt, invert_scale, causal_mask, page_table_md);
+
+    primitive_attr_t sdpa_attr = attr ? *attr : primitive_attr_t();
+
+    primitive_desc_iterator_t it(
+            engine, (op_desc_t *)&sdpa_desc, &sdpa_attr, nullptr);
+
+    sdpa_pd_ = *(++it);
+    if (!sdpa_pd_) return status::unimplemented;
+
+    return status::success;
+}
+
+} // namespace impl
+} // namespace dnnl
+
+#endif
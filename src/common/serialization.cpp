@@ -38,6 +38,7 @@ status_t serialize_desc(
         CASE(eltwise)
         CASE(inner_product)
         CASE(gemm)
+        CASE(group_normalization)
         CASE(layer_normalization)
         CASE(lrn)
         CASE(matmul)
@@ -47,6 +48,7 @@ status_t serialize_desc(
         CASE(reorder)
         CASE(resampling)
         CASE(rnn)
+        CASE(sdpa)
         CASE(shuffle)
         CASE(softmax)
         CASE(sum)
@@ -135,6 +137,7 @@ void serialize_attr(
     sstream.write(&attr.scratchpad_mode_);
     // fpmath_mode
     sstream.write(&attr.fpmath_mode_);
+    sstream.write(&attr.fpmath_apply_to_int_);
 
     if (!attr.output_scales_.has_default_values()) {
         // output_scales: mask
@@ -144,6 +147,9 @@ void serialize_attr(
         for (const auto &p : attr.scales_.scales_) {
             sstream.write(&p.first);
             sstream.write(&p.second.mask_);
+            sstream.write(&p.second.ndims_);
+            sstream.write(p.second.group_dims_, p.second.ndims_);
+            sstream.write(&p.second.data_type_);
         }
     }
     // zero_points
@@ -155,6 +161,14 @@ void serialize_attr(
             attr.zero_points_.get(arg, &mask);
             // zero_points: mask
             sstream.write(&mask);
+            // zero_points: groups
+            const int ndims = attr.zero_points_.get_group_ndims(arg);
+            sstream.write(&ndims);
+            if (ndims > 0)
+                sstream.write(attr.zero_points_.get_group_dims(arg), ndims);
+            // zero_points: data type
+            const data_type_t dt = attr.zero_points_.get_data_type(arg);
+            sstream.write(&dt);
         }
     // post_ops: entry[:]
     for (int i = 0; i < attr.post_ops_.len(); i++) {
@@ -307,6 +321,27 @@ void serialize_desc(serialization_stream_t &sstream, const gemm_desc_t &desc) {
     sstream.write(&desc.sum_ab_type);
 }
 
+void serialize_desc(serialization_stream_t &sstream,
+        const group_normalization_desc_t &desc) {
+    // Kinds
+    sstream.write(&desc.primitive_kind);
+    sstream.write(&desc.prop_kind);
+    // Memory descriptors
+    serialize_md(sstream, desc.src_desc);
+    serialize_md(sstream, desc.dst_desc);
+    serialize_md(sstream, desc.diff_src_desc);
+    serialize_md(sstream, desc.diff_dst_desc);
+    serialize_md(sstream, desc.scaleshift_desc);
+    serialize_md(sstream, desc.diff_scaleshift_desc);
+    serialize_md(sstream, desc.stat_desc);
+    // Groups
+    sstream.write(&desc.groups);
+    // Epsilon
+    sstream.write(&desc.group_norm_epsilon);
+    // Flags
+    sstream.write(&desc.flags);
+}
+
 void serialize_desc(
         serialization_stream_t &sstream, const inner_product_desc_t &desc) {
     // Kinds
@@ -489,6 +524,22 @@ void serialize_desc(serialization_stream_t &sstream, const rnn_desc_t &desc) {
 }
 
 // Shuffle
+void serialize_desc(serialization_stream_t &sstream, const sdpa_desc_t &desc) {
+    // Kind
+    sstream.write(&desc.primitive_kind);
+    // Memory descriptors
+    serialize_md(sstream, desc.q_desc);
+    serialize_md(sstream, desc.k_desc);
+    serialize_md(sstream, desc.v_desc);
+    serialize_md(sstream, desc.dst_desc);
+    serialize_md(sstream, desc.attn_mask_desc);
+    serialize_md(sstream, desc.page_table_desc);
+    // Scale and mask
+    sstream.write(&desc.scale_dt);
+    sstream.write(&desc.invert_scale);
+    sstream.write(&desc.causal_mask);
+}
+
 void serialize_desc(
         serialization_stream_t &sstream, const shuffle_desc_t &desc) {
     // Kinds
@@ -39,6 +39,8 @@ void serialize_desc(
 void serialize_desc(
         serialization_stream_t &sstream, const eltwise_desc_t &desc);
 void serialize_desc(serialization_stream_t &sstream, const gemm_desc_t &desc);
+void serialize_desc(serialization_stream_t &sstream,
+        const group_normalization_desc_t &desc);
 void serialize_desc(
         serialization_stream_t &sstream, const inner_product_desc_t &desc);
 void serialize_desc(serialization_stream_t &sstream,
@@ -55,6 +57,7 @@ void serialize_desc(
 void serialize_desc(
         serialization_stream_t &sstream, const resampling_desc_t &desc);
 void serialize_desc(serialization_stream_t &sstream, const rnn_desc_t &desc);
+void serialize_desc(serialization_stream_t &sstream, const sdpa_desc_t &desc);
 void serialize_desc(
         serialization_stream_t &sstream, const shuffle_desc_t &desc);
 void serialize_desc(
@@ -91,6 +91,12 @@ inline size_t data_type_size(data_type_t data_type) {
         case s32: return sizeof(prec_traits<s32>::type);
         case s8: return sizeof(prec_traits<s8>::type);
         case u8: return sizeof(prec_traits<u8>::type);
+        // the 4-bit types are packed in pairs, the size of a byte is returned
+        // and the buffer size is adjusted by the memory descriptor wrapper
+        case s4: return sizeof(prec_traits<s4>::type);
+        case u4: return sizeof(prec_traits<u4>::type);
+        case f8_e5m2: return sizeof(prec_traits<f8_e5m2>::type);
+        case f8_e4m3: return sizeof(prec_traits<f8_e4m3>::type);
         case data_type::undef:
         default: assert(!"unknown data_type");
     }
@@ -106,6 +112,8 @@ inline T max_value(data_type_t data_type) {
     switch (data_type) {
         CASE(f16);
         CASE(bf16);
+        CASE(f8_e5m2);
+        CASE(f8_e4m3);
         CASE(s32);
         CASE(s8);
         CASE(u8);
@@ -127,6 +135,8 @@ inline float max_value(data_type_t data_type) {
     switch (data_type) {
         CASE(f16);
         CASE(bf16);
+        CASE(f8_e5m2);
+        CASE(f8_e4m3);
         CASE(s8);
         CASE(u8);
         // INT_MAX is not representable in float. The nearest float to it is
@@ -265,6 +275,8 @@ inline data_type_t default_accum_data_type(
 
     if (one_of(f16, src_dt, dst_dt)) return f32;
     if (one_of(bf16, src_dt, dst_dt)) return f32;
+    if (one_of(f8_e5m2, src_dt, dst_dt)) return f32;
+    if (one_of(f8_e4m3, src_dt, dst_dt)) return f32;
     if (one_of(f32, src_dt, dst_dt)) return f32;
     if (one_of(f64, src_dt, dst_dt)) return f64;
     if (one_of(s32, src_dt, dst_dt)) return s32;
@@ -298,6 +310,8 @@ inline data_type_t default_accum_data_type(data_type_t src_dt,
 
     if (one_of(bf16, src_dt, wei_dt, dst_dt)) return f32;
     if (one_of(f16, src_dt, wei_dt, dst_dt)) return f32;
+    if (one_of(f8_e5m2, src_dt, wei_dt, dst_dt)) return f32;
+    if (one_of(f8_e4m3, src_dt, wei_dt, dst_dt)) return f32;
 
     return data_type::undef;
 }
@@ -341,6 +355,30 @@ inline void cvt_to_float<float16_t>(
     cvt_float16_to_float(out, inp, nelems);
 }
 
+template <>
+inline void cvt_from_float<float8_e5m2_t>(
+        float8_e5m2_t *out, const float *inp, size_t nelems) {
+    cvt_float_to_f8_e5m2(out, inp, nelems);
+}
+
+template <>
+inline void cvt_to_float<float8_e5m2_t>(
+        float *out, const float8_e5m2_t *inp, size_t nelems) {
+    cvt_f8_e5m2_to_float(out, inp, nelems);
+}
+
+template <>
+inline void cvt_from_float<float8_e4m3_t>(
+        float8_e4m3_t *out, const float *inp, size_t nelems) {
+    cvt_float_to_f8_e4m3(out, inp, nelems);
+}
+
+template <>
+inline void cvt_to_float<float8_e4m3_t>(
+        float *out, const float8_e4m3_t *inp, size_t nelems) {
+    cvt_f8_e4m3_to_float(out, inp, nelems);
+}
+
 inline void cvt_from_float(
         data_type_t dt, void *out, const float *inp, size_t nelems) {
     switch (dt) {
@@ -350,6 +388,12 @@ inline void cvt_from_float(
         case data_type::f16:
             cvt_from_float((float16_t *)out, inp, nelems);
             break;
+        case data_type::f8_e5m2:
+            cvt_from_float((float8_e5m2_t *)out, inp, nelems);
+            break;
+        case data_type::f8_e4m3:
+            cvt_from_float((float8_e4m3_t *)out, inp, nelems);
+            break;
         default: assert(!"unimplemented");
     }
 }
@@ -482,6 +526,23 @@ inline bool operator==(const gemm_desc_t &lhs, const gemm_desc_t &rhs) {
     return ret;
 }
 
+inline bool operator==(const group_normalization_desc_t &lhs,
+        const group_normalization_desc_t &rhs) {
+    bool ret = COMPARE_DESC_MEMBERS(primitive_kind)
+            && COMPARE_DESC_MEMBERS(prop_kind)
+            && COMPARE_DESC_MEMBERS(src_desc)
+            && COMPARE_DESC_MEMBERS(dst_desc)
+            && COMPARE_DESC_MEMBERS(diff_src_desc)
+            && COMPARE_DESC_MEMBERS(diff_dst_desc)
+            && COMPARE_DESC_MEMBERS(scaleshift_desc)
+            && COMPARE_DESC_MEMBERS(diff_scaleshift_desc)
+            && COMPARE_DESC_MEMBERS(stat_desc)
+            && COMPARE_DESC_MEMBERS(groups)
+            && COMPARE_FLOAT_DESC_MEMBERS(group_norm_epsilon)
+            && COMPARE_DESC_MEMBERS(flags);
+    return ret;
+}
+
 inline bool operator==(
         const inner_product_desc_t &lhs, const inner_product_desc_t &rhs) {
     bool ret = COMPARE_DESC_MEMBERS(primitive_kind)
@@ -683,6 +744,20 @@ inline bool operator==(const zero_pad_desc_t &lhs, const zero_pad_desc_t &rhs) {
     bool ret = COMPARE_DESC_MEMBERS(primitive_kind);
     return ret;
 }
+
+inline bool operator==(const sdpa_desc_t &lhs, const sdpa_desc_t &rhs) {
+    bool ret = COMPARE_DESC_MEMBERS(primitive_kind)
+            && COMPARE_DESC_MEMBERS(q_desc)
+            && COMPARE_DESC_MEMBERS(k_desc)
+            && COMPARE_DESC_MEMBERS(v_desc)
+            && COMPARE_DESC_MEMBERS(dst_desc)
+            && COMPARE_DESC_MEMBERS(attn_mask_desc)
+            && COMPARE_DESC_MEMBERS(page_table_desc)
+            && COMPARE_DESC_MEMBERS(scale_dt)
+            && COMPARE_DESC_MEMBERS(invert_scale)
+            && COMPARE_DESC_MEMBERS(causal_mask);
+    return ret;
+}
 // clang-format on
 
 #undef COMPARE_DESC_MEMBERS
@@ -922,7 +997,8 @@ inline bool memory_desc_sanity_check(int ndims, const dims_t dims,
     if (ndims == 0) return true;
 
     bool ok = dims != nullptr && 0 < ndims && ndims <= DNNL_MAX_NDIMS
-            && utils::one_of(data_type, f16, bf16, f32, f64, s32, s8, u8);
+            && utils::one_of(data_type, f16, bf16, f32, f64, s32, s8, u8, s4,
+                    u4, f8_e5m2, f8_e4m3);
     if (!ok) return false;
 
     bool has_runtime_dims = false;
@@ -955,6 +1031,7 @@ inline void copy_c_op_desc(op_desc_t *dst, const op_desc_t *src) {
         CASE_OP_DESC(deconvolution);
         CASE_OP_DESC(eltwise);
         CASE_OP_DESC(gemm);
+        CASE_OP_DESC(group_normalization);
         CASE_OP_DESC(inner_product);
         CASE_OP_DESC(layer_normalization);
         CASE_OP_DESC(lrn);
@@ -969,6 +1046,7 @@ inline void copy_c_op_desc(op_desc_t *dst, const op_desc_t *src) {
 
         // Internal descs
         CASE_OP_DESC(zero_pad);
+        CASE_OP_DESC(sdpa);
         default: assert(!"unknown C primitive kind");
     }
 #undef CASE_OP_DESC
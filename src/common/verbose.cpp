@@ -39,6 +39,7 @@
 #include "convolution_pd.hpp"
 #include "deconvolution_pd.hpp"
 #include "eltwise_pd.hpp"
+#include "group_normalization_pd.hpp"
 #include "inner_product_pd.hpp"
 #include "layer_normalization_pd.hpp"
 #include "lrn_pd.hpp"
@@ -49,6 +50,7 @@
 #include "reorder_pd.hpp"
 #include "resampling_pd.hpp"
 #include "rnn_pd.hpp"
+#include "sdpa_pd.hpp"
 #include "shuffle_pd.hpp"
 #include "softmax_pd.hpp"
 #include "sum_pd.hpp"
@@ -222,6 +224,7 @@ std::ostream &operator<<(std::ostream &ss, const engine_t *engine) {
 const char *prim_kind2str(primitive_kind_t prim_kind) {
     switch ((int)prim_kind) {
         case primitive_kind::zero_pad: return "zero_pad";
+        case primitive_kind::sdpa: return "sdpa";
         default: return dnnl_prim_kind2str(prim_kind);
     }
 }
@@ -418,8 +421,20 @@ std::string md2desc_str(const memory_desc_t *md) {
     return s;
 }
 
+// Returns string with the given dimensions: dim0xdim1x...xdimN.
+std::string dims2str(int ndims, const dims_t dims) {
+    std::string s;
+    for (int d = 0; d < ndims; ++d)
+        s += (d == 0 ? "" : "x") + get_val_str(dims[d]);
+    return s;
+}
+
 std::ostream &operator<<(std::ostream &ss, const runtime_scales_t &oscale) {
     ss << oscale.mask_;
+    if (!oscale.has_default_data_type() || !oscale.has_default_groups())
+        ss << ":" << oscale.data_type_;
+    if (!oscale.has_default_groups())
+        ss << ":" << dims2str(oscale.ndims_, oscale.group_dims_);
     return ss;
 }
 
@@ -480,8 +495,11 @@ std::ostream &operator<<(std::ostream &ss, const primitive_attr_t *attr) {
         ss << "attr-scratchpad:" << dnnl_scratchpad_mode2str(spm) << " ";
     }
     const fpmath_mode_t &fpm = attr->fpmath_mode_;
-    if (fpm != fpmath_mode_t::dnnl_fpmath_mode_strict) {
-        ss << "attr-fpmath:" << dnnl_fpmath_mode2str(fpm) << " ";
+    if (fpm != fpmath_mode_t::dnnl_fpmath_mode_strict
+            || attr->fpmath_apply_to_int_) {
+        ss << "attr-fpmath:" << dnnl_fpmath_mode2str(fpm);
+        if (attr->fpmath_apply_to_int_) ss << ":true";
+        ss << " ";
     }
 
     if (attr->has_default_values()) return ss;
@@ -517,6 +535,11 @@ std::ostream &operator<<(std::ostream &ss, const primitive_attr_t *attr) {
             zp.get(arg, &mask);
 
             ss << delim << arg2str(arg) << ":" << mask;
+            const int ndims = zp.get_group_ndims(arg);
+            if (ndims > 0 || zp.get_data_type(arg) != data_type::s32)
+                ss << ":" << zp.get_data_type(arg);
+            if (ndims > 0)
+                ss << ":" << dims2str(ndims, zp.get_group_dims(arg));
             delim = attr_delim;
         }
         ss << " ";
@@ -716,6 +739,26 @@ static std::string init_info_eltwise(const engine_t *e, const pd_t *pd) {
     return ss.str();
 }
 
+template <typename pd_t>
+static std::string init_info_group_normalization(
+        const engine_t *e, const pd_t *pd) {
+    std::stringstream ss;
+    ss << e << "," << pd->kind() << "," << pd->name() << ","
+       << pd->desc()->prop_kind << ",";
+
+    auto src_md = pd->src_md();
+    auto dst_md = pd->is_fwd() ? pd->dst_md() : pd->diff_dst_md();
+    ss << "src_" << src_md << " dst_" << dst_md;
+    if (!pd->is_fwd()) ss << " diff_src_" << pd->diff_src_md();
+    ss << ",";
+
+    ss << pd->attr() << ",";
+    ss << "flags:" << normalization_flags2str(pd->desc()->flags) << ",";
+    ss << "g" << pd->desc()->groups << md2desc_str(src_md);
+
+    return ss.str();
+}
+
 template <typename pd_t>
 static std::string init_info_inner_product(const engine_t *e, const pd_t *pd) {
     std::stringstream ss;
@@ -821,6 +864,38 @@ static std::string init_info_matmul(const engine_t *e, const pd_t *pd) {
     return ss.str();
 }
 
+template <typename pd_t>
+static std::string init_info_sdpa(const engine_t *e, const pd_t *pd) {
+    std::stringstream ss;
+    ss << e << "," << pd->kind() << "," << pd->name() << "," << prop_kind::undef
+       << ",";
+
+    auto q_md = pd->src_md(0);
+    auto k_md = pd->src_md(1);
+    auto v_md = pd->src_md(2);
+    auto msk_md = pd->src_md(3);
+    auto pt_md = pd->src_md(4);
+    auto dst_md = pd->dst_md();
+
+    ss << "query_" << q_md << " key_" << k_md << " val_" << v_md;
+    if (pd->with_attn_mask()) ss << " msk_" << msk_md;
+    if (pd->desc()->paged()) ss << " pages_" << pt_md;
+    ss << " dst_" << dst_md << ",";
+
+    ss << pd->attr() << ",";
+
+    if (pd->with_scale())
+        ss << "scale:" << pd->desc()->scale_dt
+           << (pd->desc()->invert_scale ? ":div" : ":mul") << " ";
+    if (pd->with_causal_mask()) ss << "causal ";
+    ss << ",";
+
+    ss << md2dim_str(q_md) << ":" << md2dim_str(k_md) << ":"
+       << md2dim_str(v_md);
+
+    return ss.str();
+}
+
 template <typename pd_t>
 static std::string init_info_pooling(const engine_t *e, const pd_t *pd) {
     std::stringstream ss;
@@ -1074,6 +1149,7 @@ void pd_info_t::init(engine_t *engine, const primitive_desc_t *pd) {
             CASE(convolution);
             CASE(deconvolution);
             CASE(eltwise);
+            CASE(group_normalization);
             CASE(inner_product);
             CASE(layer_normalization);
             CASE(lrn);
@@ -1084,6 +1160,7 @@ void pd_info_t::init(engine_t *engine, const primitive_desc_t *pd) {
             CASE(reorder);
             CASE(resampling);
             CASE(rnn);
+            CASE(sdpa);
             CASE(shuffle);
             CASE(softmax);
             CASE(sum);
@@ -62,6 +62,11 @@
         if ((attr)->scales_.get(arg).has_default_values()) { \
             utils::array_set(CONCAT2(scales, _buf16), 1.0f, 16); \
             scales = CONCAT2(scales, _buf16); \
+        } else if (!(attr)->scales_.get(arg).has_default_groups() \
+                || !(attr)->scales_.get(arg).has_default_data_type()) { \
+            /* group-wise or non-f32 scales are read by the implementation */ \
+            scales = CTX_IN_MEM(const float *, DNNL_ARG_ATTR_SCALES | arg); \
+            if (scales == nullptr) return status::invalid_arguments; \
         } else { \
             scales = CTX_IN_MEM(const float *, DNNL_ARG_ATTR_SCALES | arg); \
             if (scales == nullptr) return status::invalid_arguments; \
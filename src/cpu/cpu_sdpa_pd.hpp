@@ -0,0 +1,93 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_CPU_SDPA_PD_HPP
+#define CPU_CPU_SDPA_PD_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/memory_desc_wrapper.hpp"
+#include "common/sdpa_pd.hpp"
+#include "common/utils.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+struct cpu_sdpa_pd_t : public sdpa_pd_t {
+    using sdpa_pd_t::sdpa_pd_t;
+
+    // The stride of dimension `d` of `md`, zero if it is broadcast
+    static dim_t stride(const memory_desc_t &md, int d) {
+        return md.dims[d] == 1 ? 0 : md.format_desc.blocking.strides[d];
+    }
+
+    // The offset of the matrix of the flattened batch index `b` in `md`
+    dim_t batch_off(const memory_desc_t &md, dim_t b) const {
+        dim_t off = md.offset0;
+        for (int d = desc_.ndims() - 3; d >= 0; --d) {
+            const dim_t dim = desc_.dst_desc.dims[d];
+            off += (b % dim) * stride(md, d);
+            b /= dim;
+        }
+        return off;
+    }
+
+    // The offset of the key `n` of the flattened batch index `b` in the keys
+    // or the values `md`, whose dimension of the keys is `n_dim`. With a page
+    // table, the key is looked up in its page.
+    dim_t key_off(const memory_desc_t &md, int n_dim, dim_t b, dim_t n,
+            const int32_t *page_table) const {
+        if (!desc_.paged()) return batch_off(md, b) + n * stride(md, n_dim);
+
+        const auto &pt = desc_.page_table_desc;
+        const dim_t heads = desc_.dst_desc.dims[1];
+        const dim_t page_size = desc_.page_size();
+        const dim_t mb = b / heads, h = b % heads;
+        const dim_t page = page_table[pt.offset0 + mb * stride(pt, 0)
+                + (n / page_size) * stride(pt, 1)];
+        return md.offset0 + page * stride(md, 0) + h * stride(md, 1)
+                + (n % page_size) * stride(md, n_dim);
+    }
+
+protected:
+    // Resolves the formats and checks the dimensions. The implementations
+    // only support plain layouts with dense rows of queries, values and
+    // destination.
+    bool init_formats_and_dims() {
+        if (!dims_consistent() || !set_default_formats()) return false;
+        if (has_zero_dim_memory()) return false;
+
+        for (const auto md : {&desc_.q_desc, &desc_.k_desc, &desc_.v_desc,
+                     &desc_.dst_desc, &desc_.attn_mask_desc,
+                     &desc_.page_table_desc}) {
+            if (md == &desc_.attn_mask_desc && !with_attn_mask()) continue;
+            if (md == &desc_.page_table_desc && !desc_.paged()) continue;
+            const memory_desc_wrapper mdw(md);
+            if (!mdw.is_plain() || mdw.has_runtime_dims_or_strides())
+                return false;
+        }
+        const int last = desc_.ndims() - 1;
+        for (const auto md : {&desc_.q_desc, &desc_.v_desc, &desc_.dst_desc})
+            if (md->format_desc.blocking.strides[last] != 1) return false;
+        return true;
+    }
+};
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -0,0 +1,88 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "common/dnnl_thread.hpp"
+#include "common/float8.hpp"
+
+#include "cpu/platform.hpp"
+#if DNNL_X64
+#include "cpu/x64/cpu_isa_traits.hpp"
+#include "cpu/x64/jit_avx512_core_fp8cvt.hpp"
+#endif
+
+namespace dnnl {
+namespace impl {
+
+void cvt_f8_e5m2_to_float(float *out, const float8_e5m2_t *inp, size_t nelems) {
+#if DNNL_X64
+    using namespace cpu::x64;
+    if (mayiuse(avx512_core)) {
+        static const jit_avx512_core_fp8_cvt_t kernel(data_type::f8_e5m2, true);
+        return kernel(out, inp, nelems);
+    }
+#endif
+
+    PRAGMA_OMP_SIMD()
+    for (size_t i = 0; i < nelems; ++i)
+        out[i] = inp[i];
+}
+
+void cvt_f8_e4m3_to_float(float *out, const float8_e4m3_t *inp, size_t nelems) {
+#if DNNL_X64
+    using namespace cpu::x64;
+    if (mayiuse(avx512_core)) {
+        static const jit_avx512_core_fp8_cvt_t kernel(data_type::f8_e4m3, true);
+        return kernel(out, inp, nelems);
+    }
+#endif
+
+    PRAGMA_OMP_SIMD()
+    for (size_t i = 0; i < nelems; ++i)
+        out[i] = inp[i];
+}
+
+void cvt_float_to_f8_e5m2(float8_e5m2_t *out, const float *inp, size_t nelems) {
+#if DNNL_X64
+    using namespace cpu::x64;
+    if (mayiuse(avx512_core)) {
+        static const jit_avx512_core_fp8_cvt_t kernel(
+                data_type::f8_e5m2, false);
+        return kernel(out, inp, nelems);
+    }
+#endif
+
+    PRAGMA_OMP_SIMD()
+    for (size_t i = 0; i < nelems; ++i)
+        out[i] = static_cast<float8_e5m2_t>(inp[i]);
+}
+
+void cvt_float_to_f8_e4m3(float8_e4m3_t *out, const float *inp, size_t nelems) {
+#if DNNL_X64
+    using namespace cpu::x64;
+    if (mayiuse(avx512_core)) {
+        static const jit_avx512_core_fp8_cvt_t kernel(
+                data_type::f8_e4m3, false);
+        return kernel(out, inp, nelems);
+    }
+#endif
+
+    PRAGMA_OMP_SIMD()
+    for (size_t i = 0; i < nelems; ++i)
+        out[i] = static_cast<float8_e4m3_t>(inp[i]);
+}
+
+} // namespace impl
+} // namespace dnnl
@@ -72,6 +72,45 @@ status_t ref_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
     const int bia_mask
             = utils::get_dims_mask(dst_d.dims(), bia_d.dims(), ndims);
 
+    // arg scales section
+    const auto &attr_scales = pd()->attr()->scales_;
+    const bool with_src_scales
+            = !attr_scales.get(DNNL_ARG_SRC).has_default_values();
+    const bool with_wei_scales
+            = !attr_scales.get(DNNL_ARG_WEIGHTS).has_default_values();
+    const bool with_dst_scales
+            = !attr_scales.get(DNNL_ARG_DST).has_default_values();
+    const auto &wei_attr_scales = attr_scales.get(DNNL_ARG_WEIGHTS);
+    const auto wei_scales_dt = wei_attr_scales.data_type_;
+    const dim_t wei_scale_stride_n
+            = (wei_attr_scales.mask_ & pd()->wei_qmask_N()) ? 1 : 0;
+    // group-wise weights scales are applied to the weights inside the
+    // reduction, the scales of a group along K are stored in a row of N
+    const bool with_wei_scales_groups
+            = with_wei_scales && !wei_attr_scales.has_default_groups();
+    const dim_t wei_scale_group_k
+            = with_wei_scales_groups ? wei_attr_scales.group_dims_[0] : K;
+    const dim_t wei_scale_stride_k = with_wei_scales_groups ? N : 0;
+
+    // weights zero points section
+    const auto &attr_zps = pd()->attr()->zero_points_;
+    const bool with_wei_zero_points
+            = !attr_zps.has_default_values(DNNL_ARG_WEIGHTS);
+    const auto wei_zero_points = CTX_IN_MEM(
+            const void *, DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_WEIGHTS);
+    if (with_wei_zero_points && wei_zero_points == nullptr)
+        return status::invalid_arguments;
+    int wei_zp_mask = 0;
+    attr_zps.get(DNNL_ARG_WEIGHTS, &wei_zp_mask);
+    const auto wei_zp_dt = attr_zps.get_data_type(DNNL_ARG_WEIGHTS);
+    const dim_t wei_zp_stride_n = (wei_zp_mask & pd()->wei_qmask_N()) ? 1 : 0;
+    const bool with_wei_zp_groups
+            = attr_zps.get_group_ndims(DNNL_ARG_WEIGHTS) > 0;
+    const dim_t wei_zp_group_k = with_wei_zp_groups
+            ? attr_zps.get_group_dims(DNNL_ARG_WEIGHTS)[0]
+            : K;
+    const dim_t wei_zp_stride_k = with_wei_zp_groups ? N : 0;
+
     // mm kernel
     auto ker = [&](const dims_t dst_dims_idx, dim_t m, dim_t n) {
         float acc = 0;
@@ -90,8 +129,19 @@ status_t ref_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
             const auto weights_off = weights_d.off_v(weights_dims_idx);
             const float s
                     = io::load_float_value(src_d.data_type(), src, src_off);
-            const float w = io::load_float_value(
+            float w = io::load_float_value(
                     weights_d.data_type(), weights, weights_off);
+            if (with_wei_zero_points) {
+                const dim_t zp_off = wei_zp_stride_k * (k / wei_zp_group_k)
+                        + wei_zp_stride_n * n;
+                w -= io::load_float_value(wei_zp_dt, wei_zero_points, zp_off);
+            }
+            if (with_wei_scales_groups) {
+                const dim_t scale_off
+                        = wei_scale_stride_k * (k / wei_scale_group_k)
+                        + wei_scale_stride_n * n;
+                w *= io::load_float_value(wei_scales_dt, wei_scales, scale_off);
+            }
             acc += s * w;
         }
         return acc;
@@ -105,17 +155,6 @@ status_t ref_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
         return io::load_float_value(bia_d.data_type(), bias, bias_off);
     };
 
-    // arg scales section
-    const auto &attr_scales = pd()->attr()->scales_;
-    const bool with_src_scales
-            = !attr_scales.get(DNNL_ARG_SRC).has_default_values();
-    const bool with_wei_scales
-            = !attr_scales.get(DNNL_ARG_WEIGHTS).has_default_values();
-    const bool with_dst_scales
-            = !attr_scales.get(DNNL_ARG_DST).has_default_values();
-    const dim_t wei_scale_stride
-            = attr_scales.get(DNNL_ARG_WEIGHTS).mask_ == 0 ? 0 : 1;
-
     auto sum_dt = pd()->attr()->post_ops_.get_sum_dt(dst_d.data_type());
 
     // computations
@@ -126,7 +165,9 @@ status_t ref_matmul_t::execute_ref(const exec_ctx_t &ctx) const {
         utils::l_dims_by_l_offset(dst_dims_idx, l_offset, dst_d.dims(), ndims);
         float d = ker(dst_dims_idx, m, n);
         if (with_src_scales) d *= src_scales[0];
-        if (with_wei_scales) d *= wei_scales[wei_scale_stride * n];
+        if (with_wei_scales && !with_wei_scales_groups)
+            d *= io::load_float_value(
+                    wei_scales_dt, wei_scales, wei_scale_stride_n * n);
         if (bias) d += ker_bias(dst_dims_idx);
 
         const auto dst_off = dst_d.off_v(dst_dims_idx);
@@ -49,29 +49,54 @@ struct ref_matmul_t : public primitive_t {
             const auto bia_type = weights_md(1)->data_type;
             const auto dst_type = dst_md(0)->data_type;
 
-            bool ok = is_dense_data() && utils::one_of(src_type, f32, bf16, f16)
-                    && utils::one_of(wei_type, f32, bf16, f16)
-                    && utils::one_of(dst_type, f32, bf16, f16)
-                    && src_type == wei_type
-                    && IMPLICATION(src_type == f32, dst_type == f32)
+            // The 4-bit integer weights are up-converted to the source type
+            // when requested by the fpmath mode attribute
+            const bool is_int4_decompression = utils::one_of(wei_type, s4, u4)
+                    && attr_.fpmath_apply_to_int_
+                    && utils::one_of(src_type, f32, bf16);
+
+            // The 8-bit floating point source and weights are computed in
+            // f32, the f8 weights may also come with a wider source
+            const bool is_f8 = utils::one_of(wei_type, f8_e5m2, f8_e4m3)
+                    && utils::one_of(
+                            src_type, f32, bf16, f16, f8_e5m2, f8_e4m3)
+                    && utils::one_of(
+                            dst_type, f32, bf16, f16, f8_e5m2, f8_e4m3);
+
+            bool ok = is_dense_data()
+                    && (utils::one_of(src_type, f32, bf16, f16) || is_f8)
+                    && (utils::one_of(wei_type, f32, bf16, f16)
+                            || is_int4_decompression || is_f8)
+                    && (utils::one_of(dst_type, f32, bf16, f16) || is_f8)
+                    && (src_type == wei_type || is_int4_decompression || is_f8)
+                    && IMPLICATION(src_type == f32 && !is_f8, dst_type == f32)
                     && IMPLICATION(src_type == bf16,
                             utils::one_of(dst_type, f32, bf16))
                     && IMPLICATION(
                             src_type == f16, utils::one_of(dst_type, f32, f16))
                     && IMPLICATION(with_bias(),
                             utils::one_of(bia_type, f32, bf16, f16)
-                                    && IMPLICATION(
-                                            src_type == f32, bia_type == f32)
+                                    && IMPLICATION(src_type == f32 && !is_f8,
+                                            bia_type == f32)
                                     && IMPLICATION(src_type == f16,
                                             utils::one_of(bia_type, f32, f16))
                                     && IMPLICATION(src_type == bf16,
                                             utils::one_of(bia_type, f32, bf16)))
                     && platform::has_data_type_support(src_type)
-                    && attr()->has_default_values(smask_t::scales_runtime
+                    && attr()->has_default_values(
+                            smask_t::scales_runtime_groups
+                                    | smask_t::scales_runtime_data_type
+                                    | smask_t::zero_points_runtime_groups
+                                    | smask_t::zero_points_runtime_data_type
                                     | smask_t::post_ops | smask_t::sum_dt,
                             dst_type)
                     && attr_.post_ops_.check_sum_consistent_dt(dst_type)
-                    && attr_scales_ok() && set_default_formats()
+                    && attr_scales_ok()
+                    // weights zero points are supported for decompression
+                    && IMPLICATION(!is_int4_decompression,
+                            attr()->zero_points_.has_default_values())
+                    && attr_wei_decomp_zero_points_ok()
+                    && set_default_formats()
                     && attr_.set_default_formats(dst_md(0)) == status::success;
             return ok ? status::success : status::unimplemented;
         }
@@ -48,7 +48,6 @@ status_t ref_matmul_int8_t::execute_ref(const exec_ctx_t &ctx) const {
     DEFINE_ARG_SCALES_BUFFER(dst_scales, DNNL_ARG_DST);
 
     DEFINE_ZERO_POINTS_BUFFER(src_zero_point, DNNL_ARG_SRC);
-    DEFINE_ZERO_POINT_VALUE(weights_zero_point, DNNL_ARG_WEIGHTS);
     DEFINE_ZERO_POINTS_BUFFER(dst_zero_point, DNNL_ARG_DST);
 
     const auto src_d = ctx.memory_mdw(DNNL_ARG_SRC, pd()->src_md());
@@ -83,9 +82,52 @@ status_t ref_matmul_int8_t::execute_ref(const exec_ctx_t &ctx) const {
     const int dst_zp_idx_mult
             = !pd()->attr()->zero_points_.common(DNNL_ARG_DST);
 
+    // arg scales section
+    const auto &attr_scales = pd()->attr()->scales_;
+    const bool with_src_scales
+            = !attr_scales.get(DNNL_ARG_SRC).has_default_values();
+    const bool with_wei_scales
+            = !attr_scales.get(DNNL_ARG_WEIGHTS).has_default_values();
+    const bool with_dst_scales
+            = !attr_scales.get(DNNL_ARG_DST).has_default_values();
+    const auto &wei_attr_scales = attr_scales.get(DNNL_ARG_WEIGHTS);
+    const auto wei_scales_dt = wei_attr_scales.data_type_;
+    const dim_t wei_scale_stride_n
+            = (wei_attr_scales.mask_ & pd()->wei_qmask_N()) ? 1 : 0;
+    // group-wise weights scales are applied to the partial sums of the
+    // groups along K, the scales of a group are stored in a row of N
+    const bool with_wei_scales_groups
+            = with_wei_scales && !wei_attr_scales.has_default_groups();
+    const dim_t wei_scale_group_k
+            = with_wei_scales_groups ? wei_attr_scales.group_dims_[0] : K;
+    const dim_t wei_scale_stride_k = with_wei_scales_groups ? N : 0;
+
+    // weights zero points section
+    const auto &attr_zps = pd()->attr()->zero_points_;
+    const bool with_wei_zero_points
+            = !attr_zps.has_default_values(DNNL_ARG_WEIGHTS);
+    const auto wei_zero_points = CTX_IN_MEM(
+            const void *, DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_WEIGHTS);
+    if (with_wei_zero_points && wei_zero_points == nullptr)
+        return status::invalid_arguments;
+    int wei_zp_mask = 0;
+    attr_zps.get(DNNL_ARG_WEIGHTS, &wei_zp_mask);
+    const auto wei_zp_dt = attr_zps.get_data_type(DNNL_ARG_WEIGHTS);
+    const dim_t wei_zp_stride_n = (wei_zp_mask & pd()->wei_qmask_N()) ? 1 : 0;
+    const bool with_wei_zp_groups
+            = attr_zps.get_group_ndims(DNNL_ARG_WEIGHTS) > 0;
+    const dim_t wei_zp_group_k = with_wei_zp_groups
+            ? attr_zps.get_group_dims(DNNL_ARG_WEIGHTS)[0]
+            : K;
+    const dim_t wei_zp_stride_k = with_wei_zp_groups ? N : 0;
+
     // mm kernel
     auto ker = [&](const dims_t dst_dims_idx, dim_t m, dim_t n) {
-        int acc = 0;
+        // the integer sum of a group of the weights scales is converted and
+        // scaled at the end of the group, there is a single group without
+        // group-wise scales
+        float acc = 0;
+        int group_acc = 0;
         dims_t src_dims_idx, weights_dims_idx;
         utils::copy_dims_with_mask(src_dims_idx, dst_dims_idx, ndims, src_mask);
         utils::copy_dims_with_mask(
@@ -107,8 +149,24 @@ status_t ref_matmul_int8_t::execute_ref(const exec_ctx_t &ctx) const {
                         data_type::s32, src_zero_point, src_zp_idx_mult * k);
                 s -= src_zp;
             }
-            if (weights_zero_point) { w -= weights_zero_point; }
-            acc += s * w;
+            if (with_wei_zero_points) {
+                const dim_t zp_off = wei_zp_stride_k * (k / wei_zp_group_k)
+                        + wei_zp_stride_n * n;
+                w -= io::load_int_value(wei_zp_dt, wei_zero_points, zp_off);
+            }
+            group_acc += s * w;
+            if ((k + 1) % wei_scale_group_k == 0 || k + 1 == K) {
+                float group_scale = 1.f;
+                if (with_wei_scales_groups) {
+                    const dim_t scale_off
+                            = wei_scale_stride_k * (k / wei_scale_group_k)
+                            + wei_scale_stride_n * n;
+                    group_scale = io::load_float_value(
+                            wei_scales_dt, wei_scales, scale_off);
+                }
+                acc += static_cast<float>(group_acc) * group_scale;
+                group_acc = 0;
+            }
         }
         return acc;
     };
@@ -121,17 +179,6 @@ status_t ref_matmul_int8_t::execute_ref(const exec_ctx_t &ctx) const {
         return io::load_float_value(bia_d.data_type(), bias, bias_off);
     };
 
-    // arg scales section
-    const auto &attr_scales = pd()->attr()->scales_;
-    const bool with_src_scales
-            = !attr_scales.get(DNNL_ARG_SRC).has_default_values();
-    const bool with_wei_scales
-            = !attr_scales.get(DNNL_ARG_WEIGHTS).has_default_values();
-    const bool with_dst_scales
-            = !attr_scales.get(DNNL_ARG_DST).has_default_values();
-    const dim_t wei_scale_stride
-            = attr_scales.get(DNNL_ARG_WEIGHTS).mask_ == 0 ? 0 : 1;
-
     auto sum_dt = pd()->attr()->post_ops_.get_sum_dt(dst_d.data_type());
 
     // computations
@@ -140,10 +187,11 @@ status_t ref_matmul_int8_t::execute_ref(const exec_ctx_t &ctx) const {
         // account for M, N dims for index calculations
         const size_t l_offset = mb * M * N + m * N + n;
         utils::l_dims_by_l_offset(dst_dims_idx, l_offset, dst_d.dims(), ndims);
-        int acc = ker(dst_dims_idx, m, n);
-        float d = static_cast<int>(acc);
+        float d = ker(dst_dims_idx, m, n);
         if (with_src_scales) d *= src_scales[0];
-        if (with_wei_scales) d *= wei_scales[wei_scale_stride * n];
+        if (with_wei_scales && !with_wei_scales_groups)
+            d *= io::load_float_value(
+                    wei_scales_dt, wei_scales, wei_scale_stride_n * n);
         if (bias) d += ker_bias(dst_dims_idx);
 
         const auto dst_off = dst_d.off_v(dst_dims_idx);
@@ -52,8 +52,11 @@ struct ref_matmul_int8_t : public primitive_t {
                     && IMPLICATION(with_bias(),
                             utils::one_of(bia_type, f32, bf16, s32, s8, u8))
                     && utils::one_of(dst_type, f32, bf16, s32, s8, u8)
-                    && attr()->has_default_values(smask_t::scales_runtime
-                                    | smask_t::zero_points_runtime
+                    && attr()->has_default_values(
+                            smask_t::scales_runtime_groups
+                                    | smask_t::scales_runtime_data_type
+                                    | smask_t::zero_points_runtime_groups
+                                    | smask_t::zero_points_runtime_data_type
                                     | smask_t::post_ops | smask_t::sum_dt,
                             dst_type)
                     && attr_.post_ops_.check_sum_consistent_dt(dst_type)
@@ -65,13 +68,12 @@ struct ref_matmul_int8_t : public primitive_t {
 
     private:
         bool attr_zero_points_ok() const {
-            int mask_src = 0, mask_wei = 0, mask_dst = 0;
+            int mask_src = 0, mask_dst = 0;
             attr()->zero_points_.get(DNNL_ARG_SRC, &mask_src);
-            attr()->zero_points_.get(DNNL_ARG_WEIGHTS, &mask_wei);
             attr()->zero_points_.get(DNNL_ARG_DST, &mask_dst);
 
             return (mask_src == 0 || (ndims() == 2 && mask_src == 1 << 1))
-                    && (mask_wei == 0)
+                    && attr_wei_zero_points_ok()
                     && (mask_dst == 0 || (ndims() == 2 && mask_dst == 1 << 1));
         }
     };
@@ -269,6 +269,8 @@ status_t ref_eltwise_bwd_t<data_type>::execute_backward_dense(
 template struct ref_eltwise_fwd_t<data_type::f32>;
 template struct ref_eltwise_fwd_t<data_type::bf16>;
 template struct ref_eltwise_fwd_t<data_type::f16>;
+template struct ref_eltwise_fwd_t<data_type::f8_e5m2>;
+template struct ref_eltwise_fwd_t<data_type::f8_e4m3>;
 template struct ref_eltwise_fwd_t<data_type::s32>;
 template struct ref_eltwise_fwd_t<data_type::s8>;
 template struct ref_eltwise_fwd_t<data_type::u8>;
@@ -0,0 +1,272 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include <math.h>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+#include "cpu/ref_group_normalization.hpp"
+#include "cpu/ref_io_helper.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+status_t ref_group_normalization_fwd_t::execute_forward(
+        const exec_ctx_t &ctx) const {
+    status_t status = status::success;
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    const memory_desc_wrapper stat_d(pd()->stat_md());
+    const memory_desc_wrapper sc_d(pd()->weights_md());
+
+    auto src = CTX_IN_MEM(const void *, DNNL_ARG_SRC);
+    auto scale = CTX_IN_MEM(const float *, DNNL_ARG_SCALE);
+    auto shift = CTX_IN_MEM(const float *, DNNL_ARG_SHIFT);
+    auto mean = pd()->stats_is_src()
+            ? const_cast<float *>(CTX_IN_MEM(const float *, DNNL_ARG_MEAN))
+            : CTX_OUT_CLEAN_MEM(float *, DNNL_ARG_MEAN, status);
+    CHECK(status);
+    auto variance = pd()->stats_is_src()
+            ? const_cast<float *>(CTX_IN_MEM(const float *, DNNL_ARG_VARIANCE))
+            : CTX_OUT_CLEAN_MEM(float *, DNNL_ARG_VARIANCE, status);
+    CHECK(status);
+    auto dst = CTX_OUT_CLEAN_MEM(void *, DNNL_ARG_DST, status);
+    CHECK(status);
+
+    const dim_t MB = pd()->MB();
+    const dim_t C = pd()->C();
+    const dim_t G = pd()->G();
+    const dim_t C_PER_G = pd()->C_PER_G();
+    const dim_t SP = pd()->D() * pd()->H() * pd()->W();
+
+    const float eps = pd()->desc()->group_norm_epsilon;
+    const bool save_stats = pd()->is_training();
+    const bool calculate_stats = !pd()->stats_is_src();
+
+    /* fast return */
+    if (pd()->has_zero_dim_memory()) {
+        if (calculate_stats && save_stats) {
+            for_(dim_t n = 0; n < MB; n++)
+            for (dim_t g = 0; g < G; g++) {
+                mean[stat_d.off(n, g)] = 0;
+                variance[stat_d.off(n, g)] = 0;
+            }
+        }
+        return status::success;
+    }
+
+    // The logical offset of the point `sp` of the channel `c` of the sample
+    // `n`, the same for all the tensors
+    const auto l_off = [&](dim_t n, dim_t c, dim_t sp) {
+        return (n * C + c) * SP + sp;
+    };
+
+    parallel_nd(MB, G, [&](dim_t n, dim_t g) {
+        const dim_t s_off = stat_d.off(n, g);
+        const dim_t c_start = g * C_PER_G;
+        float v_mean = calculate_stats ? 0 : mean[s_off];
+        float v_variance = calculate_stats ? 0 : variance[s_off];
+
+        if (calculate_stats) {
+            for_(dim_t c = c_start; c < c_start + C_PER_G; c++)
+            for (dim_t sp = 0; sp < SP; sp++) {
+                v_mean += io::load_float_value(src_d.data_type(), src,
+                        src_d.off_l(l_off(n, c, sp)));
+            }
+            v_mean /= C_PER_G * SP;
+
+            for_(dim_t c = c_start; c < c_start + C_PER_G; c++)
+            for (dim_t sp = 0; sp < SP; sp++) {
+                const float m = io::load_float_value(src_d.data_type(), src,
+                                        src_d.off_l(l_off(n, c, sp)))
+                        - v_mean;
+                v_variance += m * m;
+            }
+            v_variance /= C_PER_G * SP;
+        }
+
+        const float sqrt_variance = sqrtf(v_variance + eps);
+        for (dim_t c = c_start; c < c_start + C_PER_G; c++) {
+            const float sm = (scale ? scale[sc_d.off(c)] : 1.f) / sqrt_variance;
+            const float sv = shift ? shift[sc_d.off(c)] : 0;
+            for (dim_t sp = 0; sp < SP; sp++) {
+                const dim_t l_offset = l_off(n, c, sp);
+                const float s = io::load_float_value(
+                        src_d.data_type(), src, src_d.off_l(l_offset));
+                float d = sm * (s - v_mean) + sv;
+
+                ref_post_ops_t::args_t args;
+                args.ctx = &ctx;
+                args.l_offset = l_offset;
+                args.dst_md = pd()->dst_md();
+                ref_post_ops_->execute(d, args);
+
+                io::store_float_value(
+                        dst_d.data_type(), d, dst, dst_d.off_l(l_offset));
+            }
+        }
+
+        if (calculate_stats && save_stats) {
+            mean[s_off] = v_mean;
+            variance[s_off] = v_variance;
+        }
+    });
+    return status::success;
+}
+
+status_t ref_group_normalization_bwd_t::execute_backward(
+        const exec_ctx_t &ctx) const {
+    status_t status = status::success;
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper stat_d(pd()->stat_md());
+    const memory_desc_wrapper diff_src_d(pd()->diff_src_md());
+    const memory_desc_wrapper diff_dst_d(pd()->diff_dst_md());
+    const memory_desc_wrapper sc_d(pd()->weights_md());
+    const memory_desc_wrapper diff_sc_d(pd()->diff_weights_md());
+
+    const auto use_scale = pd()->use_scale();
+    const auto use_shift = pd()->use_shift();
+
+    auto src = CTX_IN_MEM(const void *, DNNL_ARG_SRC);
+    auto mean = CTX_IN_MEM(const float *, DNNL_ARG_MEAN);
+    auto variance = CTX_IN_MEM(const float *, DNNL_ARG_VARIANCE);
+    auto diff_dst = CTX_IN_MEM(const void *, DNNL_ARG_DIFF_DST);
+    auto scale = CTX_IN_MEM(const float *, DNNL_ARG_SCALE);
+    auto diff_src = CTX_OUT_CLEAN_MEM(void *, DNNL_ARG_DIFF_SRC, status);
+    CHECK(status);
+
+    auto diff_scale = use_scale
+            ? CTX_OUT_CLEAN_MEM(float *, DNNL_ARG_DIFF_SCALE, status)
+            : nullptr;
+    CHECK(status);
+    auto diff_shift = use_shift
+            ? CTX_OUT_CLEAN_MEM(float *, DNNL_ARG_DIFF_SHIFT, status)
+            : nullptr;
+    CHECK(status);
+
+    const dim_t MB = pd()->MB();
+    const dim_t C = pd()->C();
+    const dim_t G = pd()->G();
+    const dim_t C_PER_G = pd()->C_PER_G();
+    const dim_t SP = pd()->D() * pd()->H() * pd()->W();
+
+    /* fast return */
+    if (pd()->has_zero_dim_memory()) {
+        if (diff_scale) {
+            for (dim_t c = 0; c < C; ++c) {
+                diff_scale[diff_sc_d.off(c)] = 0;
+            }
+        }
+        if (diff_shift) {
+            for (dim_t c = 0; c < C; ++c) {
+                diff_shift[diff_sc_d.off(c)] = 0;
+            }
+        }
+        return status::success;
+    }
+
+    const float eps = pd()->desc()->group_norm_epsilon;
+    const bool calculate_diff_stats = !pd()->use_global_stats();
+
+    const auto l_off = [&](dim_t n, dim_t c, dim_t sp) {
+        return (n * C + c) * SP + sp;
+    };
+
+    if (diff_scale || diff_shift) {
+        parallel_nd(C, [&](dim_t c) {
+            const dim_t g = c / C_PER_G;
+            float diff_gamma = 0.f;
+            float diff_beta = 0.f;
+
+            for (dim_t n = 0; n < MB; ++n) {
+                const dim_t s_off = stat_d.off(n, g);
+                const float inv_sqrt_variance
+                        = 1.f / sqrtf(variance[s_off] + eps);
+                for (dim_t sp = 0; sp < SP; ++sp) {
+                    const dim_t l_offset = l_off(n, c, sp);
+                    const float s = io::load_float_value(
+                            src_d.data_type(), src, src_d.off_l(l_offset));
+                    const float dd = io::load_float_value(diff_dst_d.data_type(),
+                            diff_dst, diff_dst_d.off_l(l_offset));
+                    diff_gamma += (s - mean[s_off]) * dd * inv_sqrt_variance;
+                    diff_beta += dd;
+                }
+            }
+
+            if (diff_scale) diff_scale[diff_sc_d.off(c)] = diff_gamma;
+            if (diff_shift) diff_shift[diff_sc_d.off(c)] = diff_beta;
+        });
+    }
+
+    parallel_nd(MB, G, [&](dim_t n, dim_t g) {
+        const dim_t s_off = stat_d.off(n, g);
+        const dim_t c_start = g * C_PER_G;
+        const float inv_sqrt_variance = 1.f / sqrtf(variance[s_off] + eps);
+        const dim_t group_size = C_PER_G * SP;
+
+        float dd_gamma = 0.f;
+        float dd_gamma_x = 0.f;
+        if (calculate_diff_stats) {
+            for (dim_t c = c_start; c < c_start + C_PER_G; c++) {
+                const float gamma = scale ? scale[sc_d.off(c)] : 1.f;
+                for (dim_t sp = 0; sp < SP; sp++) {
+                    const dim_t l_offset = l_off(n, c, sp);
+                    const float s = io::load_float_value(
+                            src_d.data_type(), src, src_d.off_l(l_offset));
+                    const float dd = io::load_float_value(diff_dst_d.data_type(),
+                            diff_dst, diff_dst_d.off_l(l_offset));
+                    dd_gamma += dd * gamma;
+                    dd_gamma_x += dd * gamma * (s - mean[s_off]);
+                }
+            }
+            dd_gamma_x *= inv_sqrt_variance;
+        }
+
+        for (dim_t c = c_start; c < c_start + C_PER_G; c++) {
+            const float gamma = scale ? scale[sc_d.off(c)] : 1.f;
+            for (dim_t sp = 0; sp < SP; sp++) {
+                const dim_t l_offset = l_off(n, c, sp);
+                const float dd = io::load_float_value(diff_dst_d.data_type(),
+                        diff_dst, diff_dst_d.off_l(l_offset));
+                float d_src = dd * gamma;
+                if (calculate_diff_stats) {
+                    const float s = io::load_float_value(
+                            src_d.data_type(), src, src_d.off_l(l_offset));
+                    d_src -= dd_gamma / group_size;
+                    d_src -= (s - mean[s_off]) * dd_gamma_x * inv_sqrt_variance
+                            / group_size;
+                }
+                d_src *= inv_sqrt_variance;
+                io::store_float_value(diff_src_d.data_type(), d_src, diff_src,
+                        diff_src_d.off_l(l_offset));
+            }
+        }
+    });
+    return status::success;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
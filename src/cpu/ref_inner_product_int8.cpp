@@ -50,27 +50,6 @@ status_t ref_inner_product_int8_fwd_t::execute_forward(
 
     const auto ndims = pd()->ndims();
 
-    auto ker = [=](dim_t mb, dim_t oc) {
-        int d = 0;
-        const dim_t KD = pd()->KD();
-        const dim_t KH = pd()->KH();
-        const dim_t KW = pd()->KW();
-        for_(dim_t ic = 0; ic < IC; ++ic)
-        for_(dim_t kd = 0; kd < KD; ++kd)
-        for_(dim_t kh = 0; kh < KH; ++kh)
-        for (dim_t kw = 0; kw < KW; ++kw) {
-            const auto src_off = ref_ip_utils::get_data_off(
-                    src_d, ndims, mb, ic, kd, kh, kw);
-            const auto wei_off = ref_ip_utils::get_weights_off(
-                    weights_d, ndims, oc, ic, kd, kh, kw);
-            const int s = io::load_int_value(src_d.data_type(), src, src_off);
-            const int w = io::load_int_value(
-                    weights_d.data_type(), weights, wei_off);
-            d += s * w;
-        }
-        return d;
-    };
-
     DEFINE_ARG_SCALES_BUFFER(src_scales, DNNL_ARG_SRC);
     DEFINE_ARG_SCALES_BUFFER(wei_scales, DNNL_ARG_WEIGHTS);
     DEFINE_ARG_SCALES_BUFFER(dst_scales, DNNL_ARG_DST);
@@ -78,18 +57,85 @@ status_t ref_inner_product_int8_fwd_t::execute_forward(
     const auto &attr_scales = pd()->attr()->scales_;
     const bool with_dst_scales
             = !attr_scales.get(DNNL_ARG_DST).has_default_values();
+    const auto &wei_attr_scales = attr_scales.get(DNNL_ARG_WEIGHTS);
+    const auto wei_scales_dt = wei_attr_scales.data_type_;
+    // group-wise weights scales are applied to the partial sums of the
+    // groups along IC, the scales of an output channel are stored in a row
+    const bool with_wei_scales_groups = !wei_attr_scales.has_default_groups();
+    const dim_t wei_scale_group_ic
+            = with_wei_scales_groups ? wei_attr_scales.group_dims_[1] : IC;
+    const dim_t wei_scale_stride_oc = with_wei_scales_groups
+            ? IC / wei_scale_group_ic
+            : (wei_attr_scales.mask_ & pd()->wei_qmask_OC()) ? 1 : 0;
+
+    const auto &attr_zps = pd()->attr()->zero_points_;
+    const bool with_wei_zero_points
+            = !attr_zps.has_default_values(DNNL_ARG_WEIGHTS);
+    const auto wei_zero_points = CTX_IN_MEM(
+            const void *, DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_WEIGHTS);
+    if (with_wei_zero_points && wei_zero_points == nullptr)
+        return status::invalid_arguments;
+    int wei_zp_mask = 0;
+    attr_zps.get(DNNL_ARG_WEIGHTS, &wei_zp_mask);
+    const auto wei_zp_dt = attr_zps.get_data_type(DNNL_ARG_WEIGHTS);
+    const bool with_wei_zp_groups
+            = attr_zps.get_group_ndims(DNNL_ARG_WEIGHTS) > 0;
+    const dim_t wei_zp_group_ic = with_wei_zp_groups
+            ? attr_zps.get_group_dims(DNNL_ARG_WEIGHTS)[1]
+            : IC;
+    const dim_t wei_zp_stride_oc = with_wei_zp_groups
+            ? IC / wei_zp_group_ic
+            : (wei_zp_mask & pd()->wei_qmask_OC()) ? 1 : 0;
+
+    auto ker = [=](dim_t mb, dim_t oc) {
+        // the integer sum of a group of the weights scales is converted and
+        // scaled at the end of the group, there is a single group without
+        // group-wise scales
+        float d = 0;
+        int group_d = 0;
+        const dim_t KD = pd()->KD();
+        const dim_t KH = pd()->KH();
+        const dim_t KW = pd()->KW();
+        for (dim_t ic = 0; ic < IC; ++ic) {
+            const int zp = with_wei_zero_points
+                    ? io::load_int_value(wei_zp_dt, wei_zero_points,
+                            wei_zp_stride_oc * oc + ic / wei_zp_group_ic)
+                    : 0;
+            for_(dim_t kd = 0; kd < KD; ++kd)
+            for_(dim_t kh = 0; kh < KH; ++kh)
+            for (dim_t kw = 0; kw < KW; ++kw) {
+                const auto src_off = ref_ip_utils::get_data_off(
+                        src_d, ndims, mb, ic, kd, kh, kw);
+                const auto wei_off = ref_ip_utils::get_weights_off(
+                        weights_d, ndims, oc, ic, kd, kh, kw);
+                const int s
+                        = io::load_int_value(src_d.data_type(), src, src_off);
+                const int w = io::load_int_value(
+                        weights_d.data_type(), weights, wei_off);
+                group_d += s * (w - zp);
+            }
+            if ((ic + 1) % wei_scale_group_ic == 0 || ic + 1 == IC) {
+                const float group_scale = with_wei_scales_groups
+                        ? io::load_float_value(wei_scales_dt, wei_scales,
+                                wei_scale_stride_oc * oc
+                                        + ic / wei_scale_group_ic)
+                        : 1.f;
+                d += static_cast<float>(group_d) * group_scale;
+                group_d = 0;
+            }
+        }
+        return d;
+    };
 
     auto maybe_oscale = [=](float &d, dim_t oc) {
-        // scale_idx_mult = 1 for per_oc scales and 0, otherwise
-        const int scale_idx_mult
-                = attr_scales.get(DNNL_ARG_WEIGHTS).mask_ == (1 << 0);
-        d *= src_scales[0] * wei_scales[oc * scale_idx_mult];
+        d *= src_scales[0];
+        if (!with_wei_scales_groups)
+            d *= io::load_float_value(
+                    wei_scales_dt, wei_scales, wei_scale_stride_oc * oc);
     };
 
     parallel_nd(MB, OC, [&](dim_t mb, dim_t oc) {
-        int acc = ker(mb, oc);
-
-        float d = acc;
+        float d = ker(mb, oc);
         maybe_oscale(d, oc);
 
         if (bias) {
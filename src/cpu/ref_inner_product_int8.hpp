@@ -56,10 +56,14 @@ struct ref_inner_product_int8_fwd_t : public primitive_t {
                             platform::has_data_type_support(bia_type))
                     && platform::has_data_type_support(dst_type)
                     && set_default_params(allow_all_tags) == status::success
-                    && attr()->has_default_values(smask_t::scales_runtime
-                            | smask_t::post_ops | smask_t::sum_dt)
+                    && attr()->has_default_values(
+                            smask_t::scales_runtime_groups
+                                    | smask_t::scales_runtime_data_type
+                                    | smask_t::zero_points_runtime_groups
+                                    | smask_t::zero_points_runtime_data_type
+                                    | smask_t::post_ops | smask_t::sum_dt)
                     && attr()->post_ops_.check_sum_consistent_dt(dst_type)
-                    && attr_scales_ok()
+                    && attr_scales_ok() && attr_wei_zero_points_ok()
                     && attr_.set_default_formats(dst_md(0)) == status::success;
             return ok ? status::success : status::unimplemented;
         }
@@ -42,6 +42,15 @@ inline int load_int_value(data_type_t dt, const void *ptr, dim_t idx) {
         CASE(s32);
         CASE(s8);
         CASE(u8);
+        // two 4-bit values are packed into a byte, idx is the value index
+        case s4: {
+            const uint8_t byte = static_cast<const uint8_t *>(ptr)[idx / 2];
+            return static_cast<int>(int4_t::extract(byte, idx % 2));
+        }
+        case u4: {
+            const uint8_t byte = static_cast<const uint8_t *>(ptr)[idx / 2];
+            return static_cast<int>(uint4_t::extract(byte, idx % 2));
+        }
         default: assert(!"bad data_type");
     }
 
@@ -61,10 +70,21 @@ inline float load_float_value(data_type_t dt, const void *ptr, dim_t idx) {
     switch (dt) {
         CASE(bf16);
         CASE(f16);
+        CASE(f8_e5m2);
+        CASE(f8_e4m3);
         CASE(f32);
         CASE(s32);
         CASE(s8);
         CASE(u8);
+        // two 4-bit values are packed into a byte, idx is the value index
+        case s4: {
+            const uint8_t byte = static_cast<const uint8_t *>(ptr)[idx / 2];
+            return static_cast<float>(int4_t::extract(byte, idx % 2));
+        }
+        case u4: {
+            const uint8_t byte = static_cast<const uint8_t *>(ptr)[idx / 2];
+            return static_cast<float>(uint4_t::extract(byte, idx % 2));
+        }
         default: assert(!"bad data_type");
     }
 
@@ -85,10 +105,22 @@ inline void store_float_value(data_type_t dt, float val, void *ptr, dim_t idx) {
     switch (dt) {
         CASE(bf16);
         CASE(f16);
+        CASE(f8_e5m2);
+        CASE(f8_e4m3);
         CASE(f32);
         CASE(s32);
         CASE(s8);
         CASE(u8);
+        // the neighbouring value sharing the byte is preserved, so stores to
+        // the two halves of a byte must not be done concurrently
+        case s4: {
+            uint8_t &byte = static_cast<uint8_t *>(ptr)[idx / 2];
+            byte = int4_t(val).insert(byte, idx % 2);
+        } break;
+        case u4: {
+            uint8_t &byte = static_cast<uint8_t *>(ptr)[idx / 2];
+            byte = uint4_t(val).insert(byte, idx % 2);
+        } break;
         default: assert(!"bad data_type");
     }
 
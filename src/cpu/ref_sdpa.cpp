@@ -0,0 +1,134 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <math.h>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/nstl.hpp"
+
+#include "cpu/ref_io_helper.hpp"
+#include "cpu/ref_sdpa.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+status_t ref_sdpa_t::execute_ref(const exec_ctx_t &ctx) const {
+    using namespace memory_tracking::names;
+
+    const auto q = CTX_IN_MEM(const void *, DNNL_ARG_QUERIES);
+    const auto k = CTX_IN_MEM(const void *, DNNL_ARG_KEYS);
+    const auto v = CTX_IN_MEM(const void *, DNNL_ARG_VALUES);
+    const auto msk = CTX_IN_MEM(const void *, DNNL_ARG_ATTN_MASK);
+    const auto scale_ptr = CTX_IN_MEM(const void *, DNNL_ARG_SCALE);
+    const auto page_table = CTX_IN_MEM(const int32_t *, DNNL_ARG_PAGE_TABLE);
+    auto dst = CTX_OUT_MEM(void *, DNNL_ARG_DST);
+
+    const sdpa_desc_t *d = pd()->desc();
+    const int nd = d->ndims();
+    const dim_t M = d->queries();
+    const dim_t D = d->head_size();
+    const dim_t N = d->keys();
+    const dim_t DV = d->values();
+
+    const auto &q_md = d->q_desc;
+    const auto &k_md = d->k_desc;
+    const auto &v_md = d->v_desc;
+    const auto &msk_md = d->attn_mask_desc;
+    const auto &dst_md = d->dst_desc;
+    const data_type_t dt = q_md.data_type;
+    const data_type_t msk_dt = msk_md.data_type;
+
+    const dim_t q_stride_m = pd_t::stride(q_md, nd - 2);
+    const dim_t k_stride_d = pd_t::stride(k_md, nd - 2);
+    const dim_t dst_stride_m = pd_t::stride(dst_md, nd - 2);
+
+    const bool with_msk = pd()->with_attn_mask();
+    const dim_t msk_stride_m = with_msk ? pd_t::stride(msk_md, nd - 2) : 0;
+    const dim_t msk_stride_n = with_msk ? pd_t::stride(msk_md, nd - 1) : 0;
+
+    const bool with_scale = pd()->with_scale();
+    const float scale = with_scale
+            ? io::load_float_value(d->scale_dt, scale_ptr, 0)
+            : 1.f;
+    const bool invert_scale = d->invert_scale;
+    const bool causal = pd()->with_causal_mask();
+
+    float *scratch_scores
+            = ctx.get_scratchpad_grantor().template get<float>(key_sdpa_scores);
+
+    parallel(0, [&](int ithr, int nthr) {
+        float *s = scratch_scores + ithr * (N + DV);
+        float *acc = s + N;
+        for_nd(ithr, nthr, d->batch(), M, [&](dim_t b, dim_t m) {
+            const dim_t q_off = pd()->batch_off(q_md, b) + m * q_stride_m;
+            const dim_t dst_off = pd()->batch_off(dst_md, b) + m * dst_stride_m;
+            const dim_t msk_off = with_msk
+                    ? pd()->batch_off(msk_md, b) + m * msk_stride_m
+                    : 0;
+
+            float max_s = -INFINITY;
+            for (dim_t n = 0; n < N; n++) {
+                const dim_t k_off
+                        = pd()->key_off(k_md, nd - 1, b, n, page_table);
+                float score = 0.f;
+                for (dim_t dd = 0; dd < D; dd++) {
+                    score += io::load_float_value(dt, q, q_off + dd)
+                            * io::load_float_value(
+                                    dt, k, k_off + dd * k_stride_d);
+                }
+                if (with_scale)
+                    score = invert_scale ? score / scale : score * scale;
+                if (with_msk)
+                    score += io::load_float_value(
+                            msk_dt, msk, msk_off + n * msk_stride_n);
+                if (causal && n > m) score = -INFINITY;
+                s[n] = score;
+                max_s = nstl::max(max_s, score);
+            }
+
+            if (max_s == -INFINITY) {
+                for (dim_t dv = 0; dv < DV; dv++)
+                    io::store_float_value(dt, 0.f, dst, dst_off + dv);
+                return;
+            }
+
+            float sum = 0.f;
+            for (dim_t n = 0; n < N; n++) {
+                s[n] = expf(s[n] - max_s);
+                sum += s[n];
+            }
+
+            for (dim_t dv = 0; dv < DV; dv++)
+                acc[dv] = 0.f;
+            for (dim_t n = 0; n < N; n++) {
+                const dim_t v_off
+                        = pd()->key_off(v_md, nd - 2, b, n, page_table);
+                for (dim_t dv = 0; dv < DV; dv++)
+                    acc[dv] += s[n] * io::load_float_value(dt, v, v_off + dv);
+            }
+            for (dim_t dv = 0; dv < DV; dv++)
+                io::store_float_value(dt, acc[dv] / sum, dst, dst_off + dv);
+        });
+    });
+
+    return status::success;
+}
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
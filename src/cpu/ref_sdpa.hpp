@@ -0,0 +1,90 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_REF_SDPA_HPP
+#define CPU_REF_SDPA_HPP
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/primitive.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_sdpa_pd.hpp"
+#include "cpu/platform.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+
+// Computes the attention row by row: the scores of a query are computed,
+// normalized and multiplied by the values. The rows whose keys are all
+// masked out are set to zero. The keys and the values may be paged.
+struct ref_sdpa_t : public primitive_t {
+    struct pd_t : public cpu_sdpa_pd_t {
+        using cpu_sdpa_pd_t::cpu_sdpa_pd_t;
+
+        DECLARE_COMMON_PD_T("ref:any", ref_sdpa_t);
+
+        status_t init(engine_t *engine) {
+            using namespace data_type;
+
+            const data_type_t dt = desc()->q_desc.data_type;
+            bool ok = utils::one_of(dt, f32, bf16, f16)
+                    && platform::has_data_type_support(dt)
+                    && utils::everyone_is(dt, desc()->k_desc.data_type,
+                            desc()->v_desc.data_type,
+                            desc()->dst_desc.data_type)
+                    && IMPLICATION(with_attn_mask(),
+                            utils::one_of(desc()->attn_mask_desc.data_type,
+                                    f32, dt))
+                    && IMPLICATION(with_scale(),
+                            utils::one_of(desc()->scale_dt, f32, dt))
+                    && attr()->has_default_values()
+                    && init_formats_and_dims();
+            if (!ok) return status::unimplemented;
+
+            init_scratchpad();
+            return status::success;
+        }
+
+    private:
+        void init_scratchpad() {
+            auto scratchpad = scratchpad_registry().registrar();
+            scratchpad.template book<float>(
+                    memory_tracking::names::key_sdpa_scores,
+                    (desc()->keys() + desc()->values())
+                            * dnnl_get_max_threads());
+        }
+    };
+
+    ref_sdpa_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t execute(const exec_ctx_t &ctx) const override {
+        return execute_ref(ctx);
+    }
+
+private:
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+    status_t execute_ref(const exec_ctx_t &ctx) const;
+};
+
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -55,7 +55,7 @@ struct reorder_impl_key_t {
     }
 
 private:
-    enum { MAX_DT_NUM = 10 };
+    enum { MAX_DT_NUM = 16 };
     size_t value() const {
         return ((size_t)ndims * MAX_DT_NUM + (size_t)src_dt) * MAX_DT_NUM
                 + (size_t)dst_dt;
@@ -77,6 +77,14 @@ extern const impl_list_map_t &regular_f16_impl_list_map();
 extern const impl_list_map_t &regular_s32_impl_list_map();
 extern const impl_list_map_t &regular_s8_impl_list_map();
 extern const impl_list_map_t &regular_u8_impl_list_map();
+extern const impl_list_map_t &regular_f32_s4_impl_list_map();
+extern const impl_list_map_t &regular_f32_u4_impl_list_map();
+extern const impl_list_map_t &regular_s4_impl_list_map();
+extern const impl_list_map_t &regular_u4_impl_list_map();
+extern const impl_list_map_t &regular_f32_f8_e5m2_impl_list_map();
+extern const impl_list_map_t &regular_f32_f8_e4m3_impl_list_map();
+extern const impl_list_map_t &regular_f8_e5m2_impl_list_map();
+extern const impl_list_map_t &regular_f8_e4m3_impl_list_map();
 
 /* conv reorders w/ compensation */
 extern const impl_list_map_t &comp_f32_s8_impl_list_map();
@@ -31,6 +31,7 @@
 #include "common/utils.hpp"
 
 #include "cpu/cpu_primitive.hpp"
+#include "cpu/ref_io_helper.hpp"
 #include "cpu/reorder/cpu_reorder_pd.hpp"
 
 #include "cpu/simple_q10n.hpp"
@@ -2066,7 +2067,9 @@ template <SIMPLE_REORDER_TEMPL_DECL>
 struct simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL,
         typename utils::enable_if<tag_i == format_tag::any
                         && tag_o == format_tag::any
-                        && order_keep == fmt_order::any,
+                        && order_keep == fmt_order::any
+                        && !utils::one_of(type_i, data_type::s4, data_type::u4)
+                        && !utils::one_of(type_o, data_type::s4, data_type::u4),
                 spec::reference>::type> {
     static bool is_applicable(const memory_desc_wrapper &input_d,
             const memory_desc_wrapper &output_d, const primitive_attr_t *attr) {
@@ -2125,6 +2128,60 @@ struct simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL,
     }
 };
 
+/* The 4-bit types are packed in pairs, so the values are accessed through the
+ * io helpers by the element offset rather than through typed pointers. */
+template <SIMPLE_REORDER_TEMPL_DECL>
+struct simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL,
+        typename utils::enable_if<tag_i == format_tag::any
+                        && tag_o == format_tag::any
+                        && order_keep == fmt_order::any
+                        && (utils::one_of(type_i, data_type::s4, data_type::u4)
+                                || utils::one_of(
+                                        type_o, data_type::s4, data_type::u4)),
+                spec::reference>::type> {
+    static bool is_applicable(const memory_desc_wrapper &input_d,
+            const memory_desc_wrapper &output_d, const primitive_attr_t *attr) {
+        int src_scales_mask = -1;
+        int dst_scales_mask = -1;
+        CHECK(get_scales_mask(attr, &src_scales_mask, &dst_scales_mask));
+
+        using skip_mask_t = dnnl_primitive_attr::skip_mask_t;
+        // The padded area of a packed tensor is not zeroed, so only the
+        // non-padded outputs are supported.
+        return input_d.is_blocking_desc() && output_d.is_blocking_desc()
+                && !output_d.is_additional_buffer()
+                && !input_d.is_additional_buffer()
+                && output_d.nelems() == output_d.nelems(true)
+                && src_scales_mask == 0 && dst_scales_mask == 0
+                && attr->has_default_values(skip_mask_t::scales_runtime
+                        | skip_mask_t::zero_points_runtime
+                        | skip_mask_t::post_ops)
+                && simple_po_check(attr);
+    }
+
+    GET_SCRATCHPAD_SIZE_ZERO();
+
+    static status_t execute(const cpu_reorder_pd_t *pd, const exec_ctx_t &ctx) {
+        DECLARE_COMMON_PARAMS();
+
+        // Two neighbouring values share a byte of the output, hence the values
+        // are written sequentially.
+        const dim_t nelems = input_d.nelems();
+        for (dim_t e = 0; e < nelems; ++e) {
+            const auto i_off = input_d.off_l(e);
+            const auto o_off = output_d.off_l(e);
+
+            float f = src_scales[0]
+                    * (io::load_float_value(type_i, input, i_off) - src_zp);
+            if (beta) f += beta * io::load_float_value(type_o, output, o_off);
+            f = f * dst_scales[0] + dst_zp;
+            io::store_float_value(type_o, f, output, o_off);
+        }
+
+        return status::success;
+    }
+};
+
 /* high level class declaration */
 
 template <SIMPLE_REORDER_TEMPL_DECL, typename spec = void>
@@ -56,9 +56,12 @@ const float *precompute_scales(const memory_tracking::grantor_t &scratchpad,
 
     const auto &attr_scales = attr->scales_;
     bool with_src_scales = !attr_scales.get(DNNL_ARG_SRC).has_default_values();
-    bool with_wei_scales
-            = !attr_scales.get(DNNL_ARG_WEIGHTS).has_default_values();
-    int wei_scale_mask = attr_scales.get(DNNL_ARG_WEIGHTS).mask_;
+    // group-wise weights scales can't be folded into the output scales, they
+    // are applied by the implementation
+    const auto &wei_attr_scales = attr_scales.get(DNNL_ARG_WEIGHTS);
+    bool with_wei_scales = !wei_attr_scales.has_default_values()
+            && wei_attr_scales.has_default_groups();
+    int wei_scale_mask = with_wei_scales ? wei_attr_scales.mask_ : 0;
     dim_t wei_scale_count = wei_scale_mask == 0 ? 1 : oc;
 
     const float *scales = nullptr;
@@ -68,8 +71,9 @@ const float *precompute_scales(const memory_tracking::grantor_t &scratchpad,
                 = scratchpad.template get<float>(key_precomputed_scales, &size);
         if (wei_scale_mask == 0) {
             const size_t count = nstl::min(size / sizeof(float), scales_simd_w);
+            const float wei_scale = with_wei_scales ? wei_scales[0] : 1.f;
             utils::array_set(loc_scales,
-                    src_scales[0] * wei_scales[0] * scale_adjust_factor, count);
+                    src_scales[0] * wei_scale * scale_adjust_factor, count);
         } else {
             const dim_t count = nstl::min(
                     static_cast<dim_t>(size / sizeof(float)), wei_scale_count);
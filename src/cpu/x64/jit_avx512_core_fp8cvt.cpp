@@ -0,0 +1,205 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+
+#include "common/float8.hpp"
+
+#include "cpu/x64/cpu_isa_traits.hpp"
+#include "cpu/x64/jit_avx512_core_fp8cvt.hpp"
+#include "cpu/x64/jit_generator.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace Xbyak;
+
+Address fp8_emulation_t::table_val(table_entry_t e) const {
+    const int offt = static_cast<int>(e * sizeof(uint32_t));
+    return host_->ptr_b[host_->rip + label_table_ + offt];
+}
+
+Xmm fp8_emulation_t::vmm_like(Xmm_t &x, int idx) const {
+    if (x.isZMM()) return Zmm(idx);
+    if (x.isYMM()) return Ymm(idx);
+    return Xmm(idx);
+}
+
+void fp8_emulation_t::vcvt_f8_to_f32(Xmm_t &out, Xmm_t &in) {
+    // The f8 values are first widened to f16 values in the words of the half
+    // length register aliasing `out`.
+    const Xmm out_half
+            = out.isZMM() ? Ymm(out.getIdx()) : Xmm(out.getIdx());
+    const Xmm aux_half = out.isZMM() ? Ymm(aux1_idx_) : Xmm(aux1_idx_);
+    const Xmm xmm_in = Xmm(in.getIdx());
+
+    host_->vpmovzxbw(out_half, xmm_in);
+    if (dt_ == data_type::f8_e5m2) {
+        // e5m2 is the top byte of f16
+        host_->vpsllw(out_half, out_half, 8);
+        host_->vcvtph2ps(out, out_half);
+        return;
+    }
+
+    // The e4m3 exponent and mantissa bits shifted into the f16 exponent and
+    // mantissa fields give the value scaled by 2^-8, including subnormals.
+    host_->vpsllw(aux_half, out_half, 8);
+    host_->vpandd(aux_half, aux_half, table_val(e4m3_word_sign_mask));
+    host_->vpandd(out_half, out_half, table_val(e4m3_word_abs_mask));
+    host_->vpsllw(out_half, out_half, 7);
+    host_->vpord(out_half, out_half, aux_half);
+    host_->vcvtph2ps(out, out_half);
+    host_->vmulps(out, out, table_val(e4m3_scale));
+
+    // S.1111.111 is NaN, which is 480 once scaled
+    const Xmm aux = vmm_like(out, aux1_idx_);
+    host_->vpandd(aux, out, table_val(abs_mask));
+    host_->vcmpeqps(kaux_, aux, table_val(e4m3_nan_value));
+    host_->vpandd(out | kaux_, out, table_val(sign_mask));
+    host_->vpord(out | kaux_, out, table_val(qnan));
+}
+
+void fp8_emulation_t::vcvt_f32_to_f8(Xmm_t &out, Xmm_t &in) {
+    const Xmm abs = vmm_like(in, aux1_idx_);
+    const Xmm code = vmm_like(in, aux2_idx_);
+    const Xmm code_subnormal = vmm_like(in, aux3_idx_);
+    const int shift = dt_ == data_type::f8_e5m2 ? 21 : 20;
+
+    host_->vpandd(abs, in, table_val(abs_mask));
+
+    // normal values: round the mantissa to nearest even and rebias the
+    // exponent, a carry out of the mantissa increments the exponent
+    host_->vpsrld(code, abs, shift);
+    host_->vpandd(code, code, table_val(one));
+    host_->vpaddd(code, code, abs);
+    host_->vpaddd(code, code, table_val(rounding_bias));
+    host_->vpsrld(code, code, shift);
+
+    // subnormal values: the f32 addition of a number whose ulp is the
+    // smallest subnormal rounds to nearest even and leaves the code in the
+    // mantissa of the sum
+    host_->vaddps(code_subnormal, abs, table_val(subnormal_magic));
+    host_->vpsubd(code_subnormal, code_subnormal, table_val(subnormal_magic));
+    host_->vpcmpd(kaux_, abs, table_val(min_normal), jit_generator::_cmp_lt_os);
+    host_->vmovdqa32(code | kaux_, code_subnormal);
+
+    // e5m2 saturates to infinity and keeps NaN, e4m3 has neither and
+    // converts both to NaN
+    host_->vpminud(code, code, table_val(max_code));
+    if (dt_ == data_type::f8_e5m2) {
+        host_->vcmpunordps(kaux_, in, in);
+        const int offt = static_cast<int>(e5m2_qnan_code * sizeof(uint32_t));
+        host_->vpbroadcastd(
+                code | kaux_, host_->ptr[host_->rip + label_table_ + offt]);
+    }
+
+    host_->vpsrld(abs, in, 24);
+    host_->vpandd(abs, abs, table_val(sign_byte));
+    host_->vpord(code, code, abs);
+    host_->vpmovdb(Xmm(out.getIdx()), code);
+}
+
+void fp8_emulation_t::prepare_table() {
+    const bool is_e5m2 = dt_ == data_type::f8_e5m2;
+    const uint32_t bias = is_e5m2 ? 15 : 7;
+    const uint32_t man_bits = is_e5m2 ? 2 : 3;
+    const uint32_t shift = 23 - man_bits;
+
+    uint32_t table[table_size];
+    table[abs_mask] = 0x7fffffff;
+    table[one] = 0x00000001;
+    table[rounding_bias] = (1u << (shift - 1)) - 1 - ((127 - bias) << 23);
+    table[subnormal_magic] = (127 + 24 - bias - man_bits) << 23;
+    table[min_normal] = (127 + 1 - bias) << 23;
+    table[max_code] = is_e5m2 ? 0x7c : 0x7f;
+    table[sign_byte] = 0x80;
+    table[e5m2_qnan_code] = 0x7e;
+    table[sign_mask] = 0x80000000;
+    table[qnan] = 0x7fc00000;
+    table[e4m3_word_abs_mask] = 0x007f007f;
+    table[e4m3_word_sign_mask] = 0x80008000;
+    table[e4m3_scale] = 0x43800000; // 256.f
+    table[e4m3_nan_value] = 0x43f00000; // 480.f
+
+    host_->align(64);
+    host_->L(label_table_);
+    for (int i = 0; i < table_size; ++i)
+        host_->dd(table[i]);
+}
+
+#define GET_OFF(field) offsetof(fp8_support::jit_call_t, field)
+
+void jit_avx512_core_fp8_cvt_t::generate() {
+    preamble();
+
+    auto cvt = [&](Xbyak::Opmask ktail_mask) {
+        const Xmm xmm_inp = Xmm(zmm_inp.getIdx());
+        const Xmm xmm_out = Xmm(zmm_out.getIdx());
+        if (to_f32_) {
+            vmovdqu8(xmm_inp | ktail_mask | T_z, ptr[reg_inp]);
+            f8_emu_.vcvt_f8_to_f32(zmm_out, xmm_inp);
+            vmovups(ptr[reg_out] | ktail_mask, zmm_out);
+        } else {
+            vmovups(zmm_inp | ktail_mask | T_z, ptr[reg_inp]);
+            f8_emu_.vcvt_f32_to_f8(xmm_out, zmm_inp);
+            vmovdqu8(ptr[reg_out] | ktail_mask, xmm_out);
+        }
+    };
+    const size_t inp_step = simd_w_ * (to_f32_ ? 1 : sizeof(float));
+    const size_t out_step = simd_w_ * (to_f32_ ? sizeof(float) : 1);
+
+    mov(reg_inp, ptr[abi_param1 + GET_OFF(inp)]);
+    mov(reg_out, ptr[abi_param1 + GET_OFF(out)]);
+    mov(reg_nelems, ptr[abi_param1 + GET_OFF(nelems)]);
+
+    mov(reg32_mask, 0xffff);
+    kmovw(ktail_mask, reg32_mask);
+
+    Xbyak::Label l_simd_loop, l_simd_tail, l_simd_notail;
+    L(l_simd_loop);
+    {
+        cmp(reg_nelems, simd_w_);
+        jl(l_simd_tail, T_NEAR);
+        cvt(ktail_mask);
+        add(reg_inp, inp_step);
+        add(reg_out, out_step);
+        sub(reg_nelems, simd_w_);
+        jmp(l_simd_loop, T_NEAR);
+    }
+    L(l_simd_tail);
+    test(reg_nelems, reg_nelems);
+    jz(l_simd_notail, T_NEAR);
+    // JIT of `tail_mask_ = (1 << (nelems_ % simd_w_)) - 1;`
+    mov(reg32_mask, 1);
+    mov(reg64_tail, reg_nelems);
+    shl(reg32_mask, reg8_mask_shift);
+    sub(reg32_mask, 1);
+    kmovd(ktail_mask, reg32_mask);
+    cvt(ktail_mask);
+    L(l_simd_notail);
+
+    postamble();
+
+    f8_emu_.prepare_table();
+}
+#undef GET_OFF
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,151 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_AVX512_CORE_FP8CVT_HPP
+#define CPU_X64_JIT_AVX512_CORE_FP8CVT_HPP
+
+#include <assert.h>
+
+#include "common/c_types_map.hpp"
+#include "common/float8.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/x64/cpu_isa_traits.hpp"
+#include "cpu/x64/jit_generator.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+namespace fp8_support {
+struct jit_call_t {
+    void *inp;
+    void *out;
+    size_t nelems;
+};
+} // namespace fp8_support
+
+// Emulates the conversions between f32 and f8_e5m2 or f8_e4m3 with
+// avx512_core instructions, rounding to nearest even. The vector length of
+// the auxiliary registers follows the one of the converted registers. The
+// constants are read from a table the host emits with prepare_table(),
+// usually right after its postamble.
+struct fp8_emulation_t {
+    using opmask_t = const Xbyak::Opmask;
+    using Xmm_t = const Xbyak::Xmm;
+
+    fp8_emulation_t(jit_generator *host, data_type_t dt, Xmm_t aux1,
+            Xmm_t aux2, Xmm_t aux3, opmask_t kaux)
+        : host_(host)
+        , dt_(dt)
+        , aux1_idx_(aux1.getIdx())
+        , aux2_idx_(aux2.getIdx())
+        , aux3_idx_(aux3.getIdx())
+        , kaux_(kaux) {
+        assert(utils::one_of(dt_, data_type::f8_e5m2, data_type::f8_e4m3));
+    }
+
+    // Converts the f8 values in the low bytes of `in` to f32 values, one per
+    // lane of `out`. `out` and `in` may be the same register.
+    void vcvt_f8_to_f32(Xmm_t &out, Xmm_t &in);
+    // Converts the f32 values of `in` to f8 values stored in the low bytes
+    // of the xmm `out`. `out` and `in` may be the same register.
+    void vcvt_f32_to_f8(Xmm_t &out, Xmm_t &in);
+
+    void prepare_table();
+
+private:
+    enum table_entry_t {
+        abs_mask = 0,
+        one,
+        rounding_bias,
+        subnormal_magic,
+        min_normal,
+        max_code,
+        sign_byte,
+        e5m2_qnan_code,
+        sign_mask,
+        qnan,
+        e4m3_word_abs_mask,
+        e4m3_word_sign_mask,
+        e4m3_scale,
+        e4m3_nan_value,
+        table_size,
+    };
+
+    Xbyak::Address table_val(table_entry_t e) const;
+    Xbyak::Xmm vmm_like(Xmm_t &x, int idx) const;
+
+    jit_generator *const host_;
+    const data_type_t dt_;
+    const int aux1_idx_;
+    const int aux2_idx_;
+    const int aux3_idx_;
+    const Xbyak::Opmask kaux_;
+    Xbyak::Label label_table_;
+};
+
+// Converts an array of f8 values to f32 values or back.
+struct jit_avx512_core_fp8_cvt_t : public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_avx512_core_fp8_cvt_t)
+
+    jit_avx512_core_fp8_cvt_t(data_type_t f8_dt, bool to_f32)
+        : jit_generator(jit_name())
+        , f8_dt_(f8_dt)
+        , to_f32_(to_f32)
+        , f8_emu_(this, f8_dt, Xbyak::Zmm(2), Xbyak::Zmm(3), Xbyak::Zmm(4),
+                  k1) {
+        create_kernel();
+    }
+
+    void generate() override;
+
+    void operator()(void *out, const void *inp, size_t nelems) const {
+        fp8_support::jit_call_t p;
+        p.inp = const_cast<void *>(inp);
+        p.out = out;
+        p.nelems = nelems;
+        jit_generator::operator()(&p);
+        msan_unpoison(out, nelems * (to_f32_ ? sizeof(float) : 1));
+    }
+
+private:
+    static constexpr int simd_w_ = 16;
+
+    const data_type_t f8_dt_;
+    const bool to_f32_;
+    fp8_emulation_t f8_emu_;
+
+    Xbyak::Opmask ktail_mask = k2;
+    Xbyak::Zmm zmm_inp = Xbyak::Zmm(0);
+    Xbyak::Zmm zmm_out = Xbyak::Zmm(1);
+
+    Xbyak::Reg64 reg_inp = rax;
+    Xbyak::Reg64 reg_out = rbx;
+    Xbyak::Reg64 reg_nelems = rdx;
+
+    Xbyak::Reg64 reg64_tail = rcx;
+    Xbyak::Reg8 reg8_mask_shift = cl;
+    Xbyak::Reg32 reg32_mask = r8d;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
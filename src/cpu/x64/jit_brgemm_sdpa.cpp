@@ -0,0 +1,438 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <math.h>
+
+#include "common/bfloat16.hpp"
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/nstl.hpp"
+#include "common/type_helpers.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/ref_io_helper.hpp"
+
+#include "cpu/x64/jit_brgemm_sdpa.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace dnnl::impl::memory_tracking::names;
+using namespace dnnl::impl::utils;
+
+namespace {
+
+// Packs the keys starting at `k`, a [head_size, n] matrix, to the columns
+// from `n_off` of the row major layout of brgemm with the leading dimension
+// `ldb`, interleaving `vnni` consecutive rows.
+template <typename data_t>
+void pack_keys(data_t *k_pack, const data_t *k, dim_t n_off, dim_t n,
+        dim_t head_size, dim_t stride_d, dim_t stride_n, dim_t ldb, int vnni) {
+    for_(dim_t in = 0; in < n; in++)
+    for (dim_t id = 0; id < head_size; id++) {
+        k_pack[(id / vnni) * ldb * vnni + (n_off + in) * vnni + id % vnni]
+                = k[id * stride_d + in * stride_n];
+    }
+}
+
+// Packs the values starting at `v`, a [n, values] matrix, to the rows from
+// `n_off` of the vnni layout of brgemm.
+template <typename data_t>
+void pack_values(data_t *v_pack, const data_t *v, dim_t n_off, dim_t n,
+        dim_t values, dim_t stride_n, int vnni) {
+    for_(dim_t in = n_off; in < n_off + n; in++)
+    for (dim_t iv = 0; iv < values; iv++) {
+        v_pack[(in / vnni) * values * vnni + iv * vnni + in % vnni]
+                = v[(in - n_off) * stride_n + iv];
+    }
+}
+
+} // namespace
+
+template <cpu_isa_t isa>
+status_t brgemm_sdpa_fwd_t<isa>::pd_t::init(engine_t *engine) {
+    using namespace data_type;
+
+    const auto d = desc();
+    dt_ = d->q_desc.data_type;
+    const bool is_bf16 = dt_ == bf16;
+
+    bool ok = mayiuse(isa) && dt_ == (isa == avx512_core_bf16 ? bf16 : f32)
+            && everyone_is(dt_, d->k_desc.data_type, d->v_desc.data_type,
+                    d->dst_desc.data_type)
+            && IMPLICATION(with_attn_mask(),
+                    one_of(d->attn_mask_desc.data_type, f32, dt_))
+            && IMPLICATION(with_scale(), one_of(d->scale_dt, f32, dt_))
+            && attr()->has_default_values() && init_formats_and_dims()
+            && IMPLICATION(is_bf16, d->head_size() % 2 == 0);
+    if (!ok) return status::unimplemented;
+
+    // The f32 values are read in place: a block of keys must either lie in
+    // a single page or span whole pages, which are then gathered by a batch
+    // of brgemm calls
+    const dim_t page_size = d->page_size();
+    if (d->paged() && !is_bf16 && page_size % n_blk != 0
+            && n_blk % page_size != 0)
+        return status::unimplemented;
+
+    const int nd = d->ndims();
+    const dim_t M = d->queries();
+    const dim_t N = d->keys();
+    const dim_t D = d->head_size();
+    const dim_t DV = d->values();
+    const int vnni = is_bf16 ? 2 : 1;
+
+    m_tail_ = M % m_blk;
+    n_tail_ = N % n_blk;
+    n_blk_pad_ = rnd_up(n_blk, vnni);
+    pack_v_ = is_bf16;
+    pv_k_blk_ = d->paged() && !pack_v_ && page_size < n_blk ? page_size
+                                                             : n_blk;
+
+    const dim_t lda_q = stride(d->q_desc, nd - 2);
+    const dim_t ldb_v = pack_v_ ? DV : stride(d->v_desc, nd - 2);
+    if (lda_q < D || ldb_v < DV) return status::unimplemented;
+
+    brgemm_attr_t brgattr_qk;
+    brgattr_qk.max_bs = 1;
+    brgemm_attr_t brgattr_pv;
+    brgattr_pv.max_bs = n_blk / pv_k_blk_;
+
+    for_(int i_m = 0; i_m < 2; i_m++)
+    for (int i_n = 0; i_n < 2; i_n++) {
+        if (!need_brg_kernel(i_m, i_n)) continue;
+        const dim_t vM = i_m ? m_tail_ : m_blk;
+        const dim_t vN = i_n ? n_tail_ : n_blk;
+        const int idx = get_brg_kernel_idx(i_m, i_n);
+
+        // scores = queries * keys
+        brgemm_t &brg_qk = brg_qk_descs_[idx];
+        CHECK(brgemm_desc_init(&brg_qk, isa, brgemm_addr, dt_, dt_, false,
+                false, brgemm_row_major, 1.f, 0.f, lda_q, n_blk, n_blk, vM, vN,
+                D));
+        CHECK(brgemm_desc_set_attr(&brg_qk, brgattr_qk));
+
+        // output += probabilities * values
+        const dim_t vK = pv_k_blk_ < n_blk ? pv_k_blk_ : rnd_up(vN, vnni);
+        brgemm_t &brg_pv = brg_pv_descs_[idx];
+        CHECK(brgemm_desc_init(&brg_pv, isa, brgemm_addr, dt_, dt_, false,
+                false, brgemm_row_major, 1.f, 1.f, n_blk_pad_, ldb_v, DV, vM,
+                DV, vK));
+        CHECK(brgemm_desc_set_attr(&brg_pv, brgattr_pv));
+    }
+
+    init_scratchpad();
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+void brgemm_sdpa_fwd_t<isa>::pd_t::init_scratchpad() {
+    const dim_t nthr = dnnl_get_max_threads();
+    const size_t dt_size = types::data_type_size(dt_);
+    const dim_t D = desc()->head_size();
+    const dim_t DV = desc()->values();
+
+    auto scratchpad = scratchpad_registry().registrar();
+    scratchpad.template book<char>(
+            key_sdpa_k_pack, nthr * D * n_blk_pad_ * dt_size);
+    scratchpad.template book<float>(key_sdpa_scores, nthr * m_blk * n_blk);
+    // the output accumulator followed by the maximum and the sum of the rows
+    scratchpad.template book<float>(key_sdpa_acc, nthr * m_blk * (DV + 2));
+    if (pack_v_) {
+        scratchpad.template book<char>(
+                key_sdpa_v_pack, nthr * n_blk_pad_ * DV * dt_size);
+        scratchpad.template book<char>(
+                key_sdpa_p, nthr * m_blk * n_blk_pad_ * dt_size);
+    }
+}
+
+template <cpu_isa_t isa>
+status_t brgemm_sdpa_fwd_t<isa>::init(engine_t *engine) {
+    for_(int i_m = 0; i_m < 2; i_m++)
+    for (int i_n = 0; i_n < 2; i_n++) {
+        if (!pd()->need_brg_kernel(i_m, i_n)) continue;
+        const int idx = pd()->get_brg_kernel_idx(i_m, i_n);
+
+        brgemm_kernel_t *ker = nullptr;
+        CHECK(brgemm_kernel_create(&ker, pd()->brg_qk_descs_[idx]));
+        CHECK(safe_ptr_assign(brg_qk_kernels_[idx], ker));
+        CHECK(brgemm_kernel_create(&ker, pd()->brg_pv_descs_[idx]));
+        CHECK(safe_ptr_assign(brg_pv_kernels_[idx], ker));
+    }
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+status_t brgemm_sdpa_fwd_t<isa>::execute_forward(const exec_ctx_t &ctx) const {
+    const auto q = CTX_IN_MEM(const char *, DNNL_ARG_QUERIES);
+    const auto k = CTX_IN_MEM(const char *, DNNL_ARG_KEYS);
+    const auto v = CTX_IN_MEM(const char *, DNNL_ARG_VALUES);
+    const auto msk = CTX_IN_MEM(const void *, DNNL_ARG_ATTN_MASK);
+    const auto scale_ptr = CTX_IN_MEM(const void *, DNNL_ARG_SCALE);
+    const auto page_table = CTX_IN_MEM(const int32_t *, DNNL_ARG_PAGE_TABLE);
+    auto dst = CTX_OUT_MEM(char *, DNNL_ARG_DST);
+
+    const auto d = pd()->desc();
+    const int nd = d->ndims();
+    const dim_t M = d->queries();
+    const dim_t N = d->keys();
+    const dim_t D = d->head_size();
+    const dim_t DV = d->values();
+    constexpr dim_t m_blk = pd_t::m_blk;
+    constexpr dim_t n_blk = pd_t::n_blk;
+    const dim_t n_blk_pad = pd()->n_blk_pad_;
+
+    const data_type_t dt = pd()->dt_;
+    const bool is_bf16 = dt == data_type::bf16;
+    const int vnni = is_bf16 ? 2 : 1;
+    const size_t dt_size = types::data_type_size(dt);
+    const bool pack_v = pd()->pack_v_;
+    const dim_t pv_k_blk = pd()->pv_k_blk_;
+    const bool paged = d->paged();
+    const dim_t page_size = d->page_size();
+
+    const auto &q_md = d->q_desc;
+    const auto &k_md = d->k_desc;
+    const auto &v_md = d->v_desc;
+    const auto &msk_md = d->attn_mask_desc;
+    const auto &dst_md = d->dst_desc;
+    const dim_t q_stride_m = pd_t::stride(q_md, nd - 2);
+    const dim_t k_stride_d = pd_t::stride(k_md, nd - 2);
+    const dim_t k_stride_n = pd_t::stride(k_md, nd - 1);
+    const dim_t v_stride_n = pd_t::stride(v_md, nd - 2);
+    const dim_t dst_stride_m = pd_t::stride(dst_md, nd - 2);
+
+    const bool with_msk = pd()->with_attn_mask();
+    const bool msk_is_f32 = msk_md.data_type == data_type::f32;
+    const dim_t msk_stride_m = with_msk ? pd_t::stride(msk_md, nd - 2) : 0;
+    const dim_t msk_stride_n = with_msk ? pd_t::stride(msk_md, nd - 1) : 0;
+
+    const bool with_scale = pd()->with_scale();
+    const float scale = with_scale
+            ? io::load_float_value(d->scale_dt, scale_ptr, 0)
+            : 1.f;
+    const float score_scale = d->invert_scale ? 1.f / scale : scale;
+    const bool causal = pd()->with_causal_mask();
+
+    const auto &scratchpad = ctx.get_scratchpad_grantor();
+    char *k_pack_base = scratchpad.template get<char>(key_sdpa_k_pack);
+    float *scores_base = scratchpad.template get<float>(key_sdpa_scores);
+    float *acc_base = scratchpad.template get<float>(key_sdpa_acc);
+    char *v_pack_base
+            = pack_v ? scratchpad.template get<char>(key_sdpa_v_pack) : nullptr;
+    char *p_base = pack_v ? scratchpad.template get<char>(key_sdpa_p) : nullptr;
+
+    const dim_t nb_m = div_up(M, m_blk);
+
+    parallel(0, [&](int ithr, int nthr) {
+        char *k_pack = k_pack_base + ithr * D * n_blk_pad * dt_size;
+        float *s = scores_base + ithr * m_blk * n_blk;
+        float *acc = acc_base + ithr * m_blk * (DV + 2);
+        float *row_max = acc + m_blk * DV;
+        float *row_sum = row_max + m_blk;
+        char *v_pack = pack_v ? v_pack_base + ithr * n_blk_pad * DV * dt_size
+                              : nullptr;
+        // The probabilities are computed in place of the scores for f32
+        char *p = pack_v ? p_base + ithr * m_blk * n_blk_pad * dt_size
+                         : reinterpret_cast<char *>(s);
+        brgemm_batch_element_t pv_batch[n_blk];
+
+        for_nd(ithr, nthr, d->batch(), nb_m, [&](dim_t b, dim_t mb) {
+            const dim_t m_start = mb * m_blk;
+            const dim_t m_cur = nstl::min(m_blk, M - m_start);
+            const bool is_m_tail = m_cur < m_blk;
+
+            for (dim_t i = 0; i < m_cur * DV; i++)
+                acc[i] = 0.f;
+            for (dim_t i = 0; i < m_cur; i++) {
+                row_max[i] = -INFINITY;
+                row_sum[i] = 0.f;
+            }
+
+            const char *q_ptr
+                    = q + (pd()->batch_off(q_md, b) + m_start * q_stride_m)
+                            * dt_size;
+            // The keys and the values are gathered in runs of consecutive
+            // keys, which are only split at the boundaries of the pages
+            const auto run_len = [&](dim_t n, dim_t n_left) {
+                return paged ? nstl::min(n_left, page_size - n % page_size)
+                             : n_left;
+            };
+            const dim_t msk_off = with_msk
+                    ? pd()->batch_off(msk_md, b) + m_start * msk_stride_m
+                    : 0;
+
+            // With the causal mask, the keys following the last query of the
+            // block are masked out for all its queries
+            const dim_t n_end = causal ? nstl::min(N, m_start + m_cur) : N;
+            for (dim_t n_start = 0; n_start < n_end; n_start += n_blk) {
+                const dim_t n_cur = nstl::min(n_blk, N - n_start);
+                const dim_t n_cur_pad = rnd_up(n_cur, vnni);
+                const bool is_n_tail = n_cur < n_blk;
+                const int idx = pd()->get_brg_kernel_idx(is_m_tail, is_n_tail);
+
+                for (dim_t j = 0; j < n_cur;) {
+                    const dim_t len = run_len(n_start + j, n_cur - j);
+                    const char *k_run = k
+                            + pd()->key_off(k_md, nd - 1, b, n_start + j,
+                                      page_table)
+                                    * dt_size;
+                    if (is_bf16)
+                        pack_keys(reinterpret_cast<bfloat16_t *>(k_pack),
+                                reinterpret_cast<const bfloat16_t *>(k_run), j,
+                                len, D, k_stride_d, k_stride_n, n_blk_pad,
+                                vnni);
+                    else
+                        pack_keys(reinterpret_cast<float *>(k_pack),
+                                reinterpret_cast<const float *>(k_run), j, len,
+                                D, k_stride_d, k_stride_n, n_blk_pad, vnni);
+                    j += len;
+                }
+
+                brgemm_batch_element_t be;
+                be.ptr.A = q_ptr;
+                be.ptr.B = k_pack;
+                be.vvpad.top = 0;
+                be.vvpad.bottom = 0;
+                brgemm_kernel_execute(brg_qk_kernels_[idx].get(), 1, &be, s);
+
+                for (dim_t i = 0; i < m_cur; i++) {
+                    float *s_row = s + i * n_blk;
+                    const dim_t m = m_start + i;
+                    const dim_t msk_row = msk_off + i * msk_stride_m;
+
+                    float mx = row_max[i];
+                    for (dim_t j = 0; j < n_cur; j++) {
+                        const dim_t n = n_start + j;
+                        float val = s_row[j] * score_scale;
+                        if (with_msk) {
+                            const dim_t msk_idx = msk_row + n * msk_stride_n;
+                            val += msk_is_f32
+                                    ? static_cast<const float *>(msk)[msk_idx]
+                                    : io::load_float_value(
+                                            msk_md.data_type, msk, msk_idx);
+                        }
+                        if (causal && n > m) val = -INFINITY;
+                        s_row[j] = val;
+                        mx = nstl::max(mx, val);
+                    }
+
+                    if (mx == -INFINITY) {
+                        // no key is visible to the query yet
+                        for (dim_t j = 0; j < n_cur; j++)
+                            s_row[j] = 0.f;
+                    } else {
+                        const float corr = expf(row_max[i] - mx);
+                        float sum = 0.f;
+                        PRAGMA_OMP_SIMD(reduction(+ : sum))
+                        for (dim_t j = 0; j < n_cur; j++) {
+                            s_row[j] = expf(s_row[j] - mx);
+                            sum += s_row[j];
+                        }
+                        row_sum[i] = row_sum[i] * corr + sum;
+                        row_max[i] = mx;
+                        if (corr != 1.f) {
+                            float *acc_row = acc + i * DV;
+                            PRAGMA_OMP_SIMD()
+                            for (dim_t dv = 0; dv < DV; dv++)
+                                acc_row[dv] *= corr;
+                        }
+                    }
+
+                    if (pack_v) {
+                        bfloat16_t *p_row
+                                = reinterpret_cast<bfloat16_t *>(p)
+                                + i * n_blk_pad;
+                        cvt_float_to_bfloat16(p_row, s_row, n_cur);
+                        for (dim_t j = n_cur; j < n_cur_pad; j++)
+                            p_row[j] = 0.f;
+                    }
+                }
+
+                int pv_bs = 1;
+                if (pack_v) {
+                    bfloat16_t *v_pack_bf16
+                            = reinterpret_cast<bfloat16_t *>(v_pack);
+                    for (dim_t j = 0; j < n_cur;) {
+                        const dim_t len = run_len(n_start + j, n_cur - j);
+                        const char *v_run = v
+                                + pd()->key_off(v_md, nd - 2, b, n_start + j,
+                                          page_table)
+                                        * dt_size;
+                        pack_values(v_pack_bf16,
+                                reinterpret_cast<const bfloat16_t *>(v_run), j,
+                                len, DV, v_stride_n, vnni);
+                        j += len;
+                    }
+                    // the odd row is padded with zeros
+                    for_(dim_t j = n_cur; j < n_cur_pad; j++)
+                    for (dim_t dv = 0; dv < DV; dv++)
+                        v_pack_bf16[(j / vnni) * DV * vnni + dv * vnni
+                                + j % vnni]
+                                = 0.f;
+                    pv_batch[0].ptr.A = p;
+                    pv_batch[0].ptr.B = v_pack;
+                } else {
+                    // The values are read in place, page by page if the
+                    // pages are smaller than the block
+                    pv_bs = static_cast<int>(div_up(n_cur, pv_k_blk));
+                    for (int i = 0; i < pv_bs; i++) {
+                        const dim_t n = n_start + i * pv_k_blk;
+                        pv_batch[i].ptr.A = p + i * pv_k_blk * dt_size;
+                        pv_batch[i].ptr.B = v
+                                + pd()->key_off(v_md, nd - 2, b, n, page_table)
+                                        * dt_size;
+                    }
+                }
+                brgemm_kernel_execute(
+                        brg_pv_kernels_[idx].get(), pv_bs, pv_batch, acc);
+            }
+
+            for (dim_t i = 0; i < m_cur; i++) {
+                float *acc_row = acc + i * DV;
+                // the rows whose keys are all masked out are set to zero
+                const float inv_sum = row_sum[i] > 0.f ? 1.f / row_sum[i] : 0.f;
+                PRAGMA_OMP_SIMD()
+                for (dim_t dv = 0; dv < DV; dv++)
+                    acc_row[dv] *= inv_sum;
+
+                char *dst_row = dst
+                        + (pd()->batch_off(dst_md, b)
+                                  + (m_start + i) * dst_stride_m)
+                                * dt_size;
+                if (is_bf16)
+                    cvt_float_to_bfloat16(
+                            reinterpret_cast<bfloat16_t *>(dst_row), acc_row,
+                            DV);
+                else
+                    utils::array_copy(
+                            reinterpret_cast<float *>(dst_row), acc_row, DV);
+            }
+        });
+    });
+
+    return status::success;
+}
+
+template struct brgemm_sdpa_fwd_t<avx512_core>;
+template struct brgemm_sdpa_fwd_t<avx512_core_bf16>;
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
@@ -0,0 +1,111 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_BRGEMM_SDPA_HPP
+#define CPU_X64_JIT_BRGEMM_SDPA_HPP
+
+#include <memory>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/primitive.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_sdpa_pd.hpp"
+
+#include "cpu/x64/brgemm/brgemm.hpp"
+#include "cpu/x64/cpu_isa_traits.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+// Computes the attention of blocks of queries with the keys and the values
+// split in blocks as well, using the online softmax: the running maximum and
+// sum of every row of scores are updated block by block and the partial
+// output is rescaled accordingly, so the scores are never materialized for
+// all the keys at once. Both products are brgemm calls, the keys and, for
+// bf16, the values are first packed to the layout brgemm expects. Paged keys
+// and values are gathered while packing, the f32 values are gathered by the
+// batch of the brgemm call instead.
+template <cpu_isa_t isa>
+struct brgemm_sdpa_fwd_t : public primitive_t {
+    struct pd_t : public cpu_sdpa_pd_t {
+        using cpu_sdpa_pd_t::cpu_sdpa_pd_t;
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("brgemm:", isa, ""), brgemm_sdpa_fwd_t);
+
+        status_t init(engine_t *engine);
+
+        // The number of queries and keys per block
+        static constexpr dim_t m_blk = 64;
+        static constexpr dim_t n_blk = 64;
+
+        int get_brg_kernel_idx(bool is_m_tail, bool is_n_tail) const {
+            return 2 * is_m_tail + is_n_tail;
+        }
+
+        bool need_brg_kernel(bool is_m_tail, bool is_n_tail) const {
+            const bool need_m = is_m_tail ? m_tail_ > 0
+                                          : desc()->queries() >= m_blk;
+            const bool need_n
+                    = is_n_tail ? n_tail_ > 0 : desc()->keys() >= n_blk;
+            return need_m && need_n;
+        }
+
+        data_type_t dt_ = data_type::undef;
+        dim_t m_tail_ = 0;
+        dim_t n_tail_ = 0;
+        // The dimensions of the packed values: the keys padded to the vnni
+        // granularity
+        dim_t n_blk_pad_ = 0;
+        bool pack_v_ = false;
+        // The number of keys per element of the batch of the brgemm call of
+        // the values, smaller than a block only for small pages
+        dim_t pv_k_blk_ = n_blk;
+
+        brgemm_t brg_qk_descs_[4];
+        brgemm_t brg_pv_descs_[4];
+
+    private:
+        void init_scratchpad();
+    };
+
+    brgemm_sdpa_fwd_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+
+    status_t execute(const exec_ctx_t &ctx) const override {
+        return execute_forward(ctx);
+    }
+
+private:
+    status_t execute_forward(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::unique_ptr<brgemm_kernel_t> brg_qk_kernels_[4];
+    std::unique_ptr<brgemm_kernel_t> brg_pv_kernels_[4];
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
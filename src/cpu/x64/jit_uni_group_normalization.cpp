@@ -0,0 +1,564 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include <math.h>
+
+#include <memory>
+#include <vector>
+
+#include "common/c_types_map.hpp"
+#include "common/dnnl_thread.hpp"
+#include "common/type_helpers.hpp"
+
+#include "cpu/cpu_primitive.hpp"
+#include "cpu/platform.hpp"
+
+#include "cpu/x64/injectors/jit_uni_eltwise_injector.hpp"
+#include "cpu/x64/jit_generator.hpp"
+#include "cpu/x64/jit_uni_group_normalization.hpp"
+#include "cpu/x64/utils/jit_io_helper.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+using namespace memory_tracking::names;
+using namespace data_type;
+using namespace Xbyak;
+
+namespace {
+
+using pd_t = jit_uni_group_normalization_fwd_t::pd_t;
+
+cpu_isa_t gnorm_isa() {
+    return mayiuse(avx512_core) ? avx512_core : avx2;
+}
+
+// The isa of the io helper: avx512_core emulates the bf16 conversions
+cpu_isa_t gnorm_io_isa(cpu_isa_t isa) {
+    return is_superset(isa, avx512_core) && mayiuse(avx512_core_bf16)
+            ? avx512_core_bf16
+            : isa;
+}
+
+template <cpu_isa_t isa>
+struct jit_gnorm_base_kernel_t : public jit_generator {
+    jit_gnorm_base_kernel_t(const char *name, const pd_t *pd)
+        : jit_generator(name)
+        , src_dt_(pd->src_md()->data_type)
+        , dst_dt_(pd->dst_md()->data_type)
+        , row_len_(pd->row_len_)
+        , nvec_(utils::div_up(row_len_, simd_w_))
+        , tail_(row_len_ % simd_w_) {
+        io::io_tail_conf_t io_tail_conf(simd_w_, tail_, tail_opmask_idx_,
+                vmm_tail_mask_.getIdx(), reg_tmp_);
+        io::io_emu_bf16_conf_t io_bf16_conf(bf16_emu_zmm_1_idx_,
+                bf16_emu_zmm_2_idx_, bf16_emu_zmm_3_idx_, reg_tmp_,
+                bf16_emu_zmm_4_idx_);
+        io_ = io::jit_io_multi_dt_helper_t<Vmm>(this, gnorm_io_isa(isa),
+                {src_dt_, dst_dt_, f32}, io::io_conf_t(), io_tail_conf,
+                io_bf16_conf);
+    }
+
+protected:
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    static constexpr dim_t simd_w_
+            = cpu_isa_traits<isa>::vlen / sizeof(float);
+    // The number of vectors of a row processed at once
+    static constexpr int unroll_ = isa == avx512_core ? 8 : 4;
+    const AddressFrame &vmmword
+            = is_superset(isa, avx512_core) ? zword : yword;
+
+    const data_type_t src_dt_;
+    const data_type_t dst_dt_;
+    const dim_t row_len_;
+    const dim_t nvec_;
+    const dim_t tail_;
+    io::jit_io_multi_dt_helper_t<Vmm> io_;
+
+    const Reg64 reg_param_ = abi_param1;
+    const Reg64 reg_src_ = r8;
+    const Reg64 reg_dst_ = r9;
+    const Reg64 reg_rows_ = r10;
+    const Reg64 reg_src_ptr_ = r11;
+    const Reg64 reg_dst_ptr_ = r12;
+    const Reg64 reg_cnt_ = r13;
+    const Reg64 reg_tmp_ = r14;
+    const Reg64 reg_a_ = r15;
+    const Reg64 reg_b_ = rbx;
+
+    // Vmm(0) is the tail mask on avx2, the eltwise injectors use Opmask(1)
+    const Vmm vmm_tail_mask_ = Vmm(0);
+    const int tail_opmask_idx_ = 2;
+    const int bf16_emu_zmm_1_idx_ = 28;
+    const int bf16_emu_zmm_2_idx_ = 29;
+    const int bf16_emu_zmm_3_idx_ = 30;
+    const int bf16_emu_zmm_4_idx_ = 31;
+
+    bool is_tail(dim_t v) const { return tail_ && v == nvec_ - 1; }
+
+    Address f32_ptr(const Reg64 &base, dim_t v) {
+        return vmmword[base + v * simd_w_ * sizeof(float)];
+    }
+    Address data_ptr(const Reg64 &base, data_type_t dt, dim_t v) {
+        return vmmword[base + v * simd_w_ * types::data_type_size(dt)];
+    }
+
+    // Emits the loop over `reg_rows_` rows, the data pointers are advanced
+    // by one row per iteration
+    template <typename F>
+    void row_loop(bool with_dst, F body) {
+        mov(reg_src_ptr_, reg_src_);
+        if (with_dst) mov(reg_dst_ptr_, reg_dst_);
+        mov(reg_cnt_, reg_rows_);
+        Label loop;
+        L(loop);
+        {
+            body();
+            add(reg_src_ptr_, row_len_ * types::data_type_size(src_dt_));
+            if (with_dst)
+                add(reg_dst_ptr_, row_len_ * types::data_type_size(dst_dt_));
+            dec(reg_cnt_);
+            jnz(loop, T_NEAR);
+        }
+    }
+};
+
+template <cpu_isa_t isa>
+struct jit_gnorm_stat_kernel_t
+    : public jit_uni_group_normalization_fwd_t::stat_kernel_t,
+      public jit_gnorm_base_kernel_t<isa> {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_gnorm_stat_kernel_t);
+
+    using base_t = jit_gnorm_base_kernel_t<isa>;
+    using Vmm = typename base_t::Vmm;
+
+    jit_gnorm_stat_kernel_t(const pd_t *pd, bool compute_var)
+        : base_t(jit_name(), pd), compute_var_(compute_var) {}
+
+    void operator()(const void *src, float *stat, const float *mean,
+            dim_t rows) const override {
+        ker_args_t args;
+        args.src = src;
+        args.stat = stat;
+        args.mean = mean;
+        args.rows = rows;
+        jit_generator::operator()(&args);
+    }
+
+    status_t create_kernel() override { return jit_generator::create_kernel(); }
+
+private:
+    struct ker_args_t {
+        const void *src;
+        float *stat;
+        const float *mean;
+        dim_t rows;
+    };
+
+    const bool compute_var_;
+
+    // reg_dst_ holds the statistics and reg_a_ the means
+    Vmm vmm_acc(int i) const { return Vmm(1 + i); }
+    Vmm vmm_mean(int i) const { return Vmm(1 + base_t::unroll_ + i); }
+    Vmm vmm_src(int i) const { return Vmm(1 + 2 * base_t::unroll_ + i); }
+
+    void generate() override {
+        this->preamble();
+
+        this->io_.init_bf16();
+        if (this->tail_) this->io_.prepare_tail_mask();
+
+#define PARAM_OFF(x) offsetof(ker_args_t, x)
+        this->mov(this->reg_src_,
+                this->ptr[this->reg_param_ + PARAM_OFF(src)]);
+        this->mov(this->reg_dst_,
+                this->ptr[this->reg_param_ + PARAM_OFF(stat)]);
+        this->mov(this->reg_a_,
+                this->ptr[this->reg_param_ + PARAM_OFF(mean)]);
+        this->mov(this->reg_rows_,
+                this->ptr[this->reg_param_ + PARAM_OFF(rows)]);
+#undef PARAM_OFF
+
+        for (dim_t v0 = 0; v0 < this->nvec_; v0 += base_t::unroll_) {
+            const int nv = static_cast<int>(
+                    nstl::min<dim_t>(base_t::unroll_, this->nvec_ - v0));
+            for (int i = 0; i < nv; i++) {
+                this->uni_vpxor(vmm_acc(i), vmm_acc(i), vmm_acc(i));
+                if (compute_var_)
+                    this->io_[f32]->load(this->f32_ptr(this->reg_a_, v0 + i),
+                            vmm_mean(i), this->is_tail(v0 + i));
+            }
+
+            this->row_loop(false, [&]() {
+                for (int i = 0; i < nv; i++) {
+                    this->io_[this->src_dt_]->load(
+                            this->data_ptr(this->reg_src_ptr_, this->src_dt_,
+                                    v0 + i),
+                            vmm_src(i), this->is_tail(v0 + i));
+                    if (compute_var_) {
+                        this->uni_vsubps(vmm_src(i), vmm_src(i), vmm_mean(i));
+                        this->uni_vfmadd231ps(
+                                vmm_acc(i), vmm_src(i), vmm_src(i));
+                    } else
+                        this->uni_vaddps(vmm_acc(i), vmm_acc(i), vmm_src(i));
+                }
+            });
+
+            for (int i = 0; i < nv; i++)
+                this->io_[f32]->store(vmm_acc(i),
+                        this->f32_ptr(this->reg_dst_, v0 + i),
+                        this->is_tail(v0 + i));
+        }
+
+        this->postamble();
+    }
+};
+
+template <cpu_isa_t isa>
+struct jit_gnorm_data_kernel_t
+    : public jit_uni_group_normalization_fwd_t::data_kernel_t,
+      public jit_gnorm_base_kernel_t<isa> {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_gnorm_data_kernel_t);
+
+    using base_t = jit_gnorm_base_kernel_t<isa>;
+    using Vmm = typename base_t::Vmm;
+
+    jit_gnorm_data_kernel_t(const pd_t *pd) : base_t(jit_name(), pd) {
+        const auto &po = pd->attr()->post_ops_;
+        for (int i = 0; i < po.len(); i++) {
+            assert(po.entry_[i].is_eltwise());
+            eltwise_injectors_.emplace_back(
+                    new jit_uni_eltwise_injector_f32<isa>(this,
+                            po.entry_[i].eltwise, true, Xbyak::util::rax,
+                            Opmask(1)));
+        }
+    }
+
+    void operator()(const void *src, void *dst, const float *a,
+            const float *b, dim_t rows) const override {
+        ker_args_t args;
+        args.src = src;
+        args.dst = dst;
+        args.a = a;
+        args.b = b;
+        args.rows = rows;
+        jit_generator::operator()(&args);
+    }
+
+    status_t create_kernel() override { return jit_generator::create_kernel(); }
+
+private:
+    struct ker_args_t {
+        const void *src;
+        void *dst;
+        const float *a;
+        const float *b;
+        dim_t rows;
+    };
+
+    std::vector<std::unique_ptr<jit_uni_eltwise_injector_f32<isa>>>
+            eltwise_injectors_;
+
+    // The values are kept in contiguous registers for the eltwise injectors
+    Vmm vmm_val(int i) const { return Vmm(1 + i); }
+    Vmm vmm_a(int i) const { return Vmm(1 + base_t::unroll_ + i); }
+    Vmm vmm_b(int i) const { return Vmm(1 + 2 * base_t::unroll_ + i); }
+
+    void generate() override {
+        this->preamble();
+
+        this->io_.init_bf16();
+        if (this->tail_) this->io_.prepare_tail_mask();
+
+#define PARAM_OFF(x) offsetof(ker_args_t, x)
+        this->mov(this->reg_src_,
+                this->ptr[this->reg_param_ + PARAM_OFF(src)]);
+        this->mov(this->reg_dst_,
+                this->ptr[this->reg_param_ + PARAM_OFF(dst)]);
+        this->mov(this->reg_a_,
+                this->ptr[this->reg_param_ + PARAM_OFF(a)]);
+        this->mov(this->reg_b_,
+                this->ptr[this->reg_param_ + PARAM_OFF(b)]);
+        this->mov(this->reg_rows_,
+                this->ptr[this->reg_param_ + PARAM_OFF(rows)]);
+#undef PARAM_OFF
+
+        for (dim_t v0 = 0; v0 < this->nvec_; v0 += base_t::unroll_) {
+            const int nv = static_cast<int>(
+                    nstl::min<dim_t>(base_t::unroll_, this->nvec_ - v0));
+            for (int i = 0; i < nv; i++) {
+                this->io_[f32]->load(this->f32_ptr(this->reg_a_, v0 + i),
+                        vmm_a(i), this->is_tail(v0 + i));
+                this->io_[f32]->load(this->f32_ptr(this->reg_b_, v0 + i),
+                        vmm_b(i), this->is_tail(v0 + i));
+            }
+
+            this->row_loop(true, [&]() {
+                for (int i = 0; i < nv; i++) {
+                    this->io_[this->src_dt_]->load(
+                            this->data_ptr(this->reg_src_ptr_, this->src_dt_,
+                                    v0 + i),
+                            vmm_val(i), this->is_tail(v0 + i));
+                    this->uni_vfmadd213ps(vmm_val(i), vmm_a(i), vmm_b(i));
+                }
+                for (auto &inj : eltwise_injectors_)
+                    inj->compute_vector_range(
+                            vmm_val(0).getIdx(), vmm_val(nv).getIdx());
+                for (int i = 0; i < nv; i++)
+                    this->io_[this->dst_dt_]->store(vmm_val(i),
+                            this->data_ptr(this->reg_dst_ptr_, this->dst_dt_,
+                                    v0 + i),
+                            this->is_tail(v0 + i));
+            });
+        }
+
+        this->postamble();
+
+        for (auto &inj : eltwise_injectors_)
+            inj->prepare_table();
+    }
+};
+
+} // namespace
+
+jit_uni_group_normalization_fwd_t::stat_kernel_t *
+jit_uni_group_normalization_fwd_t::stat_kernel_t::create(
+        const pd_t *pd, bool compute_var) {
+    if (mayiuse(avx512_core)) {
+        return new jit_gnorm_stat_kernel_t<avx512_core>(pd, compute_var);
+    } else if (mayiuse(avx2)) {
+        return new jit_gnorm_stat_kernel_t<avx2>(pd, compute_var);
+    } else {
+        assert(!"kernel is empty.");
+        return nullptr;
+    }
+}
+
+jit_uni_group_normalization_fwd_t::data_kernel_t *
+jit_uni_group_normalization_fwd_t::data_kernel_t::create(const pd_t *pd) {
+    if (mayiuse(avx512_core)) {
+        return new jit_gnorm_data_kernel_t<avx512_core>(pd);
+    } else if (mayiuse(avx2)) {
+        return new jit_gnorm_data_kernel_t<avx2>(pd);
+    } else {
+        assert(!"kernel is empty.");
+        return nullptr;
+    }
+}
+
+bool jit_uni_group_normalization_fwd_t::pd_t::post_ops_ok_jit() const {
+    const auto &po = attr()->post_ops_;
+    for (int i = 0; i < po.len(); i++) {
+        const auto &e = po.entry_[i];
+        if (!e.is_eltwise()
+                || !eltwise_injector::is_supported(gnorm_isa(), e.eltwise.alg))
+            return false;
+    }
+    return true;
+}
+
+status_t jit_uni_group_normalization_fwd_t::pd_t::init(engine_t *engine) {
+    using namespace format_tag;
+    using skip_mask_t = primitive_attr_t::skip_mask_t;
+
+    const bool ok = is_fwd() && !has_zero_dim_memory() && mayiuse(avx2)
+            && utils::one_of(src_md()->data_type, f32, bf16)
+            && utils::one_of(dst_md()->data_type, f32, bf16)
+            && IMPLICATION(utils::one_of(bf16, src_md()->data_type,
+                                   dst_md()->data_type),
+                    mayiuse(avx512_core))
+            && stat_md()->data_type == f32 && check_scale_shift_data_type()
+            && attr()->has_default_values(skip_mask_t::post_ops)
+            && post_ops_ok() && post_ops_ok_jit()
+            && set_default_formats_common()
+            && attr_.set_default_formats(dst_md(0)) == status::success;
+    if (!ok) return status::unimplemented;
+
+    const memory_desc_wrapper src_d(src_md());
+    const memory_desc_wrapper dst_d(dst_md());
+    const int nd = ndims();
+    if (nd > 5) return status::unimplemented;
+
+    const auto nspc_tag = utils::pick(nd - 2, nc, nwc, nhwc, ndhwc);
+    format_tag_t tag = src_d.matches_one_of_tag(nspc_tag);
+    if (tag != format_tag::undef) {
+        row_len_ = C();
+        nblocks_ = 1;
+    } else if (nd >= 3) {
+        const auto tag16 = utils::pick(nd - 3, nCw16c, nChw16c, nCdhw16c);
+        const auto tag8 = utils::pick(nd - 3, nCw8c, nChw8c, nCdhw8c);
+        tag = src_d.matches_one_of_tag(tag16, tag8);
+        if (tag == format_tag::undef) return status::unimplemented;
+        row_len_ = tag == tag16 ? 16 : 8;
+        // The padded channels are not supported
+        if (C() % row_len_ != 0) return status::unimplemented;
+        nblocks_ = C() / row_len_;
+    } else
+        return status::unimplemented;
+    if (!dst_d.matches_tag(tag)) return status::unimplemented;
+
+    const dim_t SP = D() * H() * W();
+    const dim_t row_bytes = row_len_ * src_d.data_type_size();
+    const dim_t chunk_bytes = platform::get_per_core_cache_size(2) / 2;
+    rows_per_chunk_ = nstl::max<dim_t>(
+            1, nstl::min<dim_t>(SP, chunk_bytes / row_bytes));
+    nchunks_ = utils::div_up(SP, rows_per_chunk_);
+
+    init_scratchpad();
+    return status::success;
+}
+
+void jit_uni_group_normalization_fwd_t::pd_t::init_scratchpad() {
+    auto scratchpad = scratchpad_registry().registrar();
+    if (!stats_is_src())
+        scratchpad.template book<float>(
+                key_gnorm_chunk_stats, MB() * C() * nchunks_ * 2);
+    scratchpad.template book<float>(key_gnorm_scale_shift, MB() * 2 * C());
+    if (use_tmp_stats()) {
+        scratchpad.template book<float>(key_gnorm_tmp_mean, MB() * G());
+        scratchpad.template book<float>(key_gnorm_tmp_var, MB() * G());
+    }
+}
+
+status_t jit_uni_group_normalization_fwd_t::init(engine_t *engine) {
+    if (!pd()->stats_is_src()) {
+        CHECK(safe_ptr_assign(
+                sum_kernel_, stat_kernel_t::create(pd(), false)));
+        CHECK(safe_ptr_assign(var_kernel_, stat_kernel_t::create(pd(), true)));
+        CHECK(sum_kernel_->create_kernel());
+        CHECK(var_kernel_->create_kernel());
+    }
+    CHECK(safe_ptr_assign(data_kernel_, data_kernel_t::create(pd())));
+    return data_kernel_->create_kernel();
+}
+
+status_t jit_uni_group_normalization_fwd_t::execute_forward(
+        const exec_ctx_t &ctx) const {
+    status_t status = status::success;
+    auto scratchpad = ctx.get_scratchpad_grantor();
+
+    const auto src = CTX_IN_MEM(const char *, DNNL_ARG_SRC);
+    auto dst = CTX_OUT_CLEAN_MEM(char *, DNNL_ARG_DST, status);
+    CHECK(status);
+    auto scale = CTX_IN_MEM(const float *, DNNL_ARG_SCALE);
+    auto shift = CTX_IN_MEM(const float *, DNNL_ARG_SHIFT);
+
+    float *mean, *variance;
+    if (pd()->use_tmp_stats()) {
+        mean = scratchpad.template get<float>(key_gnorm_tmp_mean);
+        variance = scratchpad.template get<float>(key_gnorm_tmp_var);
+    } else if (pd()->stats_is_src()) {
+        mean = const_cast<float *>(CTX_IN_MEM(const float *, DNNL_ARG_MEAN));
+        variance = const_cast<float *>(
+                CTX_IN_MEM(const float *, DNNL_ARG_VARIANCE));
+    } else {
+        mean = CTX_OUT_CLEAN_MEM(float *, DNNL_ARG_MEAN, status);
+        CHECK(status);
+        variance = CTX_OUT_CLEAN_MEM(float *, DNNL_ARG_VARIANCE, status);
+        CHECK(status);
+    }
+
+    const dim_t MB = pd()->MB();
+    const dim_t C = pd()->C();
+    const dim_t G = pd()->G();
+    const dim_t C_PER_G = pd()->C_PER_G();
+    const dim_t SP = pd()->D() * pd()->H() * pd()->W();
+    const dim_t row_len = pd()->row_len_;
+    const dim_t nblocks = pd()->nblocks_;
+    const dim_t rows_per_chunk = pd()->rows_per_chunk_;
+    const dim_t nchunks = pd()->nchunks_;
+    const float eps = pd()->desc()->group_norm_epsilon;
+
+    const size_t src_dt_size = types::data_type_size(pd()->src_md()->data_type);
+    const size_t dst_dt_size = types::data_type_size(pd()->dst_md()->data_type);
+
+    // The offset of the chunk `ch` of the channel block `cb` of the sample `n`
+    const auto data_off = [&](dim_t n, dim_t cb, dim_t ch) {
+        return (n * C + cb * row_len) * SP + ch * rows_per_chunk * row_len;
+    };
+    const auto chunk_rows = [&](dim_t ch) {
+        return nstl::min(rows_per_chunk, SP - ch * rows_per_chunk);
+    };
+
+    if (!pd()->stats_is_src()) {
+        // The per-channel mean and the sum of the squared deviations from it
+        // of every chunk, [MB][nblocks][nchunks][2][row_len]
+        float *chunk_stats
+                = scratchpad.template get<float>(key_gnorm_chunk_stats);
+        const auto chunk_stats_ptr = [&](dim_t n, dim_t cb, dim_t ch) {
+            return chunk_stats
+                    + ((n * nblocks + cb) * nchunks + ch) * 2 * row_len;
+        };
+
+        parallel_nd(MB, nblocks, nchunks, [&](dim_t n, dim_t cb, dim_t ch) {
+            const char *s = src + data_off(n, cb, ch) * src_dt_size;
+            float *cs = chunk_stats_ptr(n, cb, ch);
+            const dim_t rows = chunk_rows(ch);
+            (*sum_kernel_)(s, cs, nullptr, rows);
+            for (dim_t c = 0; c < row_len; c++)
+                cs[c] /= rows;
+            (*var_kernel_)(s, cs + row_len, cs, rows);
+        });
+
+        // Merges the partial statistics of the channels and the chunks of
+        // every group with the parallel variant of Welford's algorithm
+        parallel_nd(MB, G, [&](dim_t n, dim_t g) {
+            double cnt = 0, m = 0, m2 = 0;
+            for_(dim_t c = g * C_PER_G; c < (g + 1) * C_PER_G; c++)
+            for (dim_t ch = 0; ch < nchunks; ch++) {
+                const float *cs = chunk_stats_ptr(n, c / row_len, ch);
+                const dim_t cc = c % row_len;
+                const double cnt_b = chunk_rows(ch);
+                const double cnt_ab = cnt + cnt_b;
+                const double delta = cs[cc] - m;
+                m += delta * cnt_b / cnt_ab;
+                m2 += cs[row_len + cc] + delta * delta * cnt * cnt_b / cnt_ab;
+                cnt = cnt_ab;
+            }
+            mean[n * G + g] = static_cast<float>(m);
+            variance[n * G + g] = static_cast<float>(m2 / cnt);
+        });
+    }
+
+    // The normalization and the scale and shift are folded into
+    // dst = a * src + b with the per-sample per-channel `a` and `b`
+    float *ss = scratchpad.template get<float>(key_gnorm_scale_shift);
+    parallel_nd(MB, C, [&](dim_t n, dim_t c) {
+        const dim_t s_off = n * G + c / C_PER_G;
+        const float inv_sqrtvar = 1.f / sqrtf(variance[s_off] + eps);
+        const float a = (scale ? scale[c] : 1.f) * inv_sqrtvar;
+        ss[n * 2 * C + c] = a;
+        ss[n * 2 * C + C + c] = (shift ? shift[c] : 0.f) - mean[s_off] * a;
+    });
+
+    parallel_nd(MB, nblocks, nchunks, [&](dim_t n, dim_t cb, dim_t ch) {
+        const dim_t off = data_off(n, cb, ch);
+        const float *a = ss + n * 2 * C + cb * row_len;
+        (*data_kernel_)(src + off * src_dt_size, dst + off * dst_dt_size, a,
+                a + C, chunk_rows(ch));
+    });
+    return status::success;
+}
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -0,0 +1,109 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_X64_JIT_UNI_GROUP_NORMALIZATION_HPP
+#define CPU_X64_JIT_UNI_GROUP_NORMALIZATION_HPP
+
+#include <memory>
+
+#include "common/c_types_map.hpp"
+#include "common/memory_tracking.hpp"
+#include "common/primitive.hpp"
+#include "common/utils.hpp"
+
+#include "cpu/cpu_group_normalization_pd.hpp"
+
+#include "cpu/x64/cpu_isa_traits.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace cpu {
+namespace x64 {
+
+struct jit_uni_group_normalization_fwd_t : public primitive_t {
+    struct pd_t : public cpu_group_normalization_fwd_pd_t {
+        using cpu_group_normalization_fwd_pd_t::
+                cpu_group_normalization_fwd_pd_t;
+
+        DECLARE_COMMON_PD_T("jit:uni", jit_uni_group_normalization_fwd_t);
+
+        status_t init(engine_t *engine);
+
+        // The data tensor is processed as [MB][nblocks][SP][row_len]:
+        // `row_len` is C for the channels-last layouts and the channel
+        // block size for the blocked ones
+        dim_t row_len_ = 0;
+        dim_t nblocks_ = 0;
+        // The spatial points are split in the chunks that fit in L2, the
+        // statistics of a chunk are computed with two passes over the
+        // chunk while it stays in the cache
+        dim_t rows_per_chunk_ = 0;
+        dim_t nchunks_ = 0;
+
+        bool use_tmp_stats() const { return !stats_is_src() && !is_training(); }
+
+    private:
+        bool post_ops_ok_jit() const;
+        void init_scratchpad();
+    };
+
+    // Computes the per-channel sums (or the sums of the squared deviations
+    // from the per-channel `mean`) over `rows` rows of `row_len` elements
+    struct stat_kernel_t {
+        static stat_kernel_t *create(const pd_t *pd, bool compute_var);
+        virtual ~stat_kernel_t() = default;
+
+        virtual void operator()(const void *src, float *stat,
+                const float *mean, dim_t rows) const = 0;
+        virtual status_t create_kernel() = 0;
+    };
+
+    // Computes dst = post_ops(a * src + b) over `rows` rows of `row_len`
+    // elements, `a` and `b` are per channel
+    struct data_kernel_t {
+        static data_kernel_t *create(const pd_t *pd);
+        virtual ~data_kernel_t() = default;
+
+        virtual void operator()(const void *src, void *dst, const float *a,
+                const float *b, dim_t rows) const = 0;
+        virtual status_t create_kernel() = 0;
+    };
+
+    jit_uni_group_normalization_fwd_t(const pd_t *apd) : primitive_t(apd) {}
+
+    status_t init(engine_t *engine) override;
+
+    status_t execute(const exec_ctx_t &ctx) const override {
+        return execute_forward(ctx);
+    }
+
+private:
+    status_t execute_forward(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd().get(); }
+
+    std::unique_ptr<stat_kernel_t> sum_kernel_;
+    std::unique_ptr<stat_kernel_t> var_kernel_;
+    std::unique_ptr<data_kernel_t> data_kernel_;
+};
+
+} // namespace x64
+} // namespace cpu
+} // namespace impl
+} // namespace dnnl
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino+=l0,\:4,N-s
@@ -32,6 +32,7 @@
 #include "cpu/x64/jit_uni_reorder.hpp"
 
 #include "cpu/x64/jit_avx512_core_bf16cvt.hpp"
+#include "cpu/x64/jit_avx512_core_fp8cvt.hpp"
 #include "cpu/x64/jit_generator.hpp"
 
 // #define TR_DEBUG
@@ -166,13 +167,21 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
     static bool applicable(const prb_t &p) {
         using namespace data_type;
 
+        const bool is_f8 = utils::one_of(p.itype, f8_e5m2, f8_e4m3)
+                || utils::one_of(p.otype, f8_e5m2, f8_e4m3);
         bool ok = true && p.ndims > 0
-                && utils::one_of(p.itype, f32, bf16, f16, s32, s8, u8)
-                && utils::one_of(p.otype, f32, bf16, f16, s32, s8, u8)
+                && utils::one_of(p.itype, f32, bf16, f16, f8_e5m2, f8_e4m3,
+                        s32, s8, u8)
+                && utils::one_of(p.otype, f32, bf16, f16, f8_e5m2, f8_e4m3,
+                        s32, s8, u8)
                 && IMPLICATION(utils::one_of(p.itype, bf16, f16),
                         utils::one_of(p.otype, s8, u8, f32, bf16, f16))
                 && IMPLICATION(utils::one_of(p.otype, bf16, f16),
                         utils::one_of(p.itype, s8, u8, f32, bf16, f16))
+                // f8 is converted from or to f32 only
+                && IMPLICATION(is_f8,
+                        p.itype == p.otype
+                                || utils::one_of(f32, p.itype, p.otype))
                 && utils::everyone_is(0, p.ioff, p.ooff) /* do we need this? */
                 && utils::one_of(p.beta, 0.f, 1.f) /* anything else? */
                 && simple_impl_desc_init(p, nullptr) && mayiuse(sse41)
@@ -180,6 +189,7 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
                         mayiuse(avx512_core) || mayiuse(avx2_vnni_2))
                 && IMPLICATION(utils::one_of(f16, p.itype, p.otype),
                         mayiuse(avx512_core_fp16) || mayiuse(avx2_vnni_2))
+                && IMPLICATION(is_f8, mayiuse(avx512_core))
                 && prb_has_small_strides(p);
 
         return ok;
@@ -585,6 +595,15 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
                               } else
                                   assert("unreachable!");
                           case f16: vcvtph2ps(dst, src); break;
+                          case f8_e5m2:
+                          case f8_e4m3:
+                              if (src.isMEM()) {
+                                  uni_vmovd(dst_pure, src.getAddress());
+                                  f8_emu_->vcvt_f8_to_f32(dst, dst_pure);
+                              } else
+                                  f8_emu_->vcvt_f8_to_f32(
+                                          dst, Xmm(src.getIdx()));
+                              break;
                           case s32: uni_vcvtdq2ps(dst, src); break;
                           case s8:
                               uni_vpmovsxbd(dst, src);
@@ -622,6 +641,11 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
                         vcvtps2ph(xmm, xmm, _op_mxcsr);
                     }
                     break;
+                case f8_e5m2:
+                case f8_e4m3:
+                    if (idt != f32) cvt2ps(xmm, xmm, idt);
+                    f8_emu_->vcvt_f32_to_f8(xmm, xmm);
+                    break;
                 case s32:
                     if (idt == f32)
                         uni_vcvtps2dq(xmm, xmm);
@@ -944,7 +968,8 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
                     } else {
                         if (prb_.otype == s32) {
                             uni_vmovss(xmm_tmp_, o_addr(o_off[ur]));
-                        } else if (utils::one_of(prb_.otype, s8, u8)) {
+                        } else if (utils::one_of(prb_.otype, s8, u8,
+                                           f8_e5m2, f8_e4m3)) {
                             uni_vpinsrb(
                                     xmm_tmp_, xmm_tmp_, o_addr(o_off[ur]), 0x0);
                         } else if (utils::one_of(prb_.otype, bf16, f16)) {
@@ -1107,6 +1132,8 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
         using namespace data_type;
 
         return utils::one_of(f32, prb_.itype, prb_.otype)
+                || utils::one_of(prb_.itype, f8_e5m2, f8_e4m3)
+                || utils::one_of(prb_.otype, f8_e5m2, f8_e4m3)
                 || prb_.src_scale_type != scale_type_t::NONE
                 || prb_.dst_scale_type != scale_type_t::NONE || prb_.beta != 0.f
                 || ((prb_.req_src_zp || prb_.req_dst_zp)
@@ -1426,7 +1453,8 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
         : kernel_t(desc)
         , jit_generator(jit_name())
         , isa_(get_max_cpu_isa())
-        , bf16_emu_(nullptr) {
+        , bf16_emu_(nullptr)
+        , f8_emu_(nullptr) {
         assert(!utils::one_of(isa_, isa_undef, isa_all));
         itype_sz_ = data_type_size(prb_.itype);
         otype_sz_ = data_type_size(prb_.otype);
@@ -1437,6 +1465,16 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
                     bf16_emu_reserv_1_, bf16_emu_reserv_2_, bf16_emu_reserv_3_,
                     bf16_emu_scratch_, bf16_emu_reserv_4_);
         }
+        const data_type_t f8_dt
+                = utils::one_of(prb_.itype, data_type::f8_e5m2,
+                          data_type::f8_e4m3)
+                ? prb_.itype
+                : prb_.otype;
+        if (utils::one_of(f8_dt, data_type::f8_e5m2, data_type::f8_e4m3)) {
+            f8_emu_ = utils::make_unique<fp8_emulation_t>(this, f8_dt,
+                    f8_emu_reserv_1_, f8_emu_reserv_2_, f8_emu_reserv_3_,
+                    f8_emu_kmask_);
+        }
     }
 
     void generate() override {
@@ -1517,6 +1555,8 @@ struct jit_uni_reorder_kernel_f32_t : public kernel_t, public jit_generator {
 
         L(end_of_kernel);
         postamble();
+
+        if (f8_emu_) f8_emu_->prepare_table();
     }
 
     ~jit_uni_reorder_kernel_f32_t() override = default;
@@ -1569,6 +1609,13 @@ private:
     const Reg64 bf16_emu_scratch_ = reg_tmp_;
     const Zmm bf16_emu_reserv_3_ = Zmm(18);
     const Zmm bf16_emu_reserv_4_ = Zmm(19);
+
+    /* f8 support, converted through f32 */
+    std::unique_ptr<fp8_emulation_t> f8_emu_;
+    const Zmm f8_emu_reserv_1_ = Zmm(20);
+    const Zmm f8_emu_reserv_2_ = Zmm(21);
+    const Zmm f8_emu_reserv_3_ = Zmm(22);
+    const Opmask f8_emu_kmask_ = k1;
 };
 
 // Seperate class for no unroll/threading burden
@@ -23,6 +23,7 @@
 
 #include "cpu/cpu_primitive.hpp"
 #include "cpu/matmul/matmul_utils.hpp"
+#include "cpu/ref_io_helper.hpp"
 #include "cpu/scale_utils.hpp"
 
 #include "cpu/x64/amx_tile_configure.hpp"
@@ -61,6 +62,11 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
             = everyone_is(bf16, src_dt, wei_dt) && one_of(dst_dt, bf16, f32);
     const bool is_f16
             = everyone_is(f16, src_dt, wei_dt) && one_of(dst_dt, f16, f32);
+    // s4/u4 weights up-converted to the source data type
+    const bool is_int4_decompression = one_of(wei_dt, s4, u4)
+            && attr()->fpmath_apply_to_int_
+            && ((src_dt == f32 && dst_dt == f32)
+                    || (src_dt == bf16 && one_of(dst_dt, bf16, f32)));
 
     auto check_bias = [&]() -> bool {
         const auto bia_dt = weights_md(1)->data_type;
@@ -86,8 +92,17 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
         return ok;
     };
 
-    auto check_attr_zero_points
-            = [&]() -> bool { return attr()->zero_points_.common(); };
+    auto check_attr_zero_points = [&]() -> bool {
+        // the zero points of the decompressed weights are applied during
+        // copy B
+        if (is_int4_decompression) return attr_wei_decomp_zero_points_ok();
+        // per N and group-wise weights zero points are applied to the int8
+        // partial results of the groups
+        const auto &zp = attr()->zero_points_;
+        return zp.common(DNNL_ARG_SRC) && zp.common(DNNL_ARG_DST)
+                && IMPLICATION(!is_int8, zp.common(DNNL_ARG_WEIGHTS))
+                && attr_wei_zero_points_ok();
+    };
 
     // The current version supports runtime value for M dimension in the case
     // of 2d problems only and do not support any runtime strides for B and C
@@ -96,20 +111,23 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
     const bool no_dynamic_strides_for_B_and_C
             = !memory_desc_wrapper(weights_md_).has_runtime_strides()
             && !memory_desc_wrapper(dst_md_).has_runtime_strides();
-    const bool problem_dt_correct = is_int8 || is_bf16 || is_f32 || is_f16;
+    const bool problem_dt_correct
+            = is_int8 || is_bf16 || is_f32 || is_f16 || is_int4_decompression;
     VCHECK_MATMUL(is_dense_data(), VERBOSE_NONTRIVIAL_STRIDE);
     VCHECK_MATMUL(mayiuse(isa), VERBOSE_UNSUPPORTED_ISA);
     VCHECK_MATMUL(problem_dt_correct, VERBOSE_UNSUPPORTED_DT);
     VCHECK_MATMUL(!has_zero_dim_memory(), VERBOSE_EMPTY_TENSOR, "");
     VCHECK_MATMUL(
             no_dynamic_strides_for_B_and_C, VERBOSE_RUNTIMEDIM_UNSUPPORTED);
-    VCHECK_MATMUL(
-            attr()->has_default_values(
-                    primitive_attr_t::skip_mask_t::scales_runtime
-                            | primitive_attr_t::skip_mask_t::zero_points_runtime
-                            | primitive_attr_t::skip_mask_t::post_ops
-                            | primitive_attr_t::skip_mask_t::sum_dt,
-                    dst_dt),
+    using smask_t = primitive_attr_t::skip_mask_t;
+    auto skip_mask = smask_t::scales_runtime | smask_t::zero_points_runtime
+            | smask_t::post_ops | smask_t::sum_dt;
+    if (is_int4_decompression || is_int8)
+        skip_mask |= smask_t::scales_runtime_groups
+                | smask_t::scales_runtime_data_type
+                | smask_t::zero_points_runtime_groups
+                | smask_t::zero_points_runtime_data_type;
+    VCHECK_MATMUL(attr()->has_default_values(skip_mask, dst_dt),
             VERBOSE_UNSUPPORTED_ATTR);
     VCHECK_MATMUL(attr()->post_ops_.check_sum_consistent_dt(dst_dt),
             VERBOSE_UNSUPPORTED_DT);
@@ -131,10 +149,13 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
     // In the case of dynamic M for amx the last tail kernel generate using
     // non-amx isa. s8s8 proplem type is exception to avoid compensations
     // processing for tail kernel
+    const bool is_bf16_compute
+            = is_bf16 || (is_int4_decompression && src_dt == bf16);
     const auto backup_isa = is_amx && bgmmc_.is_runtime_M && !is_s8s8
             ? (is_f16 ? avx512_core_fp16
-                      : (is_bf16 ? avx512_core_bf16
-                                 : (is_int8 ? avx512_core_vnni : avx512_core)))
+                      : (is_bf16_compute ? avx512_core_bf16
+                                         : (is_int8 ? avx512_core_vnni
+                                                    : avx512_core)))
             : isa;
     for_(int i_bs = 0; i_bs < 2; i_bs++)
     for_(int i_init = 0; i_init < 2; i_init++)
@@ -160,9 +181,11 @@ status_t brgemm_matmul_t<isa>::pd_t::init(engine_t *engine) {
                 bgmmc_.wei_dt, false, false, brgemm_row_major, alpha, vbeta,
                 LDA, bgmmc_.LDB, bgmmc_.LDC, vM, vN, vK));
 
+        // the groups of the weights are dequantized out of the kernel
         auto LDD = bgmmc_.LDD;
-        CHECK(brgemm_desc_set_postops(
-                &brg, attr(), &dst_md_, LDD, bgmmc_.bia_dt));
+        if (!bgmmc_.with_wei_group_acc)
+            CHECK(brgemm_desc_set_postops(
+                    &brg, attr(), &dst_md_, LDD, bgmmc_.bia_dt));
 
         brgemm_attr_t brgattr;
         brgattr.generate_skip_accumulation
@@ -237,9 +260,27 @@ status_t brgemm_matmul_t<isa>::init(engine_t *engine) {
 
 template <cpu_isa_t isa>
 status_t brgemm_matmul_t<isa>::execute_body(const exec_ctx_t &ctx) const {
+    const auto &bgmmc = pd()->get_brgemm_matmul_conf();
+
     DEFINE_ZERO_POINT_VALUE(src_zero_point, DNNL_ARG_SRC);
-    DEFINE_ZERO_POINT_VALUE(wei_zero_point, DNNL_ARG_WEIGHTS);
     DEFINE_ZERO_POINT_VALUE(dst_zero_point, DNNL_ARG_DST);
+    // the zero points of the decompressed weights are applied during copy B
+    // and the ones of the int8 weights groups after each group
+    int32_t wei_zero_point = 0;
+    if (bgmmc.with_wei_group_acc) {
+        if (bgmmc.wei_acc_zero_points_dt != data_type::undef
+                && CTX_IN_MEM(const void *,
+                           DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_WEIGHTS)
+                        == nullptr)
+            return status::invalid_arguments;
+    } else if (!bgmmc.with_wei_decomp_zero_points) {
+        DEFINE_ZERO_POINT_VALUE(wei_zp, DNNL_ARG_WEIGHTS);
+        wei_zero_point = wei_zp;
+    } else if (CTX_IN_MEM(const void *,
+                       DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_WEIGHTS)
+            == nullptr) {
+        return status::invalid_arguments;
+    }
     DEFINE_ARG_SCALES_BUFFER(src_scales, DNNL_ARG_SRC);
     DEFINE_ARG_SCALES_BUFFER(wei_scales, DNNL_ARG_WEIGHTS);
     DEFINE_ARG_SCALES_BUFFER(dst_scales, DNNL_ARG_DST);
@@ -250,13 +291,16 @@ status_t brgemm_matmul_t<isa>::execute_body(const exec_ctx_t &ctx) const {
     matmul_helper_t helper(src_d, weights_d, dst_d);
 
     auto &scratchpad = ctx.get_scratchpad_grantor();
-    const float *oscales = precompute_scales(
-            scratchpad, src_scales, wei_scales, pd()->N(), pd()->attr());
+    // the weights scales of the int8 weights groups are applied after each
+    // group, only the source scale is left
+    const float *oscales = bgmmc.with_wei_group_acc
+            ? src_scales
+            : precompute_scales(scratchpad, src_scales, wei_scales,
+                    pd()->N(), pd()->attr());
 
     brg_matmul_exec_ctx_t brgmm_ctx(ctx, pd(), oscales, src_zero_point,
             wei_zero_point, dst_zero_point, dst_scales, helper);
 
-    const auto &bgmmc = pd()->get_brgemm_matmul_conf();
     const bool use_buffer_a
             = bgmmc.use_buffer_a || bgmmc.use_buffer_a_tail_only;
     const bool is_amx = is_superset(isa, avx512_core_amx);
@@ -298,8 +342,10 @@ status_t brgemm_matmul_t<isa>::execute_body(const exec_ctx_t &ctx) const {
                 for (int mb = m_start; mb < m_end; mb++) {
                     if (use_buffer_a && nb == n_start)
                         copy_a_chunk_in_buffer(brgmm_ctx, ithr, b, mb, kc);
+                    // the result of a group is initialized in buffer C
                     compute_kernel(brgmm_ctx, ithr, b, mb, nb, kc,
-                            kc == kc_start, prev_ker_idx);
+                            kc == kc_start || bgmmc.with_wei_group_acc,
+                            prev_ker_idx);
                 }
             }
             ++start;
@@ -446,10 +492,76 @@ void brgemm_matmul_t<isa>::compute_kernel(
         }
     }
 
+    if (bgmmc.with_wei_group_acc)
+        dequantize_wei_group(
+                brgmm_ctx, ithr, b_idx, m_blk_idx, n_blk_idx, k_chunk_idx);
+
     if (need_copy_d)
         brgmm_ctx.copy_dst_values_from_buffer(b_idx, m_blk_idx, n_blk_idx);
 }
 
+// Dequantizes the s32 result of a K chunk of int8 weights, which covers a
+// single group of the weights scales and zero points:
+//   acc += (C - wei_zp * sum_k(A)) * wei_scale
+// The bias and the source and destination scales are applied to the f32
+// accumulator after the last K chunk, when it is stored to the destination.
+template <cpu_isa_t isa>
+void brgemm_matmul_t<isa>::dequantize_wei_group(
+        const brg_matmul_exec_ctx_t &brgmm_ctx, int ithr, int b_idx,
+        int m_blk_idx, int n_blk_idx, int k_chunk_idx) const {
+    const auto &bgmmc = pd()->get_brgemm_matmul_conf();
+
+    const dim_t m = brgmm_ctx.get_M_idx(m_blk_idx);
+    const int n = n_blk_idx * bgmmc.N_blk;
+    const int k_start = k_chunk_idx * bgmmc.K_chunk_elems;
+    const bool is_first_K_chunk = k_chunk_idx == 0;
+    const bool is_last_K_chunk = brgmm_ctx.is_last_K_chunk(k_chunk_idx);
+    const dim_t k_end = is_last_K_chunk
+            ? bgmmc.K
+            : static_cast<dim_t>(k_start) + bgmmc.K_chunk_elems;
+    const int curr_M_blk = brgmm_ctx.get_M_kernel_size(m_blk_idx);
+    const int curr_N_blk = nstl::min(bgmmc.N - n, bgmmc.N_blk);
+
+    const auto buf_C = reinterpret_cast<const int32_t *>(
+            brgmm_ctx.get_buf_C_ptr(ithr, m_blk_idx, n_blk_idx));
+    float *buf_acc = brgmm_ctx.get_buf_acc_ptr(ithr, m_blk_idx, n_blk_idx);
+    const bool with_zero_points
+            = bgmmc.wei_acc_zero_points_dt != data_type::undef;
+    const auto ptr_bias = brgmm_ctx.get_bias_ptr(n);
+    const float src_scale = brgmm_ctx.get_oscales_ptr(0)[0];
+    const float dst_scale = brgmm_ctx.get_dst_scales_ptr()[0];
+
+    for (int i = 0; i < curr_M_blk; i++) {
+        int32_t src_sum = 0;
+        if (with_zero_points) {
+            for (dim_t k = k_start; k < k_end; k++)
+                src_sum += io::load_int_value(bgmmc.src_dt,
+                        brgmm_ctx.get_data_A_ptr(b_idx, m + i, k), 0);
+        }
+        for (int j = 0; j < curr_N_blk; j++) {
+            const dim_t off = i * bgmmc.LDC + j;
+            int32_t c = buf_C[off];
+            if (with_zero_points)
+                c -= brgmm_ctx.get_wei_acc_zero_point(k_start, n + j)
+                        * src_sum;
+            float acc = static_cast<float>(c)
+                    * brgmm_ctx.get_wei_acc_scale(k_start, n + j);
+            if (!is_first_K_chunk) acc += buf_acc[off];
+            if (!is_last_K_chunk) {
+                buf_acc[off] = acc;
+                continue;
+            }
+
+            acc *= src_scale;
+            if (ptr_bias)
+                acc += io::load_float_value(bgmmc.bia_dt, ptr_bias, j);
+            acc *= dst_scale;
+            io::store_float_value(bgmmc.dst_dt, acc,
+                    brgmm_ctx.get_data_C_ptr(b_idx, m + i, n + j), 0);
+        }
+    }
+}
+
 template <cpu_isa_t isa>
 void brgemm_matmul_t<isa>::maybe_reduce_partial_results_and_apply_postops(
         const brg_matmul_exec_ctx_t &brgmm_ctx) const {
@@ -643,6 +755,35 @@ void brgemm_matmul_t<isa>::copy_b_chunk_in_buffer(
             ithr, b_idx, n_blk_idx);
     ctx.zp_a_neg_value_ptr = (void *)brgmm_ctx.get_zp_a_neg_val_ptr();
 
+    // The weights decompression parameters change at the group boundaries
+    // along K, so the rows of a call are split by groups then
+    const bool with_wei_decomp_qparams = bgmmc.with_wei_decomp_scales
+            || bgmmc.with_wei_decomp_zero_points;
+    auto copy_B = [&]() {
+        if (!with_wei_decomp_qparams) {
+            (*copy_B_kernel_)(&ctx);
+            return;
+        }
+        const dim_t k_start = ctx.current_K_start;
+        const dim_t k_iters = ctx.current_K_iters;
+        char *tr_src = (char *)ctx.tr_src;
+        for (dim_t k_off = 0; k_off < k_iters;) {
+            const int k = k_start + k_off;
+            const dim_t rows = nstl::min(k_iters - k_off,
+                    (dim_t)brgmm_ctx.get_wei_decomp_group_rows(k));
+            ctx.src = (void *)brgmm_ctx.get_data_B_ptr(b_idx, k, n);
+            ctx.tr_src = tr_src + k_off * bgmmc.LDB * bgmmc.tr_b_dt_sz;
+            ctx.wei_decomp_scales_ptr
+                    = brgmm_ctx.get_wei_decomp_scales_ptr(k, n);
+            ctx.wei_decomp_zero_points_ptr
+                    = brgmm_ctx.get_wei_decomp_zero_points_ptr(k, n);
+            ctx.current_K_start = k;
+            ctx.current_K_iters = rows;
+            (*copy_B_kernel_)(&ctx);
+            k_off += rows;
+        }
+    };
+
     int gb = 0;
     for (; gb < gemm_batch; gb++) {
         const int k = k_start + gb * bgmmc.K_blk;
@@ -656,7 +797,7 @@ void brgemm_matmul_t<isa>::copy_b_chunk_in_buffer(
             cvt_float16_to_float((float *)ctx.tr_src, (float16_t *)ctx.src,
                     bgmmc.wei_n_blk * ctx.current_K_iters);
         } else {
-            (*copy_B_kernel_)(&ctx);
+            copy_B();
         }
     }
 
@@ -672,7 +813,7 @@ void brgemm_matmul_t<isa>::copy_b_chunk_in_buffer(
             cvt_float16_to_float((float *)ctx.tr_src, (float16_t *)ctx.src,
                     bgmmc.wei_n_blk * ctx.current_K_iters);
         } else {
-            (*copy_B_kernel_)(&ctx);
+            copy_B();
         }
     }
 }
@@ -728,6 +869,10 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
                 ? scratchpad.template get<char>(key_brgemm_primitive_buffer_d)
                 : nullptr;
 
+        buf_acc_ptr_ = (bgmmc.with_wei_group_acc)
+                ? scratchpad.template get<char>(key_brgemm_primitive_buffer_acc)
+                : nullptr;
+
         is_amx_ = is_superset(isa, avx512_core_amx);
         wsp_tile_ptr_ = is_amx_
                 ? ctx.get_scratchpad_grantor().template get<char>(
@@ -764,6 +909,24 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
 
         zero_point_c_val_ = dst_zp;
 
+        wei_decomp_scales_ptr_ = bgmmc.with_wei_decomp_scales
+                ? CTX_IN_MEM(const char *,
+                        DNNL_ARG_ATTR_SCALES | DNNL_ARG_WEIGHTS)
+                : nullptr;
+        wei_decomp_zero_points_ptr_ = bgmmc.with_wei_decomp_zero_points
+                ? CTX_IN_MEM(const char *,
+                        DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_WEIGHTS)
+                : nullptr;
+        wei_acc_scales_ptr_ = bgmmc.wei_acc_scales_dt != data_type::undef
+                ? CTX_IN_MEM(const void *,
+                        DNNL_ARG_ATTR_SCALES | DNNL_ARG_WEIGHTS)
+                : nullptr;
+        wei_acc_zero_points_ptr_
+                = bgmmc.wei_acc_zero_points_dt != data_type::undef
+                ? CTX_IN_MEM(const void *,
+                        DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_WEIGHTS)
+                : nullptr;
+
         post_ops_binary_rhs_arg_vec_ = binary_injector::prepare_binary_args(
                 pd->attr()->post_ops_, ctx);
         base_brg_ker_idx_
@@ -930,7 +1093,9 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
 
     const char *get_data_B_ptr(int b, int k, int n) const {
         int cur_b = get_bb_idx(b, bgmmc_.bcast_B_desc);
-        return data_B_ptr_ + get_data_B_off(cur_b, k, n);
+        // two s4/u4 values are packed into a byte
+        const dim_t off = get_data_B_off(cur_b, k, n);
+        return data_B_ptr_ + (bgmmc_.is_int4_weights ? off / 2 : off);
     }
 
     char *get_data_C_ptr(int b, int m, int n) const {
@@ -1027,6 +1192,15 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
                 + buf_idx * bgmmc_.buffer_c_chunk_sz;
     }
 
+    // The f32 accumulation buffer of the int8 weights groups has the layout
+    // of buffer C
+    float *get_buf_acc_ptr(int ithr, int m_blk_idx, int n_blk_idx) const {
+        if (!bgmmc_.with_wei_group_acc) return nullptr;
+
+        const char *buf_C = get_buf_C_ptr(ithr, m_blk_idx, n_blk_idx);
+        return reinterpret_cast<float *>(buf_acc_ptr_ + (buf_C - buf_C_ptr_));
+    }
+
     char *get_buf_D_ptr(int m_blk_idx, int n_blk_idx) const {
         if (!is_runtime_M_tail_chunk(m_blk_idx)) return nullptr;
 
@@ -1154,6 +1328,64 @@ struct brgemm_matmul_t<isa>::brg_matmul_exec_ctx_t {
         return &zero_point_b_negative_val_;
     }
 
+    // Returns the scale of the int8 weights group containing the row k of B
+    // for the column n
+    float get_wei_acc_scale(int k, int n) const {
+        if (!wei_acc_scales_ptr_) return 1.f;
+        const dim_t off = (k / bgmmc_.wei_acc_scales_group_k)
+                        * bgmmc_.wei_acc_scales_stride_k
+                + n * bgmmc_.wei_acc_scales_stride_n;
+        return io::load_float_value(
+                bgmmc_.wei_acc_scales_dt, wei_acc_scales_ptr_, off);
+    }
+
+    int32_t get_wei_acc_zero_point(int k, int n) const {
+        if (!wei_acc_zero_points_ptr_) return 0;
+        const dim_t off = (k / bgmmc_.wei_acc_zero_points_group_k)
+                        * bgmmc_.wei_acc_zero_points_stride_k
+                + n * bgmmc_.wei_acc_zero_points_stride_n;
+        return io::load_int_value(
+                bgmmc_.wei_acc_zero_points_dt, wei_acc_zero_points_ptr_, off);
+    }
+
+    // Returns the weights decompression scales of the group containing the
+    // row k of B, starting from the column n
+    const void *get_wei_decomp_scales_ptr(int k, int n) const {
+        if (!bgmmc_.with_wei_decomp_scales) return nullptr;
+        const dim_t off
+                = (k / bgmmc_.wei_decomp_scales_group_k) * bgmmc_.N + n;
+        return wei_decomp_scales_ptr_
+                + off * types::data_type_size(bgmmc_.wei_decomp_scales_dt);
+    }
+
+    const void *get_wei_decomp_zero_points_ptr(int k, int n) const {
+        if (!bgmmc_.with_wei_decomp_zero_points) return nullptr;
+        const auto dt = bgmmc_.wei_decomp_zero_points_dt;
+        const dim_t off = (k / bgmmc_.wei_decomp_zero_points_group_k)
+                        * bgmmc_.wei_decomp_zero_points_stride_k
+                + n;
+        // two s4/u4 values are packed into a byte
+        return wei_decomp_zero_points_ptr_
+                + (utils::one_of(dt, data_type::s4, data_type::u4)
+                                ? off / 2
+                                : off * types::data_type_size(dt));
+    }
+
+    // Returns the number of rows of B from the row k to the end of its
+    // group of the weights decompression parameters
+    int get_wei_decomp_group_rows(int k) const {
+        int rows = bgmmc_.K;
+        if (bgmmc_.with_wei_decomp_scales) {
+            const int group = bgmmc_.wei_decomp_scales_group_k;
+            rows = nstl::min(rows, group - k % group);
+        }
+        if (bgmmc_.with_wei_decomp_zero_points) {
+            const int group = bgmmc_.wei_decomp_zero_points_group_k;
+            rows = nstl::min(rows, group - k % group);
+        }
+        return rows;
+    }
+
     const int32_t *get_zp_ab_mixed_comp_ptr() const {
         return &zero_point_mixed_ab_compensation_component_;
     }
@@ -1391,6 +1623,7 @@ private:
     char *buf_B_ptr_;
     char *buf_C_ptr_;
     char *buf_D_ptr_;
+    char *buf_acc_ptr_;
 
     char *wsp_tile_ptr_;
     const char *bias_ptr_;
@@ -1404,6 +1637,10 @@ private:
 
     int32_t zero_point_a_negative_val_;
     int32_t zero_point_b_negative_val_;
+    const char *wei_decomp_scales_ptr_;
+    const char *wei_decomp_zero_points_ptr_;
+    const void *wei_acc_scales_ptr_;
+    const void *wei_acc_zero_points_ptr_;
     int32_t zero_point_mixed_ab_compensation_component_;
     int32_t zero_point_c_val_;
     std::vector<const void *> post_ops_binary_rhs_arg_vec_;
@@ -1782,6 +1782,99 @@ void jit_brgemm_matmul_copy_b_int8_t<Vmm>::generate() {
     postamble();
 }
 
+// Prepares the constants used by load_int4_as_f32(): the per lane shifts
+// extracting the value from the low or high half of a byte and the mask of a
+// 4-bit value.
+static void init_int4_consts(jit_generator *h, data_type_t dt,
+        const Zmm &zmm_shift, const Zmm &zmm_mask, const Reg64 &reg_tmp) {
+    alignas(64) static constexpr const uint32_t u4_shifts[16]
+            = {0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4, 0, 4};
+    // s4 values are shifted to the top of a dword to be sign extended
+    alignas(64) static constexpr const uint32_t s4_shifts[16] = {28, 24, 28,
+            24, 28, 24, 28, 24, 28, 24, 28, 24, 28, 24, 28, 24};
+
+    const uint32_t *shifts = dt == data_type::s4 ? s4_shifts : u4_shifts;
+    h->mov(reg_tmp, reinterpret_cast<size_t>(shifts));
+    h->vmovdqa32(zmm_shift, h->ptr[reg_tmp]);
+    h->mov(reg_tmp.cvt32(), 0xf);
+    h->vpbroadcastd(zmm_mask, reg_tmp.cvt32());
+}
+
+// Loads 16 packed s4/u4 values, i.e. up to 8 bytes selected by the byte mask,
+// and converts them to f32. The values not loaded are set to zero.
+static void load_int4_as_f32(jit_generator *h, data_type_t dt, const Zmm &zmm,
+        const Address &addr, const Opmask &kmask, const Zmm &zmm_shift,
+        const Zmm &zmm_mask) {
+    const Xmm xmm(zmm.getIdx());
+    h->vmovdqu8(xmm | kmask | h->T_z, addr);
+    // duplicate every byte, so that a dword lane gets the byte of its value
+    h->vpunpcklbw(xmm, xmm, xmm);
+    h->vpmovzxbd(zmm, xmm);
+    if (dt == data_type::s4) {
+        h->vpsllvd(zmm, zmm, zmm_shift);
+        h->vpsrad(zmm, zmm, 28);
+    } else {
+        h->vpsrlvd(zmm, zmm, zmm_shift);
+        h->vpandd(zmm, zmm, zmm_mask);
+    }
+    h->vcvtdq2ps(zmm, zmm);
+}
+
+// Applies the weights decompression parameters of the current group to 16
+// decompressed values of a row of B starting from the column n:
+// zmm = (zmm - zero_point) * scale. The parameters of the columns not selected
+// by the mask are set to zero.
+static void apply_wei_decomp_qparams(jit_generator *h,
+        const brgemm_matmul_conf_t *conf, const Zmm &zmm,
+        const Reg64 &reg_scales, const Reg64 &reg_zero_points, int n,
+        const Opmask &kmask, const Opmask &kmask_int4, const Zmm &zmm_tmp,
+        const Zmm &zmm_int4_shift, const Zmm &zmm_int4_mask) {
+    using namespace data_type;
+    const auto zmm_tmp_m = zmm_tmp | kmask | h->T_z;
+
+    if (conf->with_wei_decomp_zero_points) {
+        const auto dt = conf->wei_decomp_zero_points_dt;
+        switch (dt) {
+            case s32:
+                h->vcvtdq2ps(zmm_tmp_m,
+                        h->ptr[reg_zero_points + n * sizeof(int32_t)]);
+                break;
+            case s8:
+                h->vpmovsxbd(zmm_tmp_m, h->ptr[reg_zero_points + n]);
+                h->vcvtdq2ps(zmm_tmp, zmm_tmp);
+                break;
+            case u8:
+                h->vpmovzxbd(zmm_tmp_m, h->ptr[reg_zero_points + n]);
+                h->vcvtdq2ps(zmm_tmp, zmm_tmp);
+                break;
+            case s4:
+            case u4:
+                load_int4_as_f32(h, dt, zmm_tmp,
+                        h->ptr[reg_zero_points + n / 2], kmask_int4,
+                        zmm_int4_shift, zmm_int4_mask);
+                break;
+            default: assert(!"unsupported zero points data type");
+        }
+        h->vsubps(zmm, zmm, zmm_tmp);
+    }
+
+    if (conf->with_wei_decomp_scales) {
+        const auto dt = conf->wei_decomp_scales_dt;
+        const auto addr
+                = h->ptr[reg_scales + n * types::data_type_size(dt)];
+        switch (dt) {
+            case f32: h->vmovups(zmm_tmp_m, addr); break;
+            case bf16:
+                h->vpmovzxwd(zmm_tmp_m, addr);
+                h->vpslld(zmm_tmp, zmm_tmp, 16);
+                break;
+            case f16: h->vcvtph2ps(zmm_tmp_m, addr); break;
+            default: assert(!"unsupported scales data type");
+        }
+        h->vmulps(zmm, zmm, zmm_tmp);
+    }
+}
+
 template <typename Vmm>
 struct jit_brgemm_matmul_copy_b_bf16_t : public jit_brgemm_matmul_copy_b_t,
                                          public jit_generator {
@@ -1792,11 +1885,16 @@ struct jit_brgemm_matmul_copy_b_bf16_t : public jit_brgemm_matmul_copy_b_t,
         , jit_generator(jit_name())
         , typesize(conf->b_dt_sz)
         , tr_typesize(conf->tr_b_dt_sz)
+        , is_int4(conf->is_int4_weights)
+        , is_f32_in(conf->is_bf32 || is_int4)
+        , with_wei_decomp_qparams(conf->with_wei_decomp_scales
+                  || conf->with_wei_decomp_zero_points)
         , src_stride(conf_->wei_tag == format_tag::acbd
                           ? conf->copy_B_wei_stride
                           : conf->req_wei_vnni_downconvert
                           ? conf_->LDB * typesize
-                          : conf_->N * typesize)
+                          : is_int4 ? conf_->N / 2
+                                    : conf_->N * typesize)
         , tr_src_stride(conf_->LDB * k_blk_step * tr_typesize) {}
 
     void operator()(ctx_t *ctx) override { jit_generator::operator()(ctx); }
@@ -1811,10 +1909,15 @@ private:
 
     enum { k_blk_step = 2, n_blk_step = 16 };
     const int typesize, tr_typesize;
+    // s4/u4 weights are up-converted to f32 first and then handled as bf32
+    const bool is_int4, is_f32_in;
+    const bool with_wei_decomp_qparams;
     const dim_t src_stride, tr_src_stride;
 
     opmask_t kTail = k7;
     opmask_t kFFFF = k6;
+    opmask_t kInt4Tail = k5;
+    opmask_t kInt4Full = k4;
 
     reg64_t reg_src = rax;
     reg64_t reg_tr_src = rbx;
@@ -1822,17 +1925,22 @@ private:
     reg64_t reg_K_iters = r8;
     reg64_t reg_N_blk = r9;
     reg64_t reg_K_start = r10;
+    reg64_t reg_wei_scales = r11;
+    reg64_t reg_wei_zero_points = r12;
     reg32_t regw_tmp = r14d;
     reg64_t imm_addr64 = r15;
 
     Vmm vmm_zero = Vmm(0);
     Vmm vmm_permw = Vmm(1);
     Vmm vmm_tmp = Vmm(1); // used only for avx2_vnni_2
+    zmm zmm_int4_shift = zmm(2); // used only for s4/u4 weights
+    zmm zmm_int4_mask = zmm(3);
+    zmm zmm_wei_decomp_tmp = zmm(4);
 
     void kmovx(Opmask k, unsigned w) {
         if (!isa_has_masks(conf_->isa)) return;
         mov(regw_tmp, w);
-        if (conf_->is_bf32)
+        if (is_f32_in)
             jit_generator::kmovw(k, regw_tmp);
         else
             jit_generator::kmovd(k, regw_tmp);
@@ -1856,9 +1964,10 @@ void jit_brgemm_matmul_copy_b_bf16_t<Vmm>::copy_2x32_vnni(
     const int columns_tail = ncolumns % n_blk_step;
     const auto tail_mask = (1 << columns_tail) - 1;
     if (columns_tail < n_blk_step) kmovx(kTail, tail_mask);
+    if (is_int4) kmovx(kInt4Tail, (1 << (columns_tail / 2)) - 1);
 
     const int blk_sz = k_blk_step;
-    constexpr int reserved_regs = 2;
+    const int reserved_regs = is_int4 ? (with_wei_decomp_qparams ? 5 : 4) : 2;
     const int max_isa_regs = isa_num_vregs(conf_->isa);
     const int max_regs_available = max_isa_regs - reserved_regs;
     const int max_unroll = max_regs_available / blk_sz;
@@ -1873,13 +1982,26 @@ void jit_brgemm_matmul_copy_b_bf16_t<Vmm>::copy_2x32_vnni(
     auto load = [=](int blk, int k, int n) {
         auto src_reg = get_vmm(blk, k % k_blk_step);
         const bool is_tail = ncolumns - n < n_blk_step;
+        if (is_int4) {
+            const auto kmask = is_tail ? kTail : kFFFF;
+            const auto kmask_int4 = is_tail ? kInt4Tail : kInt4Full;
+            load_int4_as_f32(this, conf_->orig_wei_dt, zmm(src_reg.getIdx()),
+                    ptr[reg_src + k * src_stride + n / 2], kmask_int4,
+                    zmm_int4_shift, zmm_int4_mask);
+            if (with_wei_decomp_qparams)
+                apply_wei_decomp_qparams(this, conf_, zmm(src_reg.getIdx()),
+                        reg_wei_scales, reg_wei_zero_points, n, kmask,
+                        kmask_int4, zmm_wei_decomp_tmp, zmm_int4_shift,
+                        zmm_int4_mask);
+            return;
+        }
         auto src_load = maybe_mask(src_reg, is_tail);
         auto load_addr = maybe_EVEX_compress_addr(
                 reg_src, k * src_stride + n * typesize);
         if (is_tail && !isa_has_masks(conf_->isa)) {
             uni_vxorps(src_load, src_load, src_load);
             load_bytes(src_load, load_addr, columns_tail * tr_typesize);
-        } else if (IMPLICATION(isa_has_masks(conf_->isa), conf_->is_bf32)) {
+        } else if (IMPLICATION(isa_has_masks(conf_->isa), is_f32_in)) {
             uni_vmovups(src_load, load_addr);
         } else {
             vmovdqu16(src_load, load_addr);
@@ -1912,13 +2034,13 @@ void jit_brgemm_matmul_copy_b_bf16_t<Vmm>::copy_2x32_vnni(
 
         if (nrows - k >= k_blk_step) {
             load(blk_idx, k + 1, n);
-            if (conf_->is_bf32) {
+            if (is_f32_in) {
                 vcvtne2ps2bf16(src_vmm0, src_vmm1, src_vmm0);
             } else if (is_superset(conf_->isa, avx512_core)) {
                 const auto src_ymm1 = ymm(src_vmm1.getIdx());
                 vinsertf64x4(src_zmm0, src_zmm0, src_ymm1, 1);
             }
-        } else if (conf_->is_bf32) {
+        } else if (is_f32_in) {
             vcvtneps2bf16(ymm(src_vmm0.getIdx()), src_vmm0);
         } else if (!is_superset(conf_->isa, avx512_core)) {
             uni_vxorps(src_vmm1, src_vmm1, src_vmm1);
@@ -1953,6 +2075,12 @@ void jit_brgemm_matmul_copy_b_bf16_t<Vmm>::init_masks() {
         mov(imm_addr64, reinterpret_cast<size_t>(bf16_vnni_permute));
         vmovdqa64(vmm_permw, ptr[imm_addr64]);
     }
+
+    if (is_int4) {
+        kmovx(kInt4Full, 0xff); // 8 bytes of 16 packed values
+        init_int4_consts(this, conf_->orig_wei_dt, zmm_int4_shift,
+                zmm_int4_mask, imm_addr64);
+    }
 }
 
 template <typename Vmm>
@@ -1965,6 +2093,11 @@ void jit_brgemm_matmul_copy_b_bf16_t<Vmm>::generate() {
     mov(reg_tr_src, ptr[param1 + GET_OFF(tr_src)]);
     mov(reg_K_iters, ptr[param1 + GET_OFF(current_K_iters)]);
     mov(reg_N_blk, ptr[param1 + GET_OFF(current_N_blk)]);
+    if (with_wei_decomp_qparams) {
+        mov(reg_wei_scales, ptr[param1 + GET_OFF(wei_decomp_scales_ptr)]);
+        mov(reg_wei_zero_points,
+                ptr[param1 + GET_OFF(wei_decomp_zero_points_ptr)]);
+    }
 
     init_masks();
     auto compute_K_loop = [=](bool is_N_tail) {
@@ -2036,12 +2169,20 @@ struct jit_brgemm_matmul_copy_b_f32_t : public jit_brgemm_matmul_copy_b_t,
     jit_brgemm_matmul_copy_b_f32_t(const brgemm_matmul_conf_t *conf)
         : jit_brgemm_matmul_copy_b_t(conf)
         , jit_generator(jit_name())
-        , dt_in_(conf->isa == avx512_core_fp16 ? data_type::f16
-                                               : data_type::f32)
+        , dt_in_(conf->is_int4_weights
+                          ? conf->orig_wei_dt
+                          : conf->isa == avx512_core_fp16 ? data_type::f16
+                                                          : data_type::f32)
+        , is_int4_(conf->is_int4_weights)
+        , with_wei_decomp_qparams_(conf->with_wei_decomp_scales
+                  || conf->with_wei_decomp_zero_points)
         , typesize_in_(types::data_type_size(dt_in_))
-        , src_stride_(conf_->wei_tag == acbd ? conf_->copy_B_wei_stride
-                                             : conf_->N * typesize_in_)
-        , tr_src_stride_(conf_->LDB * typesize_out_) {}
+        , src_stride_(conf_->wei_tag == acbd
+                          ? conf_->copy_B_wei_stride
+                          : is_int4_ ? conf_->N / 2 : conf_->N * typesize_in_)
+        , tr_src_stride_(conf_->LDB * typesize_out_)
+        , max_regs_available_(
+                  is_int4_ ? (with_wei_decomp_qparams_ ? 27 : 28) : 30) {}
 
     void operator()(ctx_t *ctx) override { jit_generator::operator()(ctx); }
     status_t create_kernel() override { return jit_generator::create_kernel(); }
@@ -2052,14 +2193,21 @@ private:
     using opmask_t = const Xbyak::Opmask;
     using zmm = const Xbyak::Zmm;
 
-    enum { n_blk_step = 16, max_regs_available = 30 };
+    enum { n_blk_step = 16 };
     const data_type_t dt_in_;
+    const bool is_int4_;
+    const bool with_wei_decomp_qparams_;
     const size_t typesize_in_;
     const size_t typesize_out_ = sizeof(float);
     dim_t src_stride_, tr_src_stride_;
+    // zmm28 and zmm29 hold the constants for s4/u4 weights, zmm27 is used
+    // to apply the weights decompression parameters
+    const int max_regs_available_;
 
     opmask_t kTail = k7;
     opmask_t kFFFF = k6;
+    opmask_t kInt4Tail = k5;
+    opmask_t kInt4Full = k4;
 
     reg64_t reg_src = rax;
     reg64_t reg_tr_src = rbx;
@@ -2067,9 +2215,14 @@ private:
     reg64_t reg_K_iters = r8;
     reg64_t reg_N_blk = r9;
     reg64_t reg_K_start = r10;
+    reg64_t reg_wei_scales = r11;
+    reg64_t reg_wei_zero_points = r12;
     reg32_t regw_tmp = r14d;
     reg64_t imm_addr64 = r15;
 
+    zmm zmm_wei_decomp_tmp = zmm27;
+    zmm zmm_int4_shift = zmm28;
+    zmm zmm_int4_mask = zmm29;
     zmm zmm_permw = zmm30;
     zmm zmm_zero = zmm31;
 
@@ -2086,12 +2239,24 @@ void jit_brgemm_matmul_copy_b_f32_t::copy_16_x_n_block(
         int nrows, int ncolumns) {
 
     auto get_zmm = [=](int reg_idx) {
-        assert(reg_idx >= 0 && reg_idx < max_regs_available);
+        assert(reg_idx >= 0 && reg_idx < max_regs_available_);
         return zmm(reg_idx);
     };
 
     auto load = [=](int blk, int k, int n, opmask_t current_mask) {
         auto src_zmm = get_zmm(blk);
+        if (is_int4_) {
+            const auto kmask_int4
+                    = current_mask == kTail ? kInt4Tail : kInt4Full;
+            load_int4_as_f32(this, dt_in_, src_zmm,
+                    ptr[reg_src + k * src_stride_ + n / 2], kmask_int4,
+                    zmm_int4_shift, zmm_int4_mask);
+            if (with_wei_decomp_qparams_)
+                apply_wei_decomp_qparams(this, conf_, src_zmm, reg_wei_scales,
+                        reg_wei_zero_points, n, current_mask, kmask_int4,
+                        zmm_wei_decomp_tmp, zmm_int4_shift, zmm_int4_mask);
+            return;
+        }
         auto src_zmm_m = src_zmm | current_mask | T_z;
         auto addr = EVEX_compress_addr(
                 reg_src, k * src_stride_ + n * typesize_in_);
@@ -2104,6 +2269,7 @@ void jit_brgemm_matmul_copy_b_f32_t::copy_16_x_n_block(
     const int columns_tail = ncolumns % n_blk_step;
     const auto tail_mask = (1 << columns_tail) - 1;
     if (columns_tail < n_blk_step) kmovw(kTail, tail_mask);
+    if (is_int4_) kmovw(kInt4Tail, (1 << (columns_tail / 2)) - 1);
 
     int iter = 0;
     for_(int k = 0; k < nrows; k++)
@@ -2118,7 +2284,7 @@ void jit_brgemm_matmul_copy_b_f32_t::copy_16_x_n_block(
         }
 
         const opmask_t curr_msk = zero_padding < n_blk_step ? kTail : kFFFF;
-        const int blk_idx = iter % max_regs_available;
+        const int blk_idx = iter % max_regs_available_;
         load(blk_idx, k, n, curr_msk);
 
         const auto src_zmm0 = get_zmm(blk_idx);
@@ -2159,7 +2325,17 @@ void jit_brgemm_matmul_copy_b_f32_t::generate() {
     mov(reg_tr_src, ptr[param1 + GET_OFF(tr_src)]);
     mov(reg_K_iters, ptr[param1 + GET_OFF(current_K_iters)]);
     mov(reg_N_blk, ptr[param1 + GET_OFF(current_N_blk)]);
+    if (with_wei_decomp_qparams_) {
+        mov(reg_wei_scales, ptr[param1 + GET_OFF(wei_decomp_scales_ptr)]);
+        mov(reg_wei_zero_points,
+                ptr[param1 + GET_OFF(wei_decomp_zero_points_ptr)]);
+    }
     kmovw(kFFFF, 0xffff); // 1111111111111111
+    if (is_int4_) {
+        kmovw(kInt4Full, 0xff); // 8 bytes of 16 packed values
+        init_int4_consts(
+                this, dt_in_, zmm_int4_shift, zmm_int4_mask, imm_addr64);
+    }
 
     Label done;
     if (conf_->N_tail > 0) {
@@ -167,9 +167,10 @@ brgemm_matmul_conf_utils_t::brgemm_matmul_conf_utils_t(
     , blocked_48n_B_layout_tag(pick_blocked_B_layout(48))
     , blocked_32n_B_layout_tag(pick_blocked_B_layout(32))
     , blocked_16n_B_layout_tag(pick_blocked_B_layout(16))
-    , blocked_B_layouts_allowed(!utils::one_of(format_tag::undef,
-              blocked_64n_B_layout_tag, blocked_48n_B_layout_tag,
-              blocked_32n_B_layout_tag, blocked_16n_B_layout_tag))
+    , blocked_B_layouts_allowed(!bgmmc.is_int4_weights
+              && !utils::one_of(format_tag::undef, blocked_64n_B_layout_tag,
+                      blocked_48n_B_layout_tag, blocked_32n_B_layout_tag,
+                      blocked_16n_B_layout_tag))
     , n_blk_fixed((!B_any_layout) && blocked_B_layouts_allowed)
     , isa_(isa) {
     assert(int8_dt || bf16_dt || f16_dt || f32_dt || bf32_dt);
@@ -910,6 +911,19 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     bgmmc.src_dt = src_d.data_type();
     bgmmc.dst_dt = dst_d.data_type();
     bgmmc.wei_dt = weights_d.data_type();
+    bgmmc.orig_wei_dt = bgmmc.wei_dt;
+
+    // Weights decompression: the s4/u4 weights are up-converted to the source
+    // data type during copy B, so BRGeMM computes as if the weights were in
+    // the source data type.
+    bgmmc.is_int4_weights = one_of(bgmmc.wei_dt, s4, u4);
+    if (bgmmc.is_int4_weights) {
+        VCONDCHECK_BG(attr.fpmath_apply_to_int_
+                        && one_of(bgmmc.src_dt, f32, bf16)
+                        && is_superset(isa, avx512_core),
+                VERBOSE_UNSUPPORTED_DT);
+        bgmmc.wei_dt = bgmmc.src_dt;
+    }
 
     bgmmc.with_bias = mmd.bias_desc.format_kind != format_kind::undef;
     bgmmc.bia_dt = bgmmc.with_bias ? mmd.bias_desc.data_type : data_type::undef;
@@ -932,6 +946,13 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
 
     bgmmc.is_bf32 = bm_conf_utils.is_bf32();
 
+    if (bgmmc.is_int4_weights) {
+        VCONDCHECK_BG(!bgmmc.is_bf32, VERBOSE_UNSUPPORTED_FPMATH_MODE);
+        // B_strides and B offsets are computed in elements and halved when
+        // the weights are accessed
+        bgmmc.b_dt_sz = 1;
+    }
+
     // Make BRGeMM compute MatMul as if it were in bfloat16, while down-convert
     // happens during copy-buffer computations
     if (bgmmc.is_bf32) {
@@ -955,16 +976,43 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
 
     const auto &src_scales = attr.scales_.get(DNNL_ARG_SRC);
     const auto &wei_scales = attr.scales_.get(DNNL_ARG_WEIGHTS);
-    bgmmc.with_scales = !src_scales.has_default_values()
-            || !wei_scales.has_default_values();
+    const auto &zp = attr.zero_points_;
+    bgmmc.with_wei_group_acc = bm_conf_utils.is_int8()
+            && ((!wei_scales.has_default_values()
+                        && (!wei_scales.has_default_groups()
+                                || !wei_scales.has_default_data_type()))
+                    || (!zp.has_default_values(DNNL_ARG_WEIGHTS)
+                            && (!zp.common(DNNL_ARG_WEIGHTS)
+                                    || zp.get_data_type(DNNL_ARG_WEIGHTS)
+                                            != s32)));
+    // group-wise weights scales are applied during the weights decompression
+    // instead of the output scales
+    bgmmc.with_wei_decomp_scales = !wei_scales.has_default_values()
+            && !wei_scales.has_default_groups();
+    if (bgmmc.with_wei_decomp_scales) {
+        VCONDCHECK_BG(bgmmc.is_int4_weights, VERBOSE_UNSUPPORTED_SCALES_CFG);
+        bgmmc.wei_decomp_scales_dt = wei_scales.data_type_;
+        bgmmc.wei_decomp_scales_group_k = wei_scales.group_dims_[0];
+    }
+    const bool with_wei_oscales = !wei_scales.has_default_values()
+            && !bgmmc.with_wei_decomp_scales && !bgmmc.with_wei_group_acc;
+    // the source scales are applied with the weights ones
+    bgmmc.with_scales = !bgmmc.with_wei_group_acc
+            && (!src_scales.has_default_values() || with_wei_oscales);
     if (bgmmc.with_scales) {
-        bgmmc.is_oscale_per_n = wei_scales.mask_ == 1 << (bgmmc.ndims - 1);
+        bgmmc.is_oscale_per_n = with_wei_oscales
+                && wei_scales.mask_ == 1 << (bgmmc.ndims - 1);
 
         // only common and per-oc-channel scales are supported
-        VCONDCHECK_BG(wei_scales.mask_ == 0 || bgmmc.is_oscale_per_n,
+        VCONDCHECK_BG(!with_wei_oscales || wei_scales.mask_ == 0
+                        || bgmmc.is_oscale_per_n,
+                VERBOSE_UNSUPPORTED_SCALES_CFG);
+        VCONDCHECK_BG(IMPLICATION(with_wei_oscales,
+                              wei_scales.has_default_data_type()),
                 VERBOSE_UNSUPPORTED_SCALES_CFG);
     }
 
+
     const auto &dst_scales = attr.scales_.get(DNNL_ARG_DST);
     bgmmc.with_dst_scales = !dst_scales.has_default_values();
     // only common scales are supported
@@ -981,7 +1029,10 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     VCONDCHECK_BG(post_ops_ok(bgmmc, attr, dst_d), VERBOSE_UNSUPPORTED_POSTOP);
 
     bgmmc.src_zp_type = get_zp_type(attr, DNNL_ARG_SRC);
-    bgmmc.wei_zp_type = get_zp_type(attr, DNNL_ARG_WEIGHTS);
+    bgmmc.wei_zp_type
+            = bgmmc.with_wei_decomp_zero_points || bgmmc.with_wei_group_acc
+            ? brgemm_broadcast_t::none
+            : get_zp_type(attr, DNNL_ARG_WEIGHTS);
     bgmmc.dst_zp_type = get_zp_type(attr, DNNL_ARG_DST);
 
     VCONDCHECK_BG(
@@ -1001,11 +1052,74 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     bgmmc.is_runtime_N = is_runtime_value(bgmmc.N);
     bgmmc.is_runtime_K = is_runtime_value(bgmmc.K);
 
+    bgmmc.with_wei_decomp_zero_points = bgmmc.is_int4_weights
+            && !zp.has_default_values(DNNL_ARG_WEIGHTS);
+    if (bgmmc.with_wei_decomp_zero_points) {
+        int zp_mask = 0;
+        zp.get(DNNL_ARG_WEIGHTS, &zp_mask);
+        // the common zero point is not supported
+        VCONDCHECK_BG(zp_mask != 0, VERBOSE_UNSUPPORTED_ZP_CFG);
+        const bool is_grouped = zp.get_group_ndims(DNNL_ARG_WEIGHTS) > 0;
+        bgmmc.wei_decomp_zero_points_dt = zp.get_data_type(DNNL_ARG_WEIGHTS);
+        bgmmc.wei_decomp_zero_points_group_k = is_grouped
+                ? zp.get_group_dims(DNNL_ARG_WEIGHTS)[0]
+                : bgmmc.K;
+        bgmmc.wei_decomp_zero_points_stride_k = is_grouped ? bgmmc.N : 0;
+    }
+    // bf16 weights are copied in pairs of rows along K, so that a pair must
+    // not cross the boundary of a group
+    const bool is_even_scales_group = IMPLICATION(bgmmc.with_wei_decomp_scales,
+            bgmmc.wei_decomp_scales_group_k % 2 == 0);
+    const bool is_even_zp_group = IMPLICATION(
+            bgmmc.wei_decomp_zero_points_stride_k > 0,
+            bgmmc.wei_decomp_zero_points_group_k % 2 == 0);
+    VCONDCHECK_BG(IMPLICATION(bgmmc.wei_dt == bf16,
+                          is_even_scales_group && is_even_zp_group),
+            VERBOSE_UNSUPPORTED_ATTR);
+
     // runtime value for M dimension is only supported
     if (is_runtime_value(bgmmc.batch) || bgmmc.is_runtime_N
             || bgmmc.is_runtime_K)
         return status::unimplemented;
 
+    if (bgmmc.with_wei_group_acc) {
+        // the results are dequantized out of the kernel, which doesn't apply
+        // any other zero points, compensations or post-ops then
+        VCONDCHECK_BG(everyone_is(brgemm_broadcast_t::none, bgmmc.src_zp_type,
+                              bgmmc.dst_zp_type)
+                        && !bgmmc.s8s8_compensation_required
+                        && attr.post_ops_.len() == 0 && !bgmmc.is_runtime_M,
+                VERBOSE_UNSUPPORTED_ATTR);
+        const int mask_N = 1 << (bgmmc.ndims - 1);
+        if (!wei_scales.has_default_values()) {
+            const bool is_grouped = !wei_scales.has_default_groups();
+            bgmmc.wei_acc_scales_dt = wei_scales.data_type_;
+            bgmmc.wei_acc_scales_group_k
+                    = is_grouped ? wei_scales.group_dims_[0] : bgmmc.K;
+            bgmmc.wei_acc_scales_stride_k = is_grouped ? bgmmc.N : 0;
+            bgmmc.wei_acc_scales_stride_n = (wei_scales.mask_ & mask_N) ? 1 : 0;
+        }
+        if (!zp.has_default_values(DNNL_ARG_WEIGHTS)) {
+            int zp_mask = 0;
+            zp.get(DNNL_ARG_WEIGHTS, &zp_mask);
+            const bool is_grouped = zp.get_group_ndims(DNNL_ARG_WEIGHTS) > 0;
+            bgmmc.wei_acc_zero_points_dt = zp.get_data_type(DNNL_ARG_WEIGHTS);
+            bgmmc.wei_acc_zero_points_group_k = is_grouped
+                    ? zp.get_group_dims(DNNL_ARG_WEIGHTS)[0]
+                    : bgmmc.K;
+            bgmmc.wei_acc_zero_points_stride_k = is_grouped ? bgmmc.N : 0;
+            bgmmc.wei_acc_zero_points_stride_n = (zp_mask & mask_N) ? 1 : 0;
+        }
+        // a K chunk must not cross the boundary of a scales or zero points
+        // group
+        bgmmc.wei_group_acc_k = bgmmc.K;
+        for (dim_t group_k : {bgmmc.wei_acc_scales_group_k,
+                     bgmmc.wei_acc_zero_points_group_k})
+            if (group_k > 0)
+                bgmmc.wei_group_acc_k = math::gcd(static_cast<int>(group_k),
+                        static_cast<int>(bgmmc.wei_group_acc_k));
+    }
+
     // runtime value for M dimension is supported for 2d amx problems only
     if (!IMPLICATION(bgmmc.is_runtime_M, bgmmc.is_amx && bgmmc.ndims == 2))
         return status::unimplemented;
@@ -1038,6 +1152,12 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
             VERBOSE_UNSUPPORTED_TAG);
     VCHECK_BG(bm_conf_utils.set_or_check_B_tag(weights_md),
             VERBOSE_UNSUPPORTED_TAG);
+    // Only the plain B layout with an even N is supported for the packed
+    // weights, so that every row of B starts at a byte boundary.
+    VCONDCHECK_BG(IMPLICATION(bgmmc.is_int4_weights,
+                          bm_conf_utils.check_is_plain(bgmmc.wei_tag)
+                                  && bgmmc.N % 2 == 0),
+            VERBOSE_UNSUPPORTED_TAG);
 
     bgmmc.req_wei_vnni_downconvert = bm_conf_utils.wei_down_convert_to_vnni();
 
@@ -1116,6 +1236,21 @@ status_t init_brgemm_matmul_conf(cpu_isa_t isa, brgemm_matmul_conf_t &bgmmc,
     VCHECK_BG(compute_blocking_heuristic(bgmmc, bm_conf_utils),
             VERBOSE_BLOCKING_FAIL);
 
+    if (bgmmc.with_wei_group_acc) {
+        // A K chunk covers a single group, so that its s32 result is complete
+        // when it is dequantized. The whole K is a single group otherwise and
+        // may end with a K tail.
+        const dim_t group_k = bgmmc.wei_group_acc_k;
+        if (bgmmc.K_blk > group_k && group_k % bgmmc.wei_k_blk == 0)
+            bgmmc.K_blk = group_k;
+        VCONDCHECK_BG(group_k == bgmmc.K || group_k % bgmmc.K_blk == 0,
+                VERBOSE_BLOCKING_FAIL);
+        bgmmc.brgemm_batch_size
+                = nstl::max(group_k / bgmmc.K_blk, static_cast<dim_t>(1));
+        bgmmc.nthr_k = 1;
+        bgmmc.use_buffer_c = true;
+    }
+
     if (bgmmc.wei_n_blk > bgmmc.N_blk
             && IMPLICATION(
                     bgmmc.N == bgmmc.N_blk, bgmmc.N >= bgmmc.wei_n_blk)) {
@@ -1232,11 +1367,15 @@ void init_aux_values(brgemm_matmul_conf_t &bgmmc,
     bgmmc.has_zero_point_a = bgmmc.src_zp_type != brgemm_broadcast_t::none;
     bgmmc.has_zero_point_b = bgmmc.wei_zp_type != brgemm_broadcast_t::none;
     bgmmc.has_zero_point_c = bgmmc.dst_zp_type != brgemm_broadcast_t::none;
-    bgmmc.post_ops_applicable = one_of(true, bgmmc.with_sum, bgmmc.with_bias,
-            bgmmc.with_scales, bgmmc.with_eltwise, bgmmc.with_binary,
-            bgmmc.acc_dt != bgmmc.dst_dt, bgmmc.s8s8_compensation_required,
-            bgmmc.has_zero_point_a, bgmmc.has_zero_point_b,
-            bgmmc.has_zero_point_c, bgmmc.with_dst_scales);
+    // the bias and the output conversion follow the dequantization of the
+    // groups, out of the kernel
+    bgmmc.post_ops_applicable = !bgmmc.with_wei_group_acc
+            && one_of(true, bgmmc.with_sum, bgmmc.with_bias,
+                    bgmmc.with_scales, bgmmc.with_eltwise, bgmmc.with_binary,
+                    bgmmc.acc_dt != bgmmc.dst_dt,
+                    bgmmc.s8s8_compensation_required, bgmmc.has_zero_point_a,
+                    bgmmc.has_zero_point_b, bgmmc.has_zero_point_c,
+                    bgmmc.with_dst_scales);
 
     bgmmc.zp_a_comp_shift_n = bgmmc.wei_n_blk;
     bgmmc.zp_a_comp_elems_per_thr
@@ -1280,6 +1419,11 @@ void init_scratchpad(memory_tracking::registrar_t &scratchpad,
         scratchpad.book(key_brgemm_primitive_buffer,
                 bgmmc.nthr * bgmmc.buffer_c_per_thread_sz, default_data_align);
 
+    // the f32 accumulation buffer has the layout of the s32 buffer C
+    if (bgmmc.with_wei_group_acc)
+        scratchpad.book(key_brgemm_primitive_buffer_acc,
+                bgmmc.nthr * bgmmc.buffer_c_per_thread_sz, default_data_align);
+
     if (bgmmc.has_zero_point_a) {
         const auto num_elems = bgmmc.nthr * bgmmc.zp_a_comp_elems_per_thr;
         scratchpad.book(key_brgemm_primitive_zp_comp_a, num_elems,
@@ -176,6 +176,36 @@ struct brgemm_matmul_conf_t {
 
     int required_k_granularity;
     bool is_bf32 = false;
+    // s4/u4 weights up-converted to wei_dt during copy B, in which case
+    // orig_wei_dt keeps the data type of the weights in memory
+    bool is_int4_weights = false;
+    data_type_t orig_wei_dt;
+    // group-wise weights scales and per N or group-wise weights zero points
+    // applied while decompressing the weights during copy B. The parameters
+    // of a group of rows along K are stored in a row of N elements.
+    bool with_wei_decomp_scales = false;
+    bool with_wei_decomp_zero_points = false;
+    data_type_t wei_decomp_scales_dt = data_type::undef;
+    data_type_t wei_decomp_zero_points_dt = data_type::undef;
+    dim_t wei_decomp_scales_group_k = 0;
+    dim_t wei_decomp_zero_points_group_k = 0;
+    dim_t wei_decomp_zero_points_stride_k = 0;
+    // int8 weights scales that are group-wise or not in f32, and weights zero
+    // points that are per N, group-wise or not in s32, can't be folded into
+    // the output scales or the compensations. A K chunk then covers a group
+    // of wei_group_acc_k rows and its s32 result is dequantized into an f32
+    // accumulation buffer. The parameters of a group of rows along K are
+    // stored in a row of N elements.
+    bool with_wei_group_acc = false;
+    dim_t wei_group_acc_k = 0;
+    data_type_t wei_acc_scales_dt = data_type::undef;
+    data_type_t wei_acc_zero_points_dt = data_type::undef;
+    dim_t wei_acc_scales_group_k = 0;
+    dim_t wei_acc_scales_stride_k = 0;
+    dim_t wei_acc_scales_stride_n = 0;
+    dim_t wei_acc_zero_points_group_k = 0;
+    dim_t wei_acc_zero_points_stride_k = 0;
+    dim_t wei_acc_zero_points_stride_n = 0;
     bool req_wei_vnni_downconvert = false;
     bool is_runtime_M = false;
     bool is_runtime_N = false;
@@ -201,6 +231,9 @@ struct brgemm_matmul_conf_utils_t {
     }
 
     inline bool use_buffer_b(bool use_heuristic = true) const {
+        // the packed weights are always decompressed into the buffer
+        if (bgmmc.is_int4_weights) return true;
+
         if (bgmmc.is_amx)
             // use b_buffer for AMX when:
             // - not bf32 && using non-blocked weights
@@ -14,8 +14,11 @@
  * limitations under the License.
  *******************************************************************************/
 
+#include <thread>
 #include <utility>
 
+#include "common/primitive_hashing.hpp"
+
 #include "graph/utils/any.hpp"
 #include "graph/utils/utils.hpp"
 
@@ -29,6 +32,128 @@ namespace impl {
 namespace graph {
 namespace autograph_impl {
 
+constexpr size_t layout_id_manager_t::first_chunk_bits_;
+constexpr size_t layout_id_manager_t::max_chunks_;
+constexpr size_t layout_id_manager_t::num_shards_;
+
+namespace {
+// The chunk k holds the layout ids in [2^(k+b) - 2^b, 2^(k+b+1) - 2^b), where
+// b is the number of bits of the first chunk.
+inline size_t get_chunk_index(size_t layout_id, size_t first_chunk_bits) {
+    size_t n = (layout_id >> first_chunk_bits) + 1;
+    size_t k = 0;
+    while (n >>= 1)
+        k++;
+    return k;
+}
+
+inline size_t get_chunk_begin(size_t chunk, size_t first_chunk_bits) {
+    return ((size_t(1) << chunk) - 1) << first_chunk_bits;
+}
+} // namespace
+
+layout_id_manager_t::layout_id_manager_t() {
+    for (auto &chunk : chunks_)
+        chunk.store(nullptr, std::memory_order_relaxed);
+}
+
+layout_id_manager_t::~layout_id_manager_t() {
+    const size_t num = num_mem_descs_.load();
+    for (size_t k = 0; k < max_chunks_; k++) {
+        slot_t *chunk = chunks_[k].load();
+        if (!chunk) continue;
+        const size_t begin = get_chunk_begin(k, first_chunk_bits_);
+        const size_t size = size_t(1) << (k + first_chunk_bits_);
+        for (size_t i = 0; i < size && begin + i < num; i++) {
+            delete chunk[i].load();
+        }
+        delete[] chunk;
+    }
+}
+
+layout_id_manager_t::slot_t *layout_id_manager_t::get_slot(
+        size_t layout_id) const {
+    const size_t k = get_chunk_index(layout_id, first_chunk_bits_);
+    if (k >= max_chunks_) return nullptr;
+    slot_t *chunk = chunks_[k].load(std::memory_order_acquire);
+    if (!chunk) return nullptr;
+    return &chunk[layout_id - get_chunk_begin(k, first_chunk_bits_)];
+}
+
+layout_id_manager_t::slot_t &layout_id_manager_t::get_or_alloc_slot(
+        size_t layout_id) {
+    const size_t k = get_chunk_index(layout_id, first_chunk_bits_);
+    assertm(k < max_chunks_, "too many layouts");
+    slot_t *chunk = chunks_[k].load(std::memory_order_acquire);
+    if (!chunk) {
+        // several shards may try to allocate the same chunk, only one of the
+        // allocated chunks is kept
+        const size_t size = size_t(1) << (k + first_chunk_bits_);
+        slot_t *new_chunk = new slot_t[size];
+        for (size_t i = 0; i < size; i++)
+            new_chunk[i].store(nullptr, std::memory_order_relaxed);
+        if (chunks_[k].compare_exchange_strong(chunk, new_chunk,
+                    std::memory_order_acq_rel, std::memory_order_acquire)) {
+            chunk = new_chunk;
+        } else {
+            delete[] new_chunk;
+        }
+    }
+    return chunk[layout_id - get_chunk_begin(k, first_chunk_bits_)];
+}
+
+graph::utils::optional_t<size_t> layout_id_manager_t::set_mem_desc(
+        const graph::utils::any_t &mem_desc) {
+    const size_t hash = get_mem_desc_hash(mem_desc);
+    shard_t &shard = shards_[hash % num_shards_];
+
+    auto find = [&]() -> graph::utils::optional_t<size_t> {
+        auto range = shard.ids_.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            const slot_t *slot = get_slot(it->second);
+            if (is_mem_desc_equal(*slot->load(std::memory_order_acquire),
+                        mem_desc))
+                return it->second;
+        }
+        return graph::utils::nullopt;
+    };
+
+    {
+        impl::utils::lock_read_t lock_r(shard.mutex_);
+        auto layout_id = find();
+        if (layout_id.has_value()) return layout_id;
+    }
+
+    impl::utils::lock_write_t lock_w(shard.mutex_);
+    // the mem desc may have been registered by other threads in between
+    auto layout_id = find();
+    if (layout_id.has_value()) return layout_id;
+
+    const size_t id = num_mem_descs_.fetch_add(1);
+    get_or_alloc_slot(id).store(
+            new graph::utils::any_t(mem_desc), std::memory_order_release);
+    shard.ids_.insert({hash, id});
+    return id;
+}
+
+graph::utils::optional_t<graph::utils::any_t> layout_id_manager_t::get_mem_desc(
+        size_t layout_id) const {
+    if (layout_id >= num_mem_descs_.load(std::memory_order_acquire))
+        return graph::utils::nullopt;
+    const slot_t *slot = get_slot(layout_id);
+    if (!slot) return graph::utils::nullopt;
+    // the id may be reserved but not published yet
+    const graph::utils::any_t *md = slot->load(std::memory_order_acquire);
+    if (!md) return graph::utils::nullopt;
+    return *md;
+}
+
+size_t dnnl_layout_id_manager_t::get_mem_desc_hash(
+        const graph::utils::any_t &mem_desc) const {
+    auto &md = graph::utils::any_cast<const memory::desc &>(mem_desc);
+    return primitive_hashing::get_md_hash(*md.get());
+}
+
 bool dnnl_layout_id_manager_t::is_mem_desc_equal(
         const graph::utils::any_t &mem_desc1,
         const graph::utils::any_t &mem_desc2) const {
@@ -18,6 +18,7 @@
 #define GRAPH_BACKEND_DNNL_DNNL_BACKEND_HPP
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <memory>
 #include <string>
@@ -25,6 +26,8 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "common/rw_mutex.hpp"
+
 #include "graph/interface/backend.hpp"
 #include "graph/interface/c_types_map.hpp"
 #include "graph/interface/logical_tensor.hpp"
@@ -33,6 +36,7 @@
 #include "graph/utils/pm/pass_manager.hpp"
 #include "graph/utils/utils.hpp"
 
+#include "graph/backend/autograph/cache_blob.hpp"
 #include "graph/backend/autograph/common.hpp"
 #include "graph/backend/autograph/internal_ops.hpp"
 #include "graph/backend/autograph/utils.hpp"
@@ -50,8 +54,11 @@ class dnnl_partition_impl_t;
 
 class layout_id_manager_t {
 public:
-    layout_id_manager_t() = default;
-    virtual ~layout_id_manager_t() = default;
+    layout_id_manager_t();
+    virtual ~layout_id_manager_t();
+
+    layout_id_manager_t(const layout_id_manager_t &) = delete;
+    layout_id_manager_t &operator=(const layout_id_manager_t &) = delete;
 
     /*! \brief Set a backend memory descriptor to manager and get a
     * corresponding layout id
@@ -62,26 +69,7 @@ public:
     * convert a md to layout id
     */
     virtual graph::utils::optional_t<size_t> set_mem_desc(
-            const graph::utils::any_t &mem_desc) {
-        std::lock_guard<std::mutex> lock(mem_descs_.m_);
-
-        auto pos
-                = std::find_if(mem_descs_.data_.begin(), mem_descs_.data_.end(),
-                        [&](const graph::utils::any_t &m) -> bool {
-                            return is_mem_desc_equal(m, mem_desc);
-                        });
-
-        size_t layout_id;
-        if (pos != mem_descs_.data_.end()) {
-            layout_id = static_cast<size_t>(
-                    std::distance(mem_descs_.data_.begin(), pos));
-        } else {
-            mem_descs_.data_.emplace_back(mem_desc);
-            layout_id = static_cast<size_t>(mem_descs_.data_.size() - 1);
-        }
-
-        return layout_id;
-    }
+            const graph::utils::any_t &mem_desc);
 
     /*! \brief Get a backend memory descriptor from manager by using a
     * layout id
@@ -90,19 +78,10 @@ public:
     * \return When the input is a valid cache index, the return value
     * is a cached memory descriptor; otherwise, the return value will
     * be a utils::nullopt
+    * \note This function is lock free
     */
     virtual graph::utils::optional_t<graph::utils::any_t> get_mem_desc(
-            size_t layout_id) const {
-        std::lock_guard<std::mutex> lock(mem_descs_.m_);
-        if (layout_id >= mem_descs_.data_.size()) return graph::utils::nullopt;
-        return mem_descs_.data_[layout_id];
-    }
-
-protected:
-    mutable struct {
-        std::vector<graph::utils::any_t> data_;
-        mutable std::mutex m_;
-    } mem_descs_;
+            size_t layout_id) const;
 
 private:
     /*! \brief compare two backend mem desc
@@ -112,6 +91,43 @@ private:
     */
     virtual bool is_mem_desc_equal(const graph::utils::any_t &mem_desc1,
             const graph::utils::any_t &mem_desc2) const = 0;
+
+    /*! \brief hash a backend mem desc. Equal mem descs must have equal
+    * hash values
+    * \param mem_desc
+    * \return size_t
+    */
+    virtual size_t get_mem_desc_hash(
+            const graph::utils::any_t &mem_desc) const = 0;
+
+    // The registered mem descs are never removed, so they are stored in an
+    // append-only table which can be read without lock. The table consists
+    // of chunks whose sizes are doubled one by one, so a chunk never moves
+    // once it's allocated. A slot is published by storing the pointer of its
+    // mem desc.
+    static constexpr size_t first_chunk_bits_ = 6;
+    static constexpr size_t max_chunks_
+            = sizeof(size_t) * 8 - first_chunk_bits_;
+    using slot_t = std::atomic<const graph::utils::any_t *>;
+
+    // get the slot of a layout id, or nullptr if its chunk is not allocated
+    slot_t *get_slot(size_t layout_id) const;
+    // get the slot of a layout id, allocate the chunk if needed
+    slot_t &get_or_alloc_slot(size_t layout_id);
+
+    std::atomic<slot_t *> chunks_[max_chunks_];
+    std::atomic<size_t> num_mem_descs_ {0};
+
+    // The index from the hash of a mem desc to its layout ids, which is
+    // sharded to reduce the contention of concurrent registrations. Equal mem
+    // descs always fall into the same shard, so the check and insertion under
+    // the shard's lock guarantee that each mem desc is registered only once.
+    static constexpr size_t num_shards_ = 16;
+    struct shard_t {
+        impl::utils::rw_mutex_t mutex_;
+        std::unordered_multimap<size_t, size_t> ids_;
+    };
+    mutable shard_t shards_[num_shards_];
 };
 
 class dnnl_layout_id_manager_t : public layout_id_manager_t {
@@ -123,68 +139,52 @@ class dnnl_layout_id_manager_t : public layout_id_manager_t {
     bool is_mem_desc_equal(const graph::utils::any_t &mem_desc1,
             const graph::utils::any_t &mem_desc2) const override;
 
+    size_t get_mem_desc_hash(
+            const graph::utils::any_t &mem_desc) const override;
+
 #ifdef DNNL_GRAPH_LAYOUT_DEBUG
     static const size_t LAST_TAG
             = static_cast<size_t>(dnnl::memory::format_tag::format_tag_last);
 
 public:
-    graph::utils::optional<graph::utils::any_t> get_mem_desc(
+    graph::utils::optional_t<graph::utils::any_t> get_mem_desc(
             size_t layout_id) const override {
-        std::lock_guard<std::mutex> lock(mem_descs_.m_);
-        layout_id -= LAST_TAG;
-        if (layout_id >= mem_descs_.data_.size()) return graph::utils::nullopt;
-        return mem_descs_.data_[layout_id];
+        return layout_id_manager_t::get_mem_desc(layout_id - LAST_TAG);
     }
 
-    graph::utils::optional<size_t> set_mem_desc(
+    graph::utils::optional_t<size_t> set_mem_desc(
             const graph::utils::any_t &mem_desc) override {
         auto &md = graph::utils::any_cast<const memory::desc &>(mem_desc);
-        size_t layout_id = 0;
-        {
-            std::lock_guard<std::mutex> lock(mem_descs_.m_);
-
-            auto pos = std::find_if(mem_descs_.data_.begin(),
-                    mem_descs_.data_.end(),
-                    [&](const graph::utils::any_t &m) -> bool {
-                        return is_mem_desc_equal(m, mem_desc);
-                    });
-            if (pos != mem_descs_.data_.end()) {
-                layout_id = static_cast<size_t>(std::distance(
-                                    mem_descs_.data_.begin(), pos))
-                        + LAST_TAG;
-            } else if (md.get_format_kind() != format_kind::blocked) {
-                mem_descs_.data_.emplace_back(mem_desc);
-                layout_id = mem_descs_.data_.size() - 1 + LAST_TAG;
-            }
+        if (md.get_format_kind() != format_kind::blocked) {
+            size_t layout_id
+                    = layout_id_manager_t::set_mem_desc(mem_desc).value();
+            return layout_id + LAST_TAG;
         }
 
-        if (md.get_format_kind() == format_kind::blocked) {
-            size_t format_tag = static_cast<size_t>(get_format_tag(md));
-
-            if (!(format_tag > 0 && format_tag < dnnl_format_tag_last)) {
-                size_t layout_id
-                        = layout_id_manager_t::set_mem_desc(mem_desc).value();
-                return layout_id + LAST_TAG;
-            }
+        size_t format_tag = static_cast<size_t>(get_format_tag(md));
+        if (!(format_tag > 0 && format_tag < dnnl_format_tag_last)) {
+            size_t layout_id
+                    = layout_id_manager_t::set_mem_desc(mem_desc).value();
+            return layout_id + LAST_TAG;
+        }
 
-            // Check if md has extra flags. Note that since onednn didn't
-            // provide api to check extra flags, here we construct a temp md
-            // without extra flag, and then compare it with the origin md. If
-            // they are not equal, the origin md may has extra flags. Only using
-            // shape, data type and format tag can't describe the md anymore, so
-            // we must cache it to layout id manager.
-            const auto &dims = md.get_dims();
-            const auto &dtype = md.get_data_type();
-            memory::desc temp_md(
-                    dims, dtype, static_cast<memory::format_tag>(layout_id));
-            if (md != temp_md) {
-                size_t layout_id
-                        = layout_id_manager_t::set_mem_desc(mem_desc).value();
-                return layout_id + LAST_TAG;
-            }
+        // Check if md has extra flags. Note that since onednn didn't provide
+        // api to check extra flags, here we construct a temp md without extra
+        // flag, and then compare it with the origin md. If they are not equal,
+        // the origin md may has extra flags. Only using shape, data type and
+        // format tag can't describe the md anymore, so we must cache it to
+        // layout id manager.
+        const auto &dims = md.get_dims();
+        const auto &dtype = md.get_data_type();
+        memory::desc temp_md(
+                dims, dtype, static_cast<memory::format_tag>(format_tag));
+        if (md != temp_md) {
+            size_t layout_id
+                    = layout_id_manager_t::set_mem_desc(mem_desc).value();
+            return layout_id + LAST_TAG;
         }
 
-        return layout_id;
+        return format_tag;
     }
 #endif // DNNL_GRAPH_LAYOUT_DEBUG
 };
@@ -203,17 +203,60 @@ struct kernel_base_t {
     status_t compile(const dnnl_partition_impl_t *part, const engine_t *aengine,
             const std::vector<logical_tensor_t> &inputs,
             const std::vector<logical_tensor_t> &outputs) {
+        partition_hash_ = get_partition_hash(part);
         auto ret = compile_impl(part, aengine, inputs, outputs);
         if (ret != status::success) return ret;
         return prepare_inplace_pairs_impl();
     }
 
+    // Serialize the compiled kernel into a cache blob, which can be loaded by
+    // compile_from_cache_blob() in another process to skip the compilation.
+    status_t get_cache_blob(std::vector<uint8_t> &blob) const {
+        blob_writer_t writer;
+        write_cache_blob_header(writer,
+                static_cast<engine_kind_t>(p_engine_.get_kind()),
+                partition_hash_);
+        auto ret = get_cache_blob_impl(writer);
+        if (ret != status::success) return ret;
+        blob = writer.get_data();
+        return status::success;
+    }
+
+    // Restore the kernel from a cache blob. The compiled inputs and outputs
+    // stored in the blob are returned in the given vectors.
+    status_t compile_from_cache_blob(const dnnl_partition_impl_t *part,
+            const engine_t *aengine, const uint8_t *cache_blob, size_t size,
+            std::vector<logical_tensor_t> &inputs,
+            std::vector<logical_tensor_t> &outputs) {
+        blob_reader_t reader(cache_blob, size);
+        partition_hash_ = get_partition_hash(part);
+        auto ret = check_cache_blob_header(
+                reader, aengine->kind(), partition_hash_);
+        if (ret != status::success) return ret;
+        ret = compile_from_cache_blob_impl(
+                part, aengine, reader, inputs, outputs);
+        if (ret != status::success) return ret;
+        if (!reader.is_end()) return status::invalid_arguments;
+        return prepare_inplace_pairs_impl();
+    }
+
     status_t execute(const stream_t *astream,
             const std::vector<tensor_t> &inputs,
             const std::vector<tensor_t> &outputs) {
         return execute_impl(astream, inputs, outputs);
     }
 
+    // Invalidate the cached constant data computed from the given input, so
+    // that it's recomputed in the next execution. It's used when the content
+    // of a constant input is changed in place. The index is the position of
+    // the input in the inputs given to execute(). As a kernel may be shared
+    // by several compiled partitions, the inputs of the execution identify
+    // the cached constant data of the compiled partition invalidating it.
+    status_t invalidate_constant_input(
+            size_t input_index, const std::vector<tensor_t> &inputs) {
+        return invalidate_constant_input_impl(input_index, inputs);
+    }
+
 #ifdef DNNL_WITH_SYCL
     status_t execute_sycl(const stream_t *astream,
             const std::vector<tensor_t> &inputs,
@@ -245,6 +288,42 @@ struct kernel_base_t {
 
     virtual status_t prepare_inplace_pairs_impl() { return status::success; };
 
+    // A kernel may be shared by the compiled partitions of structurally
+    // identical partitions, which are executed with different inputs. Kernels
+    // caching data computed from the inputs can't be shared unless the cached
+    // data is keyed by the inputs.
+    virtual bool is_shareable() const { return true; }
+
+    // The number of compiled partitions using the kernel
+    void add_user() { num_users_++; }
+    void release_user() { num_users_--; }
+    size_t get_num_users() const { return num_users_; }
+
+    // Kernels which don't cache constant data have nothing to invalidate
+    virtual status_t invalidate_constant_input_impl(
+            size_t input_index, const std::vector<tensor_t> &inputs) {
+        UNUSED(input_index);
+        UNUSED(inputs);
+        return status::success;
+    }
+
+    virtual status_t get_cache_blob_impl(blob_writer_t &writer) const {
+        UNUSED(writer);
+        return status::unimplemented;
+    }
+
+    virtual status_t compile_from_cache_blob_impl(
+            const dnnl_partition_impl_t *part, const engine_t *aengine,
+            blob_reader_t &reader, std::vector<logical_tensor_t> &inputs,
+            std::vector<logical_tensor_t> &outputs) {
+        UNUSED(part);
+        UNUSED(aengine);
+        UNUSED(reader);
+        UNUSED(inputs);
+        UNUSED(outputs);
+        return status::unimplemented;
+    }
+
     // WA: Do not cache constant weight for SYCL CPU to workaround a segment
     // fault issue when releasing the cached buffer with sycl::free at the
     // program exits. Need to remove this check once the runtime issue is fixed.
@@ -261,6 +340,9 @@ struct kernel_base_t {
 
     std::vector<inplace_pair_t> inplace_pairs_;
     dnnl::engine p_engine_;
+    // The hash of the partition which the kernel is compiled from
+    size_t partition_hash_ = 0;
+    std::atomic<size_t> num_users_ {0};
 };
 
 using kernel_ptr = std::shared_ptr<kernel_base_t>;
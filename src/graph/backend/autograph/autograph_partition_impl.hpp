@@ -17,7 +17,9 @@
 #ifndef GRAPH_BACKEND_DNNL_DNNL_PARTITION_IMPL_HPP
 #define GRAPH_BACKEND_DNNL_DNNL_PARTITION_IMPL_HPP
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -63,24 +65,57 @@ class dnnl_compiled_partition_impl_t : public compiled_partition_impl_t {
 public:
     dnnl_compiled_partition_impl_t(const engine_t &engine,
             const std::vector<logical_tensor_t> &inputs,
-            const std::vector<logical_tensor_t> &outputs, kernel_ptr &kernel)
+            const std::vector<logical_tensor_t> &outputs,
+            const kernel_ptr &kernel)
         : compiled_partition_impl_t(
                 engine, inputs, outputs, kernel->inplace_pairs_)
-        , kernel_(kernel) {}
+        , kernel_(kernel) {
+        kernel_->add_user();
+    }
+
+    ~dnnl_compiled_partition_impl_t() override { kernel_->release_user(); }
 
     status_t execute(const stream_t *g_stream,
             const std::vector<tensor_t> &inputs,
             const std::vector<tensor_t> &outputs) override {
+        CHECK(apply_invalidated_inputs(inputs));
         // We don't need to resort the inputs and outputs
         return kernel_->execute(g_stream, inputs, outputs);
     }
 
+    status_t get_cache_blob(std::vector<uint8_t> &blob) const override {
+        return kernel_->get_cache_blob(blob);
+    }
+
+    std::shared_ptr<compiled_partition_impl_t>
+    clone_with_shared_kernel() const override {
+        if (!kernel_->is_shareable()) return nullptr;
+        return std::make_shared<dnnl_compiled_partition_impl_t>(
+                *engine_, inputs_, outputs_, kernel_);
+    }
+
+    // The invalidated inputs are passed to the kernel in the next execution,
+    // together with the input tensors identifying the cached constant data
+    // of this compiled partition, so that the constant data of other compiled
+    // partitions sharing the kernel is not affected.
+    status_t invalidate_constant_input(size_t tensor_id) override {
+        for (size_t i = 0; i < inputs_.size(); i++) {
+            if (inputs_[i].id != tensor_id) continue;
+            std::lock_guard<std::mutex> lock(invalidated_inputs_mutex_);
+            invalidated_inputs_.emplace_back(i);
+            has_invalidated_inputs_ = true;
+            return status::success;
+        }
+        return status::invalid_arguments;
+    }
+
 #ifdef DNNL_WITH_SYCL
     status_t execute_sycl(const stream_t *g_stream,
             const std::vector<tensor_t> &inputs,
             const std::vector<tensor_t> &outputs,
             const std::vector<::sycl::event> &sycl_deps,
             ::sycl::event *sycl_event) override {
+        CHECK(apply_invalidated_inputs(inputs));
         // We don't need to resort the inputs and outputs
         return kernel_->execute_sycl(
                 g_stream, inputs, outputs, sycl_deps, sycl_event);
@@ -88,7 +123,24 @@ public:
 #endif
 
 private:
+    status_t apply_invalidated_inputs(const std::vector<tensor_t> &inputs) {
+        if (!has_invalidated_inputs_) return status::success;
+        std::vector<size_t> invalidated_inputs;
+        {
+            std::lock_guard<std::mutex> lock(invalidated_inputs_mutex_);
+            invalidated_inputs.swap(invalidated_inputs_);
+            has_invalidated_inputs_ = false;
+        }
+        for (size_t i : invalidated_inputs)
+            CHECK(kernel_->invalidate_constant_input(i, inputs));
+        return status::success;
+    }
+
     kernel_ptr kernel_;
+
+    std::vector<size_t> invalidated_inputs_;
+    std::atomic<bool> has_invalidated_inputs_ {false};
+    std::mutex invalidated_inputs_mutex_;
 };
 
 class dnnl_partition_impl_t : public partition_impl_t {
@@ -164,6 +216,7 @@ public:
         ret->kernel_creator_ = kernel_creator_;
         ret->id_ = id_;
         ret->can_use_blocked_layout_ = can_use_blocked_layout_;
+        ret->inter_op_parallel_ = inter_op_parallel_;
         return ret;
     }
 
@@ -218,6 +271,37 @@ public:
         return status::success;
     }
 
+    status_t compile_from_cache_blob(compiled_partition_t *compiled_partition,
+            const uint8_t *cache_blob, size_t size,
+            const engine_t *g_engine) const override {
+        auto part = std::dynamic_pointer_cast<dnnl_partition_impl_t>(
+                this->clone());
+
+        kernel_ptr kernel = part->get_kernel_creator()();
+        if (!kernel) return status::unimplemented;
+
+        // The inputs and outputs are the ones given at the compilation time
+        // of the blob
+        std::vector<logical_tensor_t> inputs, outputs;
+        status_t ret = kernel->compile_from_cache_blob(
+                part.get(), g_engine, cache_blob, size, inputs, outputs);
+        if (ret != status::success) return ret;
+
+        std::vector<logical_tensor_t> ordered_inputs;
+        std::vector<logical_tensor_t> ordered_outputs;
+        ret = get_ordered_inputs_outputs(inputs_, inputs, ordered_inputs);
+        if (status::success != ret) return ret;
+
+        ret = get_ordered_inputs_outputs(outputs_, outputs, ordered_outputs);
+        if (status::success != ret) return ret;
+
+        auto pimpl = std::make_shared<dnnl_compiled_partition_impl_t>(
+                *g_engine, ordered_inputs, ordered_outputs, kernel);
+        compiled_partition->init(pimpl);
+
+        return status::success;
+    }
+
     status_t infer_shape(std::vector<const logical_tensor_t *> &inputs,
             std::vector<logical_tensor_t *> &outputs) const override {
         UNUSED(inputs);
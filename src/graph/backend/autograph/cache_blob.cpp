@@ -0,0 +1,474 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+
+#include "common/memory_desc.hpp"
+#include "common/utils.hpp"
+
+#include "graph/interface/logical_tensor.hpp"
+#include "graph/interface/op.hpp"
+#include "graph/interface/partition_hashing.hpp"
+#include "graph/interface/value.hpp"
+
+#include "graph/backend/autograph/autograph_backend.hpp"
+#include "graph/backend/autograph/autograph_partition_impl.hpp"
+#include "graph/backend/autograph/cache_blob.hpp"
+#include "graph/backend/autograph/common.hpp"
+#include "graph/backend/autograph/fusion_info.hpp"
+#include "graph/backend/autograph/subgraph.hpp"
+
+#include "oneapi/dnnl/dnnl.h"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace autograph_impl {
+
+namespace {
+// "DNNG" in little endian
+const uint32_t cache_blob_magic = 0x474e4e44;
+// Must be increased whenever the layout of the blob is changed
+const uint32_t cache_blob_format_version = 1;
+
+using op_ptr = std::shared_ptr<op_t>;
+using value_ptr = std::shared_ptr<value_t>;
+
+void write_logical_tensor(blob_writer_t &writer, const logical_tensor_t &lt) {
+    writer.write(lt);
+    if (logical_tensor_wrapper_t(lt).is_opaque()) {
+        const memory::desc md = make_dnnl_memory_desc(lt);
+        writer.write(*static_cast<const memory_desc_t *>(md.get()));
+    }
+}
+
+bool read_logical_tensor(blob_reader_t &reader, logical_tensor_t *lt) {
+    if (!reader.read(lt)) return false;
+    if (!logical_tensor_wrapper_t(*lt).is_opaque()) return true;
+
+    memory_desc_t c_md;
+    if (!reader.read(&c_md)) return false;
+    dnnl_memory_desc_t cloned = nullptr;
+    if (dnnl_memory_desc_clone(&cloned, &c_md) != dnnl_success) return false;
+    const memory::desc md(cloned);
+    const auto layout_id = autograph_backend::get_singleton().set_mem_desc(md);
+    if (!layout_id.has_value()) return false;
+    lt->layout.layout_id = layout_id.value();
+    return true;
+}
+
+void write_attribute_value(
+        blob_writer_t &writer, const graph::utils::attribute_value_t &value) {
+    const attribute_kind_t kind = value.get_kind();
+    writer.write(kind);
+    switch (kind) {
+        case attribute_kind::f: writer.write(value.get<float>()); break;
+        case attribute_kind::fs:
+            writer.write_vector(value.get<std::vector<float>>());
+            break;
+        case attribute_kind::i: writer.write(value.get<int64_t>()); break;
+        case attribute_kind::is:
+            writer.write_vector(value.get<std::vector<int64_t>>());
+            break;
+        case attribute_kind::s:
+            writer.write_string(value.get<std::string>());
+            break;
+        case attribute_kind::b: writer.write(value.get<bool>()); break;
+        default: assertm(false, "unknown attribute kind");
+    }
+}
+
+template <typename T>
+bool read_attribute(blob_reader_t &reader, op_t &op, op_attr_t name) {
+    T value;
+    if (!reader.read(&value)) return false;
+    op.set_attr<T>(name, value);
+    return true;
+}
+
+template <typename T>
+bool read_vector_attribute(blob_reader_t &reader, op_t &op, op_attr_t name) {
+    std::vector<T> value;
+    if (!reader.read_vector(&value)) return false;
+    op.set_attr<std::vector<T>>(name, value);
+    return true;
+}
+
+bool read_attribute_value(blob_reader_t &reader, op_t &op, op_attr_t name) {
+    attribute_kind_t kind;
+    if (!reader.read(&kind)) return false;
+    switch (kind) {
+        case attribute_kind::f: return read_attribute<float>(reader, op, name);
+        case attribute_kind::fs:
+            return read_vector_attribute<float>(reader, op, name);
+        case attribute_kind::i:
+            return read_attribute<int64_t>(reader, op, name);
+        case attribute_kind::is:
+            return read_vector_attribute<int64_t>(reader, op, name);
+        case attribute_kind::s: {
+            std::string value;
+            if (!reader.read_string(&value)) return false;
+            op.set_attr<std::string>(name, value);
+            return true;
+        }
+        case attribute_kind::b: return read_attribute<bool>(reader, op, name);
+        default: return false;
+    }
+}
+
+// Write the op itself without its inputs and outputs
+void write_op(blob_writer_t &writer, const op_t &op) {
+    writer.write(op.get_id());
+    writer.write(static_cast<size_t>(op.get_kind()));
+    writer.write_string(op.get_name());
+    writer.write(op.is_internal());
+
+    const auto &attrs = op.get_attributes();
+    writer.write(attrs.size());
+    for (const auto &attr : attrs) {
+        writer.write(static_cast<size_t>(attr.first));
+        write_attribute_value(writer, attr.second);
+    }
+}
+
+op_ptr read_op(blob_reader_t &reader) {
+    size_t id, kind, num_attrs;
+    std::string name;
+    bool internal;
+    if (!reader.read(&id) || !reader.read(&kind) || !reader.read_string(&name)
+            || !reader.read(&internal))
+        return nullptr;
+
+    auto op = std::make_shared<op_t>(
+            id, static_cast<op_kind_t>(kind), name, internal);
+    if (!reader.read(&num_attrs)) return nullptr;
+    for (size_t i = 0; i < num_attrs; i++) {
+        size_t name;
+        if (!reader.read(&name)) return nullptr;
+        if (!read_attribute_value(reader, *op, static_cast<op_attr_t>(name)))
+            return nullptr;
+    }
+    return op;
+}
+
+// The ops fused into others are not part of the subgraph. Only their own
+// attributes and the logical tensors of their inputs and outputs are used
+// when creating the primitive attr, so they are stored as standalone ops.
+void write_fused_op(blob_writer_t &writer, const op_t &op) {
+    write_op(writer, op);
+    writer.write(op.num_inputs());
+    for (const auto &val : op.get_input_values())
+        write_logical_tensor(writer, val->get_logical_tensor());
+    writer.write(op.num_outputs());
+    for (const auto &val : op.get_output_values())
+        write_logical_tensor(writer, val->get_logical_tensor());
+}
+
+op_ptr read_fused_op(blob_reader_t &reader) {
+    op_ptr op = read_op(reader);
+    if (!op) return nullptr;
+
+    size_t num_inputs, num_outputs;
+    logical_tensor_t lt;
+    if (!reader.read(&num_inputs)) return nullptr;
+    for (size_t i = 0; i < num_inputs; i++) {
+        if (!read_logical_tensor(reader, &lt)) return nullptr;
+        op->add_input(lt);
+    }
+    if (!reader.read(&num_outputs)) return nullptr;
+    for (size_t i = 0; i < num_outputs; i++) {
+        if (!read_logical_tensor(reader, &lt)) return nullptr;
+        op->add_output(lt);
+    }
+    return op;
+}
+} // namespace
+
+// The fusion information is private to fusion_info_t, so the (de)serialization
+// of the subgraph is implemented in this friend class.
+class subgraph_serializer_t {
+public:
+    static status_t serialize(
+            const std::shared_ptr<subgraph_t> &sg, blob_writer_t &writer) {
+        const auto &ops = sg->get_ops();
+
+        // Give each value an index so that the connections can be restored
+        std::unordered_map<const value_t *, size_t> value_indices;
+        std::vector<const value_t *> values;
+        auto add_value = [&](const value_ptr &val) {
+            if (value_indices.count(val.get())) return;
+            value_indices[val.get()] = values.size();
+            values.emplace_back(val.get());
+        };
+        for (const auto &op : ops) {
+            for (const auto &val : op->get_input_values()) {
+                if (!val) return status::unimplemented;
+                add_value(val);
+            }
+            for (const auto &val : op->get_output_values()) {
+                if (!val) return status::unimplemented;
+                add_value(val);
+            }
+        }
+
+        writer.write(values.size());
+        for (const value_t *val : values) {
+            write_logical_tensor(writer, val->get_logical_tensor());
+            writer.write(val->is_internal());
+        }
+
+        writer.write(ops.size());
+        for (const auto &op : ops) {
+            write_op(writer, *op);
+            writer.write(op->num_inputs());
+            for (const auto &val : op->get_input_values())
+                writer.write(value_indices.at(val.get()));
+            writer.write(op->num_outputs());
+            for (const auto &val : op->get_output_values())
+                writer.write(value_indices.at(val.get()));
+        }
+
+        const auto &infos = sg->fusion_info_mgr_.data_;
+        writer.write(infos.size());
+        for (const auto &info : infos)
+            write_fusion_info(writer, info);
+
+        writer.write(sg->ins_.size());
+        for (const auto &lt : sg->ins_)
+            write_logical_tensor(writer, lt);
+        writer.write(sg->outs_.size());
+        for (const auto &lt : sg->outs_)
+            write_logical_tensor(writer, lt);
+
+        return status::success;
+    }
+
+    static status_t deserialize(blob_reader_t &reader, const dnnl::engine &eng,
+            fpmath_mode_t fpm_mode, bool can_use_blocked_layout,
+            std::shared_ptr<subgraph_t> &sg) {
+        const status_t invalid = status::invalid_arguments;
+
+        size_t num_values;
+        if (!reader.read(&num_values)) return invalid;
+        std::vector<value_ptr> values;
+        for (size_t i = 0; i < num_values; i++) {
+            logical_tensor_t lt;
+            bool internal;
+            if (!read_logical_tensor(reader, &lt) || !reader.read(&internal))
+                return invalid;
+            values.emplace_back(std::make_shared<value_t>(lt, internal));
+        }
+
+        size_t num_ops;
+        if (!reader.read(&num_ops)) return invalid;
+        std::vector<op_ptr> ops;
+        for (size_t i = 0; i < num_ops; i++) {
+            op_ptr op = read_op(reader);
+            if (!op) return invalid;
+
+            size_t num_inputs, num_outputs, idx;
+            if (!reader.read(&num_inputs)) return invalid;
+            for (size_t j = 0; j < num_inputs; j++) {
+                if (!reader.read(&idx) || idx >= values.size()) return invalid;
+                op->connect_input(j, values[idx]);
+            }
+            if (!reader.read(&num_outputs)) return invalid;
+            for (size_t j = 0; j < num_outputs; j++) {
+                if (!reader.read(&idx) || idx >= values.size()
+                        || values[idx]->has_producer())
+                    return invalid;
+                op->add_output(values[idx]);
+            }
+            ops.emplace_back(op);
+        }
+
+        sg = std::make_shared<subgraph_t>(
+                ops, eng, fpm_mode, can_use_blocked_layout, false);
+
+        size_t num_infos;
+        if (!reader.read(&num_infos)) return invalid;
+        auto &infos = sg->fusion_info_mgr_.data_;
+        for (size_t i = 0; i < num_infos; i++) {
+            infos.emplace_back(fusion_info_t());
+            if (!read_fusion_info(reader, infos.back())) return invalid;
+        }
+
+        size_t num_ins, num_outs;
+        if (!reader.read(&num_ins)) return invalid;
+        sg->ins_.resize(num_ins);
+        for (auto &lt : sg->ins_) {
+            if (!read_logical_tensor(reader, &lt)) return invalid;
+        }
+        if (!reader.read(&num_outs)) return invalid;
+        sg->outs_.resize(num_outs);
+        for (auto &lt : sg->outs_) {
+            if (!read_logical_tensor(reader, &lt)) return invalid;
+        }
+
+        return status::success;
+    }
+
+private:
+    using meta_op_t = fusion_info_t::meta_op_t;
+    using meta_op_map_t
+            = std::unordered_map<size_t, std::shared_ptr<meta_op_t>>;
+
+    static void write_meta_op_map(
+            blob_writer_t &writer, const meta_op_map_t &map) {
+        writer.write(map.size());
+        for (const auto &kv : map) {
+            writer.write(kv.first);
+            write_fused_op(writer, *kv.second->get_op());
+        }
+    }
+
+    static bool read_meta_op_map(blob_reader_t &reader, meta_op_map_t &map) {
+        size_t size, index;
+        if (!reader.read(&size)) return false;
+        for (size_t i = 0; i < size; i++) {
+            if (!reader.read(&index)) return false;
+            op_ptr op = read_fused_op(reader);
+            if (!op) return false;
+            map[index] = std::make_shared<meta_op_t>(op);
+        }
+        return true;
+    }
+
+    static void write_meta_op(
+            blob_writer_t &writer, const std::shared_ptr<meta_op_t> &mop) {
+        writer.write(static_cast<bool>(mop));
+        if (mop) write_fused_op(writer, *mop->get_op());
+    }
+
+    static bool read_meta_op(
+            blob_reader_t &reader, std::shared_ptr<meta_op_t> &mop) {
+        bool has_op;
+        if (!reader.read(&has_op)) return false;
+        if (!has_op) return true;
+        op_ptr op = read_fused_op(reader);
+        if (!op) return false;
+        mop = std::make_shared<meta_op_t>(op);
+        return true;
+    }
+
+    static void write_fusion_info(
+            blob_writer_t &writer, const fusion_info_t &info) {
+        write_meta_op_map(writer, info.input_zps_);
+        write_meta_op(writer, info.output_zps_);
+        write_meta_op_map(writer, info.input_scales_);
+        write_meta_op(writer, info.dst_scales_);
+
+        writer.write(info.post_ops_.size());
+        for (const auto &pop : info.post_ops_) {
+            write_fused_op(writer, *pop->get_op());
+            writer.write(pop->get_scale());
+            writer.write(pop->get_zp());
+            writer.write_vector(pop->get_unfused_input_indices());
+            writer.write(pop->is_post_sum());
+        }
+    }
+
+    static bool read_fusion_info(blob_reader_t &reader, fusion_info_t &info) {
+        if (!read_meta_op_map(reader, info.input_zps_)
+                || !read_meta_op(reader, info.output_zps_)
+                || !read_meta_op_map(reader, info.input_scales_)
+                || !read_meta_op(reader, info.dst_scales_))
+            return false;
+
+        size_t num_post_ops;
+        if (!reader.read(&num_post_ops)) return false;
+        for (size_t i = 0; i < num_post_ops; i++) {
+            op_ptr op = read_fused_op(reader);
+            float scale;
+            int32_t zp;
+            std::vector<size_t> indices;
+            bool is_post_sum;
+            if (!op || !reader.read(&scale) || !reader.read(&zp)
+                    || !reader.read_vector(&indices)
+                    || !reader.read(&is_post_sum))
+                return false;
+
+            auto pop = std::make_shared<meta_op_t>(op, indices, scale, zp);
+            if (is_post_sum) pop->set_post_sum();
+            info.post_ops_.emplace_back(pop);
+        }
+        return true;
+    }
+};
+
+size_t get_partition_hash(const dnnl_partition_impl_t *part) {
+    size_t seed = 0;
+    seed = hash_combine(seed, static_cast<size_t>(part->get_kind()));
+    seed = hash_combine(seed, static_cast<size_t>(part->get_fpmath_mode()));
+    for (const auto &op : part->get_ops()) {
+        seed = hash_combine(seed, op->get_id());
+        seed = hash_combine(seed, static_cast<size_t>(op->get_kind()));
+        seed = hash_combine(
+                seed, partition_hashing::get_op_attributes_hash(*op));
+        for (const auto &val : op->get_input_values())
+            seed = hash_combine(seed, val->get_logical_tensor().id);
+        for (const auto &val : op->get_output_values())
+            seed = hash_combine(seed, val->get_logical_tensor().id);
+    }
+    return seed;
+}
+
+void write_cache_blob_header(
+        blob_writer_t &writer, engine_kind_t kind, size_t partition_hash) {
+    const dnnl_version_t *version = dnnl_version();
+    writer.write(cache_blob_magic);
+    writer.write(cache_blob_format_version);
+    writer.write(version->major);
+    writer.write(version->minor);
+    writer.write(version->patch);
+    writer.write_string(version->hash);
+    writer.write(static_cast<int>(dnnl_get_effective_cpu_isa()));
+    writer.write(kind);
+    writer.write(partition_hash);
+}
+
+status_t check_cache_blob_header(
+        blob_reader_t &reader, engine_kind_t kind, size_t partition_hash) {
+    blob_writer_t expected;
+    write_cache_blob_header(expected, kind, partition_hash);
+
+    std::vector<uint8_t> header(expected.get_data().size());
+    if (!reader.read_bytes(header.data(), header.size()))
+        return status::invalid_arguments;
+    if (header != expected.get_data()) return status::invalid_arguments;
+    return status::success;
+}
+
+status_t serialize_subgraph(
+        const std::shared_ptr<subgraph_t> &sg, blob_writer_t &writer) {
+    return subgraph_serializer_t::serialize(sg, writer);
+}
+
+status_t deserialize_subgraph(blob_reader_t &reader, const dnnl::engine &eng,
+        fpmath_mode_t fpm_mode, bool can_use_blocked_layout,
+        std::shared_ptr<subgraph_t> &sg) {
+    return subgraph_serializer_t::deserialize(
+            reader, eng, fpm_mode, can_use_blocked_layout, sg);
+}
+
+} // namespace autograph_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
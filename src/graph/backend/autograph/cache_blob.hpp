@@ -0,0 +1,148 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_BACKEND_DNNL_CACHE_BLOB_HPP
+#define GRAPH_BACKEND_DNNL_CACHE_BLOB_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "graph/interface/c_types_map.hpp"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace autograph_impl {
+
+class subgraph_t;
+class dnnl_partition_impl_t;
+
+// Append-only writer of the cache blob of a compiled partition. The written
+// values must be trivially copyable. They are stored in their in-memory
+// representation, so a blob can only be loaded by the same library build on
+// the same kind of machine, which is guaranteed by the blob header.
+class blob_writer_t {
+public:
+    void write_bytes(const void *data, size_t size) {
+        const uint8_t *p = static_cast<const uint8_t *>(data);
+        data_.insert(data_.end(), p, p + size);
+    }
+
+    template <typename T>
+    void write(const T &v) {
+        write_bytes(&v, sizeof(T));
+    }
+
+    void write_string(const std::string &s) {
+        write<size_t>(s.size());
+        write_bytes(s.data(), s.size());
+    }
+
+    template <typename T>
+    void write_vector(const std::vector<T> &v) {
+        write<size_t>(v.size());
+        if (!v.empty()) write_bytes(v.data(), v.size() * sizeof(T));
+    }
+
+    const std::vector<uint8_t> &get_data() const { return data_; }
+
+private:
+    std::vector<uint8_t> data_;
+};
+
+// Reader of the cache blob. All the read methods return false if the blob is
+// truncated, in which case the blob must be rejected.
+class blob_reader_t {
+public:
+    blob_reader_t(const uint8_t *data, size_t size)
+        : data_(data), size_(size) {}
+
+    bool read_bytes(void *dst, size_t size) {
+        if (size > size_ - pos_) return false;
+        if (size) std::memcpy(dst, data_ + pos_, size);
+        pos_ += size;
+        return true;
+    }
+
+    template <typename T>
+    bool read(T *v) {
+        return read_bytes(v, sizeof(T));
+    }
+
+    bool read_string(std::string *s) {
+        size_t size = 0;
+        if (!read(&size) || size > size_ - pos_) return false;
+        s->assign(reinterpret_cast<const char *>(data_ + pos_), size);
+        pos_ += size;
+        return true;
+    }
+
+    template <typename T>
+    bool read_vector(std::vector<T> *v) {
+        size_t size = 0;
+        if (!read(&size) || size > (size_ - pos_) / sizeof(T)) return false;
+        v->resize(size);
+        return size == 0 || read_bytes(v->data(), size * sizeof(T));
+    }
+
+    bool is_end() const { return pos_ == size_; }
+
+private:
+    const uint8_t *data_;
+    size_t size_;
+    size_t pos_ = 0;
+};
+
+// Get the hash of the partition that a cache blob is compiled from. It covers
+// the ops, their attributes and the partition boundary, so a blob can't be
+// loaded for a different partition.
+size_t get_partition_hash(const dnnl_partition_impl_t *part);
+
+// Write the blob header, which contains the blob format version, the library
+// version, the effective cpu isa, the engine kind and the partition hash
+void write_cache_blob_header(
+        blob_writer_t &writer, engine_kind_t kind, size_t partition_hash);
+
+// Check the blob header. Blobs written by a different library build, for a
+// different isa, engine kind or partition are rejected with
+// status::invalid_arguments.
+status_t check_cache_blob_header(
+        blob_reader_t &reader, engine_kind_t kind, size_t partition_hash);
+
+// Serialize the lowered subgraph: the ops with their attributes, the values
+// connecting them, the fusion information and the given inputs and outputs.
+// The opaque layouts are stored as memory descriptors since the layout ids are
+// only valid in the current process.
+status_t serialize_subgraph(
+        const std::shared_ptr<subgraph_t> &sg, blob_writer_t &writer);
+
+// Rebuild a lowered subgraph from the blob. The opaque layouts are registered
+// again to the layout id manager.
+status_t deserialize_subgraph(blob_reader_t &reader, const dnnl::engine &eng,
+        fpmath_mode_t fpm_mode, bool can_use_blocked_layout,
+        std::shared_ptr<subgraph_t> &sg);
+
+} // namespace autograph_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+#endif
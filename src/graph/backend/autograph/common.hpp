@@ -51,6 +51,8 @@ using query = dnnl::query;
 using prop_kind = dnnl::prop_kind;
 using algorithm = dnnl::algorithm;
 using exec_args = std::unordered_map<int, memory>;
+// Flat form of exec_args which can be passed to the primitive directly
+using exec_args_table = std::vector<dnnl_exec_arg_t>;
 
 using pd_cache_t = std::unordered_map<op_t *, graph::utils::any_t>;
 struct dnnl_allocator_t {
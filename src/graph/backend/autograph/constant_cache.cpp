@@ -100,6 +100,33 @@ void constant_cache_t::remove_if_exist(const key_t &key) {
     }
 }
 
+value_t constant_cache_t::get_if_exist(const key_t &key) {
+    impl::utils::lock_read_t lock_r(rw_mutex_);
+    return get(key);
+}
+
+void constant_cache_t::update(const key_t &key, const value_t &value) {
+    impl::utils::lock_write_t lock_w(rw_mutex_);
+    auto it = constant_map().find(key);
+    if (it == constant_map().end()) return;
+    it->second.value_ = value;
+    it->second.timestamp_.store(get_timestamp());
+}
+
+void constant_cache_t::retain(const key_t &key) {
+    impl::utils::lock_write_t lock_w(rw_mutex_);
+    key_users_[key]++;
+}
+
+void constant_cache_t::release(const key_t &key) {
+    impl::utils::lock_write_t lock_w(rw_mutex_);
+    auto pos = key_users_.find(key);
+    if (pos == key_users_.end()) return;
+    if (--(pos->second) > 0) return;
+    key_users_.erase(pos);
+    constant_map().erase(key);
+}
+
 // Get the total size of all cached buffers
 size_t constant_cache_t::get_size() const {
     size_t total_size = 0;
@@ -139,7 +166,7 @@ value_t constant_cache_t::get(const key_t &key) {
 
 // Evict n size of cached buffers
 void constant_cache_t::evict(size_t n) {
-    using v_t = std::unordered_map<key_t, timed_entry_t>::value_type;
+    using v_t = constant_map_t::value_type;
     if (n == get_size()) {
         constant_map().clear();
         return;
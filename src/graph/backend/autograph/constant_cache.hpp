@@ -24,6 +24,7 @@
 #include <mutex>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "common/rw_mutex.hpp"
 #include "common/utils.hpp"
@@ -73,14 +74,68 @@ private:
     const allocator_t *alc_;
 };
 
+// The key of a cached constant buffer. Kernels caching the constant data of
+// a single op use themselves as the owner of the key. The large partition
+// kernel keys its constant data by the content instead, i.e. the structural
+// hash of its constant blocks, the data handles of the constant inputs and
+// the size of the buffer, so that identical prepacked weights can be shared
+// by different kernels. Keys are compared field by field, so neither a hash
+// collision nor a content key equal to a kernel address binds a wrong buffer.
+//
+// A constant input is identified by its address only. If the memory of a
+// constant input is reused for different data, the users must invalidate
+// the input before the next execution.
+struct constant_cache_key_t {
+    constant_cache_key_t() = default;
+
+    explicit constant_cache_key_t(const void *owner) : owner_(owner) {}
+
+    constant_cache_key_t(size_t block_hash, std::vector<const void *> handles,
+            size_t persistent_size)
+        : block_hash_(block_hash)
+        , handles_(std::move(handles))
+        , persistent_size_(persistent_size) {}
+
+    bool operator==(const constant_cache_key_t &other) const {
+        return owner_ == other.owner_ && block_hash_ == other.block_hash_
+                && persistent_size_ == other.persistent_size_
+                && handles_ == other.handles_;
+    }
+
+    bool operator!=(const constant_cache_key_t &other) const {
+        return !(*this == other);
+    }
+
+    size_t hash() const {
+        size_t seed = 0;
+        seed = hash_combine(seed, owner_);
+        seed = hash_combine(seed, block_hash_);
+        seed = hash_combine(seed, persistent_size_);
+        for (const void *handle : handles_)
+            seed = hash_combine(seed, handle);
+        return seed;
+    }
+
+private:
+    const void *owner_ = nullptr;
+    size_t block_hash_ = 0;
+    std::vector<const void *> handles_;
+    size_t persistent_size_ = 0;
+};
+
+struct constant_cache_key_hash_t {
+    size_t operator()(const constant_cache_key_t &key) const {
+        return key.hash();
+    }
+};
+
 struct constant_cache_t {
-    using key_t = size_t;
+    using key_t = constant_cache_key_t;
     using cached_t = std::shared_ptr<constant_buffer_t>;
     using value_t = std::shared_future<cached_t>;
 
     constant_cache_t() {
-        constant_map_ = impl::utils::make_unique<
-                std::unordered_map<key_t, timed_entry_t>>();
+        constant_map_ = impl::utils::make_unique<constant_map_t>();
     }
 
     ~constant_cache_t() {
@@ -153,6 +208,18 @@ struct constant_cache_t {
     size_t get_capacity();
     value_t get_or_add(const key_t &key, const value_t &value);
     void remove_if_exist(const key_t &key);
+    // Get the cached value of the key, or an invalid value if it's not cached
+    value_t get_if_exist(const key_t &key);
+    // Replace the cached value of the key if it exists. The previous value
+    // is kept alive by the users still holding it.
+    void update(const key_t &key, const value_t &value);
+
+    // The cached value of a content-addressed key may be shared by several
+    // kernels. Each kernel should retain the key once before using it and
+    // release it when destroyed. The cached value will be removed once the
+    // key is released by all users.
+    void retain(const key_t &key);
+    void release(const key_t &key);
 
 private:
     void evict(size_t n);
@@ -174,11 +241,14 @@ private:
             : value_(value), timestamp_(timestamp) {}
     };
 
-    std::unordered_map<key_t, timed_entry_t> &constant_map() {
+    using constant_map_t = std::unordered_map<key_t, timed_entry_t,
+            constant_cache_key_hash_t>;
+
+    constant_map_t &constant_map() {
         return *constant_map_;
     }
 
-    const std::unordered_map<key_t, timed_entry_t> &constant_map() const {
+    const constant_map_t &constant_map() const {
         return *constant_map_;
     }
 
@@ -186,7 +256,9 @@ private:
     // NOTE: pairs that contain atomics cannot be stored in an unordered_map *as
     // an element*, since it invokes the copy constructor of std::atomic, which
     // is deleted.
-    std::unique_ptr<std::unordered_map<key_t, timed_entry_t>> constant_map_;
+    std::unique_ptr<constant_map_t> constant_map_;
+    // The number of users of each retained key
+    std::unordered_map<key_t, size_t, constant_cache_key_hash_t> key_users_;
     impl::utils::rw_mutex_t rw_mutex_;
     size_t capacity_ = std::numeric_limits<size_t>::max();
 };
@@ -41,6 +41,8 @@ namespace impl {
 namespace graph {
 namespace autograph_impl {
 
+class subgraph_serializer_t;
+
 // This class is used to represent an op's fusion information, such as the post
 // ops, the zero points or scales.
 class fusion_info_t {
@@ -101,6 +103,7 @@ class fusion_info_t {
 public:
     friend dnnl::primitive_attr make_dnnl_primitive_attr(
             const op_ptr &op, const fusion_info_t &fusion_info);
+    friend class subgraph_serializer_t;
 
     fusion_info_t() = default;
 
@@ -256,6 +259,8 @@ private:
 // op's attribute system. When using an ops' fusion info, we can use the fusion
 // info key to query it out from the manager.
 class fusion_info_mgr_t {
+    friend class subgraph_serializer_t;
+
 public:
     fusion_info_mgr_t(fpmath_mode_t fpm_mode = fpmath_mode::strict,
             bool can_use_blocked_layout = false)
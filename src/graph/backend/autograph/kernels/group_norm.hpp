@@ -0,0 +1,271 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_BACKEND_DNNL_KERNELS_GROUP_NORM_HPP
+#define GRAPH_BACKEND_DNNL_KERNELS_GROUP_NORM_HPP
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "graph/interface/backend.hpp"
+#include "graph/interface/graph.hpp"
+#include "graph/interface/shape_infer.hpp"
+
+#include "graph/backend/autograph/common.hpp"
+#include "graph/backend/autograph/kernels/large_partition.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace autograph_impl {
+
+// The kernel of the decomposed group normalization partitions: StaticReshape
+// of [N, C, spatial] to [N, G, C / G * spatial], LayerNorm over the grouped
+// dims, StaticReshape back and the per-channel Multiply and Add. The
+// partition is computed by the group normalization primitive, the partitions
+// which it doesn't support are compiled as a large partition.
+class group_norm_primitive_kernel_t : public larger_partition_kernel_t {
+    bool use_gnorm_ = false;
+    dnnl::primitive gnorm_prim_;
+
+    // The indices of the partition inputs, -1 for the absent ones
+    int src_idx_ = -1;
+    int scale_idx_ = -1;
+    int shift_idx_ = -1;
+
+    memory::desc src_md_, dst_md_, scale_md_;
+
+    // Returns the output dims of the StaticReshape `op` for the input dims
+    // `in_dims`, empty if the shape can't be inferred
+    static dims reshape_dims(const op_t *op, const dims &in_dims) {
+        logical_tensor_t in = empty_logical_tensor_with_default_id();
+        in.ndims = static_cast<int32_t>(in_dims.size());
+        for (size_t i = 0; i < in_dims.size(); i++)
+            in.dims[i] = in_dims[i];
+        logical_tensor_t out = empty_logical_tensor_with_default_id();
+        std::vector<logical_tensor_t *> ins {&in}, outs {&out};
+        if (infer_static_reshape_output_shape(
+                    const_cast<op_t *>(op), ins, outs)
+                != status::success)
+            return {};
+        return logical_tensor_wrapper_t(out).vdims();
+    }
+
+    status_t compile_gnorm(const dnnl_partition_impl_t *part,
+            const engine_t *g_engine,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) {
+#ifdef DNNL_WITH_SYCL
+        return status::unimplemented;
+#endif
+        if (g_engine->kind() != graph::engine_kind::cpu
+                || outputs.size() != 1)
+            return status::unimplemented;
+
+        const op_t *reshape_in = nullptr, *reshape_out = nullptr,
+                   *lnorm = nullptr, *mul = nullptr, *add = nullptr;
+        for (const auto &op : part->get_ops()) {
+            const auto kind = op->get_kind();
+            if (kind == graph::op_kind::StaticReshape) {
+                const auto &in0 = op->get_input_value(0);
+                const bool after_lnorm = in0->has_producer()
+                        && in0->get_producer().get_kind()
+                                == graph::op_kind::LayerNorm;
+                (after_lnorm ? reshape_out : reshape_in) = op.get();
+            } else if (kind == graph::op_kind::LayerNorm) {
+                lnorm = op.get();
+            } else if (kind == graph::op_kind::Multiply) {
+                mul = op.get();
+            } else if (kind == graph::op_kind::Add) {
+                add = op.get();
+            } else {
+                return status::unimplemented;
+            }
+        }
+        if (!reshape_in || !lnorm || !reshape_out)
+            return status::unimplemented;
+
+        const auto get_bool_attr = [](const op_t *op, op_attr_t name,
+                                           bool def) {
+            return op->has_attr(name) ? op->get_attr<bool>(name) : def;
+        };
+        if (get_bool_attr(lnorm, op_attr::use_affine, true)
+                || get_bool_attr(lnorm, op_attr::keep_stats, true))
+            return status::unimplemented;
+
+        const auto input_index = [&](const value_t *val) {
+            const size_t id = val->get_logical_tensor().id;
+            for (size_t i = 0; i < inputs.size(); i++)
+                if (inputs[i].id == id) return static_cast<int>(i);
+            return -1;
+        };
+        // The index of the partition input of the binary op other than the
+        // one produced by `producer`
+        const auto other_input_index = [&](const op_t *op,
+                                               const op_t *producer) {
+            for (size_t i = 0; i < op->num_inputs(); i++) {
+                const auto &val = op->get_input_value(i);
+                if (!val->has_producer() || &val->get_producer() != producer)
+                    return input_index(val.get());
+            }
+            return -1;
+        };
+
+        src_idx_ = input_index(reshape_in->get_input_value(0).get());
+        if (src_idx_ < 0) return status::unimplemented;
+        const logical_tensor_wrapper_t src_ltw(inputs[src_idx_]);
+        if (!src_ltw.is_strided() || src_ltw.is_shape_unknown())
+            return status::unimplemented;
+        const dims src_dims = src_ltw.vdims();
+        const int ndims = src_ltw.ndims();
+        if (ndims < 3) return status::unimplemented;
+        const dim C = src_dims[1];
+
+        // The input is split into the groups along the channels and the
+        // LayerNorm normalizes all the dims after the groups
+        const dims grouped_dims = reshape_dims(reshape_in, src_dims);
+        const int grouped_ndims = static_cast<int>(grouped_dims.size());
+        if (grouped_ndims < 3 || grouped_dims[0] != src_dims[0])
+            return status::unimplemented;
+        const dim groups = grouped_dims[1];
+        if (groups <= 0 || C % groups != 0) return status::unimplemented;
+        int64_t begin_norm_axis = lnorm->has_attr(op_attr::begin_norm_axis)
+                ? lnorm->get_attr<int64_t>(op_attr::begin_norm_axis)
+                : -1;
+        if (begin_norm_axis < 0) begin_norm_axis += grouped_ndims;
+        if (begin_norm_axis != 2) return status::unimplemented;
+        if (reshape_dims(reshape_out, grouped_dims) != src_dims)
+            return status::unimplemented;
+
+        // The scale and the shift are per channel
+        const auto per_channel_index = [&](const op_t *op,
+                                               const op_t *producer) {
+            const int idx = other_input_index(op, producer);
+            if (idx < 0) return -1;
+            const logical_tensor_wrapper_t ltw(inputs[idx]);
+            if (!ltw.is_strided() || ltw.is_shape_unknown()
+                    || ltw.data_type() != graph::data_type::f32
+                    || ltw.nelems() != C || ltw.ndims() > ndims)
+                return -1;
+            // The channels are the second dim after the numpy broadcast
+            const int c_axis = ltw.ndims() - (ndims - 1);
+            if (c_axis < 0 || ltw.vdims()[c_axis] != C
+                    || ltw.vstrides()[c_axis] != 1)
+                return -1;
+            return idx;
+        };
+        const op_t *last = reshape_out;
+        if (mul) {
+            scale_idx_ = per_channel_index(mul, last);
+            if (scale_idx_ < 0) return status::unimplemented;
+            last = mul;
+        }
+        if (add) {
+            shift_idx_ = per_channel_index(add, last);
+            if (shift_idx_ < 0) return status::unimplemented;
+        }
+
+        const logical_tensor_wrapper_t dst_ltw(outputs[0]);
+        if (!(dst_ltw.is_strided() || dst_ltw.is_any())
+                || dst_ltw.is_shape_unknown() || dst_ltw.vdims() != src_dims)
+            return status::unimplemented;
+
+        src_md_ = make_dnnl_memory_desc(inputs[src_idx_]);
+        dst_md_ = make_dnnl_memory_desc(outputs[0]);
+        if (dst_ltw.is_any())
+            dst_md_ = memory::desc(src_dims, dst_md_.get_data_type(),
+                    src_md_.get_strides());
+        scale_md_ = memory::desc(
+                {C}, memory::data_type::f32, memory::format_tag::a);
+
+        auto flags = dnnl::normalization_flags::none;
+        if (mul) flags |= dnnl::normalization_flags::use_scale;
+        if (add) flags |= dnnl::normalization_flags::use_shift;
+        const float epsilon = lnorm->has_attr(op_attr::epsilon)
+                ? lnorm->get_attr<float>(op_attr::epsilon)
+                : 1e-5f;
+
+        p_engine_ = make_dnnl_engine(*g_engine);
+        try {
+            auto pd = dnnl::group_normalization_forward::primitive_desc(
+                    p_engine_, dnnl::prop_kind::forward_inference, src_md_,
+                    dst_md_, groups, epsilon, flags);
+            gnorm_prim_ = dnnl::group_normalization_forward(pd);
+        } catch (...) { return status::unimplemented; }
+
+        auto &out = const_cast<logical_tensor_t &>(outputs[0]);
+        return fill_layout_info(&out, dst_md_);
+    }
+
+public:
+    status_t compile_impl(const dnnl_partition_impl_t *part,
+            const engine_t *g_engine,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) override {
+        use_gnorm_ = compile_gnorm(part, g_engine, inputs, outputs)
+                == status::success;
+        if (use_gnorm_) return status::success;
+        return larger_partition_kernel_t::compile_impl(
+                part, g_engine, inputs, outputs);
+    }
+
+    // The primitive is created again from the partition, so only the large
+    // partition kernels are serialized
+    status_t get_cache_blob_impl(blob_writer_t &writer) const override {
+        if (use_gnorm_) return status::unimplemented;
+        return larger_partition_kernel_t::get_cache_blob_impl(writer);
+    }
+
+    // The primitive caches no constant data
+    status_t invalidate_constant_input_impl(size_t input_index,
+            const std::vector<tensor_t> &inputs) override {
+        if (use_gnorm_) return status::success;
+        return larger_partition_kernel_t::invalidate_constant_input_impl(
+                input_index, inputs);
+    }
+
+    status_t execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs) override {
+        if (!use_gnorm_)
+            return larger_partition_kernel_t::execute_impl(
+                    g_stream, inputs, outputs);
+
+        dnnl::stream p_stream = make_dnnl_stream(p_engine_, *g_stream);
+        const auto make_mem = [&](const memory::desc &md, const tensor_t &t) {
+            return make_dnnl_memory(md, p_engine_, t.get_data_handle());
+        };
+
+        std::unordered_map<int, memory> args;
+        args[DNNL_ARG_SRC] = make_mem(src_md_, inputs[src_idx_]);
+        if (scale_idx_ >= 0)
+            args[DNNL_ARG_SCALE] = make_mem(scale_md_, inputs[scale_idx_]);
+        if (shift_idx_ >= 0)
+            args[DNNL_ARG_SHIFT] = make_mem(scale_md_, inputs[shift_idx_]);
+        args[DNNL_ARG_DST] = make_mem(dst_md_, outputs[0]);
+
+        gnorm_prim_.execute(p_stream, args);
+        return status::success;
+    }
+};
+
+} // namespace autograph_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+#endif
@@ -23,6 +23,7 @@
 #include "graph/backend/autograph/kernels/conv.hpp"
 #include "graph/backend/autograph/kernels/convtranspose.hpp"
 #include "graph/backend/autograph/kernels/eltwise.hpp"
+#include "graph/backend/autograph/kernels/group_norm.hpp"
 #include "graph/backend/autograph/kernels/large_partition.hpp"
 #include "graph/backend/autograph/kernels/layernorm.hpp"
 #include "graph/backend/autograph/kernels/logsoftmax.hpp"
@@ -32,6 +33,7 @@
 #include "graph/backend/autograph/kernels/quantize.hpp"
 #include "graph/backend/autograph/kernels/reduction.hpp"
 #include "graph/backend/autograph/kernels/reorder.hpp"
+#include "graph/backend/autograph/kernels/sdp.hpp"
 #include "graph/backend/autograph/kernels/resampling.hpp"
 #include "graph/backend/autograph/kernels/shuffle.hpp"
 #include "graph/backend/autograph/kernels/softmax.hpp"
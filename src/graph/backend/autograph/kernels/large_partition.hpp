@@ -18,14 +18,22 @@
 #define GRAPH_BACKEND_DNNL_KERNELS_LARGE_PARTITION_HPP
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "common/dnnl_thread.hpp"
+#include "common/rw_mutex.hpp"
+
 #include "graph/interface/backend.hpp"
 #include "graph/interface/graph.hpp"
 
@@ -60,21 +68,57 @@ protected:
 
     std::function<std::shared_ptr<execution_args_set_t>()> resource_ctor_;
 
-    // FIXME(qun) improve the cache key
-    constant_cache_t::key_t constant_key_
-            = reinterpret_cast<constant_cache_t::key_t>(this);
+    // The structural hash of the constant blocks and the indices of the inputs
+    // consumed by them. Together with the data handles of those inputs and
+    // the persistent buffer size, they form the key of the cached constant
+    // buffer, so that identical prepacked weights can be shared by different
+    // compiled partitions.
+    size_t constant_hash_ = 0;
+    std::vector<size_t> const_input_indices_;
+
+    // The constant cache keys retained by this kernel, the most recently used
+    // one first. The kernel may be shared by the compiled partitions of
+    // structurally identical partitions with different constant inputs, so
+    // one key is retained for each of them.
+    std::deque<constant_cache_t::key_t> constant_keys_;
+    impl::utils::rw_mutex_t constant_keys_mutex_;
+
+    // The indices of the constant executables which depend on each input
+    std::vector<std::vector<size_t>> const_exec_deps_;
+    // The inputs whose cached constant data has been invalidated but not
+    // recomputed yet. As the kernel may be shared by the compiled partitions
+    // of structurally identical partitions, they are recorded per constant
+    // cache key and only recomputed by an execution with the same key.
+    std::unordered_map<constant_cache_t::key_t, std::vector<size_t>,
+            constant_cache_key_hash_t>
+            dirty_const_inputs_;
+    std::atomic<bool> has_dirty_const_inputs_ {false};
+    std::mutex dirty_const_inputs_mutex_;
+    // Serializes the refreshing of the cached constant buffers
+    std::mutex const_refresh_mutex_;
 
     std::once_flag once_flag_;
     subgraph_visualizer_t vis_;
     pass_pipeline_t pipeline_;
 
+    // The non-constant executables grouped into execution steps. The
+    // executables in one step are independent and will be executed
+    // concurrently if the step has more than one executable.
+    std::vector<std::vector<size_t>> exec_steps_;
+
+    // Execute the executables with their flat argument tables, otherwise with
+    // the argument maps. It can be disabled by the internal env var
+    // _ONEDNN_GRAPH_ENABLE_FLAT_EXECUTION=0 for debugging purpose.
+    bool enable_flat_execution_ = true;
+
 public:
     ~larger_partition_kernel_t() override {
         thread_local_cache_t<execution_args_set_t> res_cache;
         res_cache.remove_if_exist(reinterpret_cast<size_t>(this));
 
         if (enabled_constant_cache()) {
-            get_global_constant_cache().remove_if_exist(constant_key_);
+            for (const auto &key : constant_keys_)
+                get_global_constant_cache().release(key);
         }
     }
 
@@ -181,6 +225,13 @@ public:
             BACKEND_DNNL_ADD_PASS(pipeline, constant_propagation);
         }
 
+        setup_pipeline_stage3(pipeline, mem_planner);
+    }
+
+    // The passes after which the subgraph is not changed anymore. They are
+    // the only ones to run when the kernel is restored from a cache blob.
+    static void setup_pipeline_stage3(
+            pass_pipeline_t &pipeline, memory_planner_t &mem_planner) {
         auto memory_plan = [&](std::shared_ptr<subgraph_t> &sg) {
             return mem_planner.run(sg);
         };
@@ -195,6 +246,241 @@ public:
         setup_pipeline_stage2(pipeline, mem_planner, enable_constant_cache);
     }
 
+    // Inter-op parallel execution is controlled by the internal env var
+    // _ONEDNN_GRAPH_INTER_OP_PARALLEL:
+    // - 0 (default): execute the ops in the partition one by one
+    // - 1: execute independent ops concurrently if they are small enough (see
+    //   _ONEDNN_GRAPH_INTER_OP_PARALLEL_THRESHOLD) to under-utilize the cores
+    // - 2: always execute independent ops concurrently
+    // The env vars are for tuning purpose only and may be removed without any
+    // prior notice. The setting of the partition, if any, overrides the env
+    // var. An enabled partition uses mode 1 unless the env var asks for 2.
+    static int get_inter_op_parallel_mode(const dnnl_partition_impl_t *part) {
+        const int env_mode
+                = graph::utils::getenv_int_internal("INTER_OP_PARALLEL", 0);
+        const int part_mode = part->get_inter_op_parallel();
+        if (part_mode < 0) return env_mode;
+        return part_mode == 0 ? 0 : std::max(env_mode, 1);
+    }
+
+    // Build the execution steps from the levels of the dependency DAG. A level
+    // is kept as a concurrent step only if its average output size per op is
+    // not larger than the threshold. Otherwise, it's split into sequential
+    // steps as each op can make full use of the cores by itself.
+    void prepare_exec_steps(int mode) {
+        exec_steps_.clear();
+
+        // Sequential execution follows the topo order used by the memory
+        // planner
+        if (!memory_planner_.is_inter_op_parallel()) {
+            for (size_t i = 0; i < subgraph_->execs_.size(); i++) {
+                if (subgraph_->is_constant_[i]) continue;
+                exec_steps_.push_back({i});
+            }
+            return;
+        }
+
+        std::vector<op_t *> topo_ops;
+        topo_order_visit(subgraph_->get_output_ops(), [&](op_t *op) {
+            topo_ops.emplace_back(op);
+            return status::success;
+        });
+
+        const size_t threshold = static_cast<size_t>(
+                graph::utils::getenv_int_internal(
+                        "INTER_OP_PARALLEL_THRESHOLD", 1 << 20));
+        for (const auto &level : get_op_levels(subgraph_)) {
+            std::vector<size_t> step;
+            size_t total_size = 0;
+            for (size_t idx : level) {
+                if (subgraph_->is_constant_[idx]) continue;
+                step.emplace_back(idx);
+                for (auto &out : topo_ops[idx]->get_output_values()) {
+                    total_size += make_dnnl_memory_desc(
+                            out->get_logical_tensor())
+                                          .get_size();
+                }
+            }
+            if (step.empty()) continue;
+
+            const bool small_ops = total_size <= threshold * step.size();
+            if (mode == 2 || small_ops) {
+                exec_steps_.emplace_back(step);
+            } else {
+                // Ops of the same level never share buffers, so they can
+                // also be executed one by one in any order
+                for (size_t idx : step)
+                    exec_steps_.push_back({idx});
+            }
+        }
+    }
+
+    // Get the constant cache key for the given inputs
+    constant_cache_t::key_t make_constant_key(
+            const std::vector<tensor_t> &inputs) const {
+        std::vector<const void *> handles;
+        handles.reserve(const_input_indices_.size());
+        for (size_t idx : const_input_indices_)
+            handles.emplace_back(inputs[idx].get_data_handle());
+        return constant_cache_t::key_t(constant_hash_, std::move(handles),
+                memory_planner_.total_internal_persistent_size());
+    }
+
+    // The kernel only retains the keys of the latest used constant inputs of
+    // its users, the buffers cached for the previous ones are released when
+    // the inputs change.
+    void retain_constant_key(const constant_cache_t::key_t &key) {
+        {
+            impl::utils::lock_read_t lock_r(constant_keys_mutex_);
+            if (!constant_keys_.empty() && constant_keys_.front() == key)
+                return;
+        }
+
+        impl::utils::lock_write_t lock_w(constant_keys_mutex_);
+        auto &cache = get_global_constant_cache();
+        auto pos = std::find(constant_keys_.begin(), constant_keys_.end(), key);
+        if (pos == constant_keys_.begin()) return;
+        if (pos != constant_keys_.end()) {
+            constant_keys_.erase(pos);
+        } else {
+            cache.retain(key);
+        }
+        constant_keys_.push_front(key);
+        const size_t max_keys = std::max(get_num_users(), size_t(1));
+        while (constant_keys_.size() > max_keys) {
+            cache.release(constant_keys_.back());
+            constant_keys_.pop_back();
+        }
+    }
+
+    // Get the indices of the constant executables to be recomputed for the
+    // invalidated inputs of the given key, in the execution order
+    std::vector<size_t> get_dirty_const_execs(
+            const constant_cache_t::key_t &key) {
+        std::vector<bool> is_dirty(subgraph_->execs_.size(), false);
+        {
+            std::lock_guard<std::mutex> lock(dirty_const_inputs_mutex_);
+            auto pos = dirty_const_inputs_.find(key);
+            if (pos == dirty_const_inputs_.end()) return {};
+            for (size_t idx : pos->second) {
+                for (size_t exec_idx : const_exec_deps_[idx])
+                    is_dirty[exec_idx] = true;
+            }
+        }
+
+        std::vector<size_t> dirty_execs;
+        for (size_t i = 0; i < is_dirty.size(); i++) {
+            if (is_dirty[i]) dirty_execs.emplace_back(i);
+        }
+        return dirty_execs;
+    }
+
+    void clear_dirty_const_inputs(const constant_cache_t::key_t &key) {
+        std::lock_guard<std::mutex> lock(dirty_const_inputs_mutex_);
+        dirty_const_inputs_.erase(key);
+        has_dirty_const_inputs_ = !dirty_const_inputs_.empty();
+    }
+
+    // Recompute the invalidated constant data of the given key into a new
+    // buffer and replace the cached buffer with it. The cached buffer may be
+    // in use by other executions, so it's never modified in place. The
+    // invalidation is only cleared after the replacement, so the executions
+    // with the same key wait for the refreshed buffer.
+    void refresh_constant_buffer(dnnl::stream &p_stream,
+            execution_args_set_t *res, const constant_cache_t::key_t &key) {
+        std::lock_guard<std::mutex> lock(const_refresh_mutex_);
+        const std::vector<size_t> dirty_execs = get_dirty_const_execs(key);
+        // Refreshed by another execution
+        if (dirty_execs.empty()) return;
+
+        auto &cache = get_global_constant_cache();
+        constant_cache_t::value_t cached_value = cache.get_if_exist(key);
+        // Otherwise, all the constant data is computed by the execution
+        if (cached_value.valid()) {
+            constant_cache_t::cached_t c_buffer
+                    = std::make_shared<constant_buffer_t>(
+                            memory_planner_.total_internal_persistent_size(),
+                            p_engine_, g_alloc_);
+            bind_persistent_args(res, c_buffer->data<char>());
+            if (p_engine_.get_kind() == dnnl::engine::kind::cpu) {
+                // Copy the clean constant data and recompute the dirty ones
+                p_stream.wait();
+                std::memcpy(c_buffer->data<char>(),
+                        cached_value.get()->data<char>(), c_buffer->size());
+                for (size_t i : dirty_execs)
+                    execute_exec(p_stream, res, i);
+            } else {
+                execute_const_execs(p_stream, res);
+            }
+
+            std::promise<constant_cache_t::cached_t> c_promise;
+            c_promise.set_value(c_buffer);
+            cache.update(key, c_promise.get_future());
+        }
+        clear_dirty_const_inputs(key);
+    }
+
+    void execute_exec(const dnnl::stream &p_stream,
+            const execution_args_set_t *res, size_t i) const {
+        if (enable_flat_execution_) {
+            subgraph_->execs_[i]->execute_flat(p_stream,
+                    res->get_exec_args()[i], res->get_exec_args_tables()[i]);
+        } else {
+            subgraph_->execs_[i]->execute(p_stream, res->get_exec_args()[i]);
+        }
+    }
+
+    void execute_const_execs(
+            const dnnl::stream &p_stream, const execution_args_set_t *res) {
+        for (size_t i = 0; i < subgraph_->execs_.size(); i++) {
+            if (!subgraph_->is_constant_[i]) continue;
+            execute_exec(p_stream, res, i);
+        }
+    }
+
+    void execute_step(const dnnl::stream &p_stream,
+            const execution_args_set_t *res, const std::vector<size_t> &step) {
+        if (step.size() == 1) {
+            execute_exec(p_stream, res, step[0]);
+            return;
+        }
+
+        // Split the threads into teams, each of which executes a part of the
+        // independent ops.
+        const int max_nthr = dnnl_get_max_threads();
+        const int nteams = std::min(static_cast<int>(step.size()), max_nthr);
+        std::exception_ptr eptr;
+        std::mutex eptr_mutex;
+        auto execute_team = [&](int iteam) {
+            for (size_t i = iteam; i < step.size(); i += nteams) {
+                try {
+                    execute_exec(p_stream, res, step[i]);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(eptr_mutex);
+                    if (!eptr) eptr = std::current_exception();
+                }
+            }
+        };
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
+        // Each team runs in its own arena of max_nthr / nteams threads, which
+        // the primitives of the team use for their own parallelization.
+        const int team_nthr = std::max(max_nthr / nteams, 1);
+        dnnl::impl::parallel(nteams, [&](int iteam, int) {
+            tbb::task_arena team_arena(team_nthr);
+            team_arena.execute([&]() { execute_team(iteam); });
+        });
+#else
+        // The library doesn't support nested parallelism with the other
+        // runtimes, so a team is a single thread and the primitives run
+        // sequentially inside it. That's why independent ops are only
+        // executed concurrently by default when they are too small to use
+        // all the cores, see prepare_exec_steps().
+        dnnl::impl::parallel(
+                nteams, [&](int iteam, int) { execute_team(iteam); });
+#endif
+        if (eptr) std::rethrow_exception(eptr);
+    }
+
     status_t compile_impl(const dnnl_partition_impl_t *part,
             const engine_t *g_engine,
             const std::vector<logical_tensor_t> &inputs,
@@ -220,9 +506,17 @@ public:
                     pipeline_, memory_planner_, enabled_constant_cache());
         });
 
+        // Independent ops can only be executed concurrently on CPU. The
+        // memory planner must know it to not share buffers between them.
+        const int inter_op_parallel_mode = get_inter_op_parallel_mode(part);
+        memory_planner_.set_inter_op_parallel(inter_op_parallel_mode > 0
+                && p_engine_.get_kind() == dnnl::engine::kind::cpu);
+
         // Run the added passes
         BACKEND_DNNL_CHECK(pipeline_.run(subgraph_));
 
+        prepare_execution(inter_op_parallel_mode);
+
         // fill information for inputs logical tensors
         for (size_t i = 0; i < inputs.size(); i++) {
             auto &in = const_cast<logical_tensor_t &>(inputs[i]);
@@ -235,10 +529,117 @@ public:
             out = subgraph_->outs_[i];
         }
 
+        return status::success;
+    }
+
+    // Prepare the states needed by the execution once the pass pipeline is
+    // done
+    void prepare_execution(int inter_op_parallel_mode) {
+        prepare_exec_steps(inter_op_parallel_mode);
+        enable_flat_execution_ = graph::utils::getenv_int_internal(
+                                         "GRAPH_ENABLE_FLAT_EXECUTION", 1)
+                > 0;
+
+        if (enabled_constant_cache()) {
+            constant_hash_ = get_constant_block_hash(
+                    subgraph_, const_input_indices_);
+            constant_hash_ = hash_combine(constant_hash_,
+                    static_cast<size_t>(p_engine_.get_kind()));
+            // Only host memory can be shared between engines
+            if (p_engine_.get_kind() != dnnl::engine::kind::cpu) {
+                constant_hash_ = hash_combine(constant_hash_,
+                        reinterpret_cast<uintptr_t>(p_engine_.get()));
+            }
+            const_exec_deps_ = get_constant_op_dependencies(subgraph_);
+        }
+
         resource_ctor_ = [this]() {
             return this->memory_planner_.get_exec_args_set().clone();
         };
+    }
+
+    // The blob contains the subgraph right before the memory planning, which
+    // is the end of the transformations, and a summary of the memory plan.
+    // Primitive cache blobs are not stored as the cpu primitives don't
+    // support them, the primitives are created again from the restored ops.
+    status_t get_cache_blob_impl(blob_writer_t &writer) const override {
+        BACKEND_DNNL_CHECK(serialize_subgraph(subgraph_, writer));
+        writer.write(memory_planner_.total_internal_temporary_size());
+        writer.write(memory_planner_.total_internal_persistent_size());
+        writer.write_vector(memory_planner_.get_subgraph_inplace_pairs());
+        return status::success;
+    }
+
+    status_t compile_from_cache_blob_impl(const dnnl_partition_impl_t *part,
+            const engine_t *g_engine, blob_reader_t &reader,
+            std::vector<logical_tensor_t> &inputs,
+            std::vector<logical_tensor_t> &outputs) override {
+        p_engine_ = make_dnnl_engine(*g_engine);
+        g_alloc_ = reinterpret_cast<graph::allocator_t *>(
+                g_engine->get_allocator());
+
+        BACKEND_DNNL_CHECK(deserialize_subgraph(reader, p_engine_,
+                part->get_fpmath_mode(), part->get_use_blocked_layout(),
+                subgraph_));
+
+        size_t temporary_size = 0, persistent_size = 0;
+        std::vector<inplace_pair_t> inplace_pairs;
+        if (!reader.read(&temporary_size) || !reader.read(&persistent_size)
+                || !reader.read_vector(&inplace_pairs))
+            return status::invalid_arguments;
+
+        vis_ = subgraph_visualizer_t(part->id(), [this](const value_t *val) {
+            return this->memory_planner_.get_memory_info(val);
+        });
+        pass_pipeline_t pipeline(vis_);
+        setup_pipeline_stage3(pipeline, memory_planner_);
+
+        const int inter_op_parallel_mode = get_inter_op_parallel_mode(part);
+        memory_planner_.set_inter_op_parallel(inter_op_parallel_mode > 0
+                && p_engine_.get_kind() == dnnl::engine::kind::cpu);
+        BACKEND_DNNL_CHECK(pipeline.run(subgraph_));
+
+        // Replanning the memory is cheap, but the plan must be the same as
+        // the serialized one. Otherwise, the blob was created with different
+        // memory planning settings and is rejected.
+        const auto &planned_pairs
+                = memory_planner_.get_subgraph_inplace_pairs();
+        bool same_plan
+                = memory_planner_.total_internal_temporary_size()
+                        == temporary_size
+                && memory_planner_.total_internal_persistent_size()
+                        == persistent_size
+                && planned_pairs.size() == inplace_pairs.size();
+        for (size_t i = 0; same_plan && i < inplace_pairs.size(); i++) {
+            same_plan = planned_pairs[i].input_id == inplace_pairs[i].input_id
+                    && planned_pairs[i].output_id
+                            == inplace_pairs[i].output_id;
+        }
+        if (!same_plan) return status::invalid_arguments;
+
+        prepare_execution(inter_op_parallel_mode);
+
+        inputs = subgraph_->ins_;
+        outputs = subgraph_->outs_;
+        return status::success;
+    }
 
+    // Only the constant executables depending on the invalidated input are
+    // recomputed in the next execution with the same inputs, see
+    // refresh_constant_buffer(). As the cached buffer may be shared by other
+    // compiled partitions with the same weights, the refreshed data is
+    // visible to them as well.
+    status_t invalidate_constant_input_impl(size_t input_index,
+            const std::vector<tensor_t> &inputs) override {
+        if (!enabled_constant_cache()) return status::success;
+        if (input_index >= const_exec_deps_.size())
+            return status::invalid_arguments;
+        if (const_exec_deps_[input_index].empty()) return status::success;
+
+        const constant_cache_t::key_t key = make_constant_key(inputs);
+        std::lock_guard<std::mutex> lock(dirty_const_inputs_mutex_);
+        dirty_const_inputs_[key].emplace_back(input_index);
+        has_dirty_const_inputs_ = true;
         return status::success;
     }
 
@@ -247,26 +648,31 @@ public:
         return status::success;
     }
 
-    void prepare_args_set(const execution_args_set_t *res,
+    void prepare_args_set(execution_args_set_t *res,
             const std::vector<tensor_t> &inputs,
             const std::vector<tensor_t> &outputs,
             const scratchpad_t &scratchpad) {
         // update the data of partition in/outputs args
-        for (const auto &mem_idx : res->get_mems_use_external_inputs()) {
-            mem_idx.first.set_data_handle(
-                    inputs[mem_idx.second].get_data_handle());
+        for (auto &slot : res->get_external_input_slots()) {
+            slot.bind(inputs[slot.src_].get_data_handle());
         }
-        for (const auto &mem_idx : res->get_mems_use_external_outputs()) {
-            mem_idx.first.set_data_handle(
-                    outputs[mem_idx.second].get_data_handle());
+        for (auto &slot : res->get_external_output_slots()) {
+            slot.bind(outputs[slot.src_].get_data_handle());
         }
 
         grantor_t var_grantor = memory_planner_.internal_temporary_grantor(
                 scratchpad.get_buffer());
 
-        for (auto &mem_offkey : res->get_mems_use_internal_temporary()) {
-            mem_offkey.first.set_data_handle(
-                    var_grantor.get(mem_offkey.second));
+        for (auto &slot : res->get_internal_temporary_slots()) {
+            slot.bind(var_grantor.get_by_offset(slot.src_));
+        }
+    }
+
+    void bind_persistent_args(execution_args_set_t *res, char *buffer) {
+        grantor_t c_grantor
+                = memory_planner_.internal_persistent_grantor(buffer);
+        for (auto &slot : res->get_internal_persistent_slots()) {
+            slot.bind(c_grantor.get_by_offset(slot.src_));
         }
     }
 
@@ -280,7 +686,7 @@ public:
         execution_args_set_t *res = res_cache.get_or_add(
                 reinterpret_cast<size_t>(this), resource_ctor_);
 
-        temporary_scratchpad_t scratchpad(
+        reusable_scratchpad_t scratchpad(
                 memory_planner_.total_internal_temporary_size(), p_engine_,
                 *g_alloc_);
         assertm(scratchpad.size()
@@ -289,55 +695,72 @@ public:
         prepare_args_set(res, inputs, outputs, scratchpad);
 
         if (enabled_constant_cache()) {
+            const constant_cache_t::key_t key = make_constant_key(inputs);
+            retain_constant_key(key);
+            if (has_dirty_const_inputs_)
+                refresh_constant_buffer(p_stream, res, key);
             std::promise<constant_cache_t::cached_t> c_promise;
             constant_cache_t::value_t cached_value
                     = get_global_constant_cache().get_or_add(
-                            constant_key_, c_promise.get_future());
+                            key, c_promise.get_future());
             bool is_from_cache = cached_value.valid();
             if (is_from_cache) {
                 const constant_cache_t::cached_t &c_buffer = cached_value.get();
-                grantor_t c_grantor
-                        = memory_planner_.internal_persistent_grantor(
-                                c_buffer->data<char>());
-                for (auto &mem_offkey :
-                        res->get_mems_use_internal_persistent()) {
-                    mem_offkey.first.set_data_handle(
-                            c_grantor.get(mem_offkey.second));
-                }
+                bind_persistent_args(res, c_buffer->data<char>());
             } else {
                 constant_cache_t::cached_t c_buffer
                         = std::make_shared<constant_buffer_t>(
                                 memory_planner_
                                         .total_internal_persistent_size(),
                                 p_engine_, g_alloc_);
-                grantor_t c_grantor
-                        = memory_planner_.internal_persistent_grantor(
-                                c_buffer->data<char>());
-                for (auto &mem_offkey :
-                        res->get_mems_use_internal_persistent()) {
-                    mem_offkey.first.set_data_handle(
-                            c_grantor.get(mem_offkey.second));
-                }
-
-                for (size_t i = 0; i < subgraph_->execs_.size(); i++) {
-                    if (!subgraph_->is_constant_[i]) continue;
-                    subgraph_->execs_[i]->execute(
-                            p_stream, res->get_exec_args()[i]);
-                }
-
+                bind_persistent_args(res, c_buffer->data<char>());
+                execute_const_execs(p_stream, res);
                 c_promise.set_value(c_buffer);
             }
         }
 
-        for (size_t i = 0; i < subgraph_->execs_.size(); i++) {
-            if (subgraph_->is_constant_[i]) continue;
-            subgraph_->execs_[i]->execute(p_stream, res->get_exec_args()[i]);
+        for (const auto &step : exec_steps_) {
+            execute_step(p_stream, res, step);
         }
 
         return status::success;
     }
 
 #ifdef DNNL_WITH_SYCL
+    void sycl_execute_const_execs(const dnnl::stream &p_stream,
+            const execution_args_set_t *res, std::vector<::sycl::event> &deps) {
+        for (size_t i = 0; i < subgraph_->execs_.size(); i++) {
+            if (!subgraph_->is_constant_[i]) continue;
+            ::sycl::event returned_event = subgraph_->execs_[i]->execute_sycl(
+                    p_stream, res->get_exec_args()[i], deps);
+            deps = {returned_event};
+        }
+    }
+
+    // The same as refresh_constant_buffer(). The device buffer can't be
+    // copied on host, so all the constant data is recomputed.
+    void sycl_refresh_constant_buffer(const dnnl::stream &p_stream,
+            execution_args_set_t *res, const constant_cache_t::key_t &key,
+            std::vector<::sycl::event> &deps) {
+        std::lock_guard<std::mutex> lock(const_refresh_mutex_);
+        if (get_dirty_const_execs(key).empty()) return;
+
+        auto &cache = get_global_constant_cache();
+        if (cache.get_if_exist(key).valid()) {
+            constant_cache_t::cached_t c_buffer
+                    = std::make_shared<constant_buffer_t>(
+                            memory_planner_.total_internal_persistent_size(),
+                            p_engine_, g_alloc_);
+            bind_persistent_args(res, c_buffer->data<char>());
+            sycl_execute_const_execs(p_stream, res, deps);
+
+            std::promise<constant_cache_t::cached_t> c_promise;
+            c_promise.set_value(c_buffer);
+            cache.update(key, c_promise.get_future());
+        }
+        clear_dirty_const_inputs(key);
+    }
+
     status_t sycl_execute_impl(const stream_t *g_stream,
             const std::vector<tensor_t> &inputs,
             const std::vector<tensor_t> &outputs,
@@ -361,43 +784,26 @@ public:
         prepare_args_set(res, inputs, outputs, scratchpad);
 
         if (enabled_constant_cache()) {
+            const constant_cache_t::key_t key = make_constant_key(inputs);
+            retain_constant_key(key);
+            if (has_dirty_const_inputs_)
+                sycl_refresh_constant_buffer(p_stream, res, key, deps);
             std::promise<constant_cache_t::cached_t> c_promise;
             constant_cache_t::value_t cached_value
                     = get_global_constant_cache().get_or_add(
-                            constant_key_, c_promise.get_future());
+                            key, c_promise.get_future());
             bool is_from_cache = cached_value.valid();
             if (is_from_cache) {
                 const constant_cache_t::cached_t &c_buffer = cached_value.get();
-                grantor_t c_grantor
-                        = memory_planner_.internal_persistent_grantor(
-                                c_buffer->data<char>());
-                for (auto &mem_offkey :
-                        res->get_mems_use_internal_persistent()) {
-                    mem_offkey.first.set_data_handle(
-                            c_grantor.get(mem_offkey.second));
-                }
+                bind_persistent_args(res, c_buffer->data<char>());
             } else {
                 constant_cache_t::cached_t c_buffer
                         = std::make_shared<constant_buffer_t>(
                                 memory_planner_
                                         .total_internal_persistent_size(),
                                 p_engine_, g_alloc_);
-                grantor_t c_grantor
-                        = memory_planner_.internal_persistent_grantor(
-                                c_buffer->data<char>());
-                for (auto &mem_offkey :
-                        res->get_mems_use_internal_persistent()) {
-                    mem_offkey.first.set_data_handle(
-                            c_grantor.get(mem_offkey.second));
-                }
-
-                for (size_t i = 0; i < subgraph_->execs_.size(); i++) {
-                    if (!subgraph_->is_constant_[i]) continue;
-                    returned_event = subgraph_->execs_[i]->execute_sycl(
-                            p_stream, res->get_exec_args()[i], deps);
-                    deps = {returned_event};
-                }
-
+                bind_persistent_args(res, c_buffer->data<char>());
+                sycl_execute_const_execs(p_stream, res, deps);
                 c_promise.set_value(c_buffer);
             }
         }
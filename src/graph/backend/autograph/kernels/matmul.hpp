@@ -56,8 +56,7 @@ private:
     std::function<std::shared_ptr<execution_args_set_t>()> resource_ctor_;
 
     // FIXME(qun) improve the cache key
-    constant_cache_t::key_t constant_key_
-            = reinterpret_cast<constant_cache_t::key_t>(this);
+    constant_cache_t::key_t constant_key_ {this};
 
 public:
     ~matmul_t() override {
@@ -69,6 +68,24 @@ public:
         }
     }
 
+    // The constant block of a single op kernel is small, so all the cached
+    // constant data is dropped and recomputed in the next execution.
+    status_t invalidate_constant_input_impl(size_t input_index,
+            const std::vector<tensor_t> &inputs) override {
+        UNUSED(input_index);
+        UNUSED(inputs);
+        if (enabled_constant_cache()) {
+            get_global_constant_cache().remove_if_exist(constant_key_);
+        }
+        return status::success;
+    }
+
+    // The constant data is cached per kernel instead of per inputs
+    bool is_shareable() const override {
+        return !enabled_constant_cache()
+                || memory_planner_.total_internal_persistent_size() == 0;
+    }
+
     status_t compile_impl(const dnnl_partition_impl_t *part,
             const engine_t *g_engine,
             const std::vector<logical_tensor_t> &inputs,
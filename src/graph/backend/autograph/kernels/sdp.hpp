@@ -0,0 +1,237 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_BACKEND_DNNL_KERNELS_SDP_HPP
+#define GRAPH_BACKEND_DNNL_KERNELS_SDP_HPP
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "common/primitive_desc_iface.hpp"
+#include "common/sdpa_utils.hpp"
+
+#include "graph/interface/backend.hpp"
+#include "graph/interface/graph.hpp"
+
+#include "graph/backend/autograph/common.hpp"
+#include "graph/backend/autograph/kernels/large_partition.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace autograph_impl {
+
+// The kernel of the scaled dot product attention partitions: MatMul of the
+// queries and the keys, optionally scaled and masked, SoftMax and MatMul with
+// the values. On CPU, the partition is computed by a single fused primitive,
+// so the scores are never written to memory. Partitions which the fused
+// primitive doesn't support are compiled as a large partition.
+class sdp_primitive_kernel_t : public larger_partition_kernel_t {
+    bool use_sdpa_ = false;
+    dnnl::primitive sdpa_prim_;
+
+    // The indices of the partition inputs, -1 for the absent ones
+    int q_idx_ = -1;
+    int k_idx_ = -1;
+    int v_idx_ = -1;
+    int msk_idx_ = -1;
+    int scale_idx_ = -1;
+
+    memory::desc q_md_, k_md_, v_md_, msk_md_, scale_md_, dst_md_;
+
+    status_t compile_sdpa(const dnnl_partition_impl_t *part,
+            const engine_t *g_engine,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) {
+#ifdef DNNL_WITH_SYCL
+        return status::unimplemented;
+#endif
+        if (g_engine->kind() != graph::engine_kind::cpu
+                || outputs.size() != 1)
+            return status::unimplemented;
+
+        const op_t *mm_qk = nullptr, *scale = nullptr, *add = nullptr,
+                   *softmax = nullptr, *mm_v = nullptr;
+        for (const auto &op : part->get_ops()) {
+            const auto kind = op->get_kind();
+            if (kind == graph::op_kind::MatMul) {
+                const auto &in0 = op->get_input_value(0);
+                const bool after_softmax = in0->has_producer()
+                        && in0->get_producer().get_kind()
+                                == graph::op_kind::SoftMax;
+                (after_softmax ? mm_v : mm_qk) = op.get();
+            } else if (kind == graph::op_kind::Divide
+                    || kind == graph::op_kind::Multiply) {
+                scale = op.get();
+            } else if (kind == graph::op_kind::Add) {
+                add = op.get();
+            } else if (kind == graph::op_kind::SoftMax) {
+                softmax = op.get();
+            } else {
+                return status::unimplemented;
+            }
+        }
+        if (!mm_qk || !softmax || !mm_v) return status::unimplemented;
+
+        const auto input_index = [&](const op_t *op, size_t offset) {
+            const size_t id
+                    = op->get_input_value(offset)->get_logical_tensor().id;
+            for (size_t i = 0; i < inputs.size(); i++)
+                if (inputs[i].id == id) return static_cast<int>(i);
+            return -1;
+        };
+        const auto get_bool_attr = [](const op_t *op, op_attr_t name) {
+            return op->has_attr(name) && op->get_attr<bool>(name);
+        };
+
+        if (mm_qk->num_inputs() != 2 || mm_v->num_inputs() != 2
+                || get_bool_attr(mm_qk, op_attr::transpose_a)
+                || get_bool_attr(mm_v, op_attr::transpose_a)
+                || get_bool_attr(mm_v, op_attr::transpose_b))
+            return status::unimplemented;
+
+        q_idx_ = input_index(mm_qk, 0);
+        k_idx_ = input_index(mm_qk, 1);
+        v_idx_ = input_index(mm_v, 1);
+        scale_idx_ = scale ? input_index(scale, 1) : -1;
+        msk_idx_ = add ? input_index(add, 1) : -1;
+        if (q_idx_ < 0 || k_idx_ < 0 || v_idx_ < 0
+                || (scale && scale_idx_ < 0) || (add && msk_idx_ < 0))
+            return status::unimplemented;
+
+        for (int idx : {q_idx_, k_idx_, v_idx_, msk_idx_, scale_idx_}) {
+            if (idx < 0) continue;
+            const logical_tensor_wrapper_t ltw(inputs[idx]);
+            if (!ltw.is_strided() || ltw.is_shape_unknown())
+                return status::unimplemented;
+        }
+        const logical_tensor_wrapper_t dst_ltw(outputs[0]);
+        if (!(dst_ltw.is_strided() || dst_ltw.is_any())
+                || dst_ltw.is_shape_unknown())
+            return status::unimplemented;
+
+        const int ndims = logical_tensor_wrapper_t(inputs[q_idx_]).ndims();
+        if (ndims < 2 || dst_ltw.ndims() != ndims)
+            return status::unimplemented;
+        const int64_t axis = softmax->get_attr<int64_t>(op_attr::axis);
+        if (axis != -1 && axis != ndims - 1) return status::unimplemented;
+
+        q_md_ = make_dnnl_memory_desc(inputs[q_idx_]);
+        k_md_ = make_dnnl_memory_desc(inputs[k_idx_]);
+        v_md_ = make_dnnl_memory_desc(inputs[v_idx_]);
+        if (get_bool_attr(mm_qk, op_attr::transpose_b))
+            k_md_ = transpose(k_md_, ndims - 2, ndims - 1);
+
+        const memory_desc_t *msk_md = nullptr;
+        if (add) {
+            // The mask is broadcast as per numpy rules
+            msk_md_ = make_dnnl_memory_desc(inputs[msk_idx_]);
+            if (msk_md_.get_ndims() > ndims) return status::unimplemented;
+            msk_md_ = expand(msk_md_, ndims);
+            msk_md = msk_md_.get();
+        }
+
+        data_type_t scale_dt = impl::data_type::undef;
+        if (scale) {
+            if (logical_tensor_wrapper_t(inputs[scale_idx_]).nelems() != 1)
+                return status::unimplemented;
+            scale_md_ = make_dnnl_memory_desc(inputs[scale_idx_]);
+            scale_dt = inputs[scale_idx_].data_type;
+        }
+        const bool invert_scale
+                = scale && scale->get_kind() == graph::op_kind::Divide;
+
+        dst_md_ = make_dnnl_memory_desc(outputs[0]);
+        if (dst_ltw.is_any())
+            dst_md_ = memory::desc(dst_md_.get_dims(),
+                    dst_md_.get_data_type(), get_ncx_format(ndims));
+
+        p_engine_ = make_dnnl_engine(*g_engine);
+        std::shared_ptr<primitive_desc_t> pd;
+        CHECK(create_sdpa_pd(pd, p_engine_.get(), q_md_.get(), k_md_.get(),
+                v_md_.get(), dst_md_.get(), msk_md, scale_dt, invert_scale,
+                /* causal_mask = */ false));
+
+        try {
+            sdpa_prim_ = dnnl::primitive(dnnl::primitive_desc(
+                    new primitive_desc_iface_t(pd, p_engine_.get())));
+        } catch (...) { return status::unimplemented; }
+
+        auto &out = const_cast<logical_tensor_t &>(outputs[0]);
+        return fill_layout_info(&out, dst_md_);
+    }
+
+public:
+    status_t compile_impl(const dnnl_partition_impl_t *part,
+            const engine_t *g_engine,
+            const std::vector<logical_tensor_t> &inputs,
+            const std::vector<logical_tensor_t> &outputs) override {
+        use_sdpa_ = compile_sdpa(part, g_engine, inputs, outputs)
+                == status::success;
+        if (use_sdpa_) return status::success;
+        return larger_partition_kernel_t::compile_impl(
+                part, g_engine, inputs, outputs);
+    }
+
+    // The fused primitive is created again from the partition, so only the
+    // large partition kernels are serialized
+    status_t get_cache_blob_impl(blob_writer_t &writer) const override {
+        if (use_sdpa_) return status::unimplemented;
+        return larger_partition_kernel_t::get_cache_blob_impl(writer);
+    }
+
+    // The fused primitive caches no constant data
+    status_t invalidate_constant_input_impl(size_t input_index,
+            const std::vector<tensor_t> &inputs) override {
+        if (use_sdpa_) return status::success;
+        return larger_partition_kernel_t::invalidate_constant_input_impl(
+                input_index, inputs);
+    }
+
+    status_t execute_impl(const stream_t *g_stream,
+            const std::vector<tensor_t> &inputs,
+            const std::vector<tensor_t> &outputs) override {
+        if (!use_sdpa_)
+            return larger_partition_kernel_t::execute_impl(
+                    g_stream, inputs, outputs);
+
+        dnnl::stream p_stream = make_dnnl_stream(p_engine_, *g_stream);
+        const auto make_mem = [&](const memory::desc &md, const tensor_t &t) {
+            return make_dnnl_memory(md, p_engine_, t.get_data_handle());
+        };
+
+        std::unordered_map<int, memory> args;
+        args[DNNL_ARG_QUERIES] = make_mem(q_md_, inputs[q_idx_]);
+        args[DNNL_ARG_KEYS] = make_mem(k_md_, inputs[k_idx_]);
+        args[DNNL_ARG_VALUES] = make_mem(v_md_, inputs[v_idx_]);
+        if (msk_idx_ >= 0)
+            args[DNNL_ARG_ATTN_MASK] = make_mem(msk_md_, inputs[msk_idx_]);
+        if (scale_idx_ >= 0)
+            args[DNNL_ARG_SCALE] = make_mem(scale_md_, inputs[scale_idx_]);
+        args[DNNL_ARG_DST] = make_mem(dst_md_, outputs[0]);
+
+        sdpa_prim_.execute(p_stream, args);
+        return status::success;
+    }
+};
+
+} // namespace autograph_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+#endif
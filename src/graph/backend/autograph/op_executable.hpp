@@ -80,10 +80,36 @@ inline arg_indices_t dummy_arg_indices_getter(
     static arg_indices_t get_arg_indices( \
             const op_t *op, fusion_info_mgr_t &mgr);
 
+// Execute a primitive with a flat args table, which avoids converting the args
+// map on every call like dnnl::primitive::execute does.
+inline void execute_primitive(const dnnl::primitive &prim,
+        const stream &stream, const exec_args_table &table) {
+    dnnl::error::wrap_c_api(
+            dnnl_primitive_execute(prim.get(), stream.get(),
+                    static_cast<int>(table.size()), table.data()),
+            "could not execute a primitive");
+}
+
+// Used to define the flat execute inside an op executable class whose execute
+// just passes the args to its primitive prim_
+#define DEFINE_EXECUTE_FLAT \
+    void execute_flat(const stream &stream, const exec_args &args, \
+            const exec_args_table &table) const override { \
+        UNUSED(args); \
+        execute_primitive(prim_, stream, table); \
+    }
+
 struct op_executable_t {
     virtual ~op_executable_t() = default;
     virtual void execute(const stream &stream,
             const std::unordered_map<int, memory> &args) const = 0;
+    // Execute with the flat form of args prepared at compile time. By default
+    // it falls back to execute().
+    virtual void execute_flat(const stream &stream, const exec_args &args,
+            const exec_args_table &table) const {
+        UNUSED(table);
+        execute(stream, args);
+    }
 #ifdef DNNL_WITH_SYCL
     virtual ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -333,6 +359,16 @@ struct conv_fwd_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    void execute_flat(const stream &stream, const exec_args &args,
+            const exec_args_table &table) const override {
+        // the sum post-op needs to look up the args by name
+        if (with_sum_) {
+            execute(stream, args);
+            return;
+        }
+        execute_primitive(prim_, stream, table);
+    }
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -422,6 +458,16 @@ struct deconv_fwd_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    void execute_flat(const stream &stream, const exec_args &args,
+            const exec_args_table &table) const override {
+        // the sum post-op needs to look up the args by name
+        if (with_sum_) {
+            execute(stream, args);
+            return;
+        }
+        execute_primitive(prim_, stream, table);
+    }
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -467,6 +513,8 @@ struct deconv_bwd_data_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -498,6 +546,8 @@ struct deconv_bwd_weights_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -568,6 +618,16 @@ struct matmul_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    void execute_flat(const stream &stream, const exec_args &args,
+            const exec_args_table &table) const override {
+        // dummy and sum post-op cases need to look up the args by name
+        if (is_dummy_ || with_sum_) {
+            execute(stream, args);
+            return;
+        }
+        execute_primitive(prim_, stream, table);
+    }
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -619,6 +679,8 @@ struct eltwise_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -649,6 +711,8 @@ struct eltwise_bwd_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -708,6 +772,16 @@ struct binary_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    void execute_flat(const stream &stream, const exec_args &args,
+            const exec_args_table &table) const override {
+        // dummy and sum post-op cases need to look up the args by name
+        if (is_dummy_ || with_sum_) {
+            execute(stream, args);
+            return;
+        }
+        execute_primitive(prim_, stream, table);
+    }
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -758,6 +832,8 @@ struct concat_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -788,6 +864,8 @@ struct shuffle_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -817,6 +895,8 @@ struct pool_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -847,6 +927,8 @@ struct pool_bwd_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -876,6 +958,8 @@ struct prelu_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -906,6 +990,8 @@ struct prelu_bwd_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -947,6 +1033,16 @@ struct reorder_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    void execute_flat(const stream &stream, const exec_args &args,
+            const exec_args_table &table) const override {
+        // the sum post-op needs to look up the args by name
+        if (with_sum_) {
+            execute(stream, args);
+            return;
+        }
+        execute_primitive(prim_, stream, table);
+    }
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -1226,6 +1322,8 @@ struct conv_bwd_data_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -1257,6 +1355,8 @@ struct conv_bwd_weights_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -1331,6 +1431,16 @@ struct batchnorm_executable_t : public op_executable_t {
                                 {DNNL_ARG_DST, new_running_variance}});
     }
 
+    void execute_flat(const stream &stream, const exec_args &args,
+            const exec_args_table &table) const override {
+        // training needs to update the running statistics
+        if (is_training_) {
+            execute(stream, args);
+            return;
+        }
+        execute_primitive(prim_, stream, table);
+    }
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -1404,6 +1514,8 @@ struct batchnorm_bwd_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -1445,6 +1557,16 @@ struct resampling_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    void execute_flat(const stream &stream, const exec_args &args,
+            const exec_args_table &table) const override {
+        // the sum post-op needs to look up the args by name
+        if (with_sum_) {
+            execute(stream, args);
+            return;
+        }
+        execute_primitive(prim_, stream, table);
+    }
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -1489,6 +1611,8 @@ struct resampling_bwd_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -1520,6 +1644,8 @@ struct layernorm_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -1551,6 +1677,8 @@ struct layernorm_bwd_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -1580,6 +1708,8 @@ struct sum_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -1610,6 +1740,8 @@ struct softmax_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -1640,6 +1772,8 @@ struct softmax_bwd_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    DEFINE_EXECUTE_FLAT
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
@@ -1683,6 +1817,16 @@ struct reduction_executable_t : public op_executable_t {
         prim_.execute(stream, args);
     }
 
+    void execute_flat(const stream &stream, const exec_args &args,
+            const exec_args_table &table) const override {
+        // the sum post-op needs to look up the args by name
+        if (with_sum_) {
+            execute(stream, args);
+            return;
+        }
+        execute_primitive(prim_, stream, table);
+    }
+
 #ifdef DNNL_WITH_SYCL
     ::sycl::event execute_sycl(const stream &stream,
             const std::unordered_map<int, memory> &args,
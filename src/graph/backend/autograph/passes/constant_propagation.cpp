@@ -17,10 +17,17 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
 
+#include "common/primitive_hashing.hpp"
+
+#include "graph/interface/partition_hashing.hpp"
 #include "graph/interface/value.hpp"
 
+#include "graph/backend/autograph/fusion_info.hpp"
 #include "graph/backend/autograph/internal_attrs.hpp"
 #include "graph/backend/autograph/passes/utils.hpp"
 #include "graph/backend/autograph/utils.hpp"
@@ -132,6 +139,112 @@ status_t constant_propagation(std::shared_ptr<subgraph_t> &sg) {
     return status::success;
 }
 
+size_t get_constant_block_hash(const std::shared_ptr<subgraph_t> &sg,
+        std::vector<size_t> &const_input_indices) {
+    using namespace partition_hashing;
+    const_input_indices.clear();
+
+    // The fusion info key is an index to the fusion info manager, the fusion
+    // info itself is hashed through the created primitive attr below.
+    static const std::unordered_set<op_attr_t> skipped_attrs {
+            op_attr::fusion_info_key};
+
+    auto get_md_hash = [](const value_t *val) {
+        auto md = make_dnnl_memory_desc(val->get_logical_tensor());
+        return primitive_hashing::get_md_hash(*md.get());
+    };
+
+    size_t seed = 0;
+    size_t op_index = 0;
+    std::unordered_map<const op_t *, size_t> op_indices;
+    auto ret = topo_order_visit(sg->get_output_ops(), [&](op_t *op) {
+        op_indices[op] = op_index++;
+        if (!op->has_attr(op_attr::is_constant)
+                || !op->get_attr<bool>(op_attr::is_constant))
+            return status::success;
+
+        seed = hash_combine(seed, static_cast<size_t>(op->get_kind()));
+        seed = hash_combine(seed, get_op_attributes_hash(*op, skipped_attrs));
+        if (op->has_attr(op_attr::fusion_info_key)
+                && op->get_attr<int64_t>(op_attr::fusion_info_key) != -1) {
+            int64_t key = op->get_attr<int64_t>(op_attr::fusion_info_key);
+            const fusion_info_t &fusion_info
+                    = sg->fusion_info_mgr_.get_info(key);
+            dnnl::primitive_attr attr = make_dnnl_primitive_attr(
+                    op->shared_from_this(), fusion_info);
+            seed = hash_combine(
+                    seed, primitive_hashing::get_attr_hash(*attr.get()));
+        }
+
+        for (const auto &in : op->get_input_values()) {
+            seed = hash_combine(seed, get_md_hash(in.get()));
+            if (in->has_producer()) {
+                // connection to the producer inside the subgraph
+                seed = hash_combine(
+                        seed, op_indices.at(&(in->get_producer())));
+                seed = hash_combine(seed, in->get_offset());
+                continue;
+            }
+
+            // the input comes from user given subgraph inputs
+            const size_t lt_id = in->get_logical_tensor().id;
+            for (size_t i = 0; i < sg->ins_.size(); i++) {
+                if (sg->ins_[i].id != lt_id) continue;
+                const_input_indices.emplace_back(i);
+                seed = hash_combine(seed, i);
+                break;
+            }
+        }
+
+        for (const auto &out : op->get_output_values()) {
+            seed = hash_combine(seed, get_md_hash(out.get()));
+        }
+        return status::success;
+    });
+    if (ret != status::success) return 0;
+    return seed;
+}
+
+std::vector<std::vector<size_t>> get_constant_op_dependencies(
+        const std::shared_ptr<subgraph_t> &sg) {
+    std::vector<std::vector<size_t>> deps(sg->ins_.size());
+    std::unordered_map<size_t, size_t> input_indices;
+    for (size_t i = 0; i < sg->ins_.size(); i++) {
+        input_indices[sg->ins_[i].id] = i;
+    }
+
+    // The subgraph inputs that each constant op depends on. The producers of
+    // a constant op are always constant, so they are visited before it.
+    std::unordered_map<const op_t *, std::set<size_t>> op_inputs;
+    size_t op_index = 0;
+    topo_order_visit(sg->get_output_ops(), [&](op_t *op) {
+        const size_t cur_index = op_index++;
+        if (!op->has_attr(op_attr::is_constant)
+                || !op->get_attr<bool>(op_attr::is_constant))
+            return status::success;
+
+        std::set<size_t> &cur_inputs = op_inputs[op];
+        for (const auto &in : op->get_input_values()) {
+            if (in->has_producer()) {
+                auto pos = op_inputs.find(&(in->get_producer()));
+                if (pos != op_inputs.end()) {
+                    cur_inputs.insert(pos->second.begin(), pos->second.end());
+                }
+                continue;
+            }
+
+            auto pos = input_indices.find(in->get_logical_tensor().id);
+            if (pos != input_indices.end()) cur_inputs.insert(pos->second);
+        }
+
+        for (size_t idx : cur_inputs) {
+            deps[idx].emplace_back(cur_index);
+        }
+        return status::success;
+    });
+    return deps;
+}
+
 } // namespace autograph_impl
 } // namespace graph
 } // namespace impl
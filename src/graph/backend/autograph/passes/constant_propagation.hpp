@@ -17,6 +17,7 @@
 #define GRAPH_BACKEND_DNNL_PASSES_CONSTANT_PROPAGATION_HPP
 
 #include <memory>
+#include <vector>
 
 #include "graph/interface/c_types_map.hpp"
 
@@ -29,6 +30,23 @@ namespace autograph_impl {
 
 status_t constant_propagation(std::shared_ptr<subgraph_t> &sg);
 
+// Compute a structural hash of the constant blocks in a compiled subgraph. The
+// hash covers the kinds, attributes, fusion information, memory descriptors
+// and connections of the constant ops, but not the op or tensor ids, so that
+// structurally identical constant blocks get the same hash. The indices of the
+// subgraph inputs consumed by the constant ops are returned in
+// @p const_input_indices in the order in which they were hashed.
+size_t get_constant_block_hash(const std::shared_ptr<subgraph_t> &sg,
+        std::vector<size_t> &const_input_indices);
+
+// Get the constant ops which depend on each subgraph input directly or
+// indirectly. The ops are identified by their indices in the topological
+// order, which is also the order of the executables of the compiled subgraph.
+// The i-th returned vector contains the sorted op indices for the i-th
+// subgraph input.
+std::vector<std::vector<size_t>> get_constant_op_dependencies(
+        const std::shared_ptr<subgraph_t> &sg);
+
 } // namespace autograph_impl
 } // namespace graph
 } // namespace impl
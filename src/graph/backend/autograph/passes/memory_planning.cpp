@@ -15,6 +15,7 @@
  *******************************************************************************/
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <set>
 #include <vector>
@@ -24,6 +25,8 @@
 #include "graph/interface/c_types_map.hpp"
 #include "graph/interface/value.hpp"
 
+#include "graph/utils/verbose.hpp"
+
 #include "graph/backend/autograph/common.hpp"
 #include "graph/backend/autograph/op_executable.hpp"
 
@@ -205,6 +208,8 @@ std::shared_ptr<execution_args_set_t> execution_args_set_t::clone() const {
     }
 
     ret->topo_ordered_exec_args_.reserve(topo_ordered_exec_args_.size());
+    ret->topo_ordered_exec_args_tables_.reserve(
+            topo_ordered_exec_args_tables_.size());
     for (const auto &args : topo_ordered_exec_args_) {
         std::unordered_map<int, memory> new_args;
         for (auto &kv : args) {
@@ -212,12 +217,58 @@ std::shared_ptr<execution_args_set_t> execution_args_set_t::clone() const {
             const memory &mem = kv.second;
             new_args.insert({idx, ret->value_mem_map_.at(find_val(mem))});
         }
-        ret->topo_ordered_exec_args_.emplace_back(new_args);
+        ret->add_exec_args(new_args);
     }
 
+    // the slots are in the same order as the classified memories, so only the
+    // resolved sources need to be copied
+    auto clone_slots = [](const std::vector<mem_slot_t> &slots,
+                               const std::vector<std::pair<dnnl::memory,
+                                       size_t>> &new_mems,
+                               std::vector<mem_slot_t> &new_slots) {
+        assertm(slots.empty() || slots.size() == new_mems.size(),
+                "slots mismatch with memories");
+        new_slots.reserve(slots.size());
+        for (size_t i = 0; i < slots.size(); i++) {
+            new_slots.emplace_back(new_mems[i].first, slots[i].src_);
+        }
+    };
+    clone_slots(external_input_slots_, ret->mems_use_external_inputs_,
+            ret->external_input_slots_);
+    clone_slots(external_output_slots_, ret->mems_use_external_outputs_,
+            ret->external_output_slots_);
+    clone_slots(internal_temporary_slots_, ret->mems_use_internal_temporary_,
+            ret->internal_temporary_slots_);
+    clone_slots(internal_persistent_slots_, ret->mems_use_internal_persistent_,
+            ret->internal_persistent_slots_);
+
     return ret;
 }
 
+void execution_args_set_t::prepare_mem_slots(
+        const registry_t &temporary_registry,
+        const registry_t &persistent_registry) {
+    external_input_slots_.clear();
+    external_output_slots_.clear();
+    internal_temporary_slots_.clear();
+    internal_persistent_slots_.clear();
+
+    for (const auto &mem_idx : mems_use_external_inputs_) {
+        external_input_slots_.emplace_back(mem_idx.first, mem_idx.second);
+    }
+    for (const auto &mem_idx : mems_use_external_outputs_) {
+        external_output_slots_.emplace_back(mem_idx.first, mem_idx.second);
+    }
+    for (const auto &mem_offkey : mems_use_internal_temporary_) {
+        internal_temporary_slots_.emplace_back(
+                mem_offkey.first, temporary_registry.get(mem_offkey.second));
+    }
+    for (const auto &mem_offkey : mems_use_internal_persistent_) {
+        internal_persistent_slots_.emplace_back(
+                mem_offkey.first, persistent_registry.get(mem_offkey.second));
+    }
+}
+
 void execution_args_set_t::clear() {
     mems_use_external_inputs_.clear();
     mems_use_external_outputs_.clear();
@@ -225,6 +276,11 @@ void execution_args_set_t::clear() {
     mems_use_internal_persistent_.clear();
     value_mem_map_.clear();
     topo_ordered_exec_args_.clear();
+    topo_ordered_exec_args_tables_.clear();
+    external_input_slots_.clear();
+    external_output_slots_.clear();
+    internal_temporary_slots_.clear();
+    internal_persistent_slots_.clear();
 }
 
 void alias_analyzer_t::clear() {
@@ -463,8 +519,21 @@ status_t memory_planner_t::assign_internal_temporary_buffer(
         const std::unordered_map<value_t *, size_t> &edge_ref_count,
         fusion_info_mgr_t &mgr, bool enable_standard_sharing) {
     std::unordered_map<size_t, size_t> temporary_buffer_ref_count;
+    // the index of current planning step, used to record the live range of
+    // temporary buffers
+    size_t step_idx = 0;
+    temporary_buffer_live_range_.clear();
+
+    // with offset planning, the buffers are never reused as a whole. Instead,
+    // their live ranges are recorded and the buffers with disjoint live ranges
+    // will be packed into overlapped offsets in book_buffers()
+    auto release_buffer = [&](size_t idx) {
+        if (idx == static_cast<size_t>(-1)) return;
+        temporary_buffer_live_range_[idx].end_ = step_idx;
+        if (!enable_offset_planning_) temporary_buffer_assigner_.release(idx);
+    };
 
-    auto func = [&](op_t *op) {
+    auto assign = [&](op_t *op) {
         // Handle alias first
         auto inputs = op->get_input_values();
         for (auto &in : inputs) {
@@ -511,8 +580,12 @@ status_t memory_planner_t::assign_internal_temporary_buffer(
             buffer_assignments_.insert(std::make_pair(
                     out.get(), assign_info_t(internal_temporary, idx)));
             temporary_buffer_ref_count[idx] = edge_ref_count.at(out.get());
+            temporary_buffer_live_range_[idx]
+                    = time_bound_t {step_idx, static_cast<size_t>(-1)};
         }
+    };
 
+    auto release = [&](op_t *op) {
         // Free inputs
         for (auto &in : op->get_input_values()) {
             assign_info_t info = buffer_assignments_.at(in.get());
@@ -522,7 +595,7 @@ status_t memory_planner_t::assign_internal_temporary_buffer(
             // if we decrease it to zero, we are ready to release
             if (enable_standard_sharing
                     && temporary_buffer_ref_count[info.index_] == 0) {
-                temporary_buffer_assigner_.release(info.index_);
+                release_buffer(info.index_);
             }
         }
 
@@ -534,16 +607,159 @@ status_t memory_planner_t::assign_internal_temporary_buffer(
             auto consumers = out->get_consumers();
             if (consumers.empty()) {
                 --temporary_buffer_ref_count[info.index_];
-                if (enable_standard_sharing) {
-                    temporary_buffer_assigner_.release(info.index_);
+                if (enable_standard_sharing) { release_buffer(info.index_); }
+            }
+        }
+    };
+
+    // Ops in the same step may be executed concurrently, so the buffers used
+    // by them are released only after all ops in the step have been assigned.
+    // This guarantees that concurrent ops never share a temporary buffer.
+    for (const auto &step : get_planning_steps(sg)) {
+        for (op_t *op : step)
+            assign(op);
+        for (op_t *op : step)
+            release(op);
+        step_idx++;
+    }
+
+    // buffers which are never released live until the end
+    for (auto &id_range : temporary_buffer_live_range_) {
+        if (id_range.second.end_ == static_cast<size_t>(-1))
+            id_range.second.end_ = step_idx;
+    }
+
+    return status::success;
+}
+
+buffer_offsets_plan_t plan_buffer_offsets(
+        const std::vector<buffer_live_range_t> &buffers, size_t alignment) {
+    struct item_t {
+        buffer_live_range_t buf_;
+        size_t offset_;
+    };
+
+    std::vector<item_t> items;
+    items.reserve(buffers.size());
+    for (const auto &buf : buffers) {
+        items.push_back({buf, 0});
+        items.back().buf_.size_
+                = (buf.size_ + alignment - 1) / alignment * alignment;
+    }
+
+    // Greedy by size: place the larger buffers first, since they are the
+    // hardest to fit into the gaps left by others. Ties are broken by the
+    // live range start and id to make the result deterministic.
+    std::sort(items.begin(), items.end(),
+            [](const item_t &a, const item_t &b) {
+                if (a.buf_.size_ != b.buf_.size_)
+                    return a.buf_.size_ > b.buf_.size_;
+                if (a.buf_.start_ != b.buf_.start_)
+                    return a.buf_.start_ < b.buf_.start_;
+                return a.buf_.id_ < b.buf_.id_;
+            });
+
+    auto overlapped = [](const buffer_live_range_t &a,
+                              const buffer_live_range_t &b) {
+        return a.start_ <= b.end_ && b.start_ <= a.end_;
+    };
+
+    buffer_offsets_plan_t plan;
+    std::vector<const item_t *> placed;
+    std::vector<const item_t *> conflicts;
+    for (auto &item : items) {
+        conflicts.clear();
+        for (const item_t *p : placed) {
+            if (overlapped(p->buf_, item.buf_)) conflicts.emplace_back(p);
+        }
+        std::sort(conflicts.begin(), conflicts.end(),
+                [](const item_t *a, const item_t *b) {
+                    return a->offset_ < b->offset_;
+                });
+
+        // Best fit: use the smallest gap between the conflicting buffers
+        // which can hold this buffer, otherwise put it on top of them.
+        size_t best_offset = static_cast<size_t>(-1);
+        size_t best_gap = static_cast<size_t>(-1);
+        size_t gap_start = 0;
+        for (const item_t *c : conflicts) {
+            if (c->offset_ > gap_start) {
+                size_t gap = c->offset_ - gap_start;
+                if (gap >= item.buf_.size_ && gap < best_gap) {
+                    best_gap = gap;
+                    best_offset = gap_start;
                 }
             }
+            gap_start = std::max(gap_start, c->offset_ + c->buf_.size_);
         }
+        item.offset_ = best_offset != static_cast<size_t>(-1) ? best_offset
+                                                              : gap_start;
+        plan.peak_ = std::max(plan.peak_, item.offset_ + item.buf_.size_);
+        placed.emplace_back(&item);
+    }
+
+    std::map<size_t, long long> deltas;
+    for (const auto &item : items) {
+        deltas[item.buf_.start_] += static_cast<long long>(item.buf_.size_);
+        deltas[item.buf_.end_ + 1] -= static_cast<long long>(item.buf_.size_);
+    }
+    long long alive = 0;
+    for (const auto &delta : deltas) {
+        alive += delta.second;
+        plan.lower_bound_
+                = std::max(plan.lower_bound_, static_cast<size_t>(alive));
+    }
+
+    for (const auto &item : items) {
+        plan.offsets_[item.buf_.id_] = item.offset_;
+    }
+    return plan;
+}
+
+std::unordered_map<size_t, size_t>
+memory_planner_t::plan_temporary_buffer_offsets(
+        const std::vector<size_t> &ids, size_t alignment) {
+    std::vector<buffer_live_range_t> buffers;
+    buffers.reserve(ids.size());
+    for (size_t id : ids) {
+        const time_bound_t &range = temporary_buffer_live_range_.at(id);
+        buffers.push_back({id, temporary_buffer_assigner_.query_size(id),
+                range.start_, range.end_});
+    }
+
+    buffer_offsets_plan_t plan = plan_buffer_offsets(buffers, alignment);
+    if (graph::utils::get_verbose() >= 2) {
+        printf("onednn_graph_verbose,info,memory_planning,offset,buffers:%zu,"
+               "peak:%zu,lower_bound:%zu\n",
+                buffers.size(), plan.peak_, plan.lower_bound_);
+        fflush(stdout);
+    }
+    return std::move(plan.offsets_);
+}
 
+std::vector<std::vector<op_t *>> memory_planner_t::get_planning_steps(
+        std::shared_ptr<subgraph_t> &sg) const {
+    std::vector<op_t *> topo_ops;
+    topo_order_visit(sg->get_output_ops(), [&](op_t *op) {
+        topo_ops.emplace_back(op);
         return status::success;
-    };
+    });
 
-    return topo_order_visit(sg->get_output_ops(), func);
+    std::vector<std::vector<op_t *>> steps;
+    if (!enable_inter_op_parallel_) {
+        // sequential execution, each op is a step
+        steps.reserve(topo_ops.size());
+        for (op_t *op : topo_ops)
+            steps.push_back({op});
+        return steps;
+    }
+
+    for (const auto &level : get_op_levels(sg)) {
+        steps.emplace_back();
+        for (size_t idx : level)
+            steps.back().emplace_back(topo_ops[idx]);
+    }
+    return steps;
 }
 
 status_t memory_planner_t::prepare_subgraph_inplace_pairs(
@@ -658,6 +874,22 @@ status_t memory_planner_t::book_buffers(std::shared_ptr<subgraph_t> &sg) {
 
     registrar_t temporary_registrar = temporary_registry_.registrar();
     registrar_t persistent_registrar = persistent_registry_.registrar();
+
+    // the offsets of temporary buffers are planned in advance
+    std::unordered_map<size_t, size_t> temporary_offsets;
+    const size_t alignment = 64;
+    if (enable_offset_planning_) {
+        std::set<size_t> ids;
+        for (const value_t *val : to_be_booked) {
+            const assign_info_t &info = buffer_assignments_.at(val);
+            if (info.kind_ == internal_temporary
+                    && info.index_ != static_cast<size_t>(-1))
+                ids.insert(info.index_);
+        }
+        temporary_offsets = plan_temporary_buffer_offsets(
+                std::vector<size_t>(ids.begin(), ids.end()), alignment);
+    }
+
     for (const value_t *val : to_be_booked) {
         const assign_info_t &info = buffer_assignments_.at(val);
         switch (info.kind_) {
@@ -667,8 +899,16 @@ status_t memory_planner_t::book_buffers(std::shared_ptr<subgraph_t> &sg) {
             case external_output: break;
             // book buffers for internal temporary and persistent
             case internal_temporary:
-                temporary_registrar.book(info.index_,
-                        temporary_buffer_assigner_.query_size(info.index_));
+                if (temporary_offsets.count(info.index_)) {
+                    temporary_registrar.book_at(info.index_,
+                            temporary_offsets.at(info.index_),
+                            temporary_buffer_assigner_.query_size(info.index_),
+                            alignment);
+                } else {
+                    temporary_registrar.book(info.index_,
+                            temporary_buffer_assigner_.query_size(info.index_),
+                            alignment);
+                }
                 break;
             case internal_persistent:
                 persistent_registrar.book(info.index_,
@@ -772,8 +1012,12 @@ status_t memory_planner_t::prepare_execution_args_set(
         exec_args_set_.add_exec_args(dnnl_exec_args);
         return status::success;
     });
+    if (ret != status::success) return ret;
 
-    return ret;
+    // buffers have been booked, resolve the offsets of internal memories
+    exec_args_set_.prepare_mem_slots(temporary_registry_, persistent_registry_);
+
+    return status::success;
 }
 
 // In this function, we will do the following things:
@@ -815,6 +1059,9 @@ status_t memory_planner_t::run(std::shared_ptr<subgraph_t> &sg) {
     // be removed without any prior notice.
     bool enable_memory_sharing
             = graph::utils::getenv_int_internal("ENABLE_MEM_REUSE", 1) > 0;
+    enable_offset_planning_
+            = graph::utils::getenv_int_internal("ENABLE_OFFSET_MEM_PLANNING", 0)
+            > 0;
     if (!enable_memory_sharing) {
         // if not enable memory sharing, we add additional 1 to edge reference
         // count, so that tensors will not be reused
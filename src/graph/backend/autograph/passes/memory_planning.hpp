@@ -39,6 +39,25 @@ namespace impl {
 namespace graph {
 namespace autograph_impl {
 
+// A memory object whose data handle is bound in place before each execution.
+// The source is the index of a partition input/output, or the offset of the
+// memory in the temporary/persistent buffer which is resolved once at compile
+// time. The last bound handle is remembered, so that set_data_handle is only
+// called when the handle really changes between executions.
+struct mem_slot_t {
+    mem_slot_t(const memory &mem, size_t src) : mem_(mem), src_(src) {}
+
+    void bind(void *handle) {
+        if (handle == handle_) return;
+        mem_.set_data_handle(handle);
+        handle_ = handle;
+    }
+
+    memory mem_;
+    size_t src_;
+    void *handle_ {nullptr};
+};
+
 // This execution_args_set_t class is used to hold the dnnl memory objects which
 // are used when executing a compiled subgraph in a thread. This class should
 // only be generated by the memory_planner_t class. When executing subgraph in
@@ -66,6 +85,29 @@ public:
         return value_mem_map_;
     }
 
+    // The flat argument table of each op in the subgraph. The tables refer to
+    // the same memory objects as get_exec_args(), so they stay valid when the
+    // data handles are rebound.
+    const std::vector<exec_args_table> &get_exec_args_tables() const {
+        return topo_ordered_exec_args_tables_;
+    }
+
+    std::vector<mem_slot_t> &get_external_input_slots() {
+        return external_input_slots_;
+    }
+
+    std::vector<mem_slot_t> &get_external_output_slots() {
+        return external_output_slots_;
+    }
+
+    std::vector<mem_slot_t> &get_internal_temporary_slots() {
+        return internal_temporary_slots_;
+    }
+
+    std::vector<mem_slot_t> &get_internal_persistent_slots() {
+        return internal_persistent_slots_;
+    }
+
     const std::vector<std::pair<dnnl::memory, size_t>> &
     get_mems_use_external_inputs() const {
         return mems_use_external_inputs_;
@@ -89,6 +131,12 @@ public:
     // adders
     void add_exec_args(const exec_args &args) {
         topo_ordered_exec_args_.emplace_back(args);
+
+        exec_args_table table;
+        table.reserve(args.size());
+        for (const auto &arg : args)
+            table.push_back({arg.first, arg.second.get(true)});
+        topo_ordered_exec_args_tables_.emplace_back(std::move(table));
     }
 
     void add_value_mem_map(const std::pair<value_t *, memory> &map) {
@@ -115,6 +163,12 @@ public:
         mems_use_internal_persistent_.emplace_back(mem_offkey);
     }
 
+    // Resolve the memory slots from the classified memories. The offset keys
+    // of internal memories are translated into offsets with the given
+    // registries, so binding them later needs no lookup.
+    void prepare_mem_slots(const registry_t &temporary_registry,
+            const registry_t &persistent_registry);
+
     // finders
     bool find_value_mem_map(value_t *key, memory &mem) const {
         auto pos = value_mem_map_.find(key);
@@ -140,6 +194,13 @@ private:
     std::unordered_map<value_t *, memory> value_mem_map_;
     // execution args for each op in the subgraph
     std::vector<exec_args> topo_ordered_exec_args_;
+    // flat form of topo_ordered_exec_args_
+    std::vector<exec_args_table> topo_ordered_exec_args_tables_;
+    // flat binding slots of the above classified memories, in the same order
+    std::vector<mem_slot_t> external_input_slots_;
+    std::vector<mem_slot_t> external_output_slots_;
+    std::vector<mem_slot_t> internal_temporary_slots_;
+    std::vector<mem_slot_t> internal_persistent_slots_;
 };
 
 class alias_analyzer_t {
@@ -262,6 +323,31 @@ private:
     std::vector<std::unique_ptr<buffer_info_t>> data_;
 };
 
+// A buffer to be placed by plan_buffer_offsets(), which is alive from the
+// step start_ to the step end_ (both inclusive)
+struct buffer_live_range_t {
+    size_t id_;
+    size_t size_;
+    size_t start_;
+    size_t end_;
+};
+
+struct buffer_offsets_plan_t {
+    // buffer id -> offset in the arena
+    std::unordered_map<size_t, size_t> offsets_;
+    // the size of the arena, ie. the peak of the placed buffers
+    size_t peak_ {0};
+    // the max total size of the buffers alive at the same step, which is the
+    // theoretical minimum of the peak
+    size_t lower_bound_ {0};
+};
+
+// Pack the buffers into a single arena according to their live ranges, so
+// that the buffers alive at the same step never overlap. The buffer sizes are
+// rounded up to the alignment, so all offsets are aligned.
+buffer_offsets_plan_t plan_buffer_offsets(
+        const std::vector<buffer_live_range_t> &buffers, size_t alignment);
+
 // This memory_planner_t class is used to plan which buffer can be used by each
 // value in the subgraph. All the planning works are completed in compilation
 // stage for static shape cases.
@@ -282,15 +368,37 @@ private:
 //   as an example: when writing data to t4, t2 is not used any more, so they
 //   have disjoint live range and we can make them share same buffer.
 //
+// When inter-op parallel execution is enabled, the ops in the same level of the
+// dependency DAG (see get_op_levels) may run concurrently. In that case the
+// temporary buffers are planned level by level, so ops of the same level never
+// share a buffer.
+//
+// By default, the temporary buffers are shared as a whole through the
+// buffer_assigner_t pool. Alternatively, the offset planning assigns each
+// temporary buffer a byte offset in the scratchpad by packing the live ranges
+// of all buffers (greedy by size, best fit), which usually gives a footprint
+// closer to the liveness lower bound. The achieved peak and the lower bound
+// are reported in verbose mode.
+//
 // The following internal env vars can be used to control the memory planning:
 // - _ONEDNN_GRAPH_ENABLE_MEM_REUSE
 //     - 0: Disable memory sharing
 //     - 1 (default): Enable memory sharing
+// - _ONEDNN_GRAPH_ENABLE_OFFSET_MEM_PLANNING
+//     - 0 (default): Share temporary buffers through the buffer pool
+//     - 1: Plan the offsets of temporary buffers by live range packing
 class memory_planner_t {
 public:
     memory_planner_t()
         : persistent_buffer_assigner_(16), temporary_buffer_assigner_(16) {}
 
+    // Should be set before running the planner
+    void set_inter_op_parallel(bool enable) {
+        enable_inter_op_parallel_ = enable;
+    }
+
+    bool is_inter_op_parallel() const { return enable_inter_op_parallel_; }
+
     memory_planner_t(memory_planner_t &&) = delete;
     memory_planner_t(const memory_planner_t &other) = delete;
     memory_planner_t &operator=(const memory_planner_t &) = delete;
@@ -341,6 +449,12 @@ public:
         return str;
     }
 
+    // Get the groups of ops whose temporary buffers are assigned together.
+    // Each op is a group for sequential execution, and each level of the
+    // dependency DAG is a group for inter-op parallel execution.
+    std::vector<std::vector<op_t *>> get_planning_steps(
+            std::shared_ptr<subgraph_t> &sg) const;
+
 private:
     enum buffer_kind_t {
         external_input = 0,
@@ -385,6 +499,7 @@ private:
         temporary_registry_.clear();
         external_inputs_live_range_.clear();
         inplace_pairs_.clear();
+        temporary_buffer_live_range_.clear();
     }
 
     status_t assign_external_inputs_buffer(std::shared_ptr<subgraph_t> &sg,
@@ -401,9 +516,15 @@ private:
             const std::unordered_map<value_t *, size_t> &edge_ref_count,
             fusion_info_mgr_t &mgr, bool enable_standard_sharing);
 
+
     status_t prepare_subgraph_inplace_pairs(
             std::shared_ptr<subgraph_t> &sg, bool enable_standard_sharing);
 
+    // Pack the given temporary buffers into a single arena according to their
+    // live ranges. Returns the offset of each buffer.
+    std::unordered_map<size_t, size_t> plan_temporary_buffer_offsets(
+            const std::vector<size_t> &ids, size_t alignment);
+
     status_t book_buffers(std::shared_ptr<subgraph_t> &sg);
 
     status_t prepare_execution_args_set(std::shared_ptr<subgraph_t> &sg,
@@ -422,6 +543,10 @@ private:
     std::unordered_map<const assign_info_t *, time_bound_t>
             external_inputs_live_range_;
     std::vector<inplace_pair_t> inplace_pairs_;
+    bool enable_inter_op_parallel_ {false};
+    bool enable_offset_planning_ {false};
+    // temporary buffer id -> the planning steps it's alive
+    std::unordered_map<size_t, time_bound_t> temporary_buffer_live_range_;
 };
 
 } // namespace autograph_impl
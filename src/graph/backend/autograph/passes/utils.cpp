@@ -192,6 +192,29 @@ std::vector<value_t *> get_constant_block_output_values(
     return ret;
 }
 
+std::vector<std::vector<size_t>> get_op_levels(
+        const std::shared_ptr<subgraph_t> &sg) {
+    std::vector<std::vector<size_t>> levels;
+    std::unordered_map<const op_t *, size_t> op_level;
+    size_t index = 0;
+    auto func = [&](op_t *op) {
+        size_t level = 0;
+        for (auto &in : op->get_input_values()) {
+            if (!in->has_producer()) continue;
+            auto pos = op_level.find(&(in->get_producer()));
+            if (pos == op_level.end()) continue;
+            level = std::max(level, pos->second + 1);
+        }
+        op_level[op] = level;
+        if (levels.size() <= level) levels.resize(level + 1);
+        levels[level].emplace_back(index++);
+        return status::success;
+    };
+    status_t status = topo_order_visit(sg->get_output_ops(), func);
+    if (status != status::success) return {};
+    return levels;
+}
+
 status_t infer_shape(std::shared_ptr<subgraph_t> &sg) {
     // workaround: the conv output shape will be impacted if the post-op is a
     // k3s2p1 dw conv. but with current shape infer functions' implementation,
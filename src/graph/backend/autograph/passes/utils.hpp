@@ -280,6 +280,14 @@ inline bool is_reduction_kind(op_kind_t kind) {
 std::vector<value_t *> get_constant_block_output_values(
         const std::shared_ptr<subgraph_t> &sg);
 
+// Split the ops in the subgraph into levels of the dependency DAG. The level of
+// an op is one plus the maximum level of its producers, so ops in the same
+// level don't depend on each other and can be executed concurrently. Each op is
+// represented by its index in the topo_order_visit() order, which is also the
+// order of the executables created by compile_ops.
+std::vector<std::vector<size_t>> get_op_levels(
+        const std::shared_ptr<subgraph_t> &sg);
+
 status_t infer_shape(std::shared_ptr<subgraph_t> &sg);
 
 const std::map<op_kind_t, dnnl::algorithm> &get_binary_alg_map();
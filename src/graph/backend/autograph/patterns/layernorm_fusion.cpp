@@ -15,6 +15,7 @@
 *******************************************************************************/
 
 #include "graph/backend/autograph/internal_ops.hpp"
+#include "graph/backend/autograph/kernels/group_norm.hpp"
 #include "graph/backend/autograph/kernels/layernorm.hpp"
 #include "graph/backend/autograph/patterns/fusions.hpp"
 #include "graph/backend/autograph/patterns/transformation_pattern.hpp"
@@ -115,6 +116,65 @@ DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(
             return std::make_shared<layernorm_fwd_t>();
         });
 
+/*
+StaticReshape
+  |
+LayerNorm
+  |
+StaticReshape
+  |
+[Multiply]*
+  |
+[Add]*
+
+The group normalization decomposed into the LayerNorm over the channels split
+into the groups, and the per-channel scale and shift. The priority is above
+the binary post-ops fusion, so the scale and the shift stay in the partition
+which is computed by the group normalization primitive.
+*/
+DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, float_group_norm_fusion)
+        .set_priority(8.4f)
+        .set_kind(graph::partition_kind_t::misc_post_ops)
+        .set_engine_kind(engine_kind::cpu)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    pm::pb_op_t *reshape_in = pgraph->append_op(
+                            graph::op_kind::StaticReshape, "reshape_in");
+                    pm::pb_op_t *layernorm = pgraph->append_op(
+                            graph::op_kind::LayerNorm,
+                            in_edges_t {in_edge(0, reshape_in, 0)},
+                            "layernorm");
+                    layernorm->append_decision_function(
+                            check_input_dtype<impl::data_type::f32>);
+                    pm::pb_op_t *reshape_out = pgraph->append_op(
+                            graph::op_kind::StaticReshape,
+                            in_edges_t {in_edge(0, layernorm, 0)},
+                            "reshape_out");
+
+                    auto scale_graph
+                            = std::make_shared<pb_graph_t>("pscale_graph");
+                    pm::pb_op_t *pscale = scale_graph->append_op(
+                            graph::op_kind::Multiply, "pscale");
+                    scale_graph->create_input_port(0, pscale, 0);
+                    scale_graph->create_output_port(0, pscale, 0);
+                    auto optional_scale = pgraph->append_optional(scale_graph,
+                            in_edges_t {in_edge(0, reshape_out, 0)},
+                            "optional_scale");
+
+                    auto shift_graph
+                            = std::make_shared<pb_graph_t>("pshift_graph");
+                    pm::pb_op_t *pshift = shift_graph->append_op(
+                            graph::op_kind::Add, "pshift");
+                    shift_graph->create_input_port(0, pshift, 0);
+                    shift_graph->create_output_port(0, pshift, 0);
+                    pgraph->append_optional(shift_graph,
+                            in_edges_t {in_edge(0, optional_scale, 0)},
+                            "optional_shift");
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<group_norm_primitive_kernel_t>();
+        });
+
 DNNL_BACKEND_REGISTER_PATTERN_DEF_END
 
 } // namespace pattern
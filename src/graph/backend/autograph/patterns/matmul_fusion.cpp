@@ -16,6 +16,7 @@
 
 #include "graph/backend/autograph/kernels/large_partition.hpp"
 #include "graph/backend/autograph/kernels/matmul.hpp"
+#include "graph/backend/autograph/kernels/sdp.hpp"
 #include "graph/backend/autograph/patterns/fusions.hpp"
 #include "graph/backend/autograph/patterns/transformation_pattern.hpp"
 #include "graph/backend/autograph/patterns/utils.hpp"
@@ -1264,6 +1265,63 @@ DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, int8_bf16_MHA_fusion)
             return std::make_shared<larger_partition_kernel_t>();
         });
 
+/*
+MatMul
+  |
+[Divide|Multiply]*
+  |
+[Add]*
+  |
+SoftMax
+  |
+MatMul
+
+The scaled dot product attention without the reshape of the output. On CPU,
+the partition is computed by a fused primitive.
+*/
+DNNL_BACKEND_REGISTER_TRANSFORMATION_PATTERN(dnnl, float_sdp_fusion)
+        .set_priority(20.0f)
+        .set_kind(partition_kind_t::mha)
+        .set_attr<FCreatePattern>("FCreatePattern",
+                [](const std::shared_ptr<pb_graph_t> &pgraph) -> void {
+                    auto check_float_dtype = [](op_t *op) -> bool {
+                        return check_input_dtype<impl::data_type::f32>(op)
+                                || check_input_dtype<impl::data_type::bf16>(
+                                        op);
+                    };
+                    auto matmul_qk = pgraph->append_op(
+                            graph::op_kind::MatMul, "matmul_qk");
+                    matmul_qk->append_decision_function(check_float_dtype);
+
+                    auto scale_graph
+                            = std::make_shared<pb_graph_t>("pscale_graph");
+                    auto pscale = scale_graph->append_alternation(
+                            {graph::op_kind::Divide, graph::op_kind::Multiply},
+                            "pscale");
+                    scale_graph->create_input_port(0, pscale, 0);
+                    scale_graph->create_output_port(0, pscale, 0);
+                    auto optional_scale = pgraph->append_optional(scale_graph,
+                            {in_edge(0, matmul_qk, 0)}, "optional_scale");
+
+                    auto mask_graph
+                            = std::make_shared<pb_graph_t>("pmask_graph");
+                    auto pmask = mask_graph->append_op(
+                            graph::op_kind::Add, "pmask");
+                    mask_graph->create_input_port(0, pmask, 0);
+                    mask_graph->create_output_port(0, pmask, 0);
+                    auto optional_mask = pgraph->append_optional(mask_graph,
+                            {in_edge(0, optional_scale, 0)}, "optional_mask");
+
+                    auto softmax = pgraph->append_op(graph::op_kind::SoftMax,
+                            {in_edge(0, optional_mask, 0)}, "softmax");
+                    auto matmul_v = pgraph->append_op(graph::op_kind::MatMul,
+                            {in_edge(0, softmax, 0)}, "matmul_v");
+                    matmul_v->append_decision_function(check_float_dtype);
+                })
+        .set_attr<FCreateKernel>("FCreateKernel", []() -> kernel_ptr {
+            return std::make_shared<sdp_primitive_kernel_t>();
+        });
+
 DNNL_BACKEND_REGISTER_PATTERN_DEF_END
 
 } // namespace pattern
@@ -0,0 +1,240 @@
+/*******************************************************************************
+ * Copyright 2023 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "graph/utils/utils.hpp"
+#include "graph/utils/verbose.hpp"
+
+#include "graph/backend/autograph/scratchpad.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+namespace autograph_impl {
+
+namespace {
+uint64_t now_ms() {
+    return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch())
+                    .count());
+}
+} // namespace
+
+scratchpad_arena_pool_t &scratchpad_arena_pool_t::get_global() {
+    static scratchpad_arena_pool_t pool(
+            []() {
+                const int mb = graph::utils::getenv_int_internal(
+                        "GRAPH_SCRATCHPAD_ARENA_BUDGET_MB", 1024);
+                return static_cast<size_t>(std::max(mb, 0)) << 20;
+            }(),
+            []() {
+                const int ms = graph::utils::getenv_int_internal(
+                        "GRAPH_SCRATCHPAD_ARENA_IDLE_MS", 1000);
+                return static_cast<uint64_t>(std::max(ms, 0));
+            }());
+    return pool;
+}
+
+void scratchpad_arena_pool_t::add(scratchpad_arena_t *arena) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    arenas_.emplace_back(arena);
+}
+
+void scratchpad_arena_pool_t::remove(scratchpad_arena_t *arena) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto pos = std::find(arenas_.begin(), arenas_.end(), arena);
+    if (pos != arenas_.end()) arenas_.erase(pos);
+}
+
+bool scratchpad_arena_pool_t::try_reserve(size_t size) {
+    size_t held = held_.load(std::memory_order_relaxed);
+    while (size <= budget_ && held <= budget_ - size) {
+        if (held_.compare_exchange_weak(held, held + size)) return true;
+    }
+    return false;
+}
+
+bool scratchpad_arena_pool_t::reserve(
+        size_t size, const scratchpad_arena_t *requester) {
+    if (size > budget_) return false;
+    if (try_reserve(size)) return true;
+
+    // Release the idle arenas of other threads, the least recently used first.
+    // The arenas are only tried to be locked, so an arena which is being used
+    // by its owner is skipped and the owner never waits for the pool.
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::pair<uint64_t, scratchpad_arena_t *>> candidates;
+    candidates.reserve(arenas_.size());
+    for (auto *arena : arenas_) {
+        if (arena == requester) continue;
+        candidates.emplace_back(
+                arena->last_use_ms_.load(std::memory_order_relaxed), arena);
+    }
+    std::sort(candidates.begin(), candidates.end());
+    for (auto &c : candidates) {
+        c.second->try_reclaim(std::numeric_limits<uint64_t>::max());
+        if (try_reserve(size)) return true;
+    }
+    return try_reserve(size);
+}
+
+void scratchpad_arena_pool_t::release_idle_arenas() {
+    const uint64_t now = now_ms();
+    uint64_t next_sweep = next_sweep_ms_.load(std::memory_order_acquire);
+    if (now < next_sweep) return;
+    if (!next_sweep_ms_.compare_exchange_strong(next_sweep, now + idle_ms_))
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (now < idle_ms_) return;
+    for (auto *arena : arenas_)
+        arena->try_reclaim(now - idle_ms_);
+}
+
+bool scratchpad_arena_t::enabled() {
+    static const bool enabled = graph::utils::getenv_int_internal(
+                                        "GRAPH_ENABLE_SCRATCHPAD_ARENA", 1)
+            > 0;
+    return enabled;
+}
+
+scratchpad_arena_t::scratchpad_arena_t(
+        const allocator_t *alloc, scratchpad_arena_pool_t &pool)
+    : alloc_(alloc), pool_(pool) {
+    pool_.add(this);
+}
+
+scratchpad_arena_t::~scratchpad_arena_t() {
+    // After being removed from the pool, the arena can't be reclaimed by other
+    // threads anymore
+    pool_.remove(this);
+    free_buffer();
+    print_verbose("destroy");
+}
+
+char *scratchpad_arena_t::acquire(size_t size, const dnnl::engine &eng) {
+    pool_.release_idle_arenas();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (in_use_ || size > pool_.budget()) {
+        misses_++;
+        return nullptr;
+    }
+    last_use_ms_.store(now_ms(), std::memory_order_relaxed);
+
+    // Shrink the arena under memory pressure: if the requests in the last
+    // window only used a small part of the buffer, release it and allocate a
+    // smaller one for the current request.
+    window_peak_ = std::max(window_peak_, size);
+    if (++window_count_ >= shrink_window()) {
+        if (buffer_ && window_peak_ * 2 < capacity_) {
+            free_buffer();
+            shrinks_++;
+            print_verbose("shrink");
+        }
+        window_peak_ = 0;
+        window_count_ = 0;
+    }
+
+    if (size <= capacity_) {
+        hits_++;
+        in_use_ = true;
+        return buffer_;
+    }
+
+    // grow the arena if the pool has room for it
+    misses_++;
+    free_buffer();
+    if (!pool_.reserve(size, this)) return nullptr;
+    buffer_ = reinterpret_cast<char *>(dnnl_allocator_t::malloc(
+            size, eng, alloc_, allocator_t::mem_type_t::temp));
+    if (!buffer_) {
+        pool_.unreserve(size);
+        return nullptr;
+    }
+    const_cast<allocator_t *>(alloc_)->retain();
+    capacity_ = size;
+    in_use_ = true;
+    print_verbose("grow");
+    return buffer_;
+}
+
+void scratchpad_arena_t::release() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_use_ = false;
+    last_use_ms_.store(now_ms(), std::memory_order_relaxed);
+}
+
+bool scratchpad_arena_t::try_reclaim(uint64_t before) {
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock() || in_use_ || !buffer_) return false;
+    if (last_use_ms_.load(std::memory_order_relaxed) > before) return false;
+    free_buffer();
+    reclaims_++;
+    print_verbose("reclaim");
+    return true;
+}
+
+void scratchpad_arena_t::free_buffer() {
+    if (!buffer_) return;
+    // The arena is only used for native CPU runtime, where the deallocation
+    // doesn't depend on the engine.
+    alloc_->deallocate(buffer_);
+    const_cast<allocator_t *>(alloc_)->release();
+    pool_.unreserve(capacity_);
+    buffer_ = nullptr;
+    capacity_ = 0;
+}
+
+void scratchpad_arena_t::print_verbose(const char *event) const {
+    if (graph::utils::get_verbose() < 2) return;
+    printf("onednn_graph_verbose,info,scratchpad_arena,%s,%s,capacity:%zu,"
+           "hits:%zu,misses:%zu,shrinks:%zu,reclaims:%zu,pool_held:%zu\n",
+            event,
+            graph::utils::thread_id_to_str(std::this_thread::get_id()).c_str(),
+            capacity_, hits_, misses_, shrinks_, reclaims_.load(),
+            pool_.held());
+    fflush(stdout);
+}
+
+scratchpad_arena_t &get_thread_local_scratchpad_arena(
+        const allocator_t *alloc) {
+    static thread_local std::unordered_map<const allocator_t *,
+            std::unique_ptr<scratchpad_arena_t>>
+            arenas;
+    auto pos = arenas.find(alloc);
+    if (pos != arenas.end()) return *(pos->second);
+
+    auto ret = arenas.emplace(
+            alloc, std::unique_ptr<scratchpad_arena_t>(
+                           new scratchpad_arena_t(alloc)));
+    return *(ret.first->second);
+}
+
+} // namespace autograph_impl
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
@@ -16,9 +16,14 @@
 #ifndef GRAPH_BACKEND_DNNL_SCRATCHPAD_HPP
 #define GRAPH_BACKEND_DNNL_SCRATCHPAD_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "graph/interface/allocator.hpp"
 
@@ -98,6 +103,187 @@ private:
 #endif
 };
 
+class scratchpad_arena_t;
+
+// The pool bounds the total memory held by the scratchpad arenas of all
+// threads. An arena can only grow if the pool has room for the new buffer,
+// otherwise the idle arenas of other threads are released, the least recently
+// used first. Besides, the arenas which haven't been used for idle_ms() are
+// released by the next acquire() of any arena, so the memory of threads which
+// stopped executing partitions is given back even without memory pressure.
+class scratchpad_arena_pool_t {
+public:
+    scratchpad_arena_pool_t(size_t budget, uint64_t idle_ms)
+        : budget_(budget), idle_ms_(idle_ms) {}
+
+    // The pool shared by the arenas used in partition executions
+    static scratchpad_arena_pool_t &get_global();
+
+    size_t budget() const { return budget_; }
+    uint64_t idle_ms() const { return idle_ms_; }
+    // The total capacity of the arenas in the pool
+    size_t held() const { return held_.load(std::memory_order_relaxed); }
+
+    void add(scratchpad_arena_t *arena);
+    void remove(scratchpad_arena_t *arena);
+
+    // Reserve @size bytes for @requester, releasing the idle arenas of other
+    // threads if needed. Return false if there is no enough room.
+    bool reserve(size_t size, const scratchpad_arena_t *requester);
+    void unreserve(size_t size) {
+        held_.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    // Release the arenas which are idle for longer than idle_ms(). It's done
+    // at most once per idle_ms() and returns immediately otherwise.
+    void release_idle_arenas();
+
+private:
+    bool try_reserve(size_t size);
+
+    const size_t budget_;
+    const uint64_t idle_ms_;
+    std::atomic<size_t> held_ {0};
+    std::atomic<uint64_t> next_sweep_ms_ {0};
+
+    std::mutex mutex_;
+    std::vector<scratchpad_arena_t *> arenas_;
+
+    scratchpad_arena_pool_t(const scratchpad_arena_pool_t &) = delete;
+    scratchpad_arena_pool_t &operator=(const scratchpad_arena_pool_t &)
+            = delete;
+};
+
+// A growable buffer owned by a thread, which is reused by all partition
+// executions on that thread to avoid allocating and freeing the scratchpad in
+// every execution. The arena only grows when a larger buffer is requested, and
+// the memory held by all arenas is bounded by their pool. It's released if the
+// peak requested size of the last shrink_window() requests is less than half
+// of its capacity, if it's idle for a while, or if an arena of another thread
+// needs the room.
+//
+// The arena is only used for the native CPU runtime, where the execution is
+// synchronous and the buffer is not in use anymore once the execution
+// returns. It's not used for the threadpool runtime, where the user's
+// threadpool may be asynchronous and the primitives may still be running when
+// the execution returns.
+//
+// The following internal env vars can be used to control the arena:
+// - _ONEDNN_GRAPH_ENABLE_SCRATCHPAD_ARENA
+//     - 0: Allocate a temporary scratchpad in every execution
+//     - 1 (default): Reuse the scratchpad arena of current thread
+// - _ONEDNN_GRAPH_SCRATCHPAD_ARENA_BUDGET_MB: the maximum total size in MB of
+//   the arenas of all threads, requests which can't fit fall back to
+//   temporary scratchpads (default: 1024)
+// - _ONEDNN_GRAPH_SCRATCHPAD_ARENA_IDLE_MS: the time in ms after which an
+//   unused arena is released (default: 1000)
+class scratchpad_arena_t {
+public:
+    scratchpad_arena_t(const allocator_t *alloc,
+            scratchpad_arena_pool_t &pool
+            = scratchpad_arena_pool_t::get_global());
+    ~scratchpad_arena_t();
+
+    // Get a buffer that has at least the given size. Return nullptr if the
+    // arena is in use or the pool has no room for the size.
+    char *acquire(size_t size, const dnnl::engine &eng);
+
+    // Mark the buffer returned by the last acquire() as not in use
+    void release();
+
+    size_t capacity() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+    size_t hits() const { return hits_; }
+    size_t misses() const { return misses_; }
+    size_t shrinks() const { return shrinks_; }
+    // The number of times that the buffer was released by the pool
+    size_t reclaims() const { return reclaims_; }
+
+    static bool enabled();
+    static size_t shrink_window() { return 1024; }
+
+private:
+    friend class scratchpad_arena_pool_t;
+
+    // Release the buffer if it's not in use and its last use is not later than
+    // @before. Called by the pool, possibly from other threads.
+    bool try_reclaim(uint64_t before);
+
+    void free_buffer();
+    void print_verbose(const char *event) const;
+
+    const allocator_t *alloc_;
+    scratchpad_arena_pool_t &pool_;
+
+    // protects the buffer against the reclaiming from other threads
+    mutable std::mutex mutex_;
+    char *buffer_ = nullptr;
+    size_t capacity_ = 0;
+    bool in_use_ = false;
+    std::atomic<uint64_t> last_use_ms_ {0};
+
+    // the peak requested size and the number of requests in current window
+    size_t window_peak_ = 0;
+    size_t window_count_ = 0;
+
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+    size_t shrinks_ = 0;
+    std::atomic<size_t> reclaims_ {0};
+
+    scratchpad_arena_t(const scratchpad_arena_t &) = delete;
+    scratchpad_arena_t &operator=(const scratchpad_arena_t &) = delete;
+};
+
+// Get the scratchpad arena of current thread for the given allocator
+scratchpad_arena_t &get_thread_local_scratchpad_arena(const allocator_t *alloc);
+
+// The buffer is taken from the scratchpad arena of current thread if possible,
+// and given back to the arena when destroying the reusable_scratchpad_t.
+// Otherwise, a temporary buffer is allocated.
+class reusable_scratchpad_t : public scratchpad_t {
+public:
+    reusable_scratchpad_t(
+            size_t size, const dnnl::engine &eng, const allocator_t &alloc)
+        : buffer_(nullptr), size_(size), arena_(nullptr) {
+        if (size == 0) return;
+#if DNNL_CPU_RUNTIME != DNNL_RUNTIME_SYCL \
+        && DNNL_CPU_RUNTIME != DNNL_RUNTIME_THREADPOOL
+        if (eng.get_kind() == dnnl::engine::kind::cpu
+                && scratchpad_arena_t::enabled()) {
+            auto &arena = get_thread_local_scratchpad_arena(&alloc);
+            buffer_ = arena.acquire(size, eng);
+            if (buffer_) {
+                arena_ = &arena;
+                return;
+            }
+        }
+#endif
+        temporary_.reset(new temporary_scratchpad_t(size, eng, alloc));
+        buffer_ = temporary_->get_buffer();
+        size_ = temporary_->size();
+    }
+
+    ~reusable_scratchpad_t() override {
+        if (arena_) arena_->release();
+    }
+
+    char *get_buffer() const override { return buffer_; }
+
+    size_t size() const override { return size_; }
+
+private:
+    char *buffer_;
+    size_t size_;
+    scratchpad_arena_t *arena_;
+    std::unique_ptr<temporary_scratchpad_t> temporary_;
+
+    reusable_scratchpad_t(const reusable_scratchpad_t &) = delete;
+    reusable_scratchpad_t &operator=(const reusable_scratchpad_t &) = delete;
+};
+
 class registrar_t;
 class grantor_t;
 
@@ -139,6 +325,18 @@ public:
         lcm_alignment_ = graph::utils::lcm(lcm_alignment_, alignment);
     }
 
+    // book a piece of memory at a given offset, which has been planned by the
+    // caller. The offset should be a multiple of the alignment, and pieces
+    // booked in this way are allowed to overlap.
+    void book_at(const key_t &key, offset_t offset, size_t size,
+            size_t alignment) {
+        if (offset_map_.count(key)) return;
+        assertm(offset % alignment == 0, "unaligned offset");
+        offset_map_.insert({key, offset});
+        size_ = std::max(size_, offset + size);
+        lcm_alignment_ = graph::utils::lcm(lcm_alignment_, alignment);
+    }
+
     // get the offset of a booked piece of memory
     offset_t get(const key_t &key) const {
         if (size_ == 0 || offset_map_.count(key) != 1) return 0;
@@ -180,6 +378,11 @@ public:
         registry_.book(key, size, alignment);
     }
 
+    void book_at(const registry_t::key_t &key, registry_t::offset_t offset,
+            size_t size, size_t alignment = 64) {
+        registry_.book_at(key, offset, size, alignment);
+    }
+
 private:
     registry_t &registry_;
 };
@@ -201,6 +404,12 @@ public:
         return aligned_base_ptr_ + registry_.get(key);
     }
 
+    // get the address of a piece of memory by its offset which was queried
+    // from the registry in advance
+    char *get_by_offset(const registry_t::offset_t &offset) const {
+        return aligned_base_ptr_ + offset;
+    }
+
 private:
     const registry_t &registry_;
     char *aligned_base_ptr_;
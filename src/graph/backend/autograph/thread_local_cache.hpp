@@ -1,5 +1,5 @@
 /*******************************************************************************
- * Copyright 2021-2022 Intel Corporation
+ * Copyright 2021-2023 Intel Corporation
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,9 +16,14 @@
 #ifndef GRAPH_BACKEND_DNNL_THREAD_LOCAL_CACHE_HPP
 #define GRAPH_BACKEND_DNNL_THREAD_LOCAL_CACHE_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <unordered_map>
@@ -46,28 +51,39 @@ namespace autograph_impl {
 // reduce the search and sync overhead.
 
 // Note:
-// The shared_ptr of resources in ALL threads are cached in the @global_cache_,
-// which takes the ownership of cached resources. Besides, each thread will use
-// a thread local table to cache the weak_ptr of current thread's resources. The
-// thread local table can be get by using the @get_thread_local_cache() method.
+// The shared_ptr of resources in ALL threads are cached in a global registry,
+// which takes the ownership of cached resources. The registry is split into
+// @num_shards shards by key, each of which is protected by its own mutex and
+// keeps a list of replicas (one per thread) for each key. Besides, each thread
+// will use a thread local table to cache the weak_ptr of current thread's
+// resources. The thread local table can be get by using the
+// @get_thread_local_cache() method.
 // - When looking up the cached value, we will only search the thread local
 //   table in thread safe way without lock. If cache hit, we will return the
 //   found value, and the performance should be good.
-// - If cache miss, we need to add a new value to the global table, and add its
-//   weak_ptr to the thread local table correspondingly. Ann we need to use a
-//   lock to protect the global table. The performance should be bad, but cache
-//   miss should be rare.
+// - If cache miss, we need to add a new value to the shard of the key, and add
+//   its weak_ptr to the thread local table correspondingly. Only the shard
+//   mutex is taken, so threads touching different kernels for the first time
+//   don't serialize on a single lock.
 // - We can read/write the found resource in each thread without lock, because
 //   each thread has its own replica.
 // - If a thread existed, the thread local table will be destroyed, during
-//   which, we will find the share_ptr in global table for each weak_ptr in
-//   thread local table, and release the shared_ptr.
+//   which, we will remove the thread's replicas from their shards.
 // - If users want to destroy the cached value for a certain key in ALL thread,
-//   they can call the @remove_if_exist() method. After that the corresponding
-//   shared ptr in global table will be released. Even though the weak ptr in
-//   thread local table won't be erased, we think this is acceptable because the
-//   underlying instance has been destroyed indeed and the expired weak ptr can
-//   be reused by other keys.
+//   they can call the @remove_if_exist() method. After that the key and its
+//   replicas will be erased from the shard. The expired weak ptr in the thread
+//   local tables will be erased lazily on the next lookup.
+// - To bound the memory of idle threads (eg. a large thread pool which has
+//   executed a partition only once), the replicas which haven't been used for
+//   a while are reclaimed. Adding a new replica sweeps the whole registry for
+//   idle replicas, at most once per idle time, and reclaims the idle replicas
+//   of the key at once if the key has more replicas than the capacity. The
+//   capacity defaults to the number of hardware threads and can be changed by
+//   _ONEDNN_GRAPH_THREAD_LOCAL_CACHE_CAPACITY, the idle time defaults to
+//   1000ms and can be changed by _ONEDNN_GRAPH_THREAD_LOCAL_CACHE_IDLE_MS.
+//   Each thread keeps strong references to its @num_recent most recently used
+//   replicas, so a replica which is reclaimed while its owner is still
+//   executing stays alive until the owner moves on.
 template <typename T>
 class thread_local_cache_t {
 public:
@@ -75,8 +91,7 @@ public:
 
     // Check if we have a cached value for the given key in current thread
     bool has_resource(const size_t &key) {
-        cache_type_t &cache = get_thread_local_cache();
-        return cache.data().count(key) && !cache.data()[key].expired();
+        return get_thread_local_cache().find(key) != nullptr;
     }
 
     // return the number of cached values in current thread
@@ -88,30 +103,23 @@ public:
     // Clear the cached values in current thread
     void clear() {
         cache_type_t &cache = get_thread_local_cache();
-        for (auto &it : cache.data()) {
-            std::shared_ptr<T> value = it.second.lock();
-            if (value) {
-                std::lock_guard<std::mutex> lock(global_cache_.mutex());
-                std::vector<std::shared_ptr<T>> &thread_instances
-                        = global_cache_.data().find(it.first)->second;
-                auto pos = std::find_if(thread_instances.begin(),
-                        thread_instances.end(),
-                        [&](std::shared_ptr<T> &ins) -> bool {
-                            return ins.get() == value.get();
-                        });
-                assertm(pos != thread_instances.end(),
-                        "expected value to exist in cache");
-                thread_instances.erase(pos);
-            }
-        }
-        cache.data().clear();
+        cache.release_all();
     }
 
     // Remove the cached values for the given key in ALL threads
     void remove_if_exist(const size_t &key) {
-        std::lock_guard<std::mutex> lock(global_cache_.mutex());
-        auto pos = global_cache_.data().find(key);
-        if (pos != global_cache_.data().end()) { pos->second.clear(); }
+        std::vector<std::shared_ptr<entry_t>> removed;
+        shard_t &shard = get_shard(key);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex_);
+            auto pos = shard.data_.find(key);
+            if (pos == shard.data_.end()) return;
+            removed.swap(pos->second);
+            shard.data_.erase(pos);
+            for (auto &e : removed)
+                e->reclaimed_.store(true, std::memory_order_release);
+        }
+        // the replicas are destroyed here, out of the lock
     }
 
     // Get the cached value in current thread. If the value is not cached, we
@@ -119,90 +127,225 @@ public:
     T *get_or_add(const size_t &key,
             const std::function<std::shared_ptr<T>()> &creator) {
         cache_type_t &cache = get_thread_local_cache();
-        if (has_resource(key)) { // cache hit
-            return cache.data()[key].lock().get();
-        } else { // cache miss
+        std::shared_ptr<entry_t> e = cache.find(key);
+        if (!e) { // cache miss
             // Cache miss shouldn't happen frequently, because the lock is
             // heavy. No double-check is needed here since cached values won't
             // be shared between threads
-            std::shared_ptr<T> ins = creator();
-            {
-                std::lock_guard<std::mutex> lock(global_cache_.mutex());
-                if (global_cache_.data().count(key)) {
-                    global_cache_.data().at(key).emplace_back(ins);
-                } else {
-                    global_cache_.data().emplace(
-                            key, std::vector<std::shared_ptr<T>> {ins});
-                }
-            }
-            cache.data()[key] = ins;
-            return ins.get();
+            e = std::make_shared<entry_t>(creator());
+            add_replica(key, e);
+            cache.data()[key] = e;
         }
+        cache.touch(e);
+        return e->value_.get();
     }
 
 private:
-    class global_cache_type_t {
-    public:
-        std::mutex &mutex() { return mutex_; }
-        std::unordered_map<size_t, std::vector<std::shared_ptr<T>>> &data() {
-            return data_;
-        }
+    static constexpr size_t num_shards = 64;
+    static constexpr size_t num_recent = 4;
 
-    private:
+    // A replica of the cached value in one thread
+    struct entry_t {
+        entry_t(std::shared_ptr<T> value)
+            : value_(std::move(value))
+            , last_use_(now_ms())
+            , reclaimed_(false) {}
+
+        std::shared_ptr<T> value_;
+        // The last time (in ms) that the owner thread used this replica
+        std::atomic<uint64_t> last_use_;
+        // Set when the replica is removed from the global registry
+        std::atomic<bool> reclaimed_;
+    };
+
+    struct shard_t {
         std::mutex mutex_;
-        std::unordered_map<size_t, std::vector<std::shared_ptr<T>>> data_;
+        std::unordered_map<size_t, std::vector<std::shared_ptr<entry_t>>> data_;
     };
 
     class cache_type_t {
     public:
-        cache_type_t(global_cache_type_t &global_cache)
-            : global_cache_ref_(global_cache) {}
+        ~cache_type_t() { release_all(); }
 
-        ~cache_type_t() {
-            // Remove the values of this cache that haven't already expired.
+        // Return the replica of the key if it's still in the registry
+        std::shared_ptr<entry_t> find(const size_t &key) {
+            auto pos = data_.find(key);
+            if (pos == data_.end()) return nullptr;
+            std::shared_ptr<entry_t> e = pos->second.lock();
+            if (!e || e->reclaimed_.load(std::memory_order_acquire)) {
+                data_.erase(pos);
+                return nullptr;
+            }
+            return e;
+        }
+
+        // Update the last use time of the replica and pin it
+        void touch(const std::shared_ptr<entry_t> &e) {
+            e->last_use_.store(now_ms(), std::memory_order_release);
+            for (size_t i = 0; i < num_recent; i++) {
+                if (recent_[i] == e) return;
+            }
+            recent_[recent_pos_] = e;
+            recent_pos_ = (recent_pos_ + 1) % num_recent;
+        }
+
+        // Remove the values of this cache from the registry
+        void release_all() {
             for (auto &it : data_) {
-                std::shared_ptr<T> value = it.second.lock();
-                if (value) {
-                    std::lock_guard<std::mutex> lock(global_cache_ref_.mutex());
-
-                    // Find the corresponding shared ptr in global table
-                    std::vector<std::shared_ptr<T>> &thread_instances
-                            = global_cache_ref_.data().find(it.first)->second;
-                    auto pos = std::find_if(thread_instances.begin(),
-                            thread_instances.end(),
-                            [&](std::shared_ptr<T> &ins) -> bool {
-                                return ins.get() == value.get();
-                            });
-                    assertm(pos != thread_instances.end(),
-                            "expected value to exist in cache");
-                    // Detroy it
-                    thread_instances.erase(pos);
-                }
+                std::shared_ptr<entry_t> value = it.second.lock();
+                if (value) remove_replica(it.first, value);
             }
+            data_.clear();
+            for (auto &e : recent_)
+                e.reset();
         }
 
-        std::unordered_map<size_t, std::weak_ptr<T>> &data() { return data_; }
+        std::unordered_map<size_t, std::weak_ptr<entry_t>> &data() {
+            return data_;
+        }
 
-        global_cache_type_t &global_cache_ref_;
-        std::unordered_map<size_t, std::weak_ptr<T>> data_;
+    private:
+        std::unordered_map<size_t, std::weak_ptr<entry_t>> data_;
+        std::shared_ptr<entry_t> recent_[num_recent];
+        size_t recent_pos_ = 0;
     };
 
     thread_local_cache_t(const thread_local_cache_t &other) = delete;
     thread_local_cache_t &operator=(const thread_local_cache_t &other) = delete;
 
     static cache_type_t &get_thread_local_cache() {
-        static thread_local cache_type_t cache(global_cache_);
+        static thread_local cache_type_t cache;
         return cache;
     }
 
-    // A global table to store cached values in ALL threads. This global table
-    // takes the ownership of cached values
-    static global_cache_type_t global_cache_;
+    static uint64_t now_ms() {
+        return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch())
+                        .count());
+    }
+
+    static size_t get_capacity() {
+        static const size_t capacity = []() {
+            const int hw_threads = static_cast<int>(
+                    std::max(std::thread::hardware_concurrency(), 1U));
+            int cap = graph::utils::getenv_int_internal(
+                    "GRAPH_THREAD_LOCAL_CACHE_CAPACITY", hw_threads);
+            return static_cast<size_t>(cap > 0 ? cap : hw_threads);
+        }();
+        return capacity;
+    }
+
+    static uint64_t get_idle_ms() {
+        static const uint64_t idle_ms = []() {
+            int ms = graph::utils::getenv_int_internal(
+                    "GRAPH_THREAD_LOCAL_CACHE_IDLE_MS", 1000);
+            return static_cast<uint64_t>(ms > 0 ? ms : 0);
+        }();
+        return idle_ms;
+    }
+
+    static shard_t &get_shard(const size_t &key) {
+        // keys are usually addresses of kernels, so drop the alignment bits
+        // and mix the higher bits in
+        size_t h = key >> 4;
+        h ^= (h >> 7) ^ (h >> 13);
+        return shards_[h % num_shards];
+    }
+
+    // Move the replicas which haven't been used since @now - idle time from
+    // @replicas to @reclaimed
+    static void reclaim_idle(std::vector<std::shared_ptr<entry_t>> &replicas,
+            uint64_t now, std::vector<std::shared_ptr<entry_t>> &reclaimed) {
+        const uint64_t idle_ms = get_idle_ms();
+        for (size_t i = 0; i < replicas.size();) {
+            const uint64_t last_use
+                    = replicas[i]->last_use_.load(std::memory_order_acquire);
+            if (last_use + idle_ms < now) {
+                replicas[i]->reclaimed_.store(true, std::memory_order_release);
+                reclaimed.emplace_back(std::move(replicas[i]));
+                replicas[i] = std::move(replicas.back());
+                replicas.pop_back();
+            } else {
+                i++;
+            }
+        }
+    }
+
+    // Reclaim the idle replicas of all keys. Only one thread sweeps the
+    // registry per idle time, other threads return immediately
+    static void sweep_idle_replicas() {
+        const uint64_t now = now_ms();
+        uint64_t next_sweep = next_sweep_ms_.load(std::memory_order_acquire);
+        if (now < next_sweep) return;
+        if (!next_sweep_ms_.compare_exchange_strong(
+                    next_sweep, now + get_idle_ms()))
+            return;
+
+        std::vector<std::shared_ptr<entry_t>> reclaimed;
+        for (auto &shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex_);
+            for (auto it = shard.data_.begin(); it != shard.data_.end();) {
+                reclaim_idle(it->second, now, reclaimed);
+                if (it->second.empty())
+                    it = shard.data_.erase(it);
+                else
+                    ++it;
+            }
+        }
+        // the reclaimed replicas are destroyed here, out of the locks
+    }
+
+    static void add_replica(
+            const size_t &key, const std::shared_ptr<entry_t> &e) {
+        std::vector<std::shared_ptr<entry_t>> reclaimed;
+        shard_t &shard = get_shard(key);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex_);
+            std::vector<std::shared_ptr<entry_t>> &replicas = shard.data_[key];
+            if (replicas.size() >= get_capacity())
+                reclaim_idle(replicas, now_ms(), reclaimed);
+            replicas.emplace_back(e);
+        }
+        sweep_idle_replicas();
+        // the reclaimed replicas are destroyed here, out of the lock
+    }
+
+    static void remove_replica(
+            const size_t &key, const std::shared_ptr<entry_t> &e) {
+        shard_t &shard = get_shard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        auto pos = shard.data_.find(key);
+        // the replica may have been reclaimed or removed by other threads
+        if (pos == shard.data_.end()) return;
+        std::vector<std::shared_ptr<entry_t>> &replicas = pos->second;
+        auto it = std::find(replicas.begin(), replicas.end(), e);
+        if (it == replicas.end()) return;
+        e->reclaimed_.store(true, std::memory_order_release);
+        *it = std::move(replicas.back());
+        replicas.pop_back();
+        if (replicas.empty()) shard.data_.erase(pos);
+    }
+
+    // The global registry of cached values in ALL threads, split into shards
+    // by key. It takes the ownership of cached values
+    static shard_t shards_[num_shards];
+    // The earliest time (in ms) of the next sweep of the registry
+    static std::atomic<uint64_t> next_sweep_ms_;
 };
 
 template <typename T>
-typename thread_local_cache_t<T>::global_cache_type_t
-        thread_local_cache_t<T>::global_cache_;
+constexpr size_t thread_local_cache_t<T>::num_shards;
+
+template <typename T>
+constexpr size_t thread_local_cache_t<T>::num_recent;
+
+template <typename T>
+typename thread_local_cache_t<T>::shard_t
+        thread_local_cache_t<T>::shards_[thread_local_cache_t<T>::num_shards];
+
+template <typename T>
+std::atomic<uint64_t> thread_local_cache_t<T>::next_sweep_ms_ {0};
 
 } // namespace autograph_impl
 } // namespace graph
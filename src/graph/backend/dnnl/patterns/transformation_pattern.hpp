@@ -54,16 +54,17 @@ public:
 inline void pattern_utils_t::match(graph_t &backend_graph,
         std::shared_ptr<graph::utils::pm::pb_graph_t> pgraph,
         std::vector<std::vector<op_t *>> &fusion_ops) {
-    // dfs_visit graph, do pattern matching
-    topo_order_visit(backend_graph.get_output_ops(), [&](op_t *cur_op) {
+    // only try the ops which can be bound to the root of the pattern, in
+    // topological order
+    for (op_t *cur_op :
+            graph::utils::pm::get_pattern_seeds(backend_graph, pgraph)) {
         std::vector<op_t *> candidate_fusion;
         if (!graph::utils::pm::match_pattern(
                     cur_op, pgraph, candidate_fusion)) {
-            return status::success;
+            continue;
         }
         fusion_ops.emplace_back(candidate_fusion);
-        return status::success;
-    });
+    }
 }
 
 inline void pattern_utils_t::init_partition(graph_t &backend_graph,
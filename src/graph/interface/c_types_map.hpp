@@ -296,6 +296,7 @@ using graph_t = dnnl_graph_graph;
 using op_t = dnnl_graph_op;
 using partition_t = dnnl_graph_partition;
 using compiled_partition_t = dnnl_graph_compiled_partition;
+using compile_task_t = dnnl_graph_compile_task;
 using tensor_t = dnnl_graph_tensor;
 
 // oneDNN common objects
@@ -0,0 +1,149 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "common/dnnl_thread.hpp"
+#include "common/utils.hpp"
+
+#include "graph/interface/compile_task.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+
+namespace {
+
+// Set on the threads of the compilation pool. The compilations submitted from
+// a pool thread are run inline, as waiting for them from a pool thread could
+// deadlock once all the pool threads wait.
+thread_local bool is_compile_worker = false;
+
+// Run the job with the max number of threads of the thread which submitted
+// it, since the kernels created by the compilation are specialized for it.
+status_t run_with_max_threads(
+        int max_threads, const std::function<status_t()> &job) {
+#if DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_OMP
+    const int saved = omp_get_max_threads();
+    omp_set_num_threads(max_threads);
+    status_t ret = job();
+    omp_set_num_threads(saved);
+    return ret;
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_TBB
+    status_t ret = status::success;
+    tbb::task_arena arena(max_threads);
+    arena.execute([&]() { ret = job(); });
+    return ret;
+#elif DNNL_CPU_THREADING_RUNTIME == DNNL_RUNTIME_THREADPOOL
+    int &max_concurrency = threadpool_utils::get_threadlocal_max_concurrency();
+    const int saved = max_concurrency;
+    max_concurrency = max_threads;
+    status_t ret = job();
+    max_concurrency = saved;
+    return ret;
+#else
+    UNUSED(max_threads);
+    return job();
+#endif
+}
+
+} // namespace
+
+compile_thread_pool_t::compile_thread_pool_t(size_t num_threads) {
+    threads_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; i++) {
+        threads_.emplace_back(&compile_thread_pool_t::worker, this);
+    }
+}
+
+compile_thread_pool_t::~compile_thread_pool_t() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &t : threads_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+void compile_thread_pool_t::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.emplace_back(std::move(job));
+    }
+    cv_.notify_one();
+}
+
+void compile_thread_pool_t::worker() {
+    is_compile_worker = true;
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stop_ || !jobs_.empty(); });
+            if (stop_ && jobs_.empty()) return;
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job();
+    }
+}
+
+compile_thread_pool_t &get_compile_thread_pool() {
+    // The pool is intentionally leaked: joining threads from a static
+    // destructor may hang when the library is unloaded.
+    static compile_thread_pool_t *pool = []() {
+        const int hw_threads = static_cast<int>(
+                std::max(std::thread::hardware_concurrency(), 1U));
+        int num_threads = getenv_int_user("GRAPH_COMPILE_THREADS", hw_threads);
+        if (num_threads <= 0) num_threads = hw_threads;
+        return new compile_thread_pool_t(static_cast<size_t>(num_threads));
+    }();
+    return *pool;
+}
+
+bool is_compile_worker_thread() {
+    return is_compile_worker;
+}
+
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+dnnl_graph_compile_task::dnnl_graph_compile_task(
+        std::function<status_t()> job) {
+    using namespace dnnl::impl::graph;
+    const int max_threads = dnnl_get_max_threads();
+    auto run = [max_threads, job]() {
+        status_t ret = status::success;
+        try {
+            ret = run_with_max_threads(max_threads, job);
+        } catch (...) { ret = status::runtime_error; }
+        return ret;
+    };
+
+    auto promise = std::make_shared<std::promise<status_t>>();
+    status_ = promise->get_future().share();
+    if (is_compile_worker_thread()) {
+        promise->set_value(run());
+        return;
+    }
+    get_compile_thread_pool().submit(
+            [promise, run]() { promise->set_value(run()); });
+}
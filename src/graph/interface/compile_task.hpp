@@ -0,0 +1,94 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_INTERFACE_COMPILE_TASK_HPP
+#define GRAPH_INTERFACE_COMPILE_TASK_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "oneapi/dnnl/dnnl_graph.h"
+
+#include "graph/interface/c_types_map.hpp"
+
+namespace dnnl {
+namespace impl {
+namespace graph {
+
+// A fixed size pool of background threads which run the asynchronous
+// compilations. Jobs are run in the order of submission.
+class compile_thread_pool_t {
+public:
+    explicit compile_thread_pool_t(size_t num_threads);
+
+    compile_thread_pool_t(const compile_thread_pool_t &) = delete;
+    compile_thread_pool_t &operator=(const compile_thread_pool_t &) = delete;
+
+    ~compile_thread_pool_t();
+
+    void submit(std::function<void()> job);
+
+    size_t get_num_threads() const { return threads_.size(); }
+
+private:
+    void worker();
+
+    std::vector<std::thread> threads_;
+    std::deque<std::function<void()>> jobs_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_ {false};
+};
+
+// The pool is created on first use with ONEDNN_GRAPH_COMPILE_THREADS threads,
+// or the number of hardware threads if the env var is not set.
+compile_thread_pool_t &get_compile_thread_pool();
+
+// Whether the calling thread is a thread of the compilation pool
+bool is_compile_worker_thread();
+
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+struct dnnl_graph_compile_task {
+public:
+    using status_t = dnnl::impl::graph::status_t;
+
+    // Submit the job to the compilation thread pool. The job is run with the
+    // max number of threads of the calling thread. If the calling thread is a
+    // thread of the pool, the job is run inline instead.
+    explicit dnnl_graph_compile_task(std::function<status_t()> job);
+
+    // Block until the job is completed and return its status
+    status_t wait() const { return status_.get(); }
+
+    bool is_ready() const {
+        return status_.wait_for(std::chrono::seconds(0))
+                == std::future_status::ready;
+    }
+
+private:
+    std::shared_future<status_t> status_;
+};
+
+#endif
@@ -14,6 +14,7 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <iostream>
@@ -265,9 +266,51 @@ status_t dnnl_graph_graph::finalize() {
     }
 
     finalized_ = true;
+    op_index_valid_ = false;
     return status::success;
 }
 
+void dnnl_graph_graph::build_op_index() {
+    if (op_index_valid_) return;
+    // finalize() connects the values shared by several ops, the order built
+    // before that would miss edges
+    assertm(finalized_, "the ops can only be ordered in a finalized graph");
+
+    topo_ops_.clear();
+    op_positions_.clear();
+    topo_order_visit(get_output_ops(), [&](op_t *op) {
+        op_positions_[op->get_kind()].emplace_back(topo_ops_.size());
+        topo_ops_.emplace_back(op);
+        return status::success;
+    });
+    op_index_valid_ = true;
+}
+
+std::vector<graph_t::op_t *> dnnl_graph_graph::get_topo_ordered_ops(
+        const std::vector<op_kind_t> &kinds) {
+    build_op_index();
+
+    std::vector<size_t> positions;
+    std::unordered_set<op_kind_t> visited_kinds;
+    for (const auto &kind : kinds) {
+        if (!visited_kinds.insert(kind).second) continue;
+        auto pos = op_positions_.find(kind);
+        if (pos == op_positions_.end()) continue;
+        positions.insert(
+                positions.end(), pos->second.begin(), pos->second.end());
+    }
+    // the positions of each kind are sorted, so sorting is only required to
+    // merge several kinds
+    if (visited_kinds.size() > 1)
+        std::sort(positions.begin(), positions.end());
+
+    std::vector<op_t *> ops;
+    ops.reserve(positions.size());
+    for (size_t pos : positions)
+        ops.emplace_back(topo_ops_[pos]);
+    return ops;
+}
+
 // Deep copy a graph
 std::vector<dnnl_graph_graph::op_ptr> dnnl_graph_graph::deep_copy(
         const std::vector<dnnl_graph_graph::op_ptr> &ops) {
@@ -80,6 +80,16 @@ private:
 
     bool finalized_ {false};
 
+    /*! \brief cached topological order of the ops, see get_topo_ordered_ops */
+    std::vector<op_t *> topo_ops_;
+
+    /*! \brief positions in topo_ops_ of the ops of each kind */
+    std::unordered_map<graph::op_kind_t, std::vector<size_t>> op_positions_;
+
+    bool op_index_valid_ {false};
+
+    void build_op_index();
+
 public:
     dnnl_graph_graph(graph::engine_kind_t kind = graph::engine_kind::cpu)
         : engine_kind_(kind), fpmath_mode_(dnnl::impl::get_fpmath_mode()) {}
@@ -132,6 +142,7 @@ public:
                 }
             }
             ops_.push_back(std::make_shared<op_t>(tmp_ln));
+            op_index_valid_ = false;
             auto back_op = ops_.back().get();
             for (size_t i = 0; i < back_op->num_outputs(); i++)
                 back_op->get_output_value(i)->set_producer(*back_op);
@@ -141,6 +152,7 @@ public:
 
     op_t *create_op(dnnl_graph_op_kind_t kind, std::string name = "") {
         ops_.push_back(std::make_shared<op_t>(kind, std::move(name)));
+        op_index_valid_ = false;
         return ops_.back().get();
     }
 
@@ -150,6 +162,7 @@ public:
         auto pos = std::find_if(ops_.begin(), ops_.end(),
                 [op](const op_ptr &n) -> bool { return *n == *op; });
         if (pos != ops_.end()) ops_.erase(pos);
+        op_index_valid_ = false;
     }
 
     /*!
@@ -158,6 +171,27 @@ public:
      */
     const std::vector<op_ptr> &get_ops() const { return ops_; }
 
+    /*!
+     * \brief Get the ops in the order visited by topo_order_visit from the
+     * output ops. The order is built on first use and cached until an op is
+     * added to or removed from the graph, so it must not be used while the
+     * connections of the ops are being rewritten. The graph must be
+     * finalized.
+     * \return vector of ops pointers in topological order
+     */
+    const std::vector<op_t *> &get_topo_ordered_ops() {
+        build_op_index();
+        return topo_ops_;
+    }
+
+    /*!
+     * \brief Get the ops of the given kinds in topological order.
+     * \param kinds The op kinds to look up, which may contain duplicates.
+     * \return vector of ops pointers in the order of get_topo_ordered_ops
+     */
+    std::vector<op_t *> get_topo_ordered_ops(
+            const std::vector<graph::op_kind_t> &kinds);
+
     /*! \brief how many ops in the graph */
     size_t num_ops() const { return ops_.size(); }
 
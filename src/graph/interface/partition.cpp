@@ -14,12 +14,14 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <limits>
 #include <set>
 #include <sstream>
 #include <thread>
+#include <unordered_map>
 
 #include "oneapi/dnnl/dnnl_graph.h"
 #include "oneapi/dnnl/dnnl_graph_sycl.h"
@@ -30,6 +32,7 @@
 #include "graph/interface/allocator.hpp"
 #include "graph/interface/backend.hpp"
 #include "graph/interface/c_types_map.hpp"
+#include "graph/interface/compile_task.hpp"
 #include "graph/interface/graph.hpp"
 #include "graph/interface/logical_tensor.hpp"
 #include "graph/interface/op_schema.hpp"
@@ -173,19 +176,11 @@ status_t DNNL_API dnnl_graph_partition_get_id(
     return status::success;
 }
 
-status_t DNNL_API dnnl_graph_partition_compile(partition_t *partition,
-        compiled_partition_t *compiled_partition, size_t in_num,
-        const logical_tensor_t **inputs, size_t out_num,
-        const logical_tensor_t **outputs, engine_t *engine) {
-    if (utils::any_null(partition, compiled_partition, engine)) {
-        return status::invalid_arguments;
-    }
-
-    if (!partition->is_supported()) return status::invalid_arguments;
-
-    std::vector<const logical_tensor_t *> in {inputs, inputs + in_num};
-    std::vector<const logical_tensor_t *> out {outputs, outputs + out_num};
-
+namespace {
+status_t compile_partition(const partition_t *partition,
+        compiled_partition_t *compiled_partition,
+        std::vector<const logical_tensor_t *> &in,
+        std::vector<const logical_tensor_t *> &out, engine_t *engine) {
     // The boolean in the pair indicates whether the compiled partition is from
     // global cache.
     //   true - cache_hit, the compiled partition is in the cache
@@ -207,6 +202,122 @@ status_t DNNL_API dnnl_graph_partition_compile(partition_t *partition,
     return status::success;
 }
 
+// Submit a compilation to the background threads. The logical tensors are
+// copied into the job.
+compile_task_t *submit_compilation(const partition_t *partition,
+        compiled_partition_t *compiled_partition,
+        std::vector<logical_tensor_t> in, std::vector<logical_tensor_t> out,
+        engine_t *engine) {
+    return new compile_task_t([=]() mutable {
+        std::vector<const logical_tensor_t *> in_ptrs, out_ptrs;
+        for (const auto &lt : in)
+            in_ptrs.emplace_back(&lt);
+        for (const auto &lt : out)
+            out_ptrs.emplace_back(&lt);
+        return compile_partition(
+                partition, compiled_partition, in_ptrs, out_ptrs, engine);
+    });
+}
+} // namespace
+
+status_t DNNL_API dnnl_graph_partition_compile(partition_t *partition,
+        compiled_partition_t *compiled_partition, size_t in_num,
+        const logical_tensor_t **inputs, size_t out_num,
+        const logical_tensor_t **outputs, engine_t *engine) {
+    if (utils::any_null(partition, compiled_partition, engine)) {
+        return status::invalid_arguments;
+    }
+
+    if (!partition->is_supported()) return status::invalid_arguments;
+
+    std::vector<const logical_tensor_t *> in {inputs, inputs + in_num};
+    std::vector<const logical_tensor_t *> out {outputs, outputs + out_num};
+
+    return compile_partition(partition, compiled_partition, in, out, engine);
+}
+
+status_t DNNL_API dnnl_graph_partition_compile_async(partition_t *partition,
+        compiled_partition_t *compiled_partition, size_t in_num,
+        const logical_tensor_t **inputs, size_t out_num,
+        const logical_tensor_t **outputs, engine_t *engine,
+        compile_task_t **task) {
+    if (utils::any_null(partition, compiled_partition, engine, task)) {
+        return status::invalid_arguments;
+    }
+    if ((in_num && !inputs) || (out_num && !outputs))
+        return status::invalid_arguments;
+
+    if (!partition->is_supported()) return status::invalid_arguments;
+
+    std::vector<logical_tensor_t> in, out;
+    for (size_t i = 0; i < in_num; i++) {
+        if (!inputs[i]) return status::invalid_arguments;
+        in.emplace_back(*inputs[i]);
+    }
+    for (size_t i = 0; i < out_num; i++) {
+        if (!outputs[i]) return status::invalid_arguments;
+        out.emplace_back(*outputs[i]);
+    }
+
+    *task = submit_compilation(partition, compiled_partition, std::move(in),
+            std::move(out), engine);
+    return status::success;
+}
+
+status_t DNNL_API dnnl_graph_partition_warmup(size_t num,
+        partition_t *const *partitions, const size_t *in_nums,
+        const logical_tensor_t *const *inputs, const size_t *out_nums,
+        const logical_tensor_t *const *outputs, engine_t *engine) {
+    if (num == 0) return status::success;
+    if (utils::any_null(partitions, in_nums, inputs, out_nums, outputs, engine))
+        return status::invalid_arguments;
+
+    for (size_t i = 0; i < num; i++) {
+        if (!partitions[i] || !partitions[i]->is_supported())
+            return status::invalid_arguments;
+        if ((in_nums[i] && !inputs[i]) || (out_nums[i] && !outputs[i]))
+            return status::invalid_arguments;
+    }
+
+    // The compiled partitions are only needed to hold the results. What
+    // matters is the entries put into the compiled partition cache.
+    std::vector<std::unique_ptr<compiled_partition_t>> cps;
+    std::vector<std::unique_ptr<compile_task_t>> tasks;
+    cps.reserve(num);
+    tasks.reserve(num);
+    for (size_t i = 0; i < num; i++) {
+        cps.emplace_back(new compiled_partition_t {*partitions[i]});
+        tasks.emplace_back(submit_compilation(partitions[i], cps.back().get(),
+                {inputs[i], inputs[i] + in_nums[i]},
+                {outputs[i], outputs[i] + out_nums[i]}, engine));
+    }
+
+    status_t ret = status::success;
+    for (const auto &task : tasks) {
+        status_t st = task->wait();
+        if (ret == status::success) ret = st;
+    }
+    return ret;
+}
+
+status_t DNNL_API dnnl_graph_compile_task_wait(const compile_task_t *task) {
+    if (task == nullptr) return status::invalid_arguments;
+    return task->wait();
+}
+
+status_t DNNL_API dnnl_graph_compile_task_is_ready(
+        const compile_task_t *task, uint8_t *ready) {
+    if (utils::any_null(task, ready)) return status::invalid_arguments;
+    *ready = static_cast<uint8_t>(task->is_ready());
+    return status::success;
+}
+
+status_t DNNL_API dnnl_graph_compile_task_destroy(compile_task_t *task) {
+    if (task) task->wait();
+    delete task;
+    return status::success;
+}
+
 status_t DNNL_API dnnl_graph_partition_get_input_ports_num(
         const partition_t *partition, size_t *num) {
     if (utils::any_null(partition, num)) { return status::invalid_arguments; }
@@ -270,6 +381,14 @@ status_t DNNL_API dnnl_graph_partition_get_engine_kind(
     return status::success;
 }
 
+status_t DNNL_API dnnl_graph_partition_set_inter_op_parallel(
+        partition_t *partition, uint8_t enable) {
+    if (utils::any_null(partition)) { return status::invalid_arguments; }
+
+    partition->set_inter_op_parallel(enable != 0);
+    return status::success;
+}
+
 status_t DNNL_API dnnl_graph_partition_get_kind(
         const partition_t *partition, partition_kind_t *kind) {
     if (utils::any_null(partition, kind)) { return status::invalid_arguments; }
@@ -443,6 +562,54 @@ status_t DNNL_API dnnl_graph_compiled_partition_destroy(
     return status::success;
 }
 
+status_t DNNL_API dnnl_graph_partition_compile_from_cache_blob(
+        partition_t *partition, compiled_partition_t *compiled_partition,
+        size_t size, const uint8_t *cache_blob, engine_t *engine) {
+    if (utils::any_null(partition, compiled_partition, cache_blob, engine)) {
+        return status::invalid_arguments;
+    }
+
+    if (!partition->is_supported()) return status::invalid_arguments;
+
+    if (utils::get_verbose() >= 2) {
+        double ms = dnnl::impl::get_msec();
+        CHECK(partition->compile_from_cache_blob(
+                compiled_partition, cache_blob, size, engine));
+        ms = dnnl::impl::get_msec() - ms;
+
+        printf("onednn_graph_verbose,compile:cache_blob,%s,%g\n",
+                compiled_partition->info(), ms);
+        fflush(stdout);
+        return status::success;
+    }
+    return partition->compile_from_cache_blob(
+            compiled_partition, cache_blob, size, engine);
+}
+
+status_t DNNL_API dnnl_graph_compiled_partition_get_cache_blob(
+        const compiled_partition_t *compiled_partition, size_t *size,
+        uint8_t *cache_blob) {
+    if (utils::any_null(compiled_partition, size))
+        return status::invalid_arguments;
+
+    std::vector<uint8_t> blob;
+    CHECK(compiled_partition->get_cache_blob(blob));
+    if (!cache_blob) {
+        *size = blob.size();
+        return status::success;
+    }
+
+    if (*size != blob.size()) return status::invalid_arguments;
+    std::memcpy(cache_blob, blob.data(), blob.size());
+    return status::success;
+}
+
+status_t DNNL_API dnnl_graph_compiled_partition_invalidate_constant_input(
+        compiled_partition_t *compiled_partition, size_t tensor_id) {
+    if (utils::any_null(compiled_partition)) return status::invalid_arguments;
+    return compiled_partition->invalidate_constant_input(tensor_id);
+}
+
 status_t DNNL_API dnnl_graph_compiled_partition_query_logical_tensor(
         const compiled_partition_t *compiled_partition, size_t tid,
         logical_tensor_t *lt) {
@@ -535,6 +702,88 @@ static status_t pre_process(std::vector<tensor_t> &dst,
     return status::success;
 }
 
+static bool can_use_blocked_layout(engine_kind_t kind) {
+    // Count how many registered backends support the engine kind
+    size_t effective_backends = 0;
+    for (const auto &bkd :
+            backend_registry_t::get_singleton().get_registered_backends()) {
+        const bool is_not_fake = bkd->get_priority() > 0;
+        if (is_not_fake && bkd->support_engine_kind(kind)) {
+            effective_backends++;
+        }
+    }
+
+    // If engine kind is GPU and only dnnl backend supports GPU, we can
+    // safely use blocked layout to improve performance. Otherwise, we must
+    // use plain layout, since: 1. plain layout usually give optimal layout
+    // on CPU. 2. we don't want to pass blocked layout cross backends.
+    return effective_backends == 1 && kind == engine_kind::gpu;
+}
+
+// Map the logical tensor ids of a partition to the ones of a structurally
+// identical partition by walking their ops in order. Return false if the ids
+// can't be mapped one to one.
+static bool map_logical_tensor_ids(const partition_t &src,
+        const partition_t &dst, std::unordered_map<size_t, size_t> &id_map) {
+    const auto &src_ops = src.get_ops();
+    const auto &dst_ops = dst.get_ops();
+    if (src_ops.size() != dst_ops.size()) return false;
+
+    std::unordered_map<size_t, size_t> reverse_map;
+    auto add = [&](size_t src_id, size_t dst_id) {
+        auto pos = id_map.emplace(src_id, dst_id).first;
+        auto rpos = reverse_map.emplace(dst_id, src_id).first;
+        return pos->second == dst_id && rpos->second == src_id;
+    };
+
+    for (size_t i = 0; i < src_ops.size(); i++) {
+        const op_t *src_op = src_ops[i].get();
+        const op_t *dst_op = dst_ops[i].get();
+        if (src_op->num_inputs() != dst_op->num_inputs()
+                || src_op->num_outputs() != dst_op->num_outputs())
+            return false;
+        for (size_t j = 0; j < src_op->num_inputs(); j++) {
+            if (!add(src_op->get_input_value(j)->get_logical_tensor().id,
+                        dst_op->get_input_value(j)->get_logical_tensor().id))
+                return false;
+        }
+        for (size_t j = 0; j < src_op->num_outputs(); j++) {
+            if (!add(src_op->get_output_value(j)->get_logical_tensor().id,
+                        dst_op->get_output_value(j)->get_logical_tensor().id))
+                return false;
+        }
+    }
+    return true;
+}
+
+// Create a compiled partition impl for a structurally identical partition.
+// It shares the compiled kernel with the given one, but uses the logical
+// tensor ids of that partition.
+static std::shared_ptr<compiled_partition_impl_t> share_compiled_partition(
+        const compiled_partition_impl_t &pimpl,
+        const std::unordered_map<size_t, size_t> &id_map) {
+    std::shared_ptr<compiled_partition_impl_t> ret
+            = pimpl.clone_with_shared_kernel();
+    if (!ret) return nullptr;
+
+    auto remap = [&](size_t &id) {
+        auto pos = id_map.find(id);
+        if (pos == id_map.end()) return false;
+        id = pos->second;
+        return true;
+    };
+    for (auto &lt : ret->get_mutable_inputs()) {
+        if (!remap(lt.id)) return nullptr;
+    }
+    for (auto &lt : ret->get_mutable_outputs()) {
+        if (!remap(lt.id)) return nullptr;
+    }
+    for (auto &pair : ret->get_mutable_inplace_pairs()) {
+        if (!remap(pair.input_id) || !remap(pair.output_id)) return nullptr;
+    }
+    return ret;
+}
+
 bool dnnl_graph_partition::is_supported() const {
     return (pimpl_ != nullptr)
             && (pimpl_->get_assigned_backend()->get_name() != "fake_backend");
@@ -561,25 +810,8 @@ status_t dnnl_graph_partition::compile(compiled_partition_t *cp,
     ret = pre_process(tmp_outputs, outputs, backend);
     if (status::success != ret) return ret;
 
-    // Count how many registered backends support the engine kind
-    const engine_kind_t kind = aengine->kind();
-    size_t effective_backends = 0;
-    for (const auto &bkd :
-            backend_registry_t::get_singleton().get_registered_backends()) {
-        const bool is_not_fake = bkd->get_priority() > 0;
-        if (is_not_fake && bkd->support_engine_kind(kind)) {
-            effective_backends++;
-        }
-    }
-
-    // If engine kind is GPU and only dnnl backend supports GPU, we can
-    // safely use blocked layout to improve performance. Otherwise, we must
-    // use plain layout, since: 1. plain layout usually give optimal layout
-    // on CPU. 2. we don't want to pass blocked layout cross backends.
-    const bool can_use_blocked_layout
-            = effective_backends == 1 && kind == engine_kind::gpu;
     const_cast<partition_impl_t *>(pimpl_.get())
-            ->set_use_blocked_layout(can_use_blocked_layout);
+            ->set_use_blocked_layout(can_use_blocked_layout(aengine->kind()));
 
 #ifdef DNNL_ENABLE_GRAPH_DUMP
     if (dnnl::impl::getenv_int_user("GRAPH_DUMP", 0) > 1
@@ -650,7 +882,33 @@ status_t dnnl_graph_partition::compile(
         // created by another thread.
         cp = cp_future.get().compiled_partition;
         if (!cp) return cp_future.get().status;
-        compiled_partition.first->init(cp->pimpl_);
+
+        // The cached compiled partition may be compiled from another
+        // partition with the same structure, whose logical tensor ids are
+        // different. Its kernel is shared if the backend supports it,
+        // otherwise the partition is compiled without the cache.
+        std::unordered_map<size_t, size_t> id_map;
+        if (!map_logical_tensor_ids(cp->src_partition(), *this, id_map)) {
+            compiled_partition.second = false;
+            return this->compile(
+                    compiled_partition.first, inputs, outputs, aengine);
+        }
+        const bool same_ids = std::all_of(id_map.begin(), id_map.end(),
+                [](const std::pair<const size_t, size_t> &p) {
+                    return p.first == p.second;
+                });
+        if (same_ids) {
+            compiled_partition.first->init(cp->pimpl_);
+        } else {
+            std::shared_ptr<compiled_partition_impl_t> pimpl
+                    = share_compiled_partition(*(cp->pimpl_), id_map);
+            if (!pimpl) {
+                compiled_partition.second = false;
+                return this->compile(
+                        compiled_partition.first, inputs, outputs, aengine);
+            }
+            compiled_partition.first->init(pimpl);
+        }
     } else {
         // The requested compiled partition is NOT present in the cache
         // therefore we have to create it and notify the waiting threads once
@@ -699,6 +957,30 @@ status_t dnnl_graph_partition::compile(
     return status;
 }
 
+status_t dnnl_graph_partition::compile_from_cache_blob(compiled_partition_t *cp,
+        const uint8_t *cache_blob, size_t size, const engine_t *aengine) const {
+    if (!aengine || aengine->kind() != pimpl_->get_engine_kind())
+        return status::invalid_arguments;
+
+    const backend *backend = pimpl_->get_assigned_backend();
+    if (!backend) return status::invalid_arguments;
+
+    const_cast<partition_impl_t *>(pimpl_.get())
+            ->set_use_blocked_layout(can_use_blocked_layout(aengine->kind()));
+
+    status_t ret
+            = pimpl_->compile_from_cache_blob(cp, cache_blob, size, aengine);
+    if (status::success != ret) return ret;
+    if (!cp->is_initialized()) return status::unimplemented;
+
+    // Encode backend id to the layout ids restored from the blob
+    std::vector<logical_tensor_t> unused;
+    ret = post_process(cp->get_mutable_inputs(), unused, backend);
+    if (status::success != ret) return ret;
+
+    return post_process(cp->get_mutable_outputs(), unused, backend);
+}
+
 status_t dnnl_graph_compiled_partition::execute(const stream_t *astream,
         const std::vector<tensor_t> &inputs,
         const std::vector<tensor_t> &outputs) const {
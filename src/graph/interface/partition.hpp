@@ -88,6 +88,15 @@ public:
 
     graph::partition_kind_t get_kind() const { return pimpl_->get_kind(); }
 
+    void set_inter_op_parallel(bool enable) {
+        const_cast<graph::partition_impl_t *>(pimpl_.get())
+                ->set_inter_op_parallel(enable);
+    }
+
+    int get_inter_op_parallel() const {
+        return pimpl_->get_inter_op_parallel();
+    }
+
     const std::vector<std::shared_ptr<graph::op_t>> &get_ops() const {
         return pimpl_->get_ops();
     }
@@ -127,6 +136,11 @@ public:
             std::vector<const graph::logical_tensor_t *> &outputs,
             const graph::engine_t *aengine) const;
 
+    graph::status_t compile_from_cache_blob(
+            graph::compiled_partition_t *compiled_partition,
+            const uint8_t *cache_blob, size_t size,
+            const graph::engine_t *aengine) const;
+
     graph::status_t infer_shape(
             std::vector<const graph::logical_tensor_t *> &inputs,
             std::vector<graph::logical_tensor_t *> &outputs);
@@ -187,6 +201,16 @@ public:
 
     const graph::engine_t *get_engine() const { return pimpl_->get_engine(); }
 
+    graph::status_t get_cache_blob(std::vector<uint8_t> &blob) const {
+        if (!pimpl_) return graph::status::invalid_arguments;
+        return pimpl_->get_cache_blob(blob);
+    }
+
+    graph::status_t invalidate_constant_input(size_t tensor_id) {
+        if (!pimpl_) return graph::status::invalid_arguments;
+        return pimpl_->invalidate_constant_input(tensor_id);
+    }
+
     std::vector<graph::logical_tensor_t> &get_mutable_inputs() {
         return pimpl_->get_mutable_inputs();
     }
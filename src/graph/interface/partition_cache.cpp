@@ -52,6 +52,16 @@ compiled_partition_cache_t &compiled_partition_cache() {
     return cache;
 }
 
+// Undocumented API, for testing only
+status_t get_compiled_partition_cache_size(int *size) {
+    if (size == nullptr) return status::invalid_arguments;
+    *size = 0;
+#ifndef DNNL_GRAPH_DISABLE_COMPILED_PARTITION_CACHE
+    *size = compiled_partition_cache().get_size();
+#endif
+    return status::success;
+}
+
 status_t lru_compiled_partition_cache_t::set_capacity(int capacity) {
     impl::utils::lock_write_t lock_w(rw_mutex());
     capacity_ = static_cast<size_t>(capacity);
@@ -203,6 +213,8 @@ void lru_compiled_partition_cache_t::update_entry(const key_t &key,
     for (auto &out : outs) {
         it->first.outs_.emplace_back(*out);
     }
+    it->first.structure_ = partition_hashing::get_partition_structure(
+            it->first.ops_, it->first.ins_, it->first.outs_);
 }
 
 void lru_compiled_partition_cache_t::evict(size_t n) {
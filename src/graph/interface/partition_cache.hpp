@@ -122,6 +122,9 @@ private:
 
 compiled_partition_cache_t &compiled_partition_cache();
 
+// Undocumented API for testing.
+status_t DNNL_API get_compiled_partition_cache_size(int *size);
+
 } // namespace graph
 } // namespace impl
 } // namespace dnnl
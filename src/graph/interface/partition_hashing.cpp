@@ -14,7 +14,9 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <limits>
 #include <memory>
+#include <unordered_map>
 
 #include "graph/interface/partition.hpp"
 #include "graph/interface/partition_hashing.hpp"
@@ -26,6 +28,18 @@ namespace impl {
 namespace graph {
 namespace partition_hashing {
 
+namespace {
+// Compare two logical tensors except the ids. Unlike
+// logical_tensor_wrapper_t::is_similar, the layout types must be the same
+// as the compiled partition is specialized for them.
+bool is_logical_tensor_structurally_equal(
+        const logical_tensor_t &lhs, const logical_tensor_t &rhs) {
+    return lhs.layout_type == rhs.layout_type
+            && logical_tensor_wrapper_t(lhs).is_similar(
+                    logical_tensor_wrapper_t(rhs));
+}
+} // namespace
+
 key_t::key_t(size_t partition_id, engine_kind_t engine_kind,
         const std::vector<std::shared_ptr<op_t>> &ops,
         const std::vector<const logical_tensor_t *> &ins,
@@ -43,13 +57,17 @@ key_t::key_t(size_t partition_id, engine_kind_t engine_kind,
     for (auto &out : outs) {
         outs_.emplace_back(*out);
     }
+    structure_ = get_partition_structure(ops_, ins_, outs_);
 }
 
 key_t::key_t(const partition_t *partition,
         const std::vector<const logical_tensor_t *> &ins,
         const std::vector<const logical_tensor_t *> &outs)
     : key_t(partition->id(), partition->get_engine_kind(), partition->get_ops(),
-            ins, outs) {}
+            ins, outs) {
+    fpmath_mode_ = partition->get_fpmath_mode();
+    inter_op_parallel_ = partition->get_inter_op_parallel();
+}
 
 bool key_t::operator==(const key_t &rhs) const {
     if (this == &rhs) return true;
@@ -62,36 +80,26 @@ bool key_t::operator==(const key_t &rhs) const {
     const size_t rhs_num_outs = rhs.outs_.size();
 
     bool ret = true && lhs_num_ops == rhs_num_ops && lhs_num_ins == rhs_num_ins
-            && lhs_num_outs == rhs_num_outs
-            && partition_id_ == rhs.partition_id_ && nthread_ == rhs.nthread_
-            && engine_kind_ == rhs.engine_kind_;
+            && lhs_num_outs == rhs_num_outs && nthread_ == rhs.nthread_
+            && engine_kind_ == rhs.engine_kind_
+            && fpmath_mode_ == rhs.fpmath_mode_
+            && inter_op_parallel_ == rhs.inter_op_parallel_
+            && structure_ == rhs.structure_;
     if (!ret) return false;
 
+    // The ops, inputs and outputs are matched by their positions, which are
+    // also how the topology is encoded
     for (size_t i = 0; i < lhs_num_ops; ++i) {
-        const op_t *op = ops_[i];
-        if (std::find_if(rhs.ops_.begin(), rhs.ops_.end(),
-                    [op](const op_t *rhs_op) { return *op == *rhs_op; })
-                == rhs.ops_.end())
-            return false;
+        if (!is_op_structurally_equal(*ops_[i], *rhs.ops_[i])) return false;
     }
 
     for (size_t i = 0; i < lhs_num_ins; ++i) {
-        const logical_tensor_wrapper_t lhs_lt {ins_[i]};
-        if (std::find_if(rhs.ins_.begin(), rhs.ins_.end(),
-                    [&lhs_lt](const logical_tensor_t &rhs_lt) {
-                        return logical_tensor_wrapper_t(rhs_lt) == lhs_lt;
-                    })
-                == rhs.ins_.end())
+        if (!is_logical_tensor_structurally_equal(ins_[i], rhs.ins_[i]))
             return false;
     }
 
     for (size_t i = 0; i < lhs_num_outs; ++i) {
-        const logical_tensor_wrapper_t lhs_lt {outs_[i]};
-        if (std::find_if(rhs.outs_.begin(), rhs.outs_.end(),
-                    [&lhs_lt](const logical_tensor_t &rhs_lt) {
-                        return logical_tensor_wrapper_t(rhs_lt) == lhs_lt;
-                    })
-                == rhs.outs_.end())
+        if (!is_logical_tensor_structurally_equal(outs_[i], rhs.outs_[i]))
             return false;
     }
 
@@ -100,9 +108,137 @@ bool key_t::operator==(const key_t &rhs) const {
 
 size_t get_op_hash(const op_t &op) {
     size_t seed = 0;
-    // TODO(zixuanwe): `id` might be sufficient to cover all attributes.
-    seed = hash_combine(seed, op.get_id());
     seed = hash_combine(seed, static_cast<size_t>(op.get_kind()));
+    seed = hash_combine(seed, get_op_attributes_hash(op));
+    return seed;
+}
+
+bool is_op_structurally_equal(const op_t &lhs, const op_t &rhs) {
+    if (lhs.get_kind() != rhs.get_kind()
+            || lhs.num_inputs() != rhs.num_inputs()
+            || lhs.num_outputs() != rhs.num_outputs()
+            || lhs.num_attributes() != rhs.num_attributes()
+            || !lhs.has_same_attr_values(rhs))
+        return false;
+
+    for (size_t i = 0; i < lhs.num_inputs(); i++) {
+        if (!is_logical_tensor_structurally_equal(
+                    lhs.get_input_value(i)->get_logical_tensor(),
+                    rhs.get_input_value(i)->get_logical_tensor()))
+            return false;
+    }
+    for (size_t i = 0; i < lhs.num_outputs(); i++) {
+        if (!is_logical_tensor_structurally_equal(
+                    lhs.get_output_value(i)->get_logical_tensor(),
+                    rhs.get_output_value(i)->get_logical_tensor()))
+            return false;
+    }
+    return true;
+}
+
+std::vector<size_t> get_partition_structure(const std::vector<op_t *> &ops,
+        const std::vector<logical_tensor_t> &ins,
+        const std::vector<logical_tensor_t> &outs) {
+    static const size_t not_found = std::numeric_limits<size_t>::max();
+
+    std::unordered_map<const op_t *, size_t> op_indices;
+    for (size_t i = 0; i < ops.size(); i++) {
+        op_indices[ops[i]] = i;
+    }
+    std::unordered_map<size_t, size_t> in_positions, out_positions;
+    for (size_t i = 0; i < ins.size(); i++) {
+        in_positions[ins[i].id] = i;
+    }
+    for (size_t i = 0; i < outs.size(); i++) {
+        out_positions[outs[i].id] = i;
+    }
+
+    std::vector<size_t> structure;
+    for (const op_t *op : ops) {
+        structure.emplace_back(op->num_inputs());
+        for (const auto &in : op->get_input_values()) {
+            if (in->has_producer()) {
+                auto pos = op_indices.find(&(in->get_producer()));
+                if (pos != op_indices.end()) {
+                    // produced inside the partition
+                    structure.emplace_back(0);
+                    structure.emplace_back(pos->second);
+                    structure.emplace_back(in->get_offset());
+                    continue;
+                }
+            }
+            auto pos = in_positions.find(in->get_logical_tensor().id);
+            structure.emplace_back(1);
+            structure.emplace_back(
+                    pos != in_positions.end() ? pos->second : not_found);
+        }
+
+        structure.emplace_back(op->num_outputs());
+        for (const auto &out : op->get_output_values()) {
+            auto pos = out_positions.find(out->get_logical_tensor().id);
+            structure.emplace_back(
+                    pos != out_positions.end() ? pos->second : not_found);
+        }
+    }
+    return structure;
+}
+
+size_t get_logical_tensor_structural_hash(const logical_tensor_t &lt) {
+    logical_tensor_t tmp = lt;
+    tmp.id = 0;
+    size_t seed = logical_tensor_wrapper_t(tmp).hash();
+    seed = hash_combine(seed, static_cast<size_t>(lt.property));
+    return seed;
+}
+
+size_t get_attribute_value_hash(const utils::attribute_value_t &value) {
+    size_t seed = 0;
+    seed = hash_combine(seed, static_cast<size_t>(value.get_kind()));
+    switch (value.get_kind()) {
+        case attribute_kind::i:
+            seed = hash_combine(seed, value.get<int64_t>());
+            break;
+        case attribute_kind::is: {
+            const auto &v = value.get<std::vector<int64_t>>();
+            seed = get_array_hash(seed, v.data(), v.size());
+            break;
+        }
+        case attribute_kind::f:
+            seed = hash_combine(seed, float2int(value.get<float>()));
+            break;
+        case attribute_kind::fs: {
+            const auto &v = value.get<std::vector<float>>();
+            seed = get_array_hash(seed, v.data(), v.size());
+            break;
+        }
+        case attribute_kind::s:
+            seed = hash_combine(seed, value.get<std::string>());
+            break;
+        case attribute_kind::b:
+            seed = hash_combine(seed, value.get<bool>());
+            break;
+        default: assertm(false, "unknown attribute kind");
+    }
+    return seed;
+}
+
+size_t get_op_attributes_hash(
+        const op_t &op, const std::unordered_set<op_attr_t> &skipped) {
+    // sort the attributes by name to get a stable hash
+    std::vector<op_attr_t> names;
+    names.reserve(op.num_attributes());
+    for (const auto &attr : op.get_attributes()) {
+        if (skipped.count(attr.first)) continue;
+        names.emplace_back(attr.first);
+    }
+    std::sort(names.begin(), names.end());
+
+    size_t seed = 0;
+    for (const auto &name : names) {
+        seed = hash_combine(seed, static_cast<size_t>(name));
+        seed = hash_combine(seed,
+                get_attribute_value_hash(op.get_attributes().at(name)));
+    }
     return seed;
 }
 
@@ -58,15 +58,26 @@ struct key_t {
             const std::vector<const logical_tensor_t *> &ins,
             const std::vector<const logical_tensor_t *> &outs);
 
+    // The keys of structurally identical partitions are equal, regardless
+    // of the partition, op and logical tensor ids. So the repeated partitions
+    // in a model, or the partitions of the same model loaded twice, can share
+    // one compiled partition.
     bool operator==(const key_t &other) const;
     const std::thread::id &thread_id() const { return thread_id_; }
 
+    // The partition id is not a part of the key, it's only kept for
+    // debugging
     mutable size_t partition_id_;
     mutable std::vector<op_t *> ops_;
     mutable std::vector<logical_tensor_t> ins_;
     mutable std::vector<logical_tensor_t> outs_;
+    // The topology of the ops, see get_partition_structure()
+    mutable std::vector<size_t> structure_;
     int nthread_;
     engine_kind_t engine_kind_;
+    fpmath_mode_t fpmath_mode_ = fpmath_mode::strict;
+    // See partition_impl_t::get_inter_op_parallel()
+    int inter_op_parallel_ = -1;
 
 private:
     // Thread ID is not used as part of the key, it's only used to get
@@ -75,8 +86,35 @@ private:
     std::thread::id thread_id_;
 };
 
+// Get the hash of an op from its kind and attributes. The op id is not
+// included, so identical ops in different graphs have the same hash.
 size_t get_op_hash(const op_t &op);
 
+// Check if two ops have the same kind, attributes, and input and output
+// logical tensors except the ids
+bool is_op_structurally_equal(const op_t &lhs, const op_t &rhs);
+
+// Encode the topology of a partition into a sequence of integers which
+// doesn't depend on the op or logical tensor ids. For each op in @p ops, it
+// contains where each input comes from (the producer op index and output
+// offset for the values produced inside the partition, or the position in
+// @p ins for the partition inputs) and the position in @p outs of each
+// output.
+std::vector<size_t> get_partition_structure(const std::vector<op_t *> &ops,
+        const std::vector<logical_tensor_t> &ins,
+        const std::vector<logical_tensor_t> &outs);
+
+// Get the hash of a logical tensor except its id
+size_t get_logical_tensor_structural_hash(const logical_tensor_t &lt);
+
+// Get the hash of an attribute value according to its kind and content
+size_t get_attribute_value_hash(const utils::attribute_value_t &value);
+
+// Get the hash of all attributes of an op except the ones in @p skipped. The
+// result doesn't depend on the order in which the attributes were set.
+size_t get_op_attributes_hash(
+        const op_t &op, const std::unordered_set<op_attr_t> &skipped = {});
+
 template <typename T>
 size_t get_array_hash(size_t seed, const T *v, size_t size) {
     for (size_t i = 0; i < size; i++) {
@@ -143,18 +181,34 @@ struct hash<dnnl::impl::graph::partition_hashing::key_t> {
         using namespace dnnl::impl::graph::partition_hashing;
 
         size_t seed = 0;
-        // Compute hash for partition_id_, nthread_, engine_kind_
-        seed = dnnl::impl::hash_combine(seed, key.partition_id_);
+        // Compute hash for nthread_, engine_kind_, fpmath_mode_,
+        // inter_op_parallel_
         seed = dnnl::impl::hash_combine(seed, key.nthread_);
         seed = dnnl::impl::hash_combine(
                 seed, static_cast<size_t>(key.engine_kind_));
+        seed = dnnl::impl::hash_combine(
+                seed, static_cast<size_t>(key.fpmath_mode_));
+        seed = dnnl::impl::hash_combine(seed, key.inter_op_parallel_);
 
         // Combine hash for op_kinds & attributes with the computed hash
-        seed = get_array_hash(seed, key.ops_.data(), key.ops_.size());
-
-        // Combine hash for input and output ports with the computed hash
-        seed = get_array_hash(seed, key.ins_.data(), key.ins_.size());
-        seed = get_array_hash(seed, key.outs_.data(), key.outs_.size());
+        for (const op_t *op : key.ops_) {
+            seed = dnnl::impl::hash_combine(seed, get_op_hash(*op));
+        }
+
+        // Combine hash for the topology
+        seed = get_array_hash(
+                seed, key.structure_.data(), key.structure_.size());
+
+        // Combine hash for input and output ports with the computed hash,
+        // their ids are excluded
+        for (const auto &in : key.ins_) {
+            seed = dnnl::impl::hash_combine(
+                    seed, get_logical_tensor_structural_hash(in));
+        }
+        for (const auto &out : key.outs_) {
+            seed = dnnl::impl::hash_combine(
+                    seed, get_logical_tensor_structural_hash(out));
+        }
 
         return seed;
     }
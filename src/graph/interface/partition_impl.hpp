@@ -168,6 +168,26 @@ public:
             const std::vector<logical_tensor_t> &outputs,
             const engine_t *aengine) const = 0;
 
+    /// Create a compiled_partition_impl_t from a cache blob which is got from
+    /// compiled_partition_impl_t::get_cache_blob
+    /// @param compiled_partition The pointer of the compiled_partition_t
+    ///     whose pimpl will be initialized
+    /// @param cache_blob The cache blob
+    /// @param size The size of the cache blob
+    /// @param aengine The engine that the cache blob is compiled for
+    /// @return The status code. Backends which don't support cache blob
+    ///     return status::unimplemented, and status::invalid_arguments is
+    ///     returned for blobs which can't be used by the partition
+    virtual status_t compile_from_cache_blob(
+            compiled_partition_t *compiled_partition, const uint8_t *cache_blob,
+            size_t size, const engine_t *aengine) const {
+        UNUSED(compiled_partition);
+        UNUSED(cache_blob);
+        UNUSED(size);
+        UNUSED(aengine);
+        return status::unimplemented;
+    }
+
     /// get partition_impl id
     size_t id() const { return id_; }
 
@@ -184,6 +204,15 @@ public:
         return can_use_blocked_layout_;
     }
 
+    /// Used to set if the independent ops of a partition can be executed
+    /// concurrently
+    void set_inter_op_parallel(bool flag) { inter_op_parallel_ = flag ? 1 : 0; }
+
+    /// Returns 1 if the independent ops of a partition can be executed
+    /// concurrently, 0 if not, and -1 if it's not set by users and decided
+    /// by the backend
+    int get_inter_op_parallel() const { return inter_op_parallel_; }
+
 protected:
     // Engine kind
     engine_kind_t engine_kind_;
@@ -244,6 +273,8 @@ protected:
 
     bool can_use_blocked_layout_;
 
+    int inter_op_parallel_ = -1;
+
 private:
     DNNL_DISALLOW_COPY_AND_ASSIGN(partition_impl_t);
 };
@@ -315,6 +346,21 @@ public:
 
     std::vector<logical_tensor_t> &get_mutable_outputs() { return outputs_; }
 
+    std::vector<inplace_pair_t> &get_mutable_inplace_pairs() {
+        return inplace_pairs_;
+    }
+
+    /// Create a compiled_partition_impl_t which shares the compiled kernel
+    /// with this one. It's used to reuse the compiled partition for a
+    /// structurally identical partition, the caller is responsible for
+    /// changing the logical tensor ids of the returned one.
+    /// @return The new compiled_partition_impl_t, or nullptr if the backend
+    ///     doesn't support sharing its compiled kernels
+    virtual std::shared_ptr<compiled_partition_impl_t>
+    clone_with_shared_kernel() const {
+        return nullptr;
+    }
+
     /// Execute a compiled_partition with given inputs/outputs tensors
     /// @param astream For different device target, stream represent
     ///     different runtime object, which can be used to execute the
@@ -343,6 +389,27 @@ public:
             const std::vector<tensor_t> &outputs)
             = 0;
 
+    /// Serialize the compiled partition into a cache blob, which can be
+    /// used to create the same compiled partition without compilation
+    /// @param blob The cache blob
+    /// @return The status code. Will be status::unimplemented if the backend
+    ///     doesn't support cache blob
+    virtual status_t get_cache_blob(std::vector<uint8_t> &blob) const {
+        UNUSED(blob);
+        return status::unimplemented;
+    }
+
+    /// Invalidate the cached constant data computed from a constant input,
+    /// so that it's recomputed in the next execution. It should be called
+    /// after the content of the input buffer is changed in place.
+    /// @param tensor_id The id of the input logical tensor
+    /// @return The status code. Will be status::unimplemented if the backend
+    ///     doesn't support it
+    virtual status_t invalidate_constant_input(size_t tensor_id) {
+        UNUSED(tensor_id);
+        return status::unimplemented;
+    }
+
 #ifdef DNNL_WITH_SYCL
     virtual status_t execute_sycl(const stream_t *astream,
             const std::vector<tensor_t> &inputs,
@@ -20,6 +20,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "graph/interface/graph.hpp"
 #include "graph/interface/op_schema.hpp"
 #include "graph/utils/pm/nested_matcher.hpp"
 
@@ -474,6 +475,18 @@ bool match_pattern(op_t *first_op, const std::shared_ptr<pb_graph_t> &pattern,
     return true;
 }
 
+std::vector<op_t *> get_pattern_seeds(
+        graph_t &agraph, const std::shared_ptr<pb_graph_t> &pattern) {
+    std::vector<op_kind_t> root_kinds;
+    std::vector<op_t *> seeds = pattern->get_root_op_kinds(root_kinds)
+            ? agraph.get_topo_ordered_ops(root_kinds)
+            : agraph.get_topo_ordered_ops();
+    seeds.erase(std::remove_if(seeds.begin(), seeds.end(),
+                        [](op_t *op) { return op->get_partition() != nullptr; }),
+            seeds.end());
+    return seeds;
+}
+
 inline std::vector<op_t *> reorder_matched_list(
         const std::unordered_map<op_t *, pb_op_t *> &matched_op_map) {
     // split ops and pb_op_ts
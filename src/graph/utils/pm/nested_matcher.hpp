@@ -196,6 +196,15 @@ bool match_repetition(const binding_t &b, match_context_t *context,
 bool match_pattern(op_t *first_op, const std::shared_ptr<pb_graph_t> &pattern,
         std::vector<op_t *> &fusion_ops);
 
+//
+// Get the ops of a graph from which matching the pattern may succeed, in
+// topological order. Only the ops of the kinds which can be bound to the
+// first node of the pattern are returned, and the ops already claimed by a
+// partition are skipped.
+//
+std::vector<op_t *> get_pattern_seeds(
+        graph_t &agraph, const std::shared_ptr<pb_graph_t> &pattern);
+
 //
 // reorder the matched ops to make sure they are in topology order
 //
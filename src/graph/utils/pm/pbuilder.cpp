@@ -226,6 +226,35 @@ std::vector<pb_node_t *> pb_graph_t::get_nodes() {
     return retval;
 }
 
+bool pb_graph_t::get_root_op_kinds(
+        std::vector<dnnl::impl::graph::op_kind_t> &kinds) {
+    if (nodes_.empty()) return false;
+    pb_node_t *root = nodes_.front().get();
+    switch (root->get_node_kind()) {
+        case pb_node_kind::PB_NODE_KIND_OP: {
+            const auto &op_kinds
+                    = dynamic_cast<pb_op_t *>(root)->get_op_kinds();
+            if (op_kinds.empty()) return false;
+            kinds.insert(kinds.end(), op_kinds.begin(), op_kinds.end());
+            return true;
+        }
+        case pb_node_kind::PB_NODE_KIND_ALTERNATION: {
+            auto alt = dynamic_cast<alternation_t *>(root);
+            for (pb_graph_t *alt_graph : alt->get_alternatives()) {
+                if (!alt_graph->get_root_op_kinds(kinds)) return false;
+            }
+            return true;
+        }
+        case pb_node_kind::PB_NODE_KIND_REPETITION: {
+            // a zero trip repetition forwards the first op to the next node
+            auto rep = dynamic_cast<repetition_t *>(root);
+            if (rep->get_min_rep() == 0) return false;
+            return rep->get_body()->get_root_op_kinds(kinds);
+        }
+        default: return false;
+    }
+}
+
 pb_graph_t::pb_graph_t(std::string name) {
     debug_string_ = std::move(name);
 }
@@ -247,24 +276,29 @@ pb_op_t *pb_graph_t::append_op(
 
 pb_op_t *pb_graph_t::append_op(dnnl::impl::graph::op_kind_t p_kind,
         const in_edges_t &p_in_edges, std::string name) {
-    return append_op(kind(p_kind), p_in_edges, std::move(name));
+    pb_op_t *p_op = append_op(kind(p_kind), p_in_edges, std::move(name));
+    if (p_kind != op_kind::Wildcard) p_op->op_kinds_ = {p_kind};
+    return p_op;
 }
 
 pb_op_t *pb_graph_t::append_op(
         dnnl::impl::graph::op_kind_t p_kind, std::string name) {
-    return append_op(kind(p_kind), {}, std::move(name));
+    return append_op(p_kind, {}, std::move(name));
 }
 
 pb_op_t *pb_graph_t::append_alternation(
         const std::vector<dnnl::impl::graph::op_kind_t> &p_kind,
         const in_edges_t &p_in_edges, std::string name) {
-    return append_op(one_of_kind(p_kind), p_in_edges, std::move(name));
+    pb_op_t *p_op
+            = append_op(one_of_kind(p_kind), p_in_edges, std::move(name));
+    p_op->op_kinds_ = p_kind;
+    return p_op;
 }
 
 pb_op_t *pb_graph_t::append_alternation(
         const std::vector<dnnl::impl::graph::op_kind_t> &p_kind,
         std::string name) {
-    return append_op(one_of_kind(p_kind), {}, std::move(name));
+    return append_alternation(p_kind, {}, std::move(name));
 }
 
 alternation_t *pb_graph_t::append_alternation(
@@ -134,10 +134,18 @@ public:
         return accept_internal_inputs_;
     };
 
+    // The op kinds this node can be bound to. It is empty if the node may be
+    // bound to an op of any kind, eg. a wildcard or a custom decision function
+    const std::vector<dnnl::impl::graph::op_kind_t> &get_op_kinds() const {
+        return op_kinds_;
+    }
+
 protected:
     friend class pb_graph_t;
     pb_op_t(const decision_function &p_fn);
 
+    std::vector<dnnl::impl::graph::op_kind_t> op_kinds_;
+
     /*
         The outputs could link to ops outside the pattern.
         Explained by the following example.
@@ -317,6 +325,11 @@ public:
 
     std::vector<pb_node_t *> get_nodes();
 
+    // Get the kinds of the ops which can be bound to the first node of the
+    // pattern, where the matching starts. Returns false if the first node may
+    // be bound to an op of any kind.
+    bool get_root_op_kinds(std::vector<dnnl::impl::graph::op_kind_t> &kinds);
+
 protected:
     pb_op_t *append_op(const decision_function &type_checker,
             const in_edges_t &p_in_edges, std::string name = "");
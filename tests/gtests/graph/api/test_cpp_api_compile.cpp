@@ -14,11 +14,30 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <algorithm>
+
 #include "oneapi/dnnl/dnnl_graph.hpp"
 
 #include "test_api_common.hpp"
 #include "gtest/gtest.h"
 
+namespace dnnl {
+namespace impl {
+namespace graph {
+// Undocumented API for testing, defined in the library
+dnnl_status_t DNNL_API get_compiled_partition_cache_size(int *size);
+} // namespace graph
+} // namespace impl
+} // namespace dnnl
+
+namespace {
+int get_compiled_partition_cache_size() {
+    int size = 0;
+    dnnl::impl::graph::get_compiled_partition_cache_size(&size);
+    return size;
+}
+} // namespace
+
 struct test_conv_params_t {
     std::vector<int64_t> input_dims;
     std::vector<int64_t> ref_dst_dims;
@@ -941,3 +960,298 @@ TEST_P(test_bn_compile_t, Test_BatchNorm_Compile) {
 
 INSTANTIATE_TEST_SUITE_P(Test_BatchNorm_Compile, test_bn_compile_t,
         ::testing::Values(bn_params_t {{1, 3, 3, 10}, 0.001f, "NXC"}));
+
+TEST(APICompile, CompileAsync) {
+    using namespace dnnl::graph;
+    dnnl::engine::kind engine_kind
+            = static_cast<dnnl::engine::kind>(api_test_engine_kind);
+    dnnl::engine eng = cpp_api_test_dnnl_engine_create(engine_kind);
+
+    const std::vector<int64_t> unknown_dims {DNNL_GRAPH_UNKNOWN_DIM,
+            DNNL_GRAPH_UNKNOWN_DIM, DNNL_GRAPH_UNKNOWN_DIM,
+            DNNL_GRAPH_UNKNOWN_DIM};
+    logical_tensor src {0, logical_tensor::data_type::f32, unknown_dims,
+            logical_tensor::layout_type::undef};
+    logical_tensor dst {1, logical_tensor::data_type::f32, unknown_dims,
+            logical_tensor::layout_type::undef};
+    op relu_op(0, op::kind::ReLU, {src}, {dst}, "relu");
+
+    graph g(engine_kind);
+    g.add_op(relu_op);
+    g.finalize();
+    auto partitions = g.get_partitions();
+    ASSERT_EQ(partitions.size(), 1U);
+
+    // compile several shapes concurrently
+    std::vector<std::vector<int64_t>> shapes {
+            {1, 16, 8, 8}, {2, 16, 8, 8}, {4, 32, 4, 4}};
+    std::vector<std::vector<logical_tensor>> inputs, outputs;
+    std::vector<compile_task> tasks;
+    for (const auto &shape : shapes) {
+        inputs.push_back({logical_tensor {0, logical_tensor::data_type::f32,
+                shape, logical_tensor::layout_type::strided}});
+        outputs.push_back({logical_tensor {1, logical_tensor::data_type::f32,
+                unknown_dims, logical_tensor::layout_type::strided}});
+        tasks.emplace_back(partitions[0].compile_async(
+                inputs.back(), outputs.back(), eng));
+    }
+
+    for (size_t i = 0; i < shapes.size(); i++) {
+        compiled_partition cp = tasks[i].wait();
+        ASSERT_TRUE(tasks[i].is_ready());
+        ASSERT_EQ(cp.query_logical_tensor(1).get_dims(), shapes[i]);
+    }
+
+    // warm up then compile, the compilations should hit the cache
+    std::vector<partition> warmup_partitions(shapes.size(), partitions[0]);
+    ASSERT_NO_THROW(partition::warmup(warmup_partitions, inputs, outputs, eng));
+    for (size_t i = 0; i < shapes.size(); i++) {
+        compiled_partition cp
+                = partitions[0].compile(inputs[i], outputs[i], eng);
+        ASSERT_EQ(cp.query_logical_tensor(1).get_dims(), shapes[i]);
+    }
+
+    ASSERT_ANY_THROW(partition::warmup(warmup_partitions, inputs, {}, eng));
+}
+
+TEST(APICompile, WarmupCacheHit) {
+    using namespace dnnl::graph;
+    dnnl::engine::kind engine_kind
+            = static_cast<dnnl::engine::kind>(api_test_engine_kind);
+    dnnl::engine eng = cpp_api_test_dnnl_engine_create(engine_kind);
+
+    const int capacity = get_compiled_partition_cache_capacity();
+    SKIP_IF(capacity < 4, "the compiled partition cache is too small.");
+
+    logical_tensor src {0, logical_tensor::data_type::f32,
+            {DNNL_GRAPH_UNKNOWN_DIM, 8}, logical_tensor::layout_type::undef};
+    logical_tensor dst {1, logical_tensor::data_type::f32,
+            {DNNL_GRAPH_UNKNOWN_DIM, 8}, logical_tensor::layout_type::undef};
+    op relu_op(0, op::kind::ReLU, {src}, {dst}, "relu");
+
+    graph g(engine_kind);
+    g.add_op(relu_op);
+    g.finalize();
+    auto partitions = g.get_partitions();
+    ASSERT_EQ(partitions.size(), 1U);
+
+    std::vector<std::vector<logical_tensor>> inputs, outputs;
+    for (int64_t mb : {1, 2, 3}) {
+        inputs.push_back({logical_tensor {0, logical_tensor::data_type::f32,
+                {mb, 8}, logical_tensor::layout_type::strided}});
+        outputs.push_back({logical_tensor {1, logical_tensor::data_type::f32,
+                {mb, 8}, logical_tensor::layout_type::strided}});
+    }
+    std::vector<partition> warmup_partitions(inputs.size(), partitions[0]);
+
+    // flush the cache, so that only the warm up can add the entries
+    set_compiled_partition_cache_capacity(0);
+    set_compiled_partition_cache_capacity(capacity);
+    ASSERT_EQ(get_compiled_partition_cache_size(), 0);
+
+    partition::warmup(warmup_partitions, inputs, outputs, eng);
+    ASSERT_EQ(get_compiled_partition_cache_size(), 3);
+
+    // the compilations are cache hits and add no entry
+    for (size_t i = 0; i < inputs.size(); i++) {
+        compiled_partition cp
+                = partitions[0].compile(inputs[i], outputs[i], eng);
+        ASSERT_EQ(cp.query_logical_tensor(1).get_dims(),
+                inputs[i][0].get_dims());
+    }
+    ASSERT_EQ(get_compiled_partition_cache_size(), 3);
+
+    // a compilation missing the cache adds an entry
+    logical_tensor new_src {0, logical_tensor::data_type::f32, {4, 8},
+            logical_tensor::layout_type::strided};
+    logical_tensor new_dst {1, logical_tensor::data_type::f32, {4, 8},
+            logical_tensor::layout_type::strided};
+    partitions[0].compile({new_src}, {new_dst}, eng);
+    ASSERT_EQ(get_compiled_partition_cache_size(), 4);
+}
+
+TEST(APICompile, CompileFromCacheBlob) {
+    using namespace dnnl::graph;
+    dnnl::engine::kind engine_kind
+            = static_cast<dnnl::engine::kind>(api_test_engine_kind);
+    dnnl::engine eng = cpp_api_test_dnnl_engine_create(engine_kind);
+
+    const std::vector<int64_t> dims {2, 16, 8, 8};
+    logical_tensor src {0, logical_tensor::data_type::f32, dims,
+            logical_tensor::layout_type::strided};
+    logical_tensor dst {1, logical_tensor::data_type::f32,
+            DNNL_GRAPH_UNKNOWN_NDIMS, logical_tensor::layout_type::any};
+    op relu_op(0, op::kind::ReLU, {src}, {dst}, "relu");
+
+    graph g(engine_kind);
+    g.add_op(relu_op);
+    g.finalize();
+    auto partitions = g.get_partitions();
+    ASSERT_EQ(partitions.size(), 1U);
+
+    compiled_partition cp = partitions[0].compile({src}, {dst}, eng);
+    std::vector<uint8_t> blob = cp.get_cache_blob();
+    ASSERT_FALSE(blob.empty());
+
+    compiled_partition loaded
+            = partitions[0].compile_from_cache_blob(blob, eng);
+    logical_tensor ref_dst = cp.query_logical_tensor(1);
+    logical_tensor loaded_dst = loaded.query_logical_tensor(1);
+    ASSERT_EQ(loaded_dst.get_dims(), ref_dst.get_dims());
+    ASSERT_EQ(loaded_dst.get_layout_type(), ref_dst.get_layout_type());
+    ASSERT_EQ(loaded.get_inplace_ports(), cp.get_inplace_ports());
+
+    // truncated or modified blobs are rejected
+    std::vector<uint8_t> truncated(blob.begin(), blob.end() - 1);
+    ASSERT_ANY_THROW(partitions[0].compile_from_cache_blob(truncated, eng));
+    std::vector<uint8_t> modified = blob;
+    modified[0] ^= 0xff;
+    ASSERT_ANY_THROW(partitions[0].compile_from_cache_blob(modified, eng));
+}
+
+TEST(APICompile, InvalidateConstantInput) {
+    using namespace dnnl::graph;
+    SKIP_IF(api_test_engine_kind == dnnl_gpu,
+            "skip as the test uses host buffers.");
+    dnnl::engine::kind engine_kind
+            = static_cast<dnnl::engine::kind>(api_test_engine_kind);
+    dnnl::engine eng = cpp_api_test_dnnl_engine_create(engine_kind);
+    dnnl::stream strm {eng};
+
+    logical_tensor src {0, logical_tensor::data_type::f32, {1, 2},
+            logical_tensor::layout_type::strided};
+    logical_tensor wei {1, logical_tensor::data_type::f32, {2, 2},
+            logical_tensor::layout_type::strided,
+            logical_tensor::property_type::constant};
+    logical_tensor dst {2, logical_tensor::data_type::f32, {1, 2},
+            logical_tensor::layout_type::strided};
+    op matmul_op(0, op::kind::MatMul, {src, wei}, {dst}, "matmul");
+
+    graph g(engine_kind);
+    g.add_op(matmul_op);
+    g.finalize();
+    auto partitions = g.get_partitions();
+    ASSERT_EQ(partitions.size(), 1U);
+    compiled_partition cp = partitions[0].compile({src, wei}, {dst}, eng);
+
+    std::vector<float> src_data {1.f, 1.f};
+    std::vector<float> wei_data {1.f, 2.f, 3.f, 4.f};
+    std::vector<float> dst_data(2, 0.f);
+    tensor src_ts {src, eng, src_data.data()};
+    tensor wei_ts {wei, eng, wei_data.data()};
+    tensor dst_ts {dst, eng, dst_data.data()};
+
+    cp.execute(strm, {src_ts, wei_ts}, {dst_ts});
+    strm.wait();
+    ASSERT_FLOAT_EQ(dst_data[0], 4.f);
+    ASSERT_FLOAT_EQ(dst_data[1], 6.f);
+
+    // update the constant weight in place
+    std::fill(wei_data.begin(), wei_data.end(), 1.f);
+    cp.invalidate_constant_input(wei.get_id());
+    cp.execute(strm, {src_ts, wei_ts}, {dst_ts});
+    strm.wait();
+    ASSERT_FLOAT_EQ(dst_data[0], 2.f);
+    ASSERT_FLOAT_EQ(dst_data[1], 2.f);
+
+    // the logical tensor is not an input of the compiled partition
+    ASSERT_ANY_THROW(cp.invalidate_constant_input(dst.get_id()));
+}
+
+TEST(APICompile, CompileStructurallyIdenticalPartitions) {
+    using namespace dnnl::graph;
+    dnnl::engine::kind engine_kind
+            = static_cast<dnnl::engine::kind>(api_test_engine_kind);
+    dnnl::engine eng = cpp_api_test_dnnl_engine_create(engine_kind);
+
+    // The partitions of the two graphs only differ in the ids
+    std::vector<compiled_partition> cps;
+    for (size_t base : {100, 200}) {
+        logical_tensor src {base, logical_tensor::data_type::f32,
+                {2, 16, 8, 8}, logical_tensor::layout_type::strided};
+        logical_tensor dst {base + 1, logical_tensor::data_type::f32,
+                {2, 16, 8, 8}, logical_tensor::layout_type::strided};
+        op relu_op(base, op::kind::ReLU, {src}, {dst}, "relu");
+
+        graph g(engine_kind);
+        g.add_op(relu_op);
+        g.finalize();
+        auto partitions = g.get_partitions();
+        ASSERT_EQ(partitions.size(), 1U);
+        cps.emplace_back(partitions[0].compile({src}, {dst}, eng));
+
+        // the compiled partition uses the ids of its own partition
+        logical_tensor queried = cps.back().query_logical_tensor(base + 1);
+        ASSERT_EQ(queried.get_id(), base + 1);
+        ASSERT_EQ(queried.get_dims(), dst.get_dims());
+        for (const auto &pair : cps.back().get_inplace_ports()) {
+            ASSERT_EQ(pair.first, base);
+            ASSERT_EQ(pair.second, base + 1);
+        }
+    }
+}
+
+TEST(APICompile, InvalidateConstantInputOfSharedKernel) {
+    using namespace dnnl::graph;
+    SKIP_IF(api_test_engine_kind == dnnl_gpu,
+            "skip as the test uses host buffers.");
+    dnnl::engine::kind engine_kind
+            = static_cast<dnnl::engine::kind>(api_test_engine_kind);
+    dnnl::engine eng = cpp_api_test_dnnl_engine_create(engine_kind);
+    dnnl::stream strm {eng};
+
+    // The partitions of the two graphs only differ in the ids, so they may
+    // share the compiled kernel
+    std::vector<compiled_partition> cps;
+    std::vector<logical_tensor> srcs, weis, dsts;
+    for (size_t base : {300, 400}) {
+        logical_tensor src {base, logical_tensor::data_type::f32, {1, 2},
+                logical_tensor::layout_type::strided};
+        logical_tensor wei {base + 1, logical_tensor::data_type::f32, {2, 2},
+                logical_tensor::layout_type::strided,
+                logical_tensor::property_type::constant};
+        logical_tensor dst {base + 2, logical_tensor::data_type::f32, {1, 2},
+                logical_tensor::layout_type::strided};
+        op matmul_op(base, op::kind::MatMul, {src, wei}, {dst}, "matmul");
+
+        graph g(engine_kind);
+        g.add_op(matmul_op);
+        g.finalize();
+        auto partitions = g.get_partitions();
+        ASSERT_EQ(partitions.size(), 1U);
+        cps.emplace_back(partitions[0].compile({src, wei}, {dst}, eng));
+        srcs.emplace_back(src);
+        weis.emplace_back(wei);
+        dsts.emplace_back(dst);
+    }
+
+    std::vector<float> src_data {1.f, 1.f};
+    std::vector<std::vector<float>> wei_data {
+            {1.f, 2.f, 3.f, 4.f}, {1.f, 2.f, 3.f, 4.f}};
+    std::vector<std::vector<float>> dst_data(2, std::vector<float>(2, 0.f));
+    auto run = [&](size_t i) {
+        tensor src_ts {srcs[i], eng, src_data.data()};
+        tensor wei_ts {weis[i], eng, wei_data[i].data()};
+        tensor dst_ts {dsts[i], eng, dst_data[i].data()};
+        cps[i].execute(strm, {src_ts, wei_ts}, {dst_ts});
+        strm.wait();
+    };
+
+    run(0);
+    run(1);
+    for (size_t i = 0; i < 2; i++) {
+        ASSERT_FLOAT_EQ(dst_data[i][0], 4.f);
+        ASSERT_FLOAT_EQ(dst_data[i][1], 6.f);
+    }
+
+    // Invalidate the weight of the first compiled partition only. Executing
+    // the second one in between must not drop the invalidation.
+    std::fill(wei_data[0].begin(), wei_data[0].end(), 1.f);
+    cps[0].invalidate_constant_input(weis[0].get_id());
+    run(1);
+    run(0);
+    ASSERT_FLOAT_EQ(dst_data[0][0], 2.f);
+    ASSERT_FLOAT_EQ(dst_data[0][1], 2.f);
+    ASSERT_FLOAT_EQ(dst_data[1][0], 4.f);
+    ASSERT_FLOAT_EQ(dst_data[1][1], 6.f);
+}
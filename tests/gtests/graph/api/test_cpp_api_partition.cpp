@@ -308,6 +308,27 @@ TEST(APIPartition, CompileWildcardPartition) {
     EXPECT_THROW(part.compile({lt1}, {lt2}, eng), dnnl::error);
 }
 
+TEST(APIPartition, SetInterOpParallel) {
+    using namespace dnnl::graph;
+    dnnl::engine::kind engine_kind
+            = static_cast<dnnl::engine::kind>(api_test_engine_kind);
+    dnnl::engine eng = cpp_api_test_dnnl_engine_create(engine_kind);
+
+    logical_tensor lt1 {0, logical_tensor::data_type::f32, {8, 16},
+            logical_tensor::layout_type::strided};
+    logical_tensor lt2 {1, logical_tensor::data_type::f32, {8, 16},
+            logical_tensor::layout_type::strided};
+    op relu(0, op::kind::ReLU, {lt1}, {lt2}, "relu");
+    partition part {relu, engine_kind};
+
+    ASSERT_NO_THROW(part.set_inter_op_parallel(true));
+    ASSERT_NO_THROW(part.compile({lt1}, {lt2}, eng));
+    ASSERT_NO_THROW(part.set_inter_op_parallel(false));
+    ASSERT_NO_THROW(part.compile({lt1}, {lt2}, eng));
+    ASSERT_EQ(dnnl_graph_partition_set_inter_op_parallel(nullptr, 1),
+            dnnl_invalid_arguments);
+}
+
 TEST(APIPartitionCache, GetSetCapacity) {
     ASSERT_EQ(dnnl_graph_set_compiled_partition_cache_capacity(-1),
             dnnl_invalid_arguments);
@@ -0,0 +1,46 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GRAPH_UNIT_BACKEND_AUTOGRAPH_AUTOGRAPH_TEST_COMMON_HPP
+#define GRAPH_UNIT_BACKEND_AUTOGRAPH_AUTOGRAPH_TEST_COMMON_HPP
+
+#include <algorithm>
+#include <string>
+
+#include "backend/autograph/autograph_backend.hpp"
+
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+
+namespace autograph_test {
+
+static inline dnnl::impl::graph::pass::pass_base_ptr get_pass(
+        const std::string &pass_name) {
+    auto &backend_ptr = dnnl::impl::graph::autograph_impl::autograph_backend::
+            get_singleton();
+    auto pm = dnnl::impl::graph::pass::pass_manager_t(
+            backend_ptr.get_pass_registry());
+    auto &passes = pm.get_passes();
+    auto find = std::find_if(passes.begin(), passes.end(),
+            [&pass_name](const dnnl::impl::graph::pass::pass_base_ptr &p)
+                    -> bool { return p->get_pass_name() == pass_name; });
+
+    return *find;
+}
+
+} // namespace autograph_test
+
+#endif
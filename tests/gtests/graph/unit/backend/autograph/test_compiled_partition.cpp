@@ -0,0 +1,136 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "interface/tensor.hpp"
+
+#include "backend/autograph/autograph_partition_impl.hpp"
+
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+
+namespace graph = dnnl::impl::graph;
+namespace autograph_impl = graph::autograph_impl;
+namespace utils = dnnl::graph::tests::unit::utils;
+
+namespace {
+
+// A kernel recording the invalidated inputs together with the data handle of
+// the input given to the execution applying them
+struct recording_kernel_t : public autograph_impl::kernel_base_t {
+    std::vector<std::pair<size_t, void *>> invalidated_;
+    size_t num_executions_ = 0;
+
+    graph::status_t compile_impl(
+            const autograph_impl::dnnl_partition_impl_t *part,
+            const graph::engine_t *aengine,
+            const std::vector<graph::logical_tensor_t> &inputs,
+            const std::vector<graph::logical_tensor_t> &outputs) override {
+        UNUSED(part);
+        UNUSED(aengine);
+        UNUSED(inputs);
+        UNUSED(outputs);
+        return graph::status::success;
+    }
+
+    graph::status_t execute_impl(const graph::stream_t *astream,
+            const std::vector<graph::tensor_t> &inputs,
+            const std::vector<graph::tensor_t> &outputs) override {
+        UNUSED(astream);
+        UNUSED(inputs);
+        UNUSED(outputs);
+        num_executions_++;
+        return graph::status::success;
+    }
+
+#ifdef DNNL_WITH_SYCL
+    graph::status_t sycl_execute_impl(const graph::stream_t *astream,
+            const std::vector<graph::tensor_t> &inputs,
+            const std::vector<graph::tensor_t> &outputs,
+            const std::vector<::sycl::event> &sycl_deps,
+            ::sycl::event *sycl_event) override {
+        UNUSED(sycl_deps);
+        UNUSED(sycl_event);
+        return execute_impl(astream, inputs, outputs);
+    }
+#endif
+
+    graph::status_t invalidate_constant_input_impl(size_t input_index,
+            const std::vector<graph::tensor_t> &inputs) override {
+        invalidated_.emplace_back(
+                input_index, inputs[input_index].get_data_handle());
+        return graph::status::success;
+    }
+};
+
+} // namespace
+
+TEST(AutographCompiledPartition, InvalidateSharedKernel) {
+    graph::engine_t &engine = *get_engine();
+    graph::stream_t *strm = get_stream();
+
+    auto make_lts = [](size_t base) {
+        return std::vector<graph::logical_tensor_t> {
+                utils::logical_tensor_init(base, {2}, graph::data_type::f32),
+                utils::logical_tensor_init(
+                        base + 1, {2}, graph::data_type::f32),
+                utils::logical_tensor_init(
+                        base + 2, {2}, graph::data_type::f32)};
+    };
+    auto lts0 = make_lts(0);
+    auto lts1 = make_lts(10);
+
+    auto kernel = std::make_shared<recording_kernel_t>();
+    autograph_impl::dnnl_compiled_partition_impl_t cp0(
+            engine, {lts0[0], lts0[1]}, {lts0[2]}, kernel);
+    autograph_impl::dnnl_compiled_partition_impl_t cp1(
+            engine, {lts1[0], lts1[1]}, {lts1[2]}, kernel);
+    ASSERT_EQ(kernel->get_num_users(), 2U);
+
+    std::vector<float> src(2), wei0(2), wei1(2), dst(2);
+    std::vector<graph::tensor_t> ins0 {{lts0[0], &engine, src.data()},
+            {lts0[1], &engine, wei0.data()}};
+    std::vector<graph::tensor_t> ins1 {{lts1[0], &engine, src.data()},
+            {lts1[1], &engine, wei1.data()}};
+    std::vector<graph::tensor_t> outs0 {{lts0[2], &engine, dst.data()}};
+    std::vector<graph::tensor_t> outs1 {{lts1[2], &engine, dst.data()}};
+
+    // The ids are the ones of the invalidating compiled partition
+    ASSERT_EQ(cp0.invalidate_constant_input(lts1[1].id),
+            graph::status::invalid_arguments);
+    ASSERT_EQ(cp0.invalidate_constant_input(lts0[1].id),
+            graph::status::success);
+
+    // The execution of another compiled partition sharing the kernel doesn't
+    // consume the invalidation
+    ASSERT_EQ(cp1.execute(strm, ins1, outs1), graph::status::success);
+    ASSERT_TRUE(kernel->invalidated_.empty());
+
+    // The invalidation is applied with the inputs of the compiled partition
+    ASSERT_EQ(cp0.execute(strm, ins0, outs0), graph::status::success);
+    ASSERT_EQ(kernel->invalidated_.size(), 1U);
+    ASSERT_EQ(kernel->invalidated_[0].first, 1U);
+    ASSERT_EQ(kernel->invalidated_[0].second, wei0.data());
+
+    // and only once
+    ASSERT_EQ(cp0.execute(strm, ins0, outs0), graph::status::success);
+    ASSERT_EQ(kernel->invalidated_.size(), 1U);
+    ASSERT_EQ(kernel->num_executions_, 3U);
+}
@@ -0,0 +1,137 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "backend/autograph/constant_cache.hpp"
+
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+
+namespace graph = dnnl::impl::graph;
+namespace autograph_impl = graph::autograph_impl;
+
+namespace {
+
+autograph_impl::constant_cache_t::value_t make_cached_value(size_t size) {
+    graph::engine_t &engine = *get_engine();
+    auto p_engine = autograph_impl::make_dnnl_engine(engine);
+    auto g_alloc
+            = static_cast<const graph::allocator_t *>(engine.get_allocator());
+
+    std::promise<autograph_impl::constant_cache_t::cached_t> c_promise;
+    c_promise.set_value(std::make_shared<autograph_impl::constant_buffer_t>(
+            size, p_engine, g_alloc));
+    return c_promise.get_future();
+}
+
+} // namespace
+
+TEST(AutographConstantCache, KeyEquality) {
+    using key_t = autograph_impl::constant_cache_t::key_t;
+
+    int a = 0, b = 0;
+    const key_t key0(1, {&a, &b}, 64);
+    const key_t key1(1, {&a, &b}, 64);
+    ASSERT_TRUE(key0 == key1);
+    ASSERT_EQ(key0.hash(), key1.hash());
+
+    // Any different field makes a different key
+    ASSERT_FALSE(key0 == key_t(2, {&a, &b}, 64));
+    ASSERT_FALSE(key0 == key_t(1, {&b, &a}, 64));
+    ASSERT_FALSE(key0 == key_t(1, {&a}, 64));
+    ASSERT_FALSE(key0 == key_t(1, {&a, &b}, 128));
+
+    // The keys owned by a kernel never equal to a content key, even if the
+    // block hash is the address of the kernel
+    const key_t owner_key(&a);
+    ASSERT_TRUE(owner_key == key_t(&a));
+    ASSERT_FALSE(owner_key == key_t(&b));
+    ASSERT_FALSE(
+            owner_key == key_t(reinterpret_cast<uintptr_t>(&a), {}, 0));
+}
+
+TEST(AutographConstantCache, GetOrAddDistinctKeys) {
+    using key_t = autograph_impl::constant_cache_t::key_t;
+
+    autograph_impl::constant_cache_t cache;
+    int a = 0;
+    const key_t owner_key(&a);
+    const key_t content_key(reinterpret_cast<uintptr_t>(&a), {}, 0);
+
+    auto value0 = make_cached_value(1);
+    auto value1 = make_cached_value(2);
+    ASSERT_FALSE(cache.get_or_add(owner_key, value0).valid());
+    ASSERT_FALSE(cache.get_or_add(content_key, value1).valid());
+
+    auto got0 = cache.get_or_add(owner_key, make_cached_value(3));
+    auto got1 = cache.get_or_add(content_key, make_cached_value(4));
+    ASSERT_TRUE(got0.valid());
+    ASSERT_TRUE(got1.valid());
+    ASSERT_EQ(got0.get(), value0.get());
+    ASSERT_EQ(got1.get(), value1.get());
+
+    cache.remove_if_exist(owner_key);
+    ASSERT_FALSE(cache.get_or_add(owner_key, make_cached_value(1)).valid());
+    ASSERT_EQ(cache.get_or_add(content_key, make_cached_value(1)).get(),
+            value1.get());
+}
+
+TEST(AutographConstantCache, RetainRelease) {
+    using key_t = autograph_impl::constant_cache_t::key_t;
+
+    autograph_impl::constant_cache_t cache;
+    int a = 0;
+    const key_t key(1, {&a}, 1);
+
+    cache.retain(key);
+    cache.retain(key);
+    auto value = make_cached_value(1);
+    ASSERT_FALSE(cache.get_or_add(key, value).valid());
+
+    // The value is kept until all users release the key
+    cache.release(key);
+    ASSERT_EQ(cache.get_or_add(key, make_cached_value(1)).get(), value.get());
+    cache.release(key);
+    ASSERT_FALSE(cache.get_or_add(key, make_cached_value(1)).valid());
+}
+
+TEST(AutographConstantCache, Update) {
+    using key_t = autograph_impl::constant_cache_t::key_t;
+
+    autograph_impl::constant_cache_t cache;
+    int a = 0;
+    const key_t key(1, {&a}, 1);
+
+    // Nothing is updated if the key is not cached
+    cache.update(key, make_cached_value(1));
+    ASSERT_FALSE(cache.get_if_exist(key).valid());
+
+    auto value0 = make_cached_value(1);
+    ASSERT_FALSE(cache.get_or_add(key, value0).valid());
+    ASSERT_EQ(cache.get_if_exist(key).get(), value0.get());
+
+    // The replaced buffer is still valid for its users
+    auto in_use = cache.get_if_exist(key).get();
+    auto value1 = make_cached_value(1);
+    cache.update(key, value1);
+    ASSERT_EQ(cache.get_if_exist(key).get(), value1.get());
+    ASSERT_EQ(cache.get_or_add(key, make_cached_value(1)).get(), value1.get());
+    ASSERT_EQ(in_use, value0.get());
+    ASSERT_NE(in_use->data<char>(), nullptr);
+}
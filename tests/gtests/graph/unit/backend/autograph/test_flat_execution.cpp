@@ -0,0 +1,235 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "interface/partition.hpp"
+
+#include "graph/unit/backend/autograph/autograph_test_common.hpp"
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+
+#include "oneapi/dnnl/dnnl_graph.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace graph = dnnl::impl::graph;
+namespace utils = dnnl::graph::tests::unit::utils;
+
+namespace {
+
+void set_env(const char *name, const char *value) {
+#ifdef _WIN32
+    SetEnvironmentVariable(name, value);
+#else
+    ::setenv(name, value, 1);
+#endif
+}
+
+void unset_env(const char *name) {
+#ifdef _WIN32
+    SetEnvironmentVariable(name, nullptr);
+#else
+    ::unsetenv(name);
+#endif
+}
+
+// Compile the single partition given by the pass with the large partition
+// kernel and execute it on random inputs. The partition is compiled and
+// executed with or without the flat argument tables, and the outputs are
+// returned as raw bytes.
+void run_large_partition(const std::function<void(graph::graph_t &)> &build,
+        const std::string &pass_name, bool flat,
+        std::vector<std::vector<char>> &results) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+    using ltw = graph::logical_tensor_wrapper_t;
+
+    graph::graph_t g(eng->kind());
+    build(g);
+    g.finalize();
+    graph::pass::pass_base_ptr apass = autograph_test::get_pass(pass_name);
+    apass->run(g);
+    ASSERT_EQ(g.get_num_partitions(), 1U);
+
+    graph::partition_t p;
+    p.init(g.get_partitions()[0]);
+    auto partition_inputs = p.get_inputs();
+    auto partition_outputs = p.get_outputs();
+    std::vector<const graph::logical_tensor_t *> inputs, outputs;
+    for (auto &lt : partition_inputs)
+        inputs.emplace_back(&lt);
+    for (auto &lt : partition_outputs) {
+        lt = utils::logical_tensor_init(
+                lt.id, lt.data_type, graph::layout_type::strided);
+        outputs.emplace_back(&lt);
+    }
+
+    // The env vars are read in the compilation, which must not be served by
+    // the compiled partition cache
+    const int capacity = dnnl::graph::get_compiled_partition_cache_capacity();
+    dnnl::graph::set_compiled_partition_cache_capacity(0);
+    dnnl::graph::set_compiled_partition_cache_capacity(capacity);
+    set_env("_ONEDNN_USE_LARGE_PARTITION_KERNEL", "1");
+    set_env("_ONEDNN_GRAPH_ENABLE_FLAT_EXECUTION", flat ? "1" : "0");
+    graph::compiled_partition_t cp(p);
+    graph::status_t ret = p.compile(&cp, inputs, outputs, eng);
+    unset_env("_ONEDNN_USE_LARGE_PARTITION_KERNEL");
+    unset_env("_ONEDNN_GRAPH_ENABLE_FLAT_EXECUTION");
+    ASSERT_EQ(ret, graph::status::success);
+
+    // The same random data in both runs. The data is only compared with the
+    // other run, so any bytes are fine for the integer types.
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> fdist(-1.f, 1.f);
+    std::uniform_int_distribution<int> idist(0, 255);
+    std::vector<test::vector<char>> inputs_data;
+    std::vector<graph::tensor_t> inputs_ts, outputs_ts;
+    for (auto &lt : inputs) {
+        inputs_data.emplace_back(test::vector<char>(ltw(lt).size()));
+        char *data = inputs_data.back().data();
+        if (lt->data_type == graph::data_type::f32) {
+            for (graph::dim_t i = 0; i < ltw(lt).nelems(); i++) {
+                const float v = fdist(gen);
+                std::memcpy(data + static_cast<size_t>(i) * sizeof(float), &v,
+                        sizeof(float));
+            }
+        } else {
+            for (auto &v : inputs_data.back())
+                v = static_cast<char>(idist(gen));
+        }
+        inputs_ts.emplace_back(*lt, eng, data);
+    }
+
+    results.clear();
+    results.reserve(outputs.size());
+    std::vector<test::vector<char>> outputs_data;
+    for (auto &lt : outputs) {
+        graph::logical_tensor_t compiled_output;
+        cp.query_logical_tensor(lt->id, &compiled_output);
+        outputs_data.emplace_back(
+                test::vector<char>(ltw(compiled_output).size()));
+        outputs_ts.emplace_back(
+                compiled_output, eng, outputs_data.back().data());
+    }
+
+    // Execute twice so the second execution uses the cached constants
+    for (int i = 0; i < 2; i++) {
+        ASSERT_EQ(cp.execute(strm, inputs_ts, outputs_ts),
+                graph::status::success);
+        strm->wait();
+    }
+    for (auto &data : outputs_data)
+        results.emplace_back(data.begin(), data.end());
+}
+
+void check_flat_and_map_execution(
+        const std::function<void(graph::graph_t &)> &build,
+        const std::string &pass_name) {
+    std::vector<std::vector<char>> flat, map;
+    run_large_partition(build, pass_name, true, flat);
+    run_large_partition(build, pass_name, false, map);
+    ASSERT_EQ(flat.size(), map.size());
+    ASSERT_FALSE(flat.empty());
+    for (size_t i = 0; i < flat.size(); i++) {
+        ASSERT_EQ(flat[i].size(), map[i].size());
+        ASSERT_EQ(std::memcmp(flat[i].data(), map[i].data(), flat[i].size()),
+                0)
+                << "output " << i << " differs";
+    }
+}
+
+} // namespace
+
+// The residual adds are fused as sum post-ops, whose executables fall back to
+// the argument maps in the flat execution
+TEST(AutographFlatExecution, F32Resnet50Stage2Block) {
+    SKIP_IF(get_engine()->kind() == graph::engine_kind::gpu,
+            "the flat execution is only used on cpu.");
+    check_flat_and_map_execution(
+            [](graph::graph_t &g) {
+                utils::id_generator id_gen;
+                utils::construct_f32_resnet50_stage2_block(
+                        &g, id_gen, 2, /* use biasadd */ true);
+            },
+            "f32_resnet50_stage_2_fusion");
+}
+
+// The zero points are handled by dummy executables in addition to the sum
+// post-ops
+TEST(AutographFlatExecution, Int8Resnet50Stage2Block) {
+    SKIP_IF(get_engine()->kind() == graph::engine_kind::gpu,
+            "the flat execution is only used on cpu.");
+    check_flat_and_map_execution(
+            [](graph::graph_t &g) {
+                utils::id_generator id_gen;
+                utils::construct_int8_resnet50_stage2_block(&g, id_gen);
+            },
+            "int8_resnet50_stage_2_fusion");
+}
+
+// The executable of the training batchnorm falls back to the argument map
+TEST(AutographFlatExecution, BatchNormForwardTraining) {
+    SKIP_IF(get_engine()->kind() == graph::engine_kind::gpu,
+            "the flat execution is only used on cpu.");
+    check_flat_and_map_execution(
+            [](graph::graph_t &g) {
+                graph::op_t bn(0, graph::op_kind::BatchNormForwardTraining,
+                        "bn_fwd_training");
+                bn.set_attr(graph::op_attr::epsilon, 0.001f);
+                bn.set_attr(graph::op_attr::momentum, 0.1f);
+                bn.set_attr(graph::op_attr::data_format, std::string("NCX"));
+
+                const graph::dims src_dims {3, 3, 2, 2}, c_dims {3};
+                std::vector<graph::logical_tensor_t> lts {
+                        utils::logical_tensor_init(
+                                0, src_dims, graph::data_type::f32),
+                        utils::logical_tensor_init(
+                                1, c_dims, graph::data_type::f32),
+                        utils::logical_tensor_init(
+                                2, c_dims, graph::data_type::f32),
+                        utils::logical_tensor_init(
+                                3, c_dims, graph::data_type::f32),
+                        utils::logical_tensor_init(
+                                4, c_dims, graph::data_type::f32),
+                        utils::logical_tensor_init(
+                                5, src_dims, graph::data_type::f32),
+                        utils::logical_tensor_init(
+                                6, c_dims, graph::data_type::f32),
+                        utils::logical_tensor_init(
+                                7, c_dims, graph::data_type::f32),
+                        utils::logical_tensor_init(
+                                8, c_dims, graph::data_type::f32),
+                        utils::logical_tensor_init(
+                                9, c_dims, graph::data_type::f32)};
+                // src, mean, variance, gamma, beta
+                for (size_t i = 0; i < 5; i++)
+                    bn.add_input(lts[i]);
+                // dst, running mean/variance, batch mean/variance
+                for (size_t i = 5; i < lts.size(); i++)
+                    bn.add_output(lts[i]);
+                g.add_op(&bn);
+            },
+            "bn_fw_train_pass");
+}
@@ -0,0 +1,207 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "interface/partition.hpp"
+
+#include "backend/autograph/passes/memory_planning.hpp"
+#include "backend/autograph/passes/utils.hpp"
+#include "backend/autograph/subgraph.hpp"
+
+#include "graph/unit/backend/autograph/autograph_test_common.hpp"
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+
+namespace graph = dnnl::impl::graph;
+namespace utils = dnnl::graph::tests::unit::utils;
+namespace autograph_impl = graph::autograph_impl;
+
+namespace {
+
+// Build relu0(in0) and relu1(in1), then add(relu0, relu1) -> relu2, so the
+// two first relus are independent
+std::shared_ptr<autograph_impl::subgraph_t> make_diamond_subgraph(
+        std::vector<graph::op_t *> &relus, graph::op_t *&add) {
+    using op_ptr = std::shared_ptr<graph::op_t>;
+    size_t id = 0;
+    auto lt = [&id]() {
+        return utils::logical_tensor_init(
+                id++, {1, 8}, graph::data_type::f32);
+    };
+
+    op_ptr relu0 = std::make_shared<graph::op_t>(
+            id++, graph::op_kind::ReLU, "relu0");
+    op_ptr relu1 = std::make_shared<graph::op_t>(
+            id++, graph::op_kind::ReLU, "relu1");
+    op_ptr add_op
+            = std::make_shared<graph::op_t>(id++, graph::op_kind::Add, "add");
+    op_ptr relu2 = std::make_shared<graph::op_t>(
+            id++, graph::op_kind::ReLU, "relu2");
+
+    relu0->add_input(lt());
+    relu0->add_output(lt());
+    relu1->add_input(lt());
+    relu1->add_output(lt());
+    add_op->connect_input(0, relu0->get_output_value(0));
+    add_op->connect_input(1, relu1->get_output_value(0));
+    add_op->add_output(lt());
+    relu2->connect_input(0, add_op->get_output_value(0));
+    relu2->add_output(lt());
+
+    relus = {relu0.get(), relu1.get(), relu2.get()};
+    add = add_op.get();
+    return std::make_shared<autograph_impl::subgraph_t>(
+            std::vector<op_ptr> {relu0, relu1, add_op, relu2},
+            /* reset_layout */ false);
+}
+
+std::vector<graph::op_t *> get_topo_ops(
+        const std::shared_ptr<autograph_impl::subgraph_t> &sg) {
+    std::vector<graph::op_t *> topo_ops;
+    graph::topo_order_visit(sg->get_output_ops(), [&](graph::op_t *op) {
+        topo_ops.emplace_back(op);
+        return graph::status::success;
+    });
+    return topo_ops;
+}
+
+} // namespace
+
+TEST(AutographInterOpParallel, GetOpLevels) {
+    std::vector<graph::op_t *> relus;
+    graph::op_t *add = nullptr;
+    auto sg = make_diamond_subgraph(relus, add);
+    auto topo_ops = get_topo_ops(sg);
+
+    auto levels = autograph_impl::get_op_levels(sg);
+    ASSERT_EQ(levels.size(), 3U);
+    ASSERT_EQ(levels[0].size(), 2U);
+    ASSERT_EQ(levels[1].size(), 1U);
+    ASSERT_EQ(levels[2].size(), 1U);
+
+    std::vector<graph::op_t *> level0 {
+            topo_ops[levels[0][0]], topo_ops[levels[0][1]]};
+    ASSERT_NE(std::find(level0.begin(), level0.end(), relus[0]), level0.end());
+    ASSERT_NE(std::find(level0.begin(), level0.end(), relus[1]), level0.end());
+    ASSERT_EQ(topo_ops[levels[1][0]], add);
+    ASSERT_EQ(topo_ops[levels[2][0]], relus[2]);
+}
+
+TEST(AutographInterOpParallel, GetPlanningSteps) {
+    std::vector<graph::op_t *> relus;
+    graph::op_t *add = nullptr;
+    auto sg = make_diamond_subgraph(relus, add);
+
+    // Each op is a step in sequential execution, in the topo order
+    autograph_impl::memory_planner_t mp;
+    auto steps = mp.get_planning_steps(sg);
+    auto topo_ops = get_topo_ops(sg);
+    ASSERT_EQ(steps.size(), topo_ops.size());
+    for (size_t i = 0; i < steps.size(); i++) {
+        ASSERT_EQ(steps[i].size(), 1U);
+        ASSERT_EQ(steps[i][0], topo_ops[i]);
+    }
+
+    // The independent ops are in the same step in inter-op parallel
+    // execution
+    autograph_impl::memory_planner_t mp_parallel;
+    mp_parallel.set_inter_op_parallel(true);
+    steps = mp_parallel.get_planning_steps(sg);
+    ASSERT_EQ(steps.size(), 3U);
+    ASSERT_EQ(steps[0].size(), 2U);
+    ASSERT_EQ(steps[1], std::vector<graph::op_t *> {add});
+    ASSERT_EQ(steps[2], std::vector<graph::op_t *> {relus[2]});
+}
+
+TEST(AutographInterOpParallel, F32Resnet50Stage2Block) {
+    graph::engine_t *eng = get_engine();
+    graph::stream_t *strm = get_stream();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "inter-op parallel execution is only supported on cpu.");
+
+    using ltw = graph::logical_tensor_wrapper_t;
+
+    // Compile and execute the same block with or without inter-op parallel
+    // execution, the results must be the same
+    auto run = [&](bool inter_op_parallel, std::vector<float> &result) {
+        utils::id_generator id_gen;
+        graph::graph_t g(eng->kind());
+        utils::construct_f32_resnet50_stage2_block(
+                &g, id_gen, 3, /* use biasadd */ true);
+        g.finalize();
+
+        graph::pass::pass_base_ptr apass
+                = autograph_test::get_pass("f32_resnet50_stage_2_fusion");
+        apass->run(g);
+        ASSERT_EQ(g.get_num_partitions(), 1U);
+
+        graph::partition_t p;
+        p.init(g.get_partitions()[0]);
+        p.set_inter_op_parallel(inter_op_parallel);
+        ASSERT_EQ(p.get_inter_op_parallel(), inter_op_parallel ? 1 : 0);
+
+        auto partition_inputs = p.get_inputs();
+        auto partition_outputs = p.get_outputs();
+        std::vector<const graph::logical_tensor_t *> inputs, outputs;
+        for (auto &lt : partition_inputs)
+            inputs.emplace_back(&lt);
+        for (auto &lt : partition_outputs) {
+            lt = utils::logical_tensor_init(
+                    lt.id, lt.data_type, graph::layout_type::strided);
+            outputs.emplace_back(&lt);
+        }
+
+        graph::compiled_partition_t cp(p);
+        ASSERT_EQ(p.compile(&cp, inputs, outputs, eng), graph::status::success);
+
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<float> dist(-1.f, 1.f);
+        std::vector<test::vector<float>> inputs_data;
+        std::vector<graph::tensor_t> inputs_ts, outputs_ts;
+        for (auto &lt : inputs) {
+            inputs_data.emplace_back(
+                    test::vector<float>(utils::product(ltw(lt).vdims())));
+            for (auto &v : inputs_data.back())
+                v = dist(gen);
+            inputs_ts.emplace_back(*lt, eng, inputs_data.back().data());
+        }
+
+        graph::logical_tensor_t compiled_output;
+        cp.query_logical_tensor(outputs[0]->id, &compiled_output);
+        test::vector<float> output_data(
+                utils::product(ltw(compiled_output).vdims()));
+        outputs_ts.emplace_back(compiled_output, eng, output_data.data());
+
+        ASSERT_EQ(cp.execute(strm, inputs_ts, outputs_ts),
+                graph::status::success);
+        strm->wait();
+        result.assign(output_data.begin(), output_data.end());
+    };
+
+    std::vector<float> sequential, parallel;
+    run(false, sequential);
+    run(true, parallel);
+    ASSERT_EQ(sequential.size(), parallel.size());
+    for (size_t i = 0; i < sequential.size(); i++) {
+        ASSERT_FLOAT_EQ(sequential[i], parallel[i]);
+    }
+}
@@ -0,0 +1,230 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "graph/unit/backend/autograph/autograph_test_common.hpp"
+
+namespace graph = dnnl::impl::graph;
+namespace autograph_impl = graph::autograph_impl;
+
+namespace {
+
+// A layout id manager of int "mem descs". The hash only has a few values, so
+// different mem descs collide in the index.
+class int_layout_id_manager_t : public autograph_impl::layout_id_manager_t {
+    bool is_mem_desc_equal(const graph::utils::any_t &mem_desc1,
+            const graph::utils::any_t &mem_desc2) const override {
+        return graph::utils::any_cast<int>(mem_desc1)
+                == graph::utils::any_cast<int>(mem_desc2);
+    }
+
+    size_t get_mem_desc_hash(
+            const graph::utils::any_t &mem_desc) const override {
+        return static_cast<size_t>(graph::utils::any_cast<int>(mem_desc) % 7);
+    }
+};
+
+// The layout id manager before sharding: a linear scan under a global mutex.
+// Only used as the reference of the benchmark.
+class locked_layout_id_manager_t {
+public:
+    size_t set_mem_desc(int md) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto pos = std::find(data_.begin(), data_.end(), md);
+        if (pos != data_.end())
+            return static_cast<size_t>(std::distance(data_.begin(), pos));
+        data_.emplace_back(md);
+        return data_.size() - 1;
+    }
+
+    int get_mem_desc(size_t layout_id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return data_[layout_id];
+    }
+
+private:
+    std::vector<int> data_;
+    mutable std::mutex mutex_;
+};
+
+// Each thread registers all mem descs in its own order, then looks them up
+template <typename set_func_t, typename get_func_t>
+std::vector<std::vector<size_t>> run_concurrently(size_t num_threads,
+        int num_mds, const set_func_t &set, const get_func_t &get,
+        std::atomic<bool> &ok) {
+    std::vector<std::vector<size_t>> ids(
+            num_threads, std::vector<size_t>(static_cast<size_t>(num_mds)));
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < num_mds; i++) {
+                const int md = (t % 2 == 0) ? i : num_mds - 1 - i;
+                ids[t][static_cast<size_t>(md)] = set(md);
+            }
+            for (int md = 0; md < num_mds; md++) {
+                if (get(ids[t][static_cast<size_t>(md)]) != md) ok = false;
+            }
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+    return ids;
+}
+
+} // namespace
+
+TEST(AutographLayoutIdManager, SetGet) {
+    int_layout_id_manager_t mgr;
+    // The ids are dense and given in the registration order, even if the
+    // hashes collide
+    for (int md = 0; md < 100; md++) {
+        ASSERT_EQ(mgr.set_mem_desc(md).value(), static_cast<size_t>(md));
+    }
+    for (int md = 0; md < 100; md++) {
+        ASSERT_EQ(mgr.set_mem_desc(md).value(), static_cast<size_t>(md));
+        auto got = mgr.get_mem_desc(static_cast<size_t>(md));
+        ASSERT_TRUE(got.has_value());
+        ASSERT_EQ(graph::utils::any_cast<int>(got.value()), md);
+    }
+    ASSERT_FALSE(mgr.get_mem_desc(100).has_value());
+    ASSERT_FALSE(mgr.get_mem_desc(static_cast<size_t>(-1)).has_value());
+}
+
+TEST(AutographLayoutIdManager, MultithreadingIdStability) {
+    int_layout_id_manager_t mgr;
+    const size_t num_threads = 8;
+    // more than the first chunk, so the chunks are allocated concurrently
+    const int num_mds = 1000;
+    std::atomic<bool> ok {true};
+    auto ids = run_concurrently(
+            num_threads, num_mds,
+            [&](int md) { return mgr.set_mem_desc(md).value(); },
+            [&](size_t id) {
+                return graph::utils::any_cast<int>(
+                        mgr.get_mem_desc(id).value());
+            },
+            ok);
+    ASSERT_TRUE(ok);
+
+    // All threads get the same id of a mem desc, and each mem desc is
+    // registered only once
+    std::vector<size_t> sorted_ids = ids[0];
+    for (size_t t = 1; t < num_threads; t++)
+        ASSERT_EQ(ids[t], ids[0]);
+    std::sort(sorted_ids.begin(), sorted_ids.end());
+    for (size_t i = 0; i < sorted_ids.size(); i++)
+        ASSERT_EQ(sorted_ids[i], i);
+    ASSERT_FALSE(mgr.get_mem_desc(static_cast<size_t>(num_mds)).has_value());
+}
+
+TEST(AutographLayoutIdManager, MultithreadingMemoryDesc) {
+    using dims = dnnl::memory::dims;
+    using dt = dnnl::memory::data_type;
+    using tag = dnnl::memory::format_tag;
+    auto &backend = autograph_impl::autograph_backend::get_singleton();
+
+    const std::vector<dnnl::memory::desc> mds {
+            {dims {1, 16, 7, 7}, dt::f32, tag::nChw16c},
+            {dims {1, 16, 7, 7}, dt::f32, tag::nChw8c},
+            {dims {1, 16, 7, 7}, dt::bf16, tag::nChw16c},
+            {dims {2, 16, 7, 7}, dt::f32, tag::nChw16c},
+            {dims {16, 16, 3, 3}, dt::f32, tag::OIhw16i16o}};
+    const size_t num_threads = 8;
+    std::vector<std::vector<size_t>> ids(num_threads);
+    std::atomic<bool> ok {true};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t]() {
+            for (size_t iter = 0; iter < 100; iter++) {
+                for (size_t i = 0; i < mds.size(); i++) {
+                    const size_t md_idx = (i + t) % mds.size();
+                    const size_t id
+                            = backend.set_mem_desc(mds[md_idx]).value();
+                    if (iter == 0) {
+                        ids[t].resize(mds.size());
+                        ids[t][md_idx] = id;
+                    } else if (ids[t][md_idx] != id) {
+                        ok = false;
+                    }
+                    auto got = backend.get_mem_desc(id);
+                    if (!got.has_value()
+                            || graph::utils::any_cast<dnnl::memory::desc>(
+                                       got.value())
+                                    != mds[md_idx])
+                        ok = false;
+                }
+            }
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+
+    ASSERT_TRUE(ok);
+    for (size_t t = 1; t < num_threads; t++)
+        ASSERT_EQ(ids[t], ids[0]);
+    std::vector<size_t> sorted_ids = ids[0];
+    std::sort(sorted_ids.begin(), sorted_ids.end());
+    ASSERT_EQ(std::unique(sorted_ids.begin(), sorted_ids.end()),
+            sorted_ids.end());
+}
+
+// Compare the registration and lookup throughput of the sharded manager with
+// the previous locked linear scan. Run with --gtest_also_run_disabled_tests.
+TEST(AutographLayoutIdManager, DISABLED_ConcurrentSetGetBenchmark) {
+    const size_t num_threads
+            = std::max(std::thread::hardware_concurrency(), 2U);
+    for (int num_mds : {100, 1000, 10000}) {
+        std::atomic<bool> ok {true};
+
+        auto start = std::chrono::steady_clock::now();
+        int_layout_id_manager_t sharded;
+        run_concurrently(
+                num_threads, num_mds,
+                [&](int md) { return sharded.set_mem_desc(md).value(); },
+                [&](size_t id) {
+                    return graph::utils::any_cast<int>(
+                            sharded.get_mem_desc(id).value());
+                },
+                ok);
+        const double sharded_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start)
+                                          .count();
+
+        start = std::chrono::steady_clock::now();
+        locked_layout_id_manager_t locked;
+        run_concurrently(
+                num_threads, num_mds,
+                [&](int md) { return locked.set_mem_desc(md); },
+                [&](size_t id) { return locked.get_mem_desc(id); }, ok);
+        const double locked_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start)
+                                         .count();
+
+        ASSERT_TRUE(ok);
+        std::cout << "threads:" << num_threads << ",mem_descs:" << num_mds
+                  << ",sharded_ms:" << sharded_ms
+                  << ",locked_ms:" << locked_ms << std::endl;
+    }
+}
@@ -0,0 +1,148 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "backend/autograph/passes/memory_planning.hpp"
+
+namespace graph = dnnl::impl::graph;
+namespace autograph_impl = graph::autograph_impl;
+
+using autograph_impl::buffer_live_range_t;
+using autograph_impl::buffer_offsets_plan_t;
+using autograph_impl::plan_buffer_offsets;
+
+namespace {
+
+size_t round_up(size_t size, size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+// Check that the buffers alive at the same step don't overlap in the arena,
+// the offsets are aligned and the peak is consistent with the offsets
+void check_plan(const std::vector<buffer_live_range_t> &buffers,
+        const buffer_offsets_plan_t &plan, size_t alignment) {
+    ASSERT_EQ(plan.offsets_.size(), buffers.size());
+    size_t peak = 0;
+    for (const auto &buf : buffers) {
+        const size_t offset = plan.offsets_.at(buf.id_);
+        ASSERT_EQ(offset % alignment, 0U);
+        peak = std::max(peak, offset + round_up(buf.size_, alignment));
+    }
+    ASSERT_EQ(plan.peak_, peak);
+    ASSERT_GE(plan.peak_, plan.lower_bound_);
+
+    for (size_t i = 0; i < buffers.size(); i++) {
+        for (size_t j = i + 1; j < buffers.size(); j++) {
+            const auto &a = buffers[i];
+            const auto &b = buffers[j];
+            if (a.end_ < b.start_ || b.end_ < a.start_) continue;
+            const size_t a_begin = plan.offsets_.at(a.id_);
+            const size_t b_begin = plan.offsets_.at(b.id_);
+            const bool disjoint
+                    = a_begin + round_up(a.size_, alignment) <= b_begin
+                    || b_begin + round_up(b.size_, alignment) <= a_begin;
+            ASSERT_TRUE(disjoint) << "buffers " << a.id_ << " and " << b.id_
+                                  << " are alive at the same time";
+        }
+    }
+}
+
+} // namespace
+
+TEST(AutographMemoryPlanning, PlanBufferOffsetsDisjointRanges) {
+    // The buffers which are never alive at the same time share the memory
+    std::vector<buffer_live_range_t> buffers {
+            {0, 100, 0, 1}, {1, 100, 2, 3}, {2, 64, 4, 4}};
+    auto plan = plan_buffer_offsets(buffers, 64);
+    check_plan(buffers, plan, 64);
+    ASSERT_EQ(plan.offsets_.at(0), 0U);
+    ASSERT_EQ(plan.offsets_.at(1), 0U);
+    ASSERT_EQ(plan.offsets_.at(2), 0U);
+    ASSERT_EQ(plan.peak_, 128U);
+    ASSERT_EQ(plan.lower_bound_, 128U);
+}
+
+TEST(AutographMemoryPlanning, PlanBufferOffsetsOverlappedRanges) {
+    // All buffers are alive at the step 2
+    std::vector<buffer_live_range_t> buffers {
+            {0, 256, 0, 2}, {1, 128, 1, 3}, {2, 64, 2, 4}};
+    auto plan = plan_buffer_offsets(buffers, 64);
+    check_plan(buffers, plan, 64);
+    ASSERT_EQ(plan.lower_bound_, 448U);
+    ASSERT_EQ(plan.peak_, 448U);
+}
+
+TEST(AutographMemoryPlanning, PlanBufferOffsetsBestFit) {
+    // The small buffers are alive at different steps, so they are stacked on
+    // the large one at the same offset
+    std::vector<buffer_live_range_t> buffers {{0, 512, 0, 4}, {1, 256, 0, 1},
+            {2, 256, 2, 2}, {3, 256, 3, 4}};
+    auto plan = plan_buffer_offsets(buffers, 64);
+    check_plan(buffers, plan, 64);
+    ASSERT_EQ(plan.offsets_.at(0), 0U);
+    ASSERT_EQ(plan.offsets_.at(1), 512U);
+    ASSERT_EQ(plan.offsets_.at(2), 512U);
+    ASSERT_EQ(plan.offsets_.at(3), 512U);
+    ASSERT_EQ(plan.peak_, 768U);
+    ASSERT_EQ(plan.lower_bound_, 768U);
+
+    // A buffer is put into the gap left between two buffers alive with it
+    buffers = {{0, 256, 0, 4}, {1, 128, 0, 1}, {2, 256, 0, 4},
+            {3, 128, 2, 4}};
+    plan = plan_buffer_offsets(buffers, 64);
+    check_plan(buffers, plan, 64);
+    ASSERT_EQ(plan.offsets_.at(1), plan.offsets_.at(3));
+    ASSERT_EQ(plan.peak_, 640U);
+}
+
+TEST(AutographMemoryPlanning, PlanBufferOffsetsAlignment) {
+    std::vector<buffer_live_range_t> buffers {
+            {0, 1, 0, 0}, {1, 65, 0, 0}, {2, 3, 0, 0}};
+    auto plan = plan_buffer_offsets(buffers, 64);
+    check_plan(buffers, plan, 64);
+    // The sizes are rounded up to the alignment
+    ASSERT_EQ(plan.lower_bound_, 256U);
+    ASSERT_EQ(plan.peak_, 256U);
+
+    plan = plan_buffer_offsets({}, 64);
+    ASSERT_TRUE(plan.offsets_.empty());
+    ASSERT_EQ(plan.peak_, 0U);
+    ASSERT_EQ(plan.lower_bound_, 0U);
+}
+
+TEST(AutographMemoryPlanning, PlanBufferOffsetsRandom) {
+    std::mt19937 gen(2023);
+    std::uniform_int_distribution<size_t> size_dist(1, 4096);
+    std::uniform_int_distribution<size_t> step_dist(0, 63);
+    for (size_t alignment : {1, 16, 64}) {
+        std::vector<buffer_live_range_t> buffers;
+        size_t total = 0;
+        for (size_t id = 0; id < 200; id++) {
+            size_t start = step_dist(gen), end = step_dist(gen);
+            if (start > end) std::swap(start, end);
+            buffers.push_back({id, size_dist(gen), start, end});
+            total += round_up(buffers.back().size_, alignment);
+        }
+        auto plan = plan_buffer_offsets(buffers, alignment);
+        check_plan(buffers, plan, alignment);
+        ASSERT_LE(plan.peak_, total);
+    }
+}
@@ -0,0 +1,59 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <chrono>
+#include <iostream>
+
+#include "gtest/gtest.h"
+
+#include "interface/graph.hpp"
+#include "utils/pm/pass_manager.hpp"
+
+#include "graph/unit/backend/autograph/autograph_test_common.hpp"
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+
+namespace graph = dnnl::impl::graph;
+namespace utils = dnnl::graph::tests::unit::utils;
+namespace autograph_impl = graph::autograph_impl;
+
+// Measure the time taken by all the fusion passes of the backend on graphs
+// made of resnet50 blocks. Run with --gtest_also_run_disabled_tests.
+TEST(AutographPartitioning, DISABLED_PartitioningTimeBenchmark) {
+    graph::engine_t *eng = get_engine();
+    auto &backend = autograph_impl::autograph_backend::get_singleton();
+
+    for (size_t num_ops : {1000, 10000, 100000}) {
+        utils::id_generator id_gen;
+        graph::graph_t g(eng->kind());
+        while (g.num_ops() < num_ops)
+            utils::construct_f32_resnet50_stage2_block(
+                    &g, id_gen, 3, /* use biasadd */ true);
+        ASSERT_EQ(g.finalize(), graph::status::success);
+
+        graph::pass::pass_manager_t pm(backend.get_pass_registry());
+        auto start = std::chrono::steady_clock::now();
+        pm.run_passes(g, "", graph::partition_policy::fusion);
+        const double ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start)
+                                  .count();
+
+        ASSERT_GT(g.get_num_partitions(), 0U);
+        std::cout << "ops:" << g.num_ops()
+                  << ",partitions:" << g.get_num_partitions()
+                  << ",partitioning_ms:" << ms << std::endl;
+    }
+}
@@ -0,0 +1,159 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "backend/autograph/scratchpad.hpp"
+
+#include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
+
+namespace graph = dnnl::impl::graph;
+namespace autograph_impl = graph::autograph_impl;
+
+using autograph_impl::scratchpad_arena_pool_t;
+using autograph_impl::scratchpad_arena_t;
+
+namespace {
+const uint64_t never_idle_ms = 1000000;
+} // namespace
+
+TEST(AutographScratchpadArena, ReuseAndGrow) {
+    graph::engine_t *eng = get_engine();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "scratchpad arena is only used on cpu.");
+    auto p_engine = autograph_impl::make_dnnl_engine(*eng);
+    auto alloc = static_cast<const graph::allocator_t *>(eng->get_allocator());
+
+    scratchpad_arena_pool_t pool(1 << 20, never_idle_ms);
+    {
+        scratchpad_arena_t arena(alloc, pool);
+        char *buf = arena.acquire(1024, p_engine);
+        ASSERT_NE(buf, nullptr);
+        ASSERT_EQ(arena.capacity(), 1024U);
+        ASSERT_EQ(pool.held(), 1024U);
+
+        // The arena can't be acquired again before being released
+        ASSERT_EQ(arena.acquire(16, p_engine), nullptr);
+        arena.release();
+
+        // Smaller requests reuse the buffer
+        ASSERT_EQ(arena.acquire(512, p_engine), buf);
+        arena.release();
+        ASSERT_EQ(arena.hits(), 1U);
+
+        // Larger requests grow the arena
+        ASSERT_NE(arena.acquire(4096, p_engine), nullptr);
+        arena.release();
+        ASSERT_EQ(arena.capacity(), 4096U);
+        ASSERT_EQ(pool.held(), 4096U);
+
+        // Requests exceeding the budget are not served by the arena
+        ASSERT_EQ(arena.acquire((1 << 20) + 1, p_engine), nullptr);
+        ASSERT_EQ(arena.capacity(), 4096U);
+    }
+    ASSERT_EQ(pool.held(), 0U);
+}
+
+TEST(AutographScratchpadArena, BudgetReclaimsIdleArenas) {
+    graph::engine_t *eng = get_engine();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "scratchpad arena is only used on cpu.");
+    auto p_engine = autograph_impl::make_dnnl_engine(*eng);
+    auto alloc = static_cast<const graph::allocator_t *>(eng->get_allocator());
+
+    scratchpad_arena_pool_t pool(8192, never_idle_ms);
+    scratchpad_arena_t arena0(alloc, pool), arena1(alloc, pool);
+
+    // An arena in use is never reclaimed, so the other one can't grow
+    ASSERT_NE(arena0.acquire(6000, p_engine), nullptr);
+    ASSERT_EQ(arena1.acquire(6000, p_engine), nullptr);
+    ASSERT_EQ(arena0.reclaims(), 0U);
+    ASSERT_EQ(pool.held(), 6000U);
+
+    // Once released, the idle arena gives its room to the other one
+    arena0.release();
+    ASSERT_NE(arena1.acquire(6000, p_engine), nullptr);
+    arena1.release();
+    ASSERT_EQ(arena0.reclaims(), 1U);
+    ASSERT_EQ(arena0.capacity(), 0U);
+    ASSERT_EQ(arena1.capacity(), 6000U);
+    ASSERT_EQ(pool.held(), 6000U);
+}
+
+TEST(AutographScratchpadArena, ReleaseIdleArenas) {
+    graph::engine_t *eng = get_engine();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "scratchpad arena is only used on cpu.");
+    auto p_engine = autograph_impl::make_dnnl_engine(*eng);
+    auto alloc = static_cast<const graph::allocator_t *>(eng->get_allocator());
+
+    scratchpad_arena_pool_t pool(1 << 20, 10);
+    scratchpad_arena_t idle_arena(alloc, pool), arena(alloc, pool);
+    ASSERT_NE(idle_arena.acquire(1024, p_engine), nullptr);
+    idle_arena.release();
+
+    // Any acquire releases the arenas which have been idle for a while, even
+    // if the budget is not exceeded
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_NE(arena.acquire(16, p_engine), nullptr);
+    arena.release();
+    ASSERT_EQ(idle_arena.reclaims(), 1U);
+    ASSERT_EQ(idle_arena.capacity(), 0U);
+    ASSERT_EQ(pool.held(), 16U);
+}
+
+TEST(AutographScratchpadArena, Multithreading) {
+    graph::engine_t *eng = get_engine();
+    SKIP_IF(eng->kind() == graph::engine_kind::gpu,
+            "scratchpad arena is only used on cpu.");
+    auto p_engine = autograph_impl::make_dnnl_engine(*eng);
+    auto alloc = static_cast<const graph::allocator_t *>(eng->get_allocator());
+
+    const size_t budget = 3 * 4096;
+    scratchpad_arena_pool_t pool(budget, 1);
+    std::atomic<bool> ok {true};
+    auto func = [&](size_t tid) {
+        scratchpad_arena_t arena(alloc, pool);
+        for (size_t i = 0; i < 500; i++) {
+            const size_t size = 1024 * (1 + (i + tid) % 4);
+            char *buf = arena.acquire(size, p_engine);
+            if (buf) {
+                std::memset(buf, static_cast<int>(tid), size);
+                for (size_t j = 0; j < size; j += 256) {
+                    if (buf[j] != static_cast<char>(tid)) ok = false;
+                }
+                arena.release();
+            }
+            if (pool.held() > budget) ok = false;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; t++)
+        threads.emplace_back(func, t);
+    for (auto &t : threads)
+        t.join();
+
+    ASSERT_TRUE(ok);
+    ASSERT_EQ(pool.held(), 0U);
+}
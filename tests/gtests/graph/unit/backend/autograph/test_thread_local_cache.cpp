@@ -0,0 +1,196 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "backend/autograph/thread_local_cache.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace {
+
+// The resources of the tests, counting how many of them are alive
+struct counted_resource_t {
+    counted_resource_t(size_t data, std::atomic<int> &alive)
+        : data_(data), alive_(alive) {
+        alive_++;
+    }
+    ~counted_resource_t() { alive_--; }
+
+    size_t data_;
+    std::atomic<int> &alive_;
+};
+
+using cache_t = dnnl::impl::graph::autograph_impl::thread_local_cache_t<
+        counted_resource_t>;
+
+// The idle time is read once by the first cache access, make it short so the
+// tests don't have to wait for long
+void set_short_idle_time() {
+#ifdef _WIN32
+    SetEnvironmentVariable("_ONEDNN_GRAPH_THREAD_LOCAL_CACHE_IDLE_MS", "20");
+#else
+    ::setenv("_ONEDNN_GRAPH_THREAD_LOCAL_CACHE_IDLE_MS", "20", 1);
+#endif
+}
+
+void sleep_ms(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+} // namespace
+
+TEST(AutographThreadLocalCache, ReclaimIdleOnAnyInsert) {
+    set_short_idle_time();
+    // The idle replica is counted separately from the other resources
+    std::atomic<int> idle_alive {0}, alive {0};
+    auto creator = [](size_t data, std::atomic<int> &counter) {
+        return [data, &counter]() {
+            return std::make_shared<counted_resource_t>(data, counter);
+        };
+    };
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    int stage = 0;
+    auto wait_stage = [&](int s) {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [&]() { return stage >= s; });
+    };
+    auto set_stage = [&](int s) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stage = s;
+        }
+        cv.notify_all();
+    };
+
+    const size_t idle_key = 1;
+    bool reclaimed = false, pinned = false, released = false;
+    std::thread idle_thread([&]() {
+        cache_t cache;
+        counted_resource_t *res
+                = cache.get_or_add(idle_key, creator(1, idle_alive));
+        set_stage(1);
+
+        wait_stage(2);
+        // The replica is reclaimed from the registry, but it's still pinned
+        // by this thread which used it recently
+        reclaimed = !cache.has_resource(idle_key);
+        pinned = res->data_ == 1 && idle_alive == 1;
+
+        // Using other resources unpins the reclaimed replica
+        for (size_t k = 10; k < 14; k++)
+            cache.get_or_add(k, creator(k, alive));
+        released = idle_alive == 0;
+        cache.clear();
+    });
+
+    wait_stage(1);
+    sleep_ms(50);
+    // Adding a replica of another key reclaims the idle one
+    cache_t cache;
+    cache.get_or_add(2, creator(2, alive));
+    ASSERT_EQ(idle_alive, 1);
+    set_stage(2);
+    idle_thread.join();
+
+    ASSERT_TRUE(reclaimed);
+    ASSERT_TRUE(pinned);
+    ASSERT_TRUE(released);
+    cache.clear();
+    ASSERT_EQ(idle_alive, 0);
+    ASSERT_EQ(alive, 0);
+}
+
+TEST(AutographThreadLocalCache, ReuseWhileActive) {
+    set_short_idle_time();
+    std::atomic<int> alive {0};
+    cache_t cache;
+
+    const size_t key = 1;
+    counted_resource_t *res = cache.get_or_add(key,
+            [&]() { return std::make_shared<counted_resource_t>(1, alive); });
+    // A replica used within the idle time is never reclaimed
+    for (int i = 0; i < 10; i++) {
+        sleep_ms(2);
+        ASSERT_EQ(cache.get_or_add(key,
+                          [&]() {
+                              return std::make_shared<counted_resource_t>(
+                                      2, alive);
+                          }),
+                res);
+        cache.get_or_add(key + 1 + static_cast<size_t>(i), [&]() {
+            return std::make_shared<counted_resource_t>(3, alive);
+        });
+    }
+    ASSERT_EQ(res->data_, 1U);
+    cache.clear();
+    ASSERT_EQ(alive, 0);
+}
+
+TEST(AutographThreadLocalCache, Multithreading) {
+    set_short_idle_time();
+    std::atomic<int> alive {0};
+    std::atomic<bool> ok {true};
+    std::atomic<bool> done {false};
+    const size_t num_keys = 8;
+
+    auto worker = [&](size_t tid) {
+        cache_t cache;
+        for (size_t iter = 0; iter < 200; iter++) {
+            for (size_t k = 0; k < num_keys; k++) {
+                counted_resource_t *res = cache.get_or_add(k, [&]() {
+                    return std::make_shared<counted_resource_t>(k, alive);
+                });
+                if (res->data_ != k) ok = false;
+            }
+            if (iter % 50 == tid % 50) sleep_ms(25);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 6; t++)
+        threads.emplace_back(worker, t);
+    std::thread remover([&]() {
+        cache_t cache;
+        size_t k = 0;
+        while (!done) {
+            cache.remove_if_exist(k);
+            k = (k + 1) % num_keys;
+            sleep_ms(1);
+        }
+    });
+
+    for (auto &t : threads)
+        t.join();
+    done = true;
+    remover.join();
+
+    ASSERT_TRUE(ok);
+    // All replicas are released when their owners exit
+    ASSERT_EQ(alive, 0);
+}
@@ -4814,6 +4814,7 @@ TEST(Pass, DnnlSingleOpReplacement) {
             op->set_attr<std::string>(op_attr::rounding_type, "floor");
         }
         ASSERT_EQ(op->get_kind(), akind);
+        agraph.finalize();
         pm.run_passes(agraph, "no_config");
 
         auto orig_op = agraph.get_ops()[0];
@@ -13728,6 +13729,114 @@ TEST(Pass, F32MhaFusion) {
     ASSERT_EQ(agraph.get_num_partitions(), 1U);
 }
 
+TEST(PassSystem, FuseFloatSdp) {
+    /*  matmul
+          |
+         div
+          |
+         add
+          |
+       softmax
+          |
+        matmul
+    */
+    graph_t agraph;
+    op_t matmul_qk {0, MatMul, "matmul_qk"};
+    op_t div {1, Divide, "div"};
+    op_t add {2, Add, "add"};
+    op_t softmax {3, SoftMax, "softmax"};
+    softmax.set_attr<int64_t>(op_attr::axis, -1);
+    op_t matmul_v {4, MatMul, "matmul_v"};
+    std::vector<logical_tensor_t> lt_vec = create_logical_tensors(10);
+    matmul_qk.add_input(lt_vec[0]);
+    matmul_qk.add_input(lt_vec[1]);
+    matmul_qk.add_output(lt_vec[2]);
+    div.add_input(lt_vec[2]);
+    div.add_input(lt_vec[3]);
+    div.add_output(lt_vec[4]);
+    add.add_input(lt_vec[4]);
+    add.add_input(lt_vec[5]);
+    add.add_output(lt_vec[6]);
+    softmax.add_input(lt_vec[6]);
+    softmax.add_output(lt_vec[7]);
+    matmul_v.add_input(lt_vec[7]);
+    matmul_v.add_input(lt_vec[8]);
+    matmul_v.add_output(lt_vec[9]);
+
+    ASSERT_EQ(agraph.add_op(&matmul_qk), status::success);
+    ASSERT_EQ(agraph.add_op(&div), status::success);
+    ASSERT_EQ(agraph.add_op(&add), status::success);
+    ASSERT_EQ(agraph.add_op(&softmax), status::success);
+    ASSERT_EQ(agraph.add_op(&matmul_v), status::success);
+    agraph.finalize();
+
+    auto &backend_ptr = dnnl_impl::dnnl_backend::get_singleton();
+    auto pm = pass::pass_manager_t(backend_ptr.get_pass_registry());
+    pm.run_passes(agraph, "no_config");
+
+    ASSERT_EQ(agraph.get_num_partitions(), 1U);
+    ASSERT_EQ((agraph.get_partitions()[0])->get_kind(), partition_kind_t::mha);
+    ASSERT_EQ(agraph.get_partitions()[0]->get_inputs().size(), 5U);
+    ASSERT_EQ(agraph.get_partitions()[0]->get_outputs().size(), 1U);
+    ASSERT_EQ(agraph.get_partitions()[0]->get_outputs()[0].id, 9U);
+}
+
+TEST(PassSystem, FuseFloatGroupNorm) {
+    /*  reshape
+           |
+       layernorm
+           |
+        reshape
+           |
+        multiply
+           |
+          add
+    */
+    graph_t agraph;
+    op_t reshape_in {0, StaticReshape, "reshape_in"};
+    reshape_in.set_attr<std::vector<int64_t>>(op_attr::shape, {2, 4, -1});
+    reshape_in.set_attr<bool>(op_attr::special_zero, false);
+    op_t layernorm {1, LayerNorm, "layernorm"};
+    layernorm.set_attr<bool>(op_attr::keep_stats, false);
+    layernorm.set_attr<bool>(op_attr::use_affine, false);
+    op_t reshape_out {2, StaticReshape, "reshape_out"};
+    reshape_out.set_attr<std::vector<int64_t>>(op_attr::shape, {2, 32, 8, 8});
+    reshape_out.set_attr<bool>(op_attr::special_zero, false);
+    op_t multiply {3, Multiply, "multiply"};
+    op_t add {4, Add, "add"};
+    std::vector<logical_tensor_t> lt_vec = create_logical_tensors(8);
+    reshape_in.add_input(lt_vec[0]);
+    reshape_in.add_output(lt_vec[1]);
+    layernorm.add_input(lt_vec[1]);
+    layernorm.add_output(lt_vec[2]);
+    reshape_out.add_input(lt_vec[2]);
+    reshape_out.add_output(lt_vec[3]);
+    multiply.add_input(lt_vec[3]);
+    multiply.add_input(lt_vec[4]);
+    multiply.add_output(lt_vec[5]);
+    add.add_input(lt_vec[5]);
+    add.add_input(lt_vec[6]);
+    add.add_output(lt_vec[7]);
+
+    ASSERT_EQ(agraph.add_op(&reshape_in), status::success);
+    ASSERT_EQ(agraph.add_op(&layernorm), status::success);
+    ASSERT_EQ(agraph.add_op(&reshape_out), status::success);
+    ASSERT_EQ(agraph.add_op(&multiply), status::success);
+    ASSERT_EQ(agraph.add_op(&add), status::success);
+    agraph.finalize();
+
+    auto &backend_ptr = dnnl_impl::dnnl_backend::get_singleton();
+    auto pm = pass::pass_manager_t(backend_ptr.get_pass_registry());
+    pm.run_passes(agraph, "no_config");
+
+    ASSERT_EQ(agraph.get_num_partitions(), 1U);
+    ASSERT_EQ((agraph.get_partitions()[0])->get_kind(),
+            partition_kind_t::misc_post_ops);
+    ASSERT_EQ(agraph.get_partitions()[0]->get_inputs().size(), 3U);
+    ASSERT_EQ(agraph.get_partitions()[0]->get_outputs().size(), 1U);
+    ASSERT_EQ(agraph.get_partitions()[0]->get_outputs()[0].id, 7U);
+}
+
 TEST(Pass, FuseReduceAdd) {
     /* reduce
           |
@@ -63,6 +63,7 @@ TEST(Pass, FakeSingleOpReplacement) {
         graph_t agraph;
         op_t *op = agraph.create_op(akind);
         ASSERT_EQ(op->get_kind(), akind);
+        agraph.finalize();
         fake_pm.run_passes(agraph, "no_config");
 
         auto orig_op = agraph.get_ops()[0];
@@ -22,6 +22,7 @@
 #include "interface/shape_infer.hpp"
 
 #include "graph/unit/unit_test_common.hpp"
+#include "graph/unit/utils.hpp"
 
 namespace graph = dnnl::impl::graph;
 
@@ -44,3 +45,51 @@ TEST(PartitionHashing, GetOpHash) {
     graph::op_t op {0, graph::op_kind::Wildcard, "wildcard"};
     ASSERT_NO_THROW(graph::partition_hashing::get_op_hash(op));
 }
+
+TEST(PartitionHashing, StructuralKey) {
+    using dnnl::graph::tests::unit::utils::logical_tensor_init;
+    graph::engine_t &engine = *get_engine();
+
+    // Build elu -> add(elu_out, in1) with the ids starting from @p base
+    auto build = [](size_t base, float alpha,
+                         std::vector<std::shared_ptr<graph::op_t>> &ops,
+                         std::vector<graph::logical_tensor_t> &lts) {
+        lts = {logical_tensor_init(base, {2, 3}, graph::data_type::f32),
+                logical_tensor_init(base + 1, {2, 3}, graph::data_type::f32),
+                logical_tensor_init(base + 2, {2, 3}, graph::data_type::f32),
+                logical_tensor_init(base + 3, {2, 3}, graph::data_type::f32)};
+        auto elu = std::make_shared<graph::op_t>(
+                base, graph::op_kind::Elu, "elu");
+        elu->set_attr<float>(graph::op_attr::alpha, alpha);
+        elu->add_input(lts[0]);
+        elu->add_output(lts[1]);
+        auto add = std::make_shared<graph::op_t>(
+                base + 1, graph::op_kind::Add, "add");
+        add->connect_input(0, elu->get_output_value(0));
+        add->add_input(lts[2]);
+        add->add_output(lts[3]);
+        ops = {elu, add};
+    };
+
+    std::vector<std::shared_ptr<graph::op_t>> ops0, ops1, ops2;
+    std::vector<graph::logical_tensor_t> lts0, lts1, lts2;
+    build(0, 1.f, ops0, lts0);
+    build(100, 1.f, ops1, lts1);
+    build(200, 2.f, ops2, lts2);
+
+    graph::partition_hashing::key_t key0 {
+            1, engine.kind(), ops0, {&lts0[0], &lts0[2]}, {&lts0[3]}};
+    graph::partition_hashing::key_t key1 {
+            2, engine.kind(), ops1, {&lts1[0], &lts1[2]}, {&lts1[3]}};
+    graph::partition_hashing::key_t key2 {
+            3, engine.kind(), ops2, {&lts2[0], &lts2[2]}, {&lts2[3]}};
+    // the inputs are given in a different order
+    graph::partition_hashing::key_t key3 {
+            4, engine.kind(), ops1, {&lts1[2], &lts1[0]}, {&lts1[3]}};
+
+    std::hash<graph::partition_hashing::key_t> hasher;
+    ASSERT_EQ(hasher(key0), hasher(key1));
+    ASSERT_TRUE(key0 == key1);
+    ASSERT_FALSE(key0 == key2);
+    ASSERT_FALSE(key0 == key3);
+}
@@ -2535,3 +2535,81 @@ TEST(PatternMatcher, GraphRun) {
     graph::graph_t agraph;
     ASSERT_EQ(a.run(agraph), graph::status::success);
 }
+
+TEST(PatternMatcher, RootOpKinds) {
+    std::vector<graph::op_kind_t> kinds;
+
+    auto pgraph = std::make_shared<pb_graph_t>("pgraph");
+    auto pconv = pgraph->append_op(Convolution, "pconv");
+    pgraph->append_op(ReLU, {in_edge(IN0, pconv, OUT0)}, "prelu");
+    ASSERT_TRUE(pgraph->get_root_op_kinds(kinds));
+    ASSERT_EQ(kinds, std::vector<graph::op_kind_t> {Convolution});
+
+    // the root can be any of the alternatives
+    kinds.clear();
+    auto alt_graph = std::make_shared<pb_graph_t>("alt_graph");
+    auto pmatmul = std::make_shared<pb_graph_t>("pmatmul");
+    pmatmul->append_op(MatMul, "matmul");
+    auto pbinary = std::make_shared<pb_graph_t>("pbinary");
+    pbinary->append_alternation({Add, Multiply}, "binary");
+    alt_graph->append_alternation({pmatmul, pbinary}, "palt");
+    ASSERT_TRUE(alt_graph->get_root_op_kinds(kinds));
+    ASSERT_EQ(kinds, (std::vector<graph::op_kind_t> {MatMul, Add, Multiply}));
+
+    // an optional root or a wildcard root may be bound to any op
+    kinds.clear();
+    auto opt_graph = std::make_shared<pb_graph_t>("opt_graph");
+    auto popt_body = std::make_shared<pb_graph_t>("popt_body");
+    popt_body->append_op(TypeCast, "typecast");
+    opt_graph->append_optional(popt_body, "popt");
+    ASSERT_FALSE(opt_graph->get_root_op_kinds(kinds));
+
+    auto any_graph = std::make_shared<pb_graph_t>("any_graph");
+    any_graph->append_op(Wildcard, "pany");
+    ASSERT_FALSE(any_graph->get_root_op_kinds(kinds));
+}
+
+TEST(PatternMatcher, PatternSeeds) {
+    // a chain of (matmul, relu) pairs, only the matmuls can start a match
+    const size_t num_pairs = 1000;
+    graph_t agraph;
+    std::vector<logical_tensor_t> lt_vec
+            = create_logical_tensors(num_pairs * 3 + 1);
+    for (size_t i = 0; i < num_pairs; i++) {
+        op_t matmul {i * 2, MatMul, "matmul"};
+        matmul.add_input(lt_vec[i * 3]);
+        matmul.add_input(lt_vec[i * 3 + 1]);
+        matmul.add_output(lt_vec[i * 3 + 2]);
+        op_t relu {i * 2 + 1, ReLU, "relu"};
+        relu.add_input(lt_vec[i * 3 + 2]);
+        relu.add_output(lt_vec[i * 3 + 3]);
+        ASSERT_EQ(agraph.add_op(&matmul), status::success);
+        ASSERT_EQ(agraph.add_op(&relu), status::success);
+    }
+    agraph.finalize();
+    ASSERT_EQ(agraph.get_topo_ordered_ops().size(), num_pairs * 2);
+
+    auto pgraph = std::make_shared<pb_graph_t>("pgraph");
+    auto pmatmul = pgraph->append_op(MatMul, "pmatmul");
+    pgraph->append_op(ReLU, {in_edge(IN0, pmatmul, OUT0)}, "prelu");
+
+    std::vector<op_t *> seeds = get_pattern_seeds(agraph, pgraph);
+    ASSERT_EQ(seeds.size(), num_pairs);
+    for (size_t i = 0; i < num_pairs; i++) {
+        ASSERT_EQ(seeds[i]->get_kind(), MatMul);
+        // seeds are in topological order
+        ASSERT_EQ(seeds[i]->get_id(), i * 2);
+        std::vector<op_t *> fusion_ops;
+        ASSERT_TRUE(match_pattern(seeds[i], pgraph, fusion_ops));
+        ASSERT_EQ(fusion_ops.size(), 2U);
+    }
+
+    // the index is rebuilt after the graph is changed
+    op_t matmul {num_pairs * 2, MatMul, "matmul"};
+    const size_t lt_id = num_pairs * 3 + 1;
+    matmul.add_input(logical_tensor_init(lt_id, data_type::f32));
+    matmul.add_input(logical_tensor_init(lt_id + 1, data_type::f32));
+    matmul.add_output(logical_tensor_init(lt_id + 2, data_type::f32));
+    ASSERT_EQ(agraph.add_op(&matmul), status::success);
+    ASSERT_EQ(get_pattern_seeds(agraph, pgraph).size(), num_pairs + 1);
+}
@@ -0,0 +1,157 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cmath>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "src/common/float8.hpp"
+
+namespace {
+
+using dnnl::impl::float8_e4m3_t;
+using dnnl::impl::float8_e5m2_t;
+
+template <typename f8_t>
+uint8_t to_bits(float f) {
+    return f8_t {f}.raw_bits_;
+}
+
+template <typename f8_t>
+float from_bits(uint8_t b) {
+    return static_cast<float>(f8_t {b, true});
+}
+
+// Every value but NaN converts back to its own encoding.
+template <typename f8_t>
+void assert_round_trip() {
+    for (int b = 0; b < 256; ++b) {
+        const float f = from_bits<f8_t>(static_cast<uint8_t>(b));
+        if (std::isnan(f)) continue;
+        ASSERT_EQ(to_bits<f8_t>(f), b) << "f8 bits " << b;
+    }
+}
+
+// Converts values of every exponent through a reorder and compares them to
+// the scalar conversions.
+template <typename f8_t>
+void assert_reorder_matches_scalar(dnnl::memory::data_type f8_dt) {
+    using namespace dnnl;
+    using tag = memory::format_tag;
+    using dt = memory::data_type;
+
+    // an odd size to cover the tail processing
+    const memory::dim n = 4099;
+    std::vector<float> src(n);
+    for (memory::dim i = 0; i < n; ++i) {
+        const int exp = static_cast<int>(i % 40) - 24;
+        const float mag = std::ldexp(1.f + (i % 37) / 37.f, exp);
+        src[i] = i % 2 ? -mag : mag;
+    }
+    src[0] = INFINITY;
+    src[1] = NAN;
+    src[2] = 0.f;
+    src[3] = -0.f;
+
+    engine eng(engine::kind::cpu, 0);
+    stream strm(eng);
+    memory::desc f32_md({n}, dt::f32, tag::a);
+    memory::desc f8_md({n}, f8_dt, tag::a);
+    memory f32_mem(f32_md, eng), f8_mem(f8_md, eng), back_mem(f32_md, eng);
+    {
+        auto ptr = map_memory<float>(f32_mem);
+        for (memory::dim i = 0; i < n; ++i)
+            ptr[i] = src[i];
+    }
+
+    reorder(f32_mem, f8_mem).execute(strm, f32_mem, f8_mem);
+    reorder(f8_mem, back_mem).execute(strm, f8_mem, back_mem);
+    strm.wait();
+
+    auto f8_ptr = map_memory<uint8_t>(f8_mem);
+    auto back_ptr = map_memory<float>(back_mem);
+    for (memory::dim i = 0; i < n; ++i) {
+        const uint8_t expected = to_bits<f8_t>(src[i]);
+        ASSERT_EQ(f8_ptr[i], expected) << "at " << i << " for " << src[i];
+        const float expected_back = from_bits<f8_t>(expected);
+        if (std::isnan(expected_back))
+            ASSERT_TRUE(std::isnan(back_ptr[i])) << "at " << i;
+        else
+            ASSERT_EQ(back_ptr[i], expected_back) << "at " << i;
+    }
+}
+
+} // namespace
+
+namespace dnnl {
+
+TEST(test_float8_e5m2, SpecialValues) {
+    ASSERT_EQ(to_bits<float8_e5m2_t>(0.f), 0x00);
+    ASSERT_EQ(to_bits<float8_e5m2_t>(-0.f), 0x80);
+    ASSERT_EQ(to_bits<float8_e5m2_t>(1.f), 0x3c);
+    // the largest finite value and the first one rounded to infinity
+    ASSERT_EQ(to_bits<float8_e5m2_t>(57344.f), 0x7b);
+    ASSERT_EQ(to_bits<float8_e5m2_t>(61440.f), 0x7c);
+    ASSERT_EQ(to_bits<float8_e5m2_t>(-INFINITY), 0xfc);
+    ASSERT_EQ(to_bits<float8_e5m2_t>(NAN), 0x7e);
+    ASSERT_TRUE(std::isnan(from_bits<float8_e5m2_t>(0xfe)));
+    // subnormals are multiples of 2^-16, ties are rounded to even
+    ASSERT_EQ(to_bits<float8_e5m2_t>(std::ldexp(1.f, -16)), 0x01);
+    ASSERT_EQ(to_bits<float8_e5m2_t>(std::ldexp(1.f, -17)), 0x00);
+    ASSERT_EQ(to_bits<float8_e5m2_t>(std::ldexp(3.f, -17)), 0x02);
+    ASSERT_EQ(from_bits<float8_e5m2_t>(0x03), std::ldexp(3.f, -16));
+}
+
+TEST(test_float8_e4m3, SpecialValues) {
+    ASSERT_EQ(to_bits<float8_e4m3_t>(0.f), 0x00);
+    ASSERT_EQ(to_bits<float8_e4m3_t>(-0.f), 0x80);
+    ASSERT_EQ(to_bits<float8_e4m3_t>(1.f), 0x38);
+    // there is no infinity, values above the largest finite one are NaN
+    ASSERT_EQ(to_bits<float8_e4m3_t>(448.f), 0x7e);
+    ASSERT_EQ(to_bits<float8_e4m3_t>(464.f), 0x7f);
+    ASSERT_EQ(to_bits<float8_e4m3_t>(-INFINITY), 0xff);
+    ASSERT_EQ(to_bits<float8_e4m3_t>(NAN), 0x7f);
+    ASSERT_TRUE(std::isnan(from_bits<float8_e4m3_t>(0xff)));
+    // subnormals are multiples of 2^-9, ties are rounded to even
+    ASSERT_EQ(to_bits<float8_e4m3_t>(std::ldexp(1.f, -9)), 0x01);
+    ASSERT_EQ(to_bits<float8_e4m3_t>(std::ldexp(1.f, -10)), 0x00);
+    ASSERT_EQ(to_bits<float8_e4m3_t>(std::ldexp(3.f, -10)), 0x02);
+    ASSERT_EQ(from_bits<float8_e4m3_t>(0x07), std::ldexp(7.f, -9));
+}
+
+TEST(test_float8_e5m2, RoundTrip) {
+    assert_round_trip<float8_e5m2_t>();
+}
+
+TEST(test_float8_e4m3, RoundTrip) {
+    assert_round_trip<float8_e4m3_t>();
+}
+
+TEST(test_float8_e5m2, ReorderMatchesScalarConversion) {
+    SKIP_IF(engine::get_count(engine::kind::cpu) == 0,
+            "f8 is supported on CPU only");
+    assert_reorder_matches_scalar<float8_e5m2_t>(memory::data_type::f8_e5m2);
+}
+
+TEST(test_float8_e4m3, ReorderMatchesScalarConversion) {
+    SKIP_IF(engine::get_count(engine::kind::cpu) == 0,
+            "f8 is supported on CPU only");
+    assert_reorder_matches_scalar<float8_e4m3_t>(memory::data_type::f8_e4m3);
+}
+
+} // namespace dnnl
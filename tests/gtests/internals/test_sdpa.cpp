@@ -0,0 +1,261 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+#include "src/common/bfloat16.hpp"
+#include "src/common/primitive_desc_iface.hpp"
+#include "src/common/sdpa_utils.hpp"
+#include "src/cpu/platform.hpp"
+
+namespace dnnl {
+
+struct sdpa_test_params_t {
+    memory::data_type dt;
+    memory::dim mb, heads, queries, keys, head_size, values;
+    bool with_mask;
+    // The mask is [1, 1, queries, keys] if true, [mb, heads, 1, keys] if not
+    bool mask_bcast_batch;
+    bool with_scale;
+    bool invert_scale;
+    bool causal;
+    // The keys are stored as [mb, heads, keys, head_size]
+    bool transposed_keys;
+    // The number of keys per page of the keys and the values, zero if they
+    // are not paged
+    memory::dim page_size;
+};
+
+class sdpa_test_t : public ::testing::TestWithParam<sdpa_test_params_t> {
+protected:
+    void SetUp() override {
+        const auto &p = GetParam();
+
+        SKIP_IF(engine::get_count(engine::kind::cpu) == 0,
+                "SDPA requires cpu.");
+        eng_ = std::make_shared<engine>(engine::kind::cpu, 0);
+
+        SKIP_IF(!impl::cpu::platform::has_data_type_support(
+                        memory::convert_to_c(p.dt)),
+                "Engine does not support this data type.");
+
+        Test();
+    }
+
+    // Fills the memory with values in [-1, 1]
+    static void fill(const memory &mem, int seed) {
+        const auto md = mem.get_desc();
+        const size_t nelems = md.get_size()
+                / memory::data_type_size(md.get_data_type());
+        const bool is_bf16 = md.get_data_type() == memory::data_type::bf16;
+        for (size_t i = 0; i < nelems; i++) {
+            const float val
+                    = static_cast<float>((i * 37 + seed * 11) % 29) / 14.f
+                    - 1.f;
+            if (is_bf16)
+                static_cast<impl::bfloat16_t *>(mem.get_data_handle())[i]
+                        = val;
+            else
+                static_cast<float *>(mem.get_data_handle())[i] = val;
+        }
+    }
+
+    static float load(const memory &mem, size_t off) {
+        if (mem.get_desc().get_data_type() == memory::data_type::bf16)
+            return static_cast<const impl::bfloat16_t *>(
+                    mem.get_data_handle())[off];
+        return static_cast<const float *>(mem.get_data_handle())[off];
+    }
+
+    void Test() {
+        const auto &p = GetParam();
+        const memory::dim B = p.mb * p.heads;
+        const memory::dim M = p.queries, N = p.keys, D = p.head_size,
+                          DV = p.values;
+
+        memory::desc q_md(
+                {p.mb, p.heads, M, D}, p.dt, memory::format_tag::abcd);
+        // The pages of the sequences are stored in the reverse order in
+        // the pools, after an unused page
+        const bool paged = p.page_size > 0;
+        const memory::dim pages_per_seq = paged ? N / p.page_size : 0;
+        const memory::dim pages = p.mb * pages_per_seq + 1;
+        const memory::dim k_outer = paged ? pages : p.mb;
+        const memory::dim k_inner = paged ? p.page_size : N;
+
+        const auto k_tag = p.transposed_keys ? memory::format_tag::abdc
+                                             : memory::format_tag::abcd;
+        memory::desc k_md({k_outer, p.heads, D, k_inner}, p.dt, k_tag);
+        memory::desc v_md({k_outer, p.heads, k_inner, DV}, p.dt,
+                memory::format_tag::abcd);
+        memory::desc pt_md({p.mb, paged ? pages_per_seq : 1},
+                memory::data_type::s32, memory::format_tag::ab);
+        memory::desc dst_md(
+                {p.mb, p.heads, M, DV}, p.dt, memory::format_tag::abcd);
+        memory::desc msk_md = p.mask_bcast_batch
+                ? memory::desc({1, 1, M, N}, memory::data_type::f32,
+                        memory::format_tag::abcd)
+                : memory::desc({p.mb, p.heads, 1, N}, memory::data_type::f32,
+                        memory::format_tag::abcd);
+        memory::desc scale_md(
+                {1}, memory::data_type::f32, memory::format_tag::a);
+
+        std::shared_ptr<impl::primitive_desc_t> pd;
+        ASSERT_EQ(impl::create_sdpa_pd(pd, eng_->get(), q_md.get(),
+                          k_md.get(), v_md.get(), dst_md.get(),
+                          p.with_mask ? msk_md.get() : nullptr,
+                          p.with_scale ? impl::data_type::f32
+                                       : impl::data_type::undef,
+                          p.invert_scale, p.causal, nullptr,
+                          paged ? pt_md.get() : nullptr),
+                impl::status::success);
+        primitive sdpa(primitive_desc(
+                new primitive_desc_iface_t(pd, eng_->get())));
+
+        memory q_mem(q_md, *eng_), k_mem(k_md, *eng_), v_mem(v_md, *eng_),
+                dst_mem(dst_md, *eng_), msk_mem(msk_md, *eng_),
+                scale_mem(scale_md, *eng_);
+        fill(q_mem, 1);
+        fill(k_mem, 2);
+        fill(v_mem, 3);
+        fill(msk_mem, 4);
+        const float scale = 0.125f;
+        *static_cast<float *>(scale_mem.get_data_handle()) = scale;
+
+        memory pt_mem(pt_md, *eng_);
+        auto page_table = static_cast<int32_t *>(pt_mem.get_data_handle());
+        for (memory::dim i = 0; i < p.mb * pages_per_seq; i++)
+            page_table[i] = static_cast<int32_t>(pages - 1 - i);
+
+        std::unordered_map<int, memory> args = {{DNNL_ARG_QUERIES, q_mem},
+                {DNNL_ARG_KEYS, k_mem}, {DNNL_ARG_VALUES, v_mem},
+                {DNNL_ARG_DST, dst_mem}};
+        if (p.with_mask) args.insert({DNNL_ARG_ATTN_MASK, msk_mem});
+        if (p.with_scale) args.insert({DNNL_ARG_SCALE, scale_mem});
+        if (paged) args.insert({DNNL_ARG_PAGE_TABLE, pt_mem});
+
+        stream strm(*eng_);
+        sdpa.execute(strm, args);
+        strm.wait();
+
+        // The offset of the key `n` of the sequence `mb` in the keys or the
+        // values, with the strides `strides` and the keys in dimension `n_dim`
+        const auto key_off = [&](const memory::dims &strides, int n_dim,
+                                     memory::dim mb, memory::dim h,
+                                     memory::dim n) {
+            if (!paged)
+                return mb * strides[0] + h * strides[1] + n * strides[n_dim];
+            const memory::dim page
+                    = page_table[mb * pages_per_seq + n / p.page_size];
+            return page * strides[0] + h * strides[1]
+                    + (n % p.page_size) * strides[n_dim];
+        };
+        const auto k_strides = k_md.get_strides();
+        const auto v_strides = v_md.get_strides();
+        const float eps = p.dt == memory::data_type::bf16 ? 2e-2f : 1e-4f;
+        std::vector<double> s(N);
+        for_(memory::dim b = 0; b < B; b++)
+        for (memory::dim m = 0; m < M; m++) {
+            const memory::dim mb = b / p.heads, h = b % p.heads;
+            double max_s = -INFINITY;
+            for (memory::dim n = 0; n < N; n++) {
+                double acc = 0;
+                const memory::dim k_off = key_off(k_strides, 3, mb, h, n);
+                for (memory::dim d = 0; d < D; d++)
+                    acc += load(q_mem, (b * M + m) * D + d)
+                            * load(k_mem, k_off + d * k_strides[2]);
+                if (p.with_scale)
+                    acc = p.invert_scale ? acc / scale : acc * scale;
+                if (p.with_mask)
+                    acc += load(msk_mem,
+                            p.mask_bcast_batch ? m * N + n : b * N + n);
+                if (p.causal && n > m) acc = -INFINITY;
+                s[n] = acc;
+                max_s = std::max(max_s, acc);
+            }
+
+            double sum = 0;
+            for (memory::dim n = 0; n < N; n++) {
+                s[n] = std::exp(s[n] - max_s);
+                sum += s[n];
+            }
+
+            for (memory::dim dv = 0; dv < DV; dv++) {
+                double ref = 0;
+                for (memory::dim n = 0; n < N; n++)
+                    ref += s[n]
+                            * load(v_mem, key_off(v_strides, 2, mb, h, n) + dv);
+                ref /= sum;
+                const float got = load(dst_mem, (b * M + m) * DV + dv);
+                ASSERT_NEAR(got, ref, eps * std::max(1.0, std::fabs(ref)))
+                        << "b: " << b << " m: " << m << " dv: " << dv;
+            }
+        }
+    }
+
+    std::shared_ptr<engine> eng_;
+};
+
+TEST_P(sdpa_test_t, TestsSDPA) {}
+
+namespace {
+using dt = memory::data_type;
+// dt, mb, heads, queries, keys, head_size, values, with_mask,
+// mask_bcast_batch, with_scale, invert_scale, causal, transposed_keys,
+// page_size
+const sdpa_test_params_t sdpa_cases[] = {
+        {dt::f32, 1, 2, 64, 64, 16, 16, false, false, false, false, false,
+                false, 0},
+        {dt::f32, 2, 2, 70, 130, 32, 48, true, true, true, true, false, false,
+                0},
+        {dt::f32, 2, 3, 17, 65, 8, 24, true, false, true, false, false, true,
+                0},
+        {dt::f32, 1, 2, 130, 130, 16, 32, false, false, true, true, true,
+                false, 0},
+        {dt::f32, 2, 1, 1, 5, 4, 4, true, true, false, false, false, true, 0},
+        {dt::bf16, 1, 2, 64, 128, 32, 32, false, false, true, true, false,
+                false, 0},
+        {dt::bf16, 2, 2, 70, 131, 16, 24, true, true, true, false, true, true,
+                0},
+        {dt::bf16, 1, 1, 5, 3, 2, 3, true, false, false, false, false, false,
+                0},
+        // paged keys and values
+        {dt::f32, 2, 2, 1, 160, 16, 16, true, false, true, false, false,
+                false, 16},
+        {dt::f32, 2, 2, 70, 256, 16, 16, false, false, true, true, true,
+                true, 128},
+        {dt::f32, 3, 1, 4, 21, 8, 8, true, true, false, false, false, false,
+                7},
+        {dt::bf16, 2, 2, 1, 96, 32, 32, true, false, true, false, false, true,
+                32},
+        {dt::bf16, 1, 2, 9, 45, 16, 16, false, false, true, true, true, false,
+                5},
+};
+} // namespace
+
+INSTANTIATE_TEST_SUITE_P(
+        TestSDPA, sdpa_test_t, ::testing::ValuesIn(sdpa_cases));
+
+} // namespace dnnl
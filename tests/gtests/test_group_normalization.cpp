@@ -0,0 +1,369 @@
+/*******************************************************************************
+* Copyright 2023 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "dnnl_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "oneapi/dnnl/dnnl.hpp"
+
+namespace dnnl {
+
+static constexpr float epsilon = 1e-5f;
+
+struct test_gnorm_params_t {
+    memory::format_tag tag;
+    memory::data_type dt;
+    memory::dims dims;
+    memory::dim groups;
+    bool with_relu;
+};
+
+class gnorm_test_t : public ::testing::TestWithParam<test_gnorm_params_t> {
+private:
+    test_gnorm_params_t p;
+    engine eng;
+    stream strm;
+
+    memory::dim MB, C, SP;
+    // The plain f32 source and the scale and shift of the tests
+    std::vector<float> src_, scale_, shift_;
+
+protected:
+    void SetUp() override {
+        p = ::testing::TestWithParam<decltype(p)>::GetParam();
+        SKIP_IF(get_test_engine_kind() != engine::kind::cpu,
+                "Group normalization is supported on CPU only.");
+        SKIP_IF(unsupported_data_type(p.dt),
+                "Engine does not support this data type.");
+        Test();
+    }
+
+    memory::format_tag plain_tag() const {
+        switch (p.dims.size()) {
+            case 3: return memory::format_tag::ncw;
+            case 4: return memory::format_tag::nchw;
+            default: return memory::format_tag::ncdhw;
+        }
+    }
+
+    // Creates the memory of the tested layout with the plain f32 `data`
+    memory to_test_memory(
+            const std::vector<float> &data, memory::data_type dt) {
+        memory plain({p.dims, memory::data_type::f32, plain_tag()}, eng);
+        float *ptr = static_cast<float *>(plain.get_data_handle());
+        for (size_t i = 0; i < data.size(); i++)
+            ptr[i] = data[i];
+        memory mem({p.dims, dt, p.tag}, eng);
+        reorder(plain, mem).execute(strm, plain, mem);
+        strm.wait();
+        return mem;
+    }
+
+    std::vector<float> to_plain(memory &mem) {
+        memory plain({p.dims, memory::data_type::f32, plain_tag()}, eng);
+        reorder(mem, plain).execute(strm, mem, plain);
+        strm.wait();
+        const float *ptr = static_cast<const float *>(plain.get_data_handle());
+        return std::vector<float>(ptr, ptr + MB * C * SP);
+    }
+
+    memory make_f32(const memory::dims &dims, const std::vector<float> &v) {
+        memory mem({dims, memory::data_type::f32,
+                           dims.size() == 1 ? memory::format_tag::a
+                                            : memory::format_tag::ab},
+                eng);
+        float *ptr = static_cast<float *>(mem.get_data_handle());
+        for (size_t i = 0; i < v.size(); i++)
+            ptr[i] = v[i];
+        return mem;
+    }
+
+    void Test() {
+        eng = get_test_engine();
+        strm = make_stream(eng);
+
+        MB = p.dims[0];
+        C = p.dims[1];
+        SP = 1;
+        for (size_t d = 2; d < p.dims.size(); d++)
+            SP *= p.dims[d];
+
+        // The values are not centered, so that the statistics are computed
+        // with a large mean
+        src_.resize(MB * C * SP);
+        for (size_t i = 0; i < src_.size(); i++)
+            src_[i] = 4.f + static_cast<float>((i * 37) % 23) / 8.f;
+        scale_.resize(C);
+        shift_.resize(C);
+        for (memory::dim c = 0; c < C; c++) {
+            scale_[c] = 0.5f + static_cast<float>(c % 5) / 4.f;
+            shift_[c] = static_cast<float>(c % 3) - 1.f;
+        }
+
+        using flags = normalization_flags;
+        Forward(prop_kind::forward_training, flags::none);
+        Forward(prop_kind::forward_training,
+                flags::use_scale | flags::use_shift);
+        Forward(prop_kind::forward_inference, flags::use_scale);
+        Forward(prop_kind::forward_inference,
+                flags::use_global_stats | flags::use_shift);
+        if (p.dt == memory::data_type::f32 && !p.with_relu) {
+            Backward(prop_kind::backward_data, flags::none);
+            Backward(prop_kind::backward, flags::use_scale | flags::use_shift);
+        }
+    }
+
+    // The reference mean and variance of every group
+    void compute_stats(std::vector<float> &mean, std::vector<float> &var) {
+        const memory::dim G = p.groups, CPG = C / G;
+        mean.assign(MB * G, 0);
+        var.assign(MB * G, 0);
+        for_(memory::dim n = 0; n < MB; n++)
+        for (memory::dim g = 0; g < G; g++) {
+            const float *s = &src_[(n * C + g * CPG) * SP];
+            double m = 0, v = 0;
+            for (memory::dim i = 0; i < CPG * SP; i++)
+                m += s[i];
+            m /= CPG * SP;
+            for (memory::dim i = 0; i < CPG * SP; i++)
+                v += (s[i] - m) * (s[i] - m);
+            mean[n * G + g] = static_cast<float>(m);
+            var[n * G + g] = static_cast<float>(v / (CPG * SP));
+        }
+    }
+
+    void Forward(prop_kind pk, normalization_flags flags) {
+        const bool use_scale = (bool)(flags & normalization_flags::use_scale);
+        const bool use_shift = (bool)(flags & normalization_flags::use_shift);
+        const bool use_global_stats
+                = (bool)(flags & normalization_flags::use_global_stats);
+        const bool is_training = pk == prop_kind::forward_training;
+        const memory::dim G = p.groups, CPG = C / G;
+
+        primitive_attr attr;
+        if (p.with_relu) {
+            post_ops ops;
+            ops.append_eltwise(algorithm::eltwise_relu, 0.f, 0.f);
+            attr.set_post_ops(ops);
+        }
+
+        memory::desc data_md(p.dims, p.dt, p.tag);
+        auto pd = group_normalization_forward::primitive_desc(
+                eng, pk, data_md, data_md, G, epsilon, flags, attr);
+        pd = group_normalization_forward::primitive_desc(
+                pd.get()); // test construction from a C pd
+        ASSERT_EQ(pd.get_group_size(), G);
+        ASSERT_EQ(pd.get_epsilon(), epsilon);
+        ASSERT_TRUE(pd.get_flags() == flags);
+
+        std::vector<float> ref_mean, ref_var;
+        compute_stats(ref_mean, ref_var);
+        // The global statistics are shifted, so that they differ from the
+        // computed ones
+        if (use_global_stats)
+            for (auto &m : ref_mean)
+                m += 0.25f;
+
+        memory src = to_test_memory(src_, p.dt);
+        memory dst(pd.dst_desc(), eng);
+        memory mean = make_f32({MB, G}, ref_mean);
+        memory var = make_f32({MB, G}, ref_var);
+        memory scale = make_f32({C}, scale_);
+        memory shift = make_f32({C}, shift_);
+        if (is_training && !use_global_stats) {
+            float *m = static_cast<float *>(mean.get_data_handle());
+            float *v = static_cast<float *>(var.get_data_handle());
+            for (memory::dim i = 0; i < MB * G; i++)
+                m[i] = v[i] = NAN;
+        }
+
+        std::unordered_map<int, memory> args
+                = {{DNNL_ARG_SRC, src}, {DNNL_ARG_DST, dst}};
+        if (use_global_stats || is_training) {
+            args.insert({DNNL_ARG_MEAN, mean});
+            args.insert({DNNL_ARG_VARIANCE, var});
+        }
+        if (use_scale) args.insert({DNNL_ARG_SCALE, scale});
+        if (use_shift) args.insert({DNNL_ARG_SHIFT, shift});
+        group_normalization_forward(pd).execute(strm, args);
+        strm.wait();
+
+        const bool is_bf16 = p.dt == memory::data_type::bf16;
+        const float stat_eps = 1e-4f;
+        if (is_training && !use_global_stats) {
+            const float *m = static_cast<const float *>(mean.get_data_handle());
+            const float *v = static_cast<const float *>(var.get_data_handle());
+            for (memory::dim i = 0; i < MB * G; i++) {
+                // The bf16 source is rounded, the statistics are not exact
+                const float eps = is_bf16 ? 5e-2f : stat_eps;
+                ASSERT_NEAR(m[i], ref_mean[i], eps * std::fabs(ref_mean[i]));
+                ASSERT_NEAR(v[i], ref_var[i], eps * (1.f + ref_var[i]));
+            }
+        }
+        if (is_bf16) return;
+
+        const auto got = to_plain(dst);
+        for_(memory::dim n = 0; n < MB; n++)
+        for_(memory::dim c = 0; c < C; c++)
+        for (memory::dim sp = 0; sp < SP; sp++) {
+            const memory::dim s_off = n * G + c / CPG;
+            const memory::dim off = (n * C + c) * SP + sp;
+            float ref = (src_[off] - ref_mean[s_off])
+                    / std::sqrt(ref_var[s_off] + epsilon);
+            if (use_scale) ref *= scale_[c];
+            if (use_shift) ref += shift_[c];
+            if (p.with_relu) ref = std::max(ref, 0.f);
+            ASSERT_NEAR(got[off], ref, 1e-4f * (1.f + std::fabs(ref)))
+                    << "n: " << n << " c: " << c << " sp: " << sp;
+        }
+    }
+
+    void Backward(prop_kind pk, normalization_flags flags) {
+        const bool use_scale = (bool)(flags & normalization_flags::use_scale);
+        const bool use_shift = (bool)(flags & normalization_flags::use_shift);
+        const memory::dim G = p.groups, CPG = C / G;
+
+        memory::desc data_md(p.dims, p.dt, p.tag);
+        auto hint = group_normalization_forward::primitive_desc(eng,
+                prop_kind::forward_training, data_md, data_md, G, epsilon,
+                flags);
+        auto pd = group_normalization_backward::primitive_desc(
+                eng, pk, data_md, data_md, data_md, G, epsilon, flags, hint);
+
+        std::vector<float> ref_mean, ref_var;
+        compute_stats(ref_mean, ref_var);
+        std::vector<float> diff_dst_(src_.size());
+        for (size_t i = 0; i < diff_dst_.size(); i++)
+            diff_dst_[i] = static_cast<float>((i * 13) % 11) / 5.f - 1.f;
+
+        memory src = to_test_memory(src_, p.dt);
+        memory diff_dst = to_test_memory(diff_dst_, p.dt);
+        memory diff_src(pd.diff_src_desc(), eng);
+        memory mean = make_f32({MB, G}, ref_mean);
+        memory var = make_f32({MB, G}, ref_var);
+        memory scale = make_f32({C}, scale_);
+        memory diff_scale = make_f32({C}, std::vector<float>(C));
+        memory diff_shift = make_f32({C}, std::vector<float>(C));
+
+        std::unordered_map<int, memory> args = {{DNNL_ARG_SRC, src},
+                {DNNL_ARG_DIFF_DST, diff_dst}, {DNNL_ARG_MEAN, mean},
+                {DNNL_ARG_VARIANCE, var}, {DNNL_ARG_DIFF_SRC, diff_src}};
+        if (use_scale) {
+            args.insert({DNNL_ARG_SCALE, scale});
+            args.insert({DNNL_ARG_DIFF_SCALE, diff_scale});
+        }
+        if (use_shift) args.insert({DNNL_ARG_DIFF_SHIFT, diff_shift});
+        group_normalization_backward(pd).execute(strm, args);
+        strm.wait();
+
+        const auto got = to_plain(diff_src);
+        for_(memory::dim n = 0; n < MB; n++)
+        for (memory::dim g = 0; g < G; g++) {
+            const memory::dim s_off = n * G + g;
+            const double inv_sqrtvar = 1. / std::sqrt(ref_var[s_off] + epsilon);
+            const double group_size = static_cast<double>(CPG * SP);
+            double dd_gamma = 0, dd_gamma_x = 0;
+            for_(memory::dim c = g * CPG; c < (g + 1) * CPG; c++)
+            for (memory::dim sp = 0; sp < SP; sp++) {
+                const memory::dim off = (n * C + c) * SP + sp;
+                const double gamma = use_scale ? scale_[c] : 1.;
+                dd_gamma += diff_dst_[off] * gamma;
+                dd_gamma_x += diff_dst_[off] * gamma
+                        * (src_[off] - ref_mean[s_off]);
+            }
+            dd_gamma_x *= inv_sqrtvar;
+
+            for_(memory::dim c = g * CPG; c < (g + 1) * CPG; c++)
+            for (memory::dim sp = 0; sp < SP; sp++) {
+                const memory::dim off = (n * C + c) * SP + sp;
+                const double gamma = use_scale ? scale_[c] : 1.;
+                double ref = diff_dst_[off] * gamma - dd_gamma / group_size
+                        - (src_[off] - ref_mean[s_off]) * dd_gamma_x
+                                * inv_sqrtvar / group_size;
+                ref *= inv_sqrtvar;
+                ASSERT_NEAR(got[off], ref, 1e-4 * (1. + std::fabs(ref)))
+                        << "n: " << n << " c: " << c << " sp: " << sp;
+            }
+        }
+
+        if (!use_scale || !use_shift) return;
+        const float *ds
+                = static_cast<const float *>(diff_scale.get_data_handle());
+        const float *db
+                = static_cast<const float *>(diff_shift.get_data_handle());
+        for (memory::dim c = 0; c < C; c++) {
+            double ref_ds = 0, ref_db = 0;
+            for_(memory::dim n = 0; n < MB; n++)
+            for (memory::dim sp = 0; sp < SP; sp++) {
+                const memory::dim s_off = n * G + c / CPG;
+                const memory::dim off = (n * C + c) * SP + sp;
+                ref_ds += (src_[off] - ref_mean[s_off]) * diff_dst_[off]
+                        / std::sqrt(ref_var[s_off] + epsilon);
+                ref_db += diff_dst_[off];
+            }
+            ASSERT_NEAR(ds[c], ref_ds, 1e-4 * (1. + std::fabs(ref_ds)));
+            ASSERT_NEAR(db[c], ref_db, 1e-4 * (1. + std::fabs(ref_db)));
+        }
+    }
+};
+
+TEST_P(gnorm_test_t, TestsGroupNormalization) {}
+
+namespace {
+using tag = memory::format_tag;
+using dt = memory::data_type;
+} // namespace
+
+INSTANTIATE_TEST_SUITE_P(TestGroupNormalizationNspc, gnorm_test_t,
+        ::testing::Values(
+                test_gnorm_params_t {tag::nhwc, dt::f32, {2, 32, 5, 7}, 8,
+                        false},
+                test_gnorm_params_t {tag::nhwc, dt::f32, {1, 20, 9, 9}, 4,
+                        true},
+                test_gnorm_params_t {tag::nwc, dt::f32, {3, 6, 17}, 3,
+                        false},
+                test_gnorm_params_t {tag::ndhwc, dt::f32, {2, 64, 3, 4, 5},
+                        32, true},
+                test_gnorm_params_t {tag::nhwc, dt::bf16, {2, 32, 6, 6}, 4,
+                        false}));
+
+INSTANTIATE_TEST_SUITE_P(TestGroupNormalizationBlocked, gnorm_test_t,
+        ::testing::Values(
+                test_gnorm_params_t {tag::nChw16c, dt::f32, {2, 32, 5, 7},
+                        4, false},
+                test_gnorm_params_t {tag::nChw8c, dt::f32, {2, 24, 6, 3}, 3,
+                        true},
+                test_gnorm_params_t {tag::nCdhw16c, dt::f32,
+                        {1, 48, 2, 3, 4}, 6, false},
+                test_gnorm_params_t {tag::nChw16c, dt::bf16, {2, 32, 4, 4},
+                        2, true}));
+
+INSTANTIATE_TEST_SUITE_P(TestGroupNormalizationPlain, gnorm_test_t,
+        ::testing::Values(
+                test_gnorm_params_t {tag::nchw, dt::f32, {2, 12, 5, 5}, 3,
+                        false},
+                test_gnorm_params_t {tag::nchw, dt::f32, {2, 20, 3, 3}, 20,
+                        true},
+                test_gnorm_params_t {tag::ncw, dt::f32, {2, 10, 11}, 1,
+                        false}));
+
+} // namespace dnnl
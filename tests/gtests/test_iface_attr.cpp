@@ -42,6 +42,30 @@ TEST_F(attr_test_t, TestFPMathMode) {
     }
 }
 
+TEST_F(attr_test_t, TestFPMathModeApplyToInt) {
+    dnnl::primitive_attr attr;
+    fpmath_mode mode;
+    bool apply_to_int = true;
+    attr.get_fpmath_mode(mode, apply_to_int);
+    ASSERT_EQ(mode, fpmath_mode::strict);
+    ASSERT_FALSE(apply_to_int);
+
+    for (auto m : {fpmath_mode::strict, fpmath_mode::bf16, fpmath_mode::f16,
+                 fpmath_mode::tf32, fpmath_mode::any}) {
+        for (bool a : {false, true}) {
+            attr.set_fpmath_mode(m, a);
+            attr.get_fpmath_mode(mode, apply_to_int);
+            ASSERT_EQ(m, mode);
+            ASSERT_EQ(a, apply_to_int);
+        }
+    }
+
+    // the single argument setter resets the flag
+    attr.set_fpmath_mode(fpmath_mode::strict);
+    attr.get_fpmath_mode(mode, apply_to_int);
+    ASSERT_FALSE(apply_to_int);
+}
+
 TEST_F(attr_test_t, TestFPMathModeDefault) {
     ASSERT_EQ(fpmath_mode::strict, get_default_fpmath_mode());
 
@@ -256,6 +280,36 @@ TEST_F(attr_test_t, TestScalesExpectFailure) {
     EXPECT_ANY_THROW(attr.set_scales_mask(unsupported_arg, 1 << 1));
 }
 
+TEST_F(attr_test_t, TestGroupedQuantizationParameters) {
+    dnnl::primitive_attr attr;
+    const int wei_mask = (1 << 0) | (1 << 1);
+
+    attr.set_scales(DNNL_ARG_WEIGHTS, wei_mask, {32, 1});
+    attr.set_scales(
+            DNNL_ARG_WEIGHTS, wei_mask, {32, 1}, memory::data_type::bf16);
+    attr.set_scales(
+            DNNL_ARG_WEIGHTS, wei_mask, {128, 1}, memory::data_type::f16);
+    attr.set_zero_points(DNNL_ARG_WEIGHTS, wei_mask, {32, 1});
+    for (auto dt : {memory::data_type::s8, memory::data_type::u8,
+                 memory::data_type::s4, memory::data_type::u4})
+        attr.set_zero_points(DNNL_ARG_WEIGHTS, wei_mask, {32, 1}, dt);
+
+    // groups must be positive
+    EXPECT_ANY_THROW(attr.set_scales(DNNL_ARG_WEIGHTS, wei_mask, {0, 1}));
+    EXPECT_ANY_THROW(attr.set_zero_points(DNNL_ARG_WEIGHTS, wei_mask, {-1, 1}));
+
+    // integer scales and floating point zero points are not supported
+    EXPECT_ANY_THROW(attr.set_scales(
+            DNNL_ARG_WEIGHTS, wei_mask, {32, 1}, memory::data_type::s8));
+    EXPECT_ANY_THROW(attr.set_zero_points(
+            DNNL_ARG_WEIGHTS, wei_mask, {32, 1}, memory::data_type::f32));
+
+    // only weights zero points may be grouped or of a non-s32 data type
+    EXPECT_ANY_THROW(attr.set_zero_points(DNNL_ARG_SRC, 0, {32, 1}));
+    EXPECT_ANY_THROW(
+            attr.set_zero_points(DNNL_ARG_SRC, 0, {}, memory::data_type::u8));
+}
+
 HANDLE_EXCEPTIONS_FOR_TEST_F(attr_test_t, TestPostOps) {
     dnnl::primitive_attr attr;
     dnnl::post_ops ops;
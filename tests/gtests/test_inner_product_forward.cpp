@@ -483,4 +483,73 @@ INSTANTIATE_TEST_SUITE_P(TestInnerProductForward, inner_product_test_float,
                         memory::format_tag::nc, memory::format_tag::oi,
                         memory::format_tag::x, memory::format_tag::nc,
                         EXPAND_SIZES_2D(2, 8, 16, 1, 1)}));
+
+class inner_product_int8_grouped_weights_t : public ::testing::Test {};
+
+HANDLE_EXCEPTIONS_FOR_TEST(
+        inner_product_int8_grouped_weights_t, TestGroupedInt8) {
+    using tag = memory::format_tag;
+    using dt = memory::data_type;
+    auto engine_kind = get_test_engine_kind();
+    SKIP_IF(engine_kind != engine::kind::cpu,
+            "group-wise int8 weights are supported on CPU only");
+    engine e {engine_kind, 0};
+    stream s(e);
+
+    const memory::dim MB = 4, IC = 64, OC = 16, G = 16;
+
+    memory src_m({{MB, IC}, dt::u8, tag::nc}, e);
+    memory wei_m({{OC, IC}, dt::s8, tag::oi}, e);
+    memory dst_m({{MB, OC}, dt::f32, tag::nc}, e);
+    // a scale and a zero point per output channel and per group of G input
+    // channels
+    memory scales_m({{OC, IC / G}, dt::f32, tag::ab}, e);
+    memory zp_m({{OC, IC / G}, dt::u8, tag::ab}, e);
+
+    std::vector<int> src(MB * IC), wei(OC * IC), zp(OC * IC / G);
+    std::vector<float> scales(OC * IC / G);
+    {
+        auto src_ptr = map_memory<uint8_t>(src_m);
+        for (size_t i = 0; i < src.size(); i++)
+            src_ptr[i] = static_cast<uint8_t>(src[i] = static_cast<int>(i % 7));
+        auto wei_ptr = map_memory<int8_t>(wei_m);
+        for (size_t i = 0; i < wei.size(); i++)
+            wei_ptr[i] = static_cast<int8_t>(
+                    wei[i] = static_cast<int>(i % 9) - 4);
+        auto scales_ptr = map_memory<float>(scales_m);
+        auto zp_ptr = map_memory<uint8_t>(zp_m);
+        for (size_t i = 0; i < scales.size(); i++) {
+            scales_ptr[i] = scales[i] = 0.5f * static_cast<float>(1 + i % 3);
+            zp_ptr[i] = static_cast<uint8_t>(zp[i] = static_cast<int>(i % 5));
+        }
+    }
+
+    primitive_attr attr;
+    attr.set_scales(DNNL_ARG_WEIGHTS, (1 << 0) | (1 << 1), {1, G});
+    attr.set_zero_points(
+            DNNL_ARG_WEIGHTS, (1 << 0) | (1 << 1), {1, G}, dt::u8);
+    auto pd = inner_product_forward::primitive_desc(e,
+            prop_kind::forward_inference, src_m.get_desc(), wei_m.get_desc(),
+            dst_m.get_desc(), attr);
+    inner_product_forward(pd).execute(s,
+            {{DNNL_ARG_SRC, src_m}, {DNNL_ARG_WEIGHTS, wei_m},
+                    {DNNL_ARG_DST, dst_m},
+                    {DNNL_ARG_ATTR_SCALES | DNNL_ARG_WEIGHTS, scales_m},
+                    {DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_WEIGHTS, zp_m}});
+    s.wait();
+
+    auto dst = map_memory<float>(dst_m);
+    for_(memory::dim mb = 0; mb < MB; mb++)
+    for (memory::dim oc = 0; oc < OC; oc++) {
+        float ref = 0.f;
+        for (memory::dim g = 0; g < IC / G; g++) {
+            const memory::dim q = oc * (IC / G) + g;
+            int group_acc = 0;
+            for (memory::dim ic = g * G; ic < (g + 1) * G; ic++)
+                group_acc += src[mb * IC + ic] * (wei[oc * IC + ic] - zp[q]);
+            ref += static_cast<float>(group_acc) * scales[q];
+        }
+        ASSERT_EQ(ref, dst[mb * OC + oc]);
+    }
+}
 } // namespace dnnl
@@ -368,6 +368,207 @@ HANDLE_EXCEPTIONS_FOR_TEST_P(
     ASSERT_EQ(impl_info_no_postops, impl_info_with_postops);
 }
 
+struct int4_weights_test_t
+    : public ::testing::TestWithParam<memory::data_type> {};
+
+HANDLE_EXCEPTIONS_FOR_TEST_P(int4_weights_test_t, TestDecompression) {
+    auto engine_kind = get_test_engine_kind();
+    SKIP_IF(engine_kind != engine::kind::cpu,
+            "s4/u4 weights are supported on CPU only");
+    engine e {engine_kind, 0};
+    stream s(e);
+
+    const auto wei_dt = GetParam();
+    // odd K and N with a tail to cover the partially loaded bytes
+    const memory::dim M = 3, K = 5, N = 34;
+    const float min_val = wei_dt == memory::data_type::s4 ? -8.f : 0.f;
+
+    memory src_m({{M, K}, memory::data_type::f32, tag::ab}, e);
+    memory wei_f32_m({{K, N}, memory::data_type::f32, tag::ab}, e);
+    memory wei_m({{K, N}, wei_dt, tag::ab}, e);
+    memory dst_m({{M, N}, memory::data_type::f32, tag::ab}, e);
+
+    std::vector<float> src(M * K), wei(K * N);
+    {
+        auto src_ptr = map_memory<float>(src_m);
+        for (size_t i = 0; i < src.size(); i++)
+            src_ptr[i] = src[i] = static_cast<float>(i % 7) - 3.f;
+        auto wei_ptr = map_memory<float>(wei_f32_m);
+        for (size_t i = 0; i < wei.size(); i++)
+            wei_ptr[i] = wei[i] = min_val + static_cast<float>(i % 16);
+    }
+
+    reorder(wei_f32_m, wei_m).execute(s, wei_f32_m, wei_m);
+
+    primitive_attr attr;
+    attr.set_fpmath_mode(fpmath_mode::strict, true);
+    auto pd = matmul::primitive_desc(e, src_m.get_desc(), wei_m.get_desc(),
+            dst_m.get_desc(), attr);
+    matmul(pd).execute(s,
+            {{DNNL_ARG_SRC, src_m}, {DNNL_ARG_WEIGHTS, wei_m},
+                    {DNNL_ARG_DST, dst_m}});
+    s.wait();
+
+    auto dst = map_memory<float>(dst_m);
+    for_(memory::dim m = 0; m < M; m++)
+    for (memory::dim n = 0; n < N; n++) {
+        float ref = 0.f;
+        for (memory::dim k = 0; k < K; k++)
+            ref += src[m * K + k] * wei[k * N + n];
+        ASSERT_EQ(ref, dst[m * N + n]);
+    }
+}
+
+HANDLE_EXCEPTIONS_FOR_TEST_P(int4_weights_test_t, TestGroupedDecompression) {
+    auto engine_kind = get_test_engine_kind();
+    SKIP_IF(engine_kind != engine::kind::cpu,
+            "s4/u4 weights are supported on CPU only");
+    engine e {engine_kind, 0};
+    stream s(e);
+
+    const auto wei_dt = GetParam();
+    const memory::dim M = 3, K = 8, N = 34, G = 4;
+    const float min_val = wei_dt == memory::data_type::s4 ? -8.f : 0.f;
+
+    memory src_m({{M, K}, memory::data_type::f32, tag::ab}, e);
+    memory wei_f32_m({{K, N}, memory::data_type::f32, tag::ab}, e);
+    memory wei_m({{K, N}, wei_dt, tag::ab}, e);
+    memory dst_m({{M, N}, memory::data_type::f32, tag::ab}, e);
+    // a scale and a zero point per group of G rows along K and per column
+    memory scales_m({{K / G, N}, memory::data_type::f32, tag::ab}, e);
+    memory zp_m({{K / G, N}, memory::data_type::u8, tag::ab}, e);
+
+    std::vector<float> src(M * K), wei(K * N), scales(K / G * N), zp(K / G * N);
+    {
+        auto src_ptr = map_memory<float>(src_m);
+        for (size_t i = 0; i < src.size(); i++)
+            src_ptr[i] = src[i] = static_cast<float>(i % 7) - 3.f;
+        auto wei_ptr = map_memory<float>(wei_f32_m);
+        for (size_t i = 0; i < wei.size(); i++)
+            wei_ptr[i] = wei[i] = min_val + static_cast<float>(i % 16);
+        auto scales_ptr = map_memory<float>(scales_m);
+        auto zp_ptr = map_memory<uint8_t>(zp_m);
+        for (size_t i = 0; i < scales.size(); i++) {
+            scales_ptr[i] = scales[i] = 0.5f * static_cast<float>(1 + i % 3);
+            zp_ptr[i] = static_cast<uint8_t>(i % 5);
+            zp[i] = static_cast<float>(zp_ptr[i]);
+        }
+    }
+
+    reorder(wei_f32_m, wei_m).execute(s, wei_f32_m, wei_m);
+
+    primitive_attr attr;
+    attr.set_fpmath_mode(fpmath_mode::strict, true);
+    attr.set_scales(DNNL_ARG_WEIGHTS, (1 << 0) | (1 << 1), {G, 1});
+    attr.set_zero_points(DNNL_ARG_WEIGHTS, (1 << 0) | (1 << 1), {G, 1},
+            memory::data_type::u8);
+    auto pd = matmul::primitive_desc(e, src_m.get_desc(), wei_m.get_desc(),
+            dst_m.get_desc(), attr);
+    matmul(pd).execute(s,
+            {{DNNL_ARG_SRC, src_m}, {DNNL_ARG_WEIGHTS, wei_m},
+                    {DNNL_ARG_DST, dst_m},
+                    {DNNL_ARG_ATTR_SCALES | DNNL_ARG_WEIGHTS, scales_m},
+                    {DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_WEIGHTS, zp_m}});
+    s.wait();
+
+    auto dst = map_memory<float>(dst_m);
+    for_(memory::dim m = 0; m < M; m++)
+    for (memory::dim n = 0; n < N; n++) {
+        float ref = 0.f;
+        for (memory::dim k = 0; k < K; k++) {
+            const memory::dim q = (k / G) * N + n;
+            ref += src[m * K + k] * (wei[k * N + n] - zp[q]) * scales[q];
+        }
+        ASSERT_EQ(ref, dst[m * N + n]);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Int4Weights, int4_weights_test_t,
+        ::testing::Values(memory::data_type::s4, memory::data_type::u4));
+
+// The parameter is the group size along K of the weights scales and zero
+// points, the shape is large enough to be dispatched to the optimized int8
+// implementations
+struct int8_grouped_weights_test_t
+    : public ::testing::TestWithParam<memory::dim> {};
+
+HANDLE_EXCEPTIONS_FOR_TEST_P(int8_grouped_weights_test_t, TestGroupedInt8) {
+    auto engine_kind = get_test_engine_kind();
+    SKIP_IF(engine_kind != engine::kind::cpu,
+            "group-wise int8 weights are supported on CPU only");
+    engine e {engine_kind, 0};
+    stream s(e);
+
+    const memory::dim G = GetParam();
+    const memory::dim M = 16, K = 256, N = 64;
+    const float src_scale = 0.5f;
+
+    memory src_m({{M, K}, memory::data_type::u8, tag::ab}, e);
+    memory wei_m({{K, N}, memory::data_type::s8, tag::ab}, e);
+    memory bia_m({{1, N}, memory::data_type::f32, tag::ab}, e);
+    memory dst_m({{M, N}, memory::data_type::f32, tag::ab}, e);
+    memory src_scale_m({{1}, memory::data_type::f32, tag::a}, e);
+    // a scale and a zero point per group of G rows along K and per column
+    memory scales_m({{K / G, N}, memory::data_type::f32, tag::ab}, e);
+    memory zp_m({{K / G, N}, memory::data_type::s8, tag::ab}, e);
+
+    std::vector<int> src(M * K), wei(K * N), zp(K / G * N);
+    std::vector<float> bia(N), scales(K / G * N);
+    {
+        auto src_ptr = map_memory<uint8_t>(src_m);
+        for (size_t i = 0; i < src.size(); i++)
+            src_ptr[i] = static_cast<uint8_t>(src[i] = static_cast<int>(i % 7));
+        auto wei_ptr = map_memory<int8_t>(wei_m);
+        for (size_t i = 0; i < wei.size(); i++)
+            wei_ptr[i] = static_cast<int8_t>(
+                    wei[i] = static_cast<int>(i % 9) - 4);
+        auto bia_ptr = map_memory<float>(bia_m);
+        for (size_t i = 0; i < bia.size(); i++)
+            bia_ptr[i] = bia[i] = static_cast<float>(i % 3);
+        map_memory<float>(src_scale_m)[0] = src_scale;
+        auto scales_ptr = map_memory<float>(scales_m);
+        auto zp_ptr = map_memory<int8_t>(zp_m);
+        for (size_t i = 0; i < scales.size(); i++) {
+            scales_ptr[i] = scales[i] = 0.5f * static_cast<float>(1 + i % 3);
+            zp_ptr[i] = static_cast<int8_t>(
+                    zp[i] = static_cast<int>(i % 5) - 2);
+        }
+    }
+
+    primitive_attr attr;
+    attr.set_scales_mask(DNNL_ARG_SRC, 0);
+    attr.set_scales(DNNL_ARG_WEIGHTS, (1 << 0) | (1 << 1), {G, 1});
+    attr.set_zero_points(DNNL_ARG_WEIGHTS, (1 << 0) | (1 << 1), {G, 1},
+            memory::data_type::s8);
+    auto pd = matmul::primitive_desc(e, src_m.get_desc(), wei_m.get_desc(),
+            bia_m.get_desc(), dst_m.get_desc(), attr);
+    matmul(pd).execute(s,
+            {{DNNL_ARG_SRC, src_m}, {DNNL_ARG_WEIGHTS, wei_m},
+                    {DNNL_ARG_BIAS, bia_m}, {DNNL_ARG_DST, dst_m},
+                    {DNNL_ARG_ATTR_SCALES | DNNL_ARG_SRC, src_scale_m},
+                    {DNNL_ARG_ATTR_SCALES | DNNL_ARG_WEIGHTS, scales_m},
+                    {DNNL_ARG_ATTR_ZERO_POINTS | DNNL_ARG_WEIGHTS, zp_m}});
+    s.wait();
+
+    auto dst = map_memory<float>(dst_m);
+    for_(memory::dim m = 0; m < M; m++)
+    for (memory::dim n = 0; n < N; n++) {
+        float ref = 0.f;
+        for (memory::dim g = 0; g < K / G; g++) {
+            const memory::dim q = g * N + n;
+            int group_acc = 0;
+            for (memory::dim k = g * G; k < (g + 1) * G; k++)
+                group_acc += src[m * K + k] * (wei[k * N + n] - zp[q]);
+            ref += static_cast<float>(group_acc) * scales[q];
+        }
+        ref = ref * src_scale + bia[n];
+        ASSERT_EQ(ref, dst[m * N + n]);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Int8GroupedWeights, int8_grouped_weights_test_t,
+        ::testing::Values(32, 64, 128, 256));
+
 /********************************* TEST CASES *********************************/
 
 using iface = matmul_iface_test_t;